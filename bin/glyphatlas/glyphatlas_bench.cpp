@@ -0,0 +1,158 @@
+// Host benchmark for GlyphAtlas (src/helpers/ui/GlyphAtlas.cpp)
+//
+// Renders screens of chat text into a 960x540 1-bpp canvas (T5S3 panel) two ways: the per-pixel path
+// (Adafruit GFX drawChar(): a virtual drawPixel() per set bit, as GFXcanvas1 does), and GlyphAtlas
+// get() + blit(). Checks both give the same framebuffer, and reports glyphs/sec for each, per font.
+//
+//   g++ -O2 -I bin/glyphatlas/host -I src/helpers/ui -I examples/companion_radio/ui-new/fonts
+//       bin/glyphatlas/glyphatlas_bench.cpp src/helpers/ui/GlyphAtlas.cpp -o glyphatlas_bench
+//   ./glyphatlas_bench [screens]
+
+#include "GlyphAtlas.h"
+#include "Montserrat7pt7b.h"
+#include "NotoSans9pt8b.h"
+#include "NotoSansBold12pt7b.h"
+#include "MontserratBold24pt7b.h"
+#include <stdio.h>
+#include <chrono>
+
+#define FB_W  960
+#define FB_H  540
+#define FB_ROW_BYTES  ((FB_W + 7) / 8)
+
+static const char* const sample[] = {
+  "Hey is anyone out there?", "Good morning all, the repeater on the hill is back up",
+  "Thanks for the test, I hear you loud and clear", "Copy that, signal is good here",
+  "What is your SNR to the new node?", "lol that's great", "I'm going to put the antenna on the roof tomorrow",
+  "Anyone know how to set the path hash mode?", "Received, thanks!",
+  "Battery is at 40% so I will be off the mesh for a while", "See you at the meetup on Saturday",
+  "The weather is bad today, rain all day", "Can you hear me from home?", "Testing from the car, 12km from the repeater",
+};
+#define NUM_SAMPLES  (int)(sizeof(sample) / sizeof(sample[0]))
+
+struct BenchFont {
+  const char* name;
+  const GFXfont* font;
+};
+
+static const BenchFont fonts[] = {
+  { "Montserrat 7pt", &Montserrat_Regular7pt7b },
+  { "NotoSans 9pt", &NotoSans9pt8b },
+  { "NotoSans Bold 12pt", &NotoSans_Bold12pt7b },
+  { "Montserrat Bold 24pt", &Montserrat_Bold24pt7b },
+};
+
+// what GFXcanvas1 does per pixel (rotation 0)
+class Canvas {
+public:
+  uint8_t buf[FB_ROW_BYTES * FB_H];
+
+  virtual ~Canvas() { }
+  virtual void drawPixel(int16_t x, int16_t y, uint16_t color) {
+    if (x < 0 || y < 0 || x >= FB_W || y >= FB_H) return;
+    uint8_t* ptr = &buf[(x / 8) + y * FB_ROW_BYTES];
+    if (color) *ptr |= 0x80 >> (x & 7); else *ptr &= ~(0x80 >> (x & 7));
+  }
+};
+
+// Adafruit_GFX::drawChar(), custom font, size 1
+static void drawCharPerPixel(Canvas* c, const GFXfont* font, int16_t x, int16_t y, uint8_t ch, uint16_t color) {
+  const GFXglyph* glyph = &font->glyph[ch - font->first];
+  const uint8_t* bitmap = font->bitmap;
+  uint16_t bo = glyph->bitmapOffset;
+  uint8_t w = glyph->width, h = glyph->height;
+  int8_t xo = glyph->xOffset, yo = glyph->yOffset;
+  uint8_t bits = 0, bit = 0;
+  for (uint8_t yy = 0; yy < h; yy++) {
+    for (uint8_t xx = 0; xx < w; xx++) {
+      if (!(bit++ & 7)) bits = bitmap[bo++];
+      if (bits & 0x80) c->drawPixel(x + xo + xx, y + yo + yy, color);
+      bits <<= 1;
+    }
+  }
+}
+
+// lays text out like print() does (wrapping at the right edge), calls draw() per glyph. Returns glyphs drawn
+template<class F>
+static long renderScreen(const GFXfont* font, int first_msg, F draw) {
+  long n = 0;
+  int x = 0, y = font->yAdvance;
+  for (int m = first_msg; y < FB_H; m++) {
+    for (const char* p = sample[m % NUM_SAMPLES]; *p; p++) {
+      uint8_t ch = *p;
+      if (ch < font->first || ch > font->last) continue;
+      const GFXglyph* g = &font->glyph[ch - font->first];
+      if (x + g->xOffset + g->width > FB_W) {
+        x = 0;
+        y += font->yAdvance;
+      }
+      draw(x, y, ch);
+      x += g->xAdvance;
+      n++;
+    }
+    x = 0;
+    y += font->yAdvance;
+  }
+  return n;
+}
+
+static double seconds(std::chrono::steady_clock::time_point t0) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+int main(int argc, char* argv[]) {
+  int screens = argc > 1 ? atoi(argv[1]) : 2000;
+  static Canvas pixel_canvas;
+  static Canvas* volatile canvas_ref = &pixel_canvas;
+  static uint8_t atlas_fb[FB_ROW_BYTES * FB_H];
+  Canvas* canvas = canvas_ref;   // not devirtualised, as in Adafruit GFX
+
+  GlyphAtlas atlas;
+  if (!atlas.begin()) {
+    printf("atlas allocation failed\n");
+    return 1;
+  }
+
+  printf("%d screens of %dx%d per font\n", screens, FB_W, FB_H);
+  printf("%-22s %12s %12s %8s\n", "font", "pixel gl/s", "atlas gl/s", "speedup");
+  for (const BenchFont& bf : fonts) {
+    const GFXfont* font = bf.font;
+
+    // same output?
+    memset(canvas->buf, 0xFF, sizeof(canvas->buf));
+    memset(atlas_fb, 0xFF, sizeof(atlas_fb));
+    renderScreen(font, 0, [&](int x, int y, uint8_t ch) { drawCharPerPixel(canvas, font, x, y, ch, 0); });
+    renderScreen(font, 0, [&](int x, int y, uint8_t ch) {
+      const AtlasGlyph* g = atlas.get(font, ch);
+      if (g && g->w > 0 && g->h > 0) atlas.blit(atlas_fb, FB_ROW_BYTES, FB_H, x, y, g, false);
+    });
+    if (memcmp(canvas->buf, atlas_fb, sizeof(atlas_fb)) != 0) {
+      printf("%s: atlas output differs from per-pixel output\n", bf.name);
+      return 1;
+    }
+
+    long n_pixel = 0, n_atlas = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int s = 0; s < screens; s++) {
+      if ((s & 7) == 0) memset(canvas->buf, 0xFF, sizeof(canvas->buf));   // startFrame() clears
+      n_pixel += renderScreen(font, s, [&](int x, int y, uint8_t ch) { drawCharPerPixel(canvas, font, x, y, ch, 0); });
+    }
+    double t_pixel = seconds(t0);
+
+    t0 = std::chrono::steady_clock::now();
+    for (int s = 0; s < screens; s++) {
+      if ((s & 7) == 0) memset(atlas_fb, 0xFF, sizeof(atlas_fb));
+      n_atlas += renderScreen(font, s, [&](int x, int y, uint8_t ch) {
+        const AtlasGlyph* g = atlas.get(font, ch);
+        if (g && g->w > 0 && g->h > 0) atlas.blit(atlas_fb, FB_ROW_BYTES, FB_H, x, y, g, false);
+      });
+    }
+    double t_atlas = seconds(t0);
+
+    double r_pixel = n_pixel / t_pixel, r_atlas = n_atlas / t_atlas;
+    printf("%-22s %12.0f %12.0f %7.1fx\n", bf.name, r_pixel, r_atlas, r_atlas / r_pixel);
+  }
+  printf("atlas: hits %u  misses %u  flushes %u  arena %u bytes\n", (unsigned)atlas.getHits(),
+         (unsigned)atlas.getMisses(), (unsigned)atlas.getFlushes(), (unsigned)atlas.getArenaUsed());
+  return 0;
+}
@@ -0,0 +1,8 @@
+// Minimal stand-in for the Arduino core, enough to build GlyphAtlas and the GFX font tables on the host.
+#pragma once
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PROGMEM
@@ -0,0 +1,150 @@
+#!/usr/bin/env python3
+"""
+Build a Meck glyph pack (.mgp) from a BDF bitmap font, eg. GNU Unifont.
+
+The firmware loads packs from /fonts on the SD card and uses them for code
+points the built-in fonts can't draw (Cyrillic, Greek, CJK ...). Put one pack
+per pixel size there; the nearest size to the current font is used.
+
+  make_glyphpack.py unifont.bdf unicode_16.mgp
+  make_glyphpack.py unifont.bdf unicode_16.mgp --ranges 0370-03FF,0400-04FF
+
+TTF/OTF fonts can be converted to BDF first, eg. with otf2bdf -p <size>.
+File layout is documented in src/helpers/ui/GlyphPack.h.
+"""
+import argparse
+import struct
+import sys
+
+BLOCK = 64          # index entries per fence block
+MAX_DIM = 48        # GLYPH_PACK_MAX_DIM in firmware
+COMPRESSED = 0x80000000
+
+
+def parse_ranges(text):
+    ranges = []
+    for part in text.split(","):
+        lo, _, hi = part.strip().partition("-")
+        ranges.append((int(lo, 16), int(hi or lo, 16)))
+    return ranges
+
+
+def read_bdf(path):
+    ascent = descent = 0
+    glyphs = {}
+    with open(path, "r", encoding="latin-1") as f:
+        lines = iter(f.read().splitlines())
+    for line in lines:
+        if line.startswith("FONT_ASCENT "):
+            ascent = int(line.split()[1])
+        elif line.startswith("FONT_DESCENT "):
+            descent = int(line.split()[1])
+        elif line.startswith("STARTCHAR"):
+            cp = -1
+            dwidth = 0
+            bbx = (0, 0, 0, 0)
+            rows = []
+            for line in lines:
+                if line.startswith("ENCODING "):
+                    cp = int(line.split()[1])
+                elif line.startswith("DWIDTH "):
+                    dwidth = int(line.split()[1])
+                elif line.startswith("BBX "):
+                    bbx = tuple(int(v) for v in line.split()[1:5])
+                elif line.startswith("BITMAP"):
+                    for line in lines:
+                        if line.startswith("ENDCHAR"):
+                            break
+                        rows.append(line.strip())
+                    break
+            if cp >= 0:
+                glyphs[cp] = (dwidth, bbx, rows)
+    return ascent, descent, glyphs
+
+
+def pack_bits(w, h, rows):
+    """BDF hex rows -> GFXfont bit stream (MSB first, rows not byte aligned)"""
+    out = bytearray((w * h + 7) // 8)
+    bit = 0
+    for y in range(h):
+        row = int(rows[y], 16) if y < len(rows) and rows[y] else 0
+        row_bits = len(rows[y]) * 4 if y < len(rows) else w
+        for x in range(w):
+            if row & (1 << (row_bits - 1 - x)):
+                out[bit >> 3] |= 0x80 >> (bit & 7)
+            bit += 1
+    return bytes(out)
+
+
+def packbits(data):
+    """n < 128: n+1 literals follow, n >= 128: next byte repeated n-126 times"""
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        run = 1
+        while i + run < len(data) and run < 129 and data[i + run] == data[i]:
+            run += 1
+        if run >= 2:
+            out += bytes((run + 126, data[i]))
+            i += run
+            continue
+        j = i
+        while j < len(data) and j - i < 128 and not (j + 1 < len(data) and data[j + 1] == data[j]):
+            j += 1
+        if j == i:
+            j = i + 1
+        out.append(j - i - 1)
+        out += data[i:j]
+        i = j
+    return bytes(out)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("bdf")
+    ap.add_argument("out")
+    ap.add_argument("--ranges", help="hex code point ranges to include, eg. 0370-03FF,0400-04FF (default: all >= 0x80)")
+    args = ap.parse_args()
+
+    ascent, descent, glyphs = read_bdf(args.bdf)
+    ranges = parse_ranges(args.ranges) if args.ranges else [(0x80, 0xFFFFFF)]
+    cps = sorted(cp for cp in glyphs if any(lo <= cp <= hi for lo, hi in ranges))
+
+    entries = []
+    bitmaps = bytearray()
+    for cp in cps:
+        dwidth, (w, h, xo, yo), rows = glyphs[cp]
+        if w > MAX_DIM or h > MAX_DIM or dwidth > 255:
+            continue
+        raw = pack_bits(w, h, rows)
+        comp = packbits(raw)
+        off = len(bitmaps)
+        if len(comp) < len(raw):
+            bitmaps += comp
+            off |= COMPRESSED
+        else:
+            bitmaps += raw
+        entries.append((cp, dwidth, off, w, h, xo, -(yo + h)))
+
+    if not entries:
+        sys.exit("no glyphs in range")
+
+    fences = [entries[i][0] for i in range(0, len(entries), BLOCK)]
+    fence_off = 20
+    index_off = fence_off + 4 * len(fences)
+    data_off = index_off + 12 * len(entries)
+
+    with open(args.out, "wb") as f:
+        f.write(b"MGP1")
+        f.write(struct.pack("<BBHIII", ascent + descent, ascent, BLOCK, len(entries), fence_off, index_off))
+        f.write(struct.pack("<%dI" % len(fences), *fences))
+        for cp, xa, off, w, h, xo, yo in entries:
+            off = (off & COMPRESSED) | ((off & ~COMPRESSED) + data_off)
+            f.write(struct.pack("<IIBBbb", cp | (xa << 24), off, w, h, xo, yo))
+        f.write(bitmaps)
+
+    print("%s: %d glyphs, %dpx, %d bytes" % (args.out, len(entries), ascent + descent, data_off + len(bitmaps)))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,10 @@
+// host shim: just what the bridge code uses
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+unsigned long millis();
+unsigned long micros();
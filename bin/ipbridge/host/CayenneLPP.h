@@ -0,0 +1,3 @@
+// host shim: only referenced (SensorManager.h), never used by the bridge
+#pragma once
+class CayenneLPP;
@@ -0,0 +1,16 @@
+// host shim: BridgeBase::getLogDateTime()
+#pragma once
+#include <stdint.h>
+#include <time.h>
+
+class DateTime {
+  struct tm _tm;
+public:
+  DateTime(uint32_t t) { time_t tt = t; gmtime_r(&tt, &_tm); }
+  int year() const { return _tm.tm_year + 1900; }
+  int month() const { return _tm.tm_mon + 1; }
+  int day() const { return _tm.tm_mday; }
+  int hour() const { return _tm.tm_hour; }
+  int minute() const { return _tm.tm_min; }
+  int second() const { return _tm.tm_sec; }
+};
@@ -0,0 +1,9 @@
+// host shim: Stream and the filesystem are only referenced by the headers the bridge pulls in
+#pragma once
+class Stream;
+
+class HostFS {
+public:
+  bool mkdir(const char* path) { return false; }
+};
+#define FILESYSTEM  HostFS
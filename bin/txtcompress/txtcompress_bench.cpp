@@ -0,0 +1,86 @@
+// Host benchmark for TxtCompressor (src/helpers/TxtCompressor.cpp)
+//
+// Round-trips each message, and reports the compression ratio and the TXT_MSG
+// packet bytes before/after cipher-block rounding. Uses the built-in sample of
+// typical mesh chat, or a file with one message per line.
+//
+//   g++ -O2 -I src bin/txtcompress/txtcompress_bench.cpp src/helpers/TxtCompressor.cpp -o txtcompress_bench
+//   ./txtcompress_bench [messages.txt]
+
+#include "helpers/TxtCompressor.h"
+#include <stdio.h>
+#include <string.h>
+
+#define CIPHER_BLOCK    16
+#define TXT_MSG_HDR      5   // timestamp + flags, encrypted with the text
+#define TXT_MSG_OVERHEAD 6   // header, dest/src hash, MAC (outside the cipher blocks)
+
+static const char* const sample[] = {
+  "Hey is anyone out there?", "Good morning all, the repeater on the hill is back up",
+  "Thanks for the test, I hear you loud and clear", "Copy that, signal is good here",
+  "What is your SNR to the new node?", "lol that's great", "I'm going to put the antenna on the roof tomorrow",
+  "Anyone know how to set the path hash mode?", "Received, thanks!",
+  "Battery is at 40% so I will be off the mesh for a while", "See you at the meetup on Saturday",
+  "The weather is bad today, rain all day", "Can you hear me from home?", "Testing from the car, 12km from the repeater",
+  "ok", "Where are you now?", "Just got back from work", "Let me know when you get this message",
+  "Nice one, thanks for the help", "I think the node needs a firmware update",
+  "It's working now, I have two hops to the city", "Good night everyone", "Please check the channel settings",
+  "How many nodes are on the mesh now?", "That would be great, I can bring a spare radio",
+};
+
+static int packetBytes(int text_len) {
+  return TXT_MSG_OVERHEAD + (TXT_MSG_HDR + text_len + CIPHER_BLOCK - 1) / CIPHER_BLOCK * CIPHER_BLOCK;
+}
+
+struct Totals {
+  int msgs, in, out, pkt_before, pkt_after;
+};
+
+static bool measure(const char* msg, Totals& t) {
+  uint8_t packed[256];
+  char unpacked[256];
+  int n = strlen(msg);
+  int m = TxtCompressor::compress(msg, n, packed, sizeof(packed));
+  if (m < 0) {
+    printf("does not fit: %s\n", msg);
+    return false;
+  }
+  int k = TxtCompressor::decompress(packed, m, unpacked, sizeof(unpacked));
+  if (k != n || memcmp(unpacked, msg, n) != 0) {
+    printf("round-trip FAILED: %s\n", msg);
+    return false;
+  }
+  t.msgs++;
+  t.in += n;
+  t.out += m;
+  t.pkt_before += packetBytes(n);
+  t.pkt_after += packetBytes(m);
+  return true;
+}
+
+int main(int argc, char* argv[]) {
+  Totals t = {};
+  if (argc > 1) {
+    FILE* f = fopen(argv[1], "r");
+    if (f == NULL) {
+      printf("can't open %s\n", argv[1]);
+      return 1;
+    }
+    char line[256];
+    while (fgets(line, sizeof(line), f)) {
+      line[strcspn(line, "\r\n")] = 0;
+      if (line[0] && !measure(line, t)) return 1;
+    }
+    fclose(f);
+  } else {
+    for (size_t i = 0; i < sizeof(sample) / sizeof(sample[0]); i++) {
+      if (!measure(sample[i], t)) return 1;
+    }
+  }
+  if (t.msgs == 0) return 1;
+
+  printf("messages: %d  text bytes in: %d  out: %d  ratio: %.2f\n", t.msgs, t.in, t.out, (double)t.out / t.in);
+  printf("TXT_MSG packet bytes before: %d  after: %d  saved: %.1f%%\n", t.pkt_before, t.pkt_after,
+         100.0 * (t.pkt_before - t.pkt_after) / t.pkt_before);
+  return 0;
+}
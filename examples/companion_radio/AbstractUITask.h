@@ -33,7 +33,7 @@ protected:
   }
 
 public:
-  void setHasConnection(bool connected) { _connected = connected; }
+  virtual void setHasConnection(bool connected) { _connected = connected; }
   bool hasConnection() const { return _connected; }
   uint16_t getBattMilliVolts() const { return _board->getBattMilliVolts(); }
   uint8_t getBatteryPercent() const { return _board->getBatteryPercent(); }
@@ -0,0 +1,89 @@
+#include "BootSequence.h"
+
+BootProfiler bootProfiler;
+BootJobs bootJobs;
+
+void BootProfiler::phase(const char* name) {
+  uint32_t now = millis();
+  end();
+  if (_num >= BOOT_MAX_PHASES) return;
+  _phases[_num].name = name;
+  _phases[_num].start_ms = now;
+  _phases[_num].ms = 0;
+  _num++;
+  _open = true;
+}
+
+void BootProfiler::end() {
+  if (!_open) return;
+  Phase& p = _phases[_num - 1];
+  p.ms = millis() - p.start_ms;
+  _open = false;
+}
+
+void BootProfiler::print(Print& out) const {
+  out.printf("Boot: radio %lums, home %lums, first rx %lums, jobs done %lums\n",
+             (unsigned long)_milestones[BOOT_RADIO_READY], (unsigned long)_milestones[BOOT_HOME_SHOWN],
+             (unsigned long)_milestones[BOOT_FIRST_RX], (unsigned long)_milestones[BOOT_JOBS_DONE]);
+  for (int i = 0; i < _num; i++) {
+    out.printf("  %-12s @%5lu %5lums\n", _phases[i].name,
+               (unsigned long)_phases[i].start_ms, (unsigned long)_phases[i].ms);
+  }
+}
+
+int BootJobs::add(const char* name, BootJobFn fn, void* ctx, uint32_t after) {
+  if (_num >= BOOT_MAX_JOBS) {
+    Serial.printf("Boot: job table full, '%s' runs now\n", name);
+    while (!fn(ctx)) { }
+    return -1;
+  }
+  Job& j = _jobs[_num];
+  j.name = name;
+  j.fn = fn;
+  j.ctx = ctx;
+  j.after = after;
+  j.busy_ms = 0;
+  j.done_ms = 0;
+  j.calls = 0;
+  return _num++;
+}
+
+bool BootJobs::isReady(int id) const {
+  if (_done & BOOT_JOB_BIT(id)) return false;
+  return (_jobs[id].after & ~_done) == 0;
+}
+
+void BootJobs::loop() {
+  if (!_started) return;
+  if (allDone()) {
+    bootProfiler.milestone(BOOT_JOBS_DONE);
+    return;
+  }
+
+  for (int n = 0; n < _num; n++) {
+    int id = (_next + n) % _num;
+    if (!isReady(id)) continue;
+
+    Job& j = _jobs[id];
+    unsigned long t0 = millis();
+    bool finished = j.fn(j.ctx);
+    j.busy_ms += millis() - t0;
+    j.calls++;
+    _next = id + 1;
+
+    if (finished) {
+      j.done_ms = millis();
+      _done |= BOOT_JOB_BIT(id);
+      Serial.printf("Boot: job '%s' done, %lums busy\n", j.name, (unsigned long)j.busy_ms);
+    }
+    return;
+  }
+}
+
+void BootJobs::print(Print& out) const {
+  for (int i = 0; i < _num; i++) {
+    const Job& j = _jobs[i];
+    out.printf("  job %-8s %5lums busy, done @%lu (%u steps)\n", j.name,
+               (unsigned long)j.busy_ms, (unsigned long)j.done_ms, j.calls);
+  }
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <Arduino.h>
+
+// ---------------------------------------------------------------------------
+// Boot profiling and deferred startup.
+//
+// BootProfiler -- setup() marks the start of each phase, and the time each
+// took is kept along with a few milestones (radio listening, home screen
+// drawn, first packet heard), for the serial summary and the boot log.
+//
+// BootJobs -- startup work the home screen doesn't need (WiFi connect, modem
+// bring-up, SD housekeeping) is registered as jobs instead of running inline
+// in setup(). They start once the home screen has been drawn and run from
+// loop(), one step per call. A job returns true when finished, or false to be
+// called again (eg. waiting for WiFi to associate), like SDWriteScheduler.
+// A job can wait for other jobs to finish first.
+// ---------------------------------------------------------------------------
+
+#ifndef BOOT_MAX_PHASES
+  #define BOOT_MAX_PHASES   24
+#endif
+#ifndef BOOT_MAX_JOBS
+  #define BOOT_MAX_JOBS      8
+#endif
+
+#define BOOT_JOB_BIT(id)   (1UL << (id))
+
+enum BootMilestone : uint8_t {
+  BOOT_RADIO_READY = 0,   // mesh loop running, packets can be received
+  BOOT_HOME_SHOWN,        // first UI pass done
+  BOOT_FIRST_RX,
+  BOOT_JOBS_DONE,         // every boot job finished (set even if there are none)
+  BOOT_NUM_MILESTONES
+};
+
+class BootProfiler {
+  struct Phase {
+    const char* name;
+    uint32_t start_ms;
+    uint32_t ms;
+  };
+  Phase _phases[BOOT_MAX_PHASES];
+  int _num = 0;
+  bool _open = false;
+  volatile uint32_t _milestones[BOOT_NUM_MILESTONES] = {};
+
+public:
+  // Ends the phase before it (name must be a literal / static)
+  void phase(const char* name);
+  // Ends the current phase, at the end of setup()
+  void end();
+  // Records the first time only; safe from the mesh task
+  void milestone(BootMilestone m) { if (_milestones[m] == 0) _milestones[m] = millis(); }
+  uint32_t getMilestone(BootMilestone m) const { return _milestones[m]; }
+
+  void print(Print& out) const;
+};
+
+typedef bool (*BootJobFn)(void* ctx);   // returns true when done
+
+class BootJobs {
+  struct Job {
+    const char* name;
+    BootJobFn fn;
+    void* ctx;
+    uint32_t after;       // BOOT_JOB_BIT()s that must finish first
+    uint32_t busy_ms;     // time spent inside fn
+    uint32_t done_ms;     // millis() when finished
+    uint16_t calls;
+  };
+  Job _jobs[BOOT_MAX_JOBS];
+  int _num = 0;
+  int _next = 0;          // round robin, so a polling job doesn't starve the rest
+  uint32_t _done = 0;
+  bool _started = false;
+
+  bool isReady(int id) const;
+
+public:
+  // Returns job id, or -1 if the table is full
+  int add(const char* name, BootJobFn fn, void* ctx, uint32_t after = 0);
+
+  // Home screen is up: jobs may run
+  void start() { _started = true; }
+  bool isStarted() const { return _started; }
+  bool allDone() const { return _done == (BOOT_JOB_BIT(_num) - 1); }
+
+  // Runs one step of the next ready job (call from main loop)
+  void loop();
+
+  void print(Print& out) const;
+};
+
+extern BootProfiler bootProfiler;
+extern BootJobs bootJobs;
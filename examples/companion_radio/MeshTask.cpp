@@ -0,0 +1,249 @@
+#include "MeshTask.h"
+
+#if MESH_TASK
+  #include <freertos/FreeRTOS.h>
+  #include <freertos/semphr.h>
+  #include <freertos/task.h>
+  #include <freertos/queue.h>
+
+  #define MESH_TASK_PRIORITY   2   // above loop() (1), so mesh gets the lock back promptly
+
+static SemaphoreHandle_t mesh_mutex = NULL;
+static void (*mesh_loop_fn)() = NULL;
+static IdleScheduler* mesh_idle = NULL;
+
+void mesh_lock() {
+  if (mesh_mutex) xSemaphoreTakeRecursive(mesh_mutex, portMAX_DELAY);
+}
+void mesh_unlock() {
+  if (mesh_mutex) xSemaphoreGiveRecursive(mesh_mutex);
+}
+
+static void meshTaskLoop(void* arg) {
+  if (mesh_idle) mesh_idle->begin();   // this task is the one that waits
+  for (;;) {
+    mesh_lock();
+    mesh_loop_fn();
+    mesh_unlock();
+    if (mesh_idle) {
+      mesh_idle->wait(MESH_TASK_MAX_IDLE_MS);   // until next deadline or radio interrupt, at least a tick (lets UI task in)
+    } else {
+      vTaskDelay(1);   // let UI task in
+    }
+  }
+}
+
+void mesh_task_begin(void (*loop_fn)(), IdleScheduler* idle) {
+  mesh_loop_fn = loop_fn;
+  mesh_idle = idle;
+  xTaskCreatePinnedToCore(meshTaskLoop, "mesh", MESH_TASK_STACK_SIZE, NULL, MESH_TASK_PRIORITY, NULL, MESH_TASK_CORE);
+}
+
+// NOTE: created statically (not in mesh_task_begin()), as the UI task takes the lock before setup() completes
+static struct MeshMutexInit {
+  MeshMutexInit() { mesh_mutex = xSemaphoreCreateRecursiveMutex(); }
+} mesh_mutex_init;
+
+#else
+void mesh_lock() { }
+void mesh_unlock() { }
+void mesh_task_begin(void (*loop_fn)(), IdleScheduler* idle) { }   // caller keeps calling the_mesh.loop() from loop()
+#endif
+
+QueuedUITask::QueuedUITask(AbstractUITask* target, mesh::MainBoard* board, BaseSerialInterface* serial)
+    : AbstractUITask(board, serial), _target(target) {
+  _queue = NULL;
+  _dropped = 0;
+}
+
+void QueuedUITask::begin() {
+#if MESH_TASK
+  if (_queue == NULL) _queue = xQueueCreate(UI_EVENT_QUEUE_SIZE, sizeof(UIEvent));
+#endif
+}
+
+static void deliver(AbstractUITask* ui, const UIEvent& ev) {
+  switch (ev.kind) {
+    case UIEventKind::msgRead:
+      ui->msgRead(ev.num);
+      break;
+    case UIEventKind::newMsg:
+      ui->newMsg(ev.arg0, ev.name, ev.text, ev.num, ev.has_path ? ev.path : nullptr, ev.snr, ev.arg1);
+      break;
+    case UIEventKind::notify:
+      ui->notify((UIEventType) ev.arg0);
+      break;
+    case UIEventKind::alert:
+      ui->showAlert(ev.text, ev.num);
+      break;
+    case UIEventKind::refresh:
+      ui->forceRefresh();
+      break;
+    case UIEventKind::sentChannelMessage:
+      ui->addSentChannelMessage(ev.arg0, ev.name, ev.text);
+      break;
+    case UIEventKind::markChannelRead:
+      ui->markChannelReadFromBLE(ev.arg0);
+      break;
+    case UIEventKind::markAllChannelsRead:
+      ui->markAllChannelsRead();
+      break;
+    case UIEventKind::adminLogin:
+      ui->onAdminLoginResult(ev.arg0 != 0, ev.arg1, ev.num);
+      break;
+    case UIEventKind::adminCliResponse:
+      ui->onAdminCliResponse(ev.name, ev.text);
+      break;
+    case UIEventKind::adminTelemetry:
+      ui->onAdminTelemetryResult(ev.data, ev.len);
+      break;
+    case UIEventKind::traceResult:
+      ui->onTraceResult(ev.num, ev.arg0, ev.trace.snrs, ev.trace.hashes, ev.len, ev.snr);
+      break;
+    case UIEventKind::connection:
+      ui->setHasConnection(ev.arg0 != 0);
+      break;
+  }
+}
+
+void QueuedUITask::post(const UIEvent& ev) {
+#if MESH_TASK
+  if (_queue) {
+    if (xQueueSend((QueueHandle_t)_queue, &ev, 0) != pdTRUE) _dropped++;   // never block the mesh task
+    return;
+  }
+#endif
+  deliver(_target, ev);
+}
+
+void QueuedUITask::dispatch() {
+#if MESH_TASK
+  if (_queue == NULL) return;
+
+  static UIEvent ev;   // (too big for the stack)
+  while (xQueueReceive((QueueHandle_t)_queue, &ev, 0) == pdTRUE) {
+    deliver(_target, ev);
+  }
+#endif
+}
+
+static void copyText(char* dest, const char* src, size_t sz) {
+  strncpy(dest, src ? src : "", sz - 1);
+  dest[sz - 1] = 0;
+}
+
+void QueuedUITask::setHasConnection(bool connected) {
+  if (connected == _connected) return;   // MyMesh calls this every loop, only post changes
+  AbstractUITask::setHasConnection(connected);
+  UIEvent ev;
+  ev.kind = UIEventKind::connection;
+  ev.arg0 = connected;
+  post(ev);
+}
+
+void QueuedUITask::msgRead(int msgcount) {
+  UIEvent ev;
+  ev.kind = UIEventKind::msgRead;
+  ev.num = msgcount;
+  post(ev);
+}
+
+void QueuedUITask::newMsg(uint8_t path_len, const char* from_name, const char* text, int msgcount,
+                          const uint8_t* path, int8_t snr, uint8_t scope_idx) {
+  UIEvent ev;
+  ev.kind = UIEventKind::newMsg;
+  ev.arg0 = path_len;
+  ev.arg1 = scope_idx;
+  ev.num = msgcount;
+  ev.snr = snr;
+  ev.has_path = path != nullptr;
+  if (path) {
+    uint16_t bl = mesh::Packet::getPathByteLenFor(path_len);
+    memcpy(ev.path, path, bl > MAX_PATH_SIZE ? MAX_PATH_SIZE : bl);
+  }
+  copyText(ev.name, from_name, sizeof(ev.name));
+  copyText(ev.text, text, sizeof(ev.text));
+  post(ev);
+}
+
+void QueuedUITask::notify(UIEventType t) {
+  UIEvent ev;
+  ev.kind = UIEventKind::notify;
+  ev.arg0 = (uint8_t) t;
+  post(ev);
+}
+
+void QueuedUITask::showAlert(const char* text, int duration_millis) {
+  UIEvent ev;
+  ev.kind = UIEventKind::alert;
+  ev.num = duration_millis;
+  copyText(ev.text, text, sizeof(ev.text));
+  post(ev);
+}
+
+void QueuedUITask::forceRefresh() {
+  UIEvent ev;
+  ev.kind = UIEventKind::refresh;
+  post(ev);
+}
+
+void QueuedUITask::addSentChannelMessage(uint8_t channel_idx, const char* sender, const char* text) {
+  UIEvent ev;
+  ev.kind = UIEventKind::sentChannelMessage;
+  ev.arg0 = channel_idx;
+  copyText(ev.name, sender, sizeof(ev.name));
+  copyText(ev.text, text, sizeof(ev.text));
+  post(ev);
+}
+
+void QueuedUITask::markChannelReadFromBLE(uint8_t channel_idx) {
+  UIEvent ev;
+  ev.kind = UIEventKind::markChannelRead;
+  ev.arg0 = channel_idx;
+  post(ev);
+}
+
+void QueuedUITask::markAllChannelsRead() {
+  UIEvent ev;
+  ev.kind = UIEventKind::markAllChannelsRead;
+  post(ev);
+}
+
+void QueuedUITask::onAdminLoginResult(bool success, uint8_t permissions, uint32_t server_time) {
+  UIEvent ev;
+  ev.kind = UIEventKind::adminLogin;
+  ev.arg0 = success;
+  ev.arg1 = permissions;
+  ev.num = server_time;
+  post(ev);
+}
+
+void QueuedUITask::onAdminCliResponse(const char* from_name, const char* text) {
+  UIEvent ev;
+  ev.kind = UIEventKind::adminCliResponse;
+  copyText(ev.name, from_name, sizeof(ev.name));
+  copyText(ev.text, text, sizeof(ev.text));
+  post(ev);
+}
+
+void QueuedUITask::onAdminTelemetryResult(const uint8_t* data, uint8_t len) {
+  UIEvent ev;
+  ev.kind = UIEventKind::adminTelemetry;
+  ev.len = len > sizeof(ev.data) ? sizeof(ev.data) : len;
+  memcpy(ev.data, data, ev.len);
+  post(ev);
+}
+
+void QueuedUITask::onTraceResult(uint32_t tag, uint8_t flags, const uint8_t* path_snrs,
+                                 const uint8_t* path_hashes, uint8_t path_len, int8_t final_snr) {
+  UIEvent ev;
+  ev.kind = UIEventKind::traceResult;
+  ev.num = tag;
+  ev.arg0 = flags;
+  ev.snr = final_snr;
+  ev.len = path_len > MAX_PATH_SIZE ? MAX_PATH_SIZE : path_len;
+  memcpy(ev.trace.hashes, path_hashes, ev.len);
+  uint8_t num_hops = ev.len >> (flags & 0x03);
+  memcpy(ev.trace.snrs, path_snrs, num_hops);
+  post(ev);
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <Arduino.h>
+#include <MeshCore.h>
+#include <helpers/IdleScheduler.h>
+#include "AbstractUITask.h"
+
+// ---------------------------------------------------------------------------
+// Mesh task -- runs the mesh stack (Dispatcher, MyMesh, serial interface) on
+// its own FreeRTOS task, pinned to the protocol core, so radio handling isn't
+// held up by UI work (eg. e-ink refreshes that block for 500ms+).
+//
+// The UI (loop() task) still calls into the_mesh directly, each call holding
+// the mesh lock just for that call, eg. locked(the_mesh)->sendGroupMessage(..).
+// Where several calls must see the same state (iterating contacts, pointers into
+// the contact table) the sequence is held in a MeshLock scope. Rendering, SD
+// and other slow UI work is done without the lock.
+// Mesh -> UI callbacks are posted as UIEvents to a queue by QueuedUITask, and
+// dispatched on the UI task, so UI state is only touched from the UI task.
+// ---------------------------------------------------------------------------
+
+#ifndef MESH_TASK
+  #if defined(ESP32)
+    #define MESH_TASK  1
+  #else
+    #define MESH_TASK  0
+  #endif
+#endif
+
+#ifndef MESH_TASK_CORE
+  #define MESH_TASK_CORE        0      // Arduino loop() runs on core 1
+#endif
+#ifndef MESH_TASK_STACK_SIZE
+  #define MESH_TASK_STACK_SIZE  12288
+#endif
+#ifndef MESH_TASK_MAX_IDLE_MS
+  #define MESH_TASK_MAX_IDLE_MS 10     // longest wait between passes (serial/BLE frames, acks are polled)
+#endif
+#ifndef UI_EVENT_QUEUE_SIZE
+  #define UI_EVENT_QUEUE_SIZE   12
+#endif
+
+void mesh_lock();
+void mesh_unlock();
+
+// starts mesh task, which calls loop_fn() (with mesh lock held) repeatedly. Between passes it
+// waits on 'idle' (deadlines registered by loop_fn, radio interrupt wakes it), or just yields
+void mesh_task_begin(void (*loop_fn)(), IdleScheduler* idle = NULL);
+
+// holds mesh lock for the current scope (can be released early)
+class MeshLock {
+  bool _held;
+public:
+  MeshLock() { mesh_lock(); _held = true; }
+  ~MeshLock() { release(); }
+  void release() { if (_held) { mesh_unlock(); _held = false; } }
+};
+
+// 'obj' with mesh lock held until the end of the full expression, eg. locked(the_mesh)->advert()
+template<class T>
+class MeshLocked {
+  T* _obj;
+public:
+  explicit MeshLocked(T* obj) : _obj(obj) { mesh_lock(); }
+  MeshLocked(MeshLocked&& other) : _obj(other._obj) { other._obj = NULL; }
+  ~MeshLocked() { if (_obj) mesh_unlock(); }
+  T* operator->() const { return _obj; }
+};
+
+template<class T>
+MeshLocked<T> locked(T& obj) { return MeshLocked<T>(&obj); }
+
+enum class UIEventKind : uint8_t {
+  msgRead,
+  newMsg,
+  notify,
+  alert,
+  refresh,
+  sentChannelMessage,
+  markChannelRead,
+  markAllChannelsRead,
+  adminLogin,
+  adminCliResponse,
+  adminTelemetry,
+  traceResult,
+  connection
+};
+
+struct UIEvent {
+  UIEventKind kind;
+  uint8_t arg0, arg1, len;   // path_len / channel_idx / flags ..., scope_idx / permissions ..., length of data
+  int8_t snr;
+  bool has_path;
+  int32_t num;              // msgcount, duration, server_time, tag ...
+  char name[32];
+  uint8_t path[MAX_PATH_SIZE];
+  union {
+    char text[MAX_PACKET_PAYLOAD + 1];
+    uint8_t data[MAX_PACKET_PAYLOAD];
+    struct {
+      uint8_t snrs[MAX_PATH_SIZE];
+      uint8_t hashes[MAX_PATH_SIZE];
+    } trace;
+  };
+};
+
+/**
+ * \brief  AbstractUITask given to MyMesh. Queues the callbacks, and dispatch() (on UI task) delivers them to the real UI.
+ */
+class QueuedUITask : public AbstractUITask {
+  AbstractUITask* _target;
+  void* _queue;     // QueueHandle_t
+  uint32_t _dropped;
+
+  void post(const UIEvent& ev);
+
+public:
+  QueuedUITask(AbstractUITask* target, mesh::MainBoard* board, BaseSerialInterface* serial);
+
+  void begin();
+  void dispatch();   // call from UI task
+  uint32_t getNumDropped() const { return _dropped; }
+
+  void setHasConnection(bool connected) override;
+  void msgRead(int msgcount) override;
+  void newMsg(uint8_t path_len, const char* from_name, const char* text, int msgcount,
+              const uint8_t* path = nullptr, int8_t snr = 0, uint8_t scope_idx = 0xFF) override;
+  void notify(UIEventType t = UIEventType::none) override;
+  void loop() override { }
+  void showAlert(const char* text, int duration_millis) override;
+  void forceRefresh() override;
+  void addSentChannelMessage(uint8_t channel_idx, const char* sender, const char* text) override;
+  void markChannelReadFromBLE(uint8_t channel_idx) override;
+  void markAllChannelsRead() override;
+  void onAdminLoginResult(bool success, uint8_t permissions, uint32_t server_time) override;
+  void onAdminCliResponse(const char* from_name, const char* text) override;
+  void onAdminTelemetryResult(const uint8_t* data, uint8_t len) override;
+  void onTraceResult(uint32_t tag, uint8_t flags, const uint8_t* path_snrs,
+                     const uint8_t* path_hashes, uint8_t path_len, int8_t final_snr) override;
+};
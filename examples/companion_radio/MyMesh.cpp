@@ -3,6 +3,8 @@
 #include <Arduino.h> // needed for PlatformIO
 #include <Mesh.h>
 #include "RadioPresets.h"        // Shared radio presets (serial CLI + settings screen)
+#include "BootSequence.h"        // first-packet boot milestone
+#include <helpers/IdleScheduler.h>   // "power" CLI command
 
 #if defined(LilyGo_T5S3_EPaper_Pro)
   #include "target.h"            // for board.setBacklight() CLI command
@@ -77,6 +79,10 @@
 #define CMD_SEND_CHANNEL_DATA         62
 #define CMD_SET_DEFAULT_FLOOD_SCOPE   63   // v1.15+ (device-wide default scope name+key)
 #define CMD_GET_DEFAULT_FLOOD_SCOPE   64   // v1.15+ (query current default scope)
+#define CMD_BLOB_START                65   // Meck: fragmented blob transfers
+#define CMD_BLOB_DATA                 66
+#define CMD_BLOB_SEND                 67
+#define CMD_BLOB_READ                 68
 
 // Stats sub-types for CMD_GET_STATS
 #define STATS_TYPE_CORE               0
@@ -112,6 +118,9 @@
 #define RESP_ALLOWED_REPEAT_FREQ      26
 #define RESP_CODE_CHANNEL_DATA_RECV   27
 #define RESP_CODE_DEFAULT_FLOOD_SCOPE 28   // v1.15+
+#define RESP_CODE_BLOB_START          29   // a reply to CMD_BLOB_START
+#define RESP_CODE_BLOB_SENT           30   // a reply to CMD_BLOB_SEND
+#define RESP_CODE_BLOB_DATA           31   // a reply to CMD_BLOB_READ
 
 #define SEND_TIMEOUT_BASE_MILLIS        500
 #define FLOOD_SEND_TIMEOUT_FACTOR       16.0f
@@ -140,6 +149,10 @@
 #define PUSH_CODE_CONTROL_DATA          0x8E   // v8+
 #define PUSH_CODE_CONTACT_DELETED       0x8F // used to notify client app of deleted contact when overwriting oldest
 #define PUSH_CODE_CONTACTS_FULL         0x90 // used to notify client app that contacts storage is full
+#define PUSH_CODE_BLOB_SEND_COMPLETE    0x91 // outbound blob transfer finished (or failed)
+#define PUSH_CODE_BLOB_WAITING          0x92 // a blob was received, app fetches it with CMD_BLOB_READ
+
+#define BLOB_READ_CHUNK                 192
 
 #define ERR_CODE_UNSUPPORTED_CMD        1
 #define ERR_CODE_NOT_FOUND              2
@@ -313,6 +326,7 @@ uint8_t MyMesh::getAutoAddMaxHops() const {
 }
 
 void MyMesh::logRxRaw(float snr, float rssi, const uint8_t raw[], int len) {
+  bootProfiler.milestone(BOOT_FIRST_RX);
   if (_serial->isConnected() && len + 3 <= MAX_FRAME_SIZE) {
     int i = 0;
     out_frame[i++] = PUSH_CODE_LOG_RX_DATA;
@@ -510,19 +524,16 @@ void MyMesh::onContactPathUpdated(const ContactInfo &contact) {
 }
 
 ContactInfo*  MyMesh::processAck(const uint8_t *data) {
-  // see if matches any in a table
-  for (int i = 0; i < EXPECTED_ACK_TABLE_SIZE; i++) {
-    if (memcmp(data, &expected_ack_table[i].ack, 4) == 0) { // got an ACK from recipient
-      out_frame[0] = PUSH_CODE_SEND_CONFIRMED;
-      memcpy(&out_frame[1], data, 4);
-      uint32_t trip_time = _ms->getMillis() - expected_ack_table[i].msg_sent;
-      memcpy(&out_frame[5], &trip_time, 4);
-      _serial->writeFrame(out_frame, 9);
+  // see if matches any we're waiting for (NOTE: the same ACK can be received multiple times!)
+  uint32_t trip_time;
+  ContactInfo* contact;
+  if (completeExpectedAck(data, trip_time, contact)) { // got an ACK from recipient
+    out_frame[0] = PUSH_CODE_SEND_CONFIRMED;
+    memcpy(&out_frame[1], data, 4);
+    memcpy(&out_frame[5], &trip_time, 4);
+    _serial->writeFrame(out_frame, 9);
 
-      // NOTE: the same ACK can be received multiple times!
-      expected_ack_table[i].ack = 0; // clear expected hash, now that we have received ACK
-      return expected_ack_table[i].contact;
-    }
+    if (contact) return contact;
   }
   return checkConnectionsAck(data);
 }
@@ -954,21 +965,14 @@ bool MyMesh::uiSendDirectMessage(uint32_t contact_idx, const char* text) {
 
   uint32_t timestamp = getRTCClock()->getCurrentTimeUnique();
   uint32_t expected_ack, est_timeout;
-  int result = sendMessage(*recipient, timestamp, 0, text, expected_ack, est_timeout);
+  // no app to drive retries, so device retries (with backoff, then flood) until ACKed
+  int result = sendMessageReliable(*recipient, timestamp, text, expected_ack, est_timeout);
 
   if (result == MSG_SEND_FAILED) {
     MESH_DEBUG_PRINTLN("UI: DM send failed to %s", recipient->name);
     return false;
   }
 
-  // Track expected ACK for delivery confirmation
-  if (expected_ack) {
-    expected_ack_table[next_ack_idx].msg_sent = _ms->getMillis();
-    expected_ack_table[next_ack_idx].ack = expected_ack;
-    expected_ack_table[next_ack_idx].contact = recipient;
-    next_ack_idx = (next_ack_idx + 1) % EXPECTED_ACK_TABLE_SIZE;
-  }
-
   MESH_DEBUG_PRINTLN("UI: DM sent to %s (%s), ack=0x%08X timeout=%dms",
                      recipient->name, result == MSG_SEND_SENT_FLOOD ? "flood" : "direct",
                      expected_ack, est_timeout);
@@ -1457,6 +1461,8 @@ void MyMesh::onTraceRecv(mesh::Packet *packet, uint32_t tag, uint32_t auth_code,
   i += path_len >> path_sz;
   out_frame[i++] = (int8_t)(packet->getSNR() * 4); // extra/final SNR (to this node)
 
+  learnRouteFromTrace(path_hashes, path_len, flags);  // round-trip trace proves a route to the far end
+
   if (_serial->isConnected()) {
     _serial->writeFrame(out_frame, i);
   } else {
@@ -1484,6 +1490,73 @@ uint32_t MyMesh::calcDirectTimeoutMillisFor(uint32_t pkt_airtime_millis, uint8_t
 
 void MyMesh::onSendTimeout() {}
 
+void MyMesh::onReliableSendFailed(const ContactInfo& contact, uint32_t timestamp, const char* text) {
+  MESH_DEBUG_PRINTLN("DM to %s not delivered, giving up after %d attempts", contact.name, ACK_TRACKER_MAX_ATTEMPTS);
+  if (_ui) {
+    char buf[64];
+    snprintf(buf, sizeof(buf), "Not delivered: %s", contact.name);
+    _ui->showAlert(buf, 3000);
+  }
+}
+
+bool MyMesh::keepBlobIn(const uint8_t* data, size_t len) {
+  if (blob_in) free(blob_in);   // only the latest is kept, app should fetch promptly
+  blob_in = (uint8_t *)malloc(len);
+  blob_in_len = blob_in ? len : 0;
+  if (blob_in == NULL) {
+    MESH_DEBUG_PRINTLN("keepBlobIn: unable to allocate %d bytes", (uint32_t)len);
+    return false;
+  }
+  memcpy(blob_in, data, len);
+  return true;
+}
+
+void MyMesh::onContactBlobRecv(const ContactInfo& from, uint8_t blob_type, const uint8_t* data, size_t len) {
+  if (!keepBlobIn(data, len)) return;
+
+  int i = 0;
+  out_frame[i++] = PUSH_CODE_BLOB_WAITING;
+  out_frame[i++] = 0;   // from a contact
+  out_frame[i++] = blob_type;
+  memcpy(&out_frame[i], from.id.pub_key, 6); i += 6;   // pub_key prefix
+  memcpy(&out_frame[i], &blob_in_len, 2); i += 2;
+  if (_serial->isConnected()) {
+    _serial->writeFrame(out_frame, i);
+  } else {
+    MESH_DEBUG_PRINTLN("onContactBlobRecv(), blob received while app offline");
+  }
+}
+
+void MyMesh::onChannelBlobRecv(const mesh::GroupChannel& channel, const uint8_t* sender_prefix, uint8_t blob_type, const uint8_t* data, size_t len) {
+  int channel_idx = findChannelIdx(channel);
+  if (channel_idx < 0 || !keepBlobIn(data, len)) return;
+
+  int i = 0;
+  out_frame[i++] = PUSH_CODE_BLOB_WAITING;
+  out_frame[i++] = 1;   // from a channel
+  out_frame[i++] = blob_type;
+  out_frame[i++] = (uint8_t)channel_idx;
+  memcpy(&out_frame[i], sender_prefix, FRAG_GRP_PREFIX_SIZE); i += FRAG_GRP_PREFIX_SIZE;
+  out_frame[i++] = 0;   // pad, so total_len is at same offset as contact blobs
+  memcpy(&out_frame[i], &blob_in_len, 2); i += 2;
+  if (_serial->isConnected()) {
+    _serial->writeFrame(out_frame, i);
+  } else {
+    MESH_DEBUG_PRINTLN("onChannelBlobRecv(), blob received while app offline");
+  }
+}
+
+void MyMesh::onBlobSendComplete(uint16_t xfer_id, bool success) {
+  MESH_DEBUG_PRINTLN("blob xfer_id=%d %s", (uint32_t)xfer_id, success ? "delivered" : "failed");
+  if (_serial->isConnected()) {
+    int i = 0;
+    out_frame[i++] = PUSH_CODE_BLOB_SEND_COMPLETE;
+    memcpy(&out_frame[i], &xfer_id, 2); i += 2;
+    out_frame[i++] = success ? 1 : 0;
+    _serial->writeFrame(out_frame, i);
+  }
+}
+
 MyMesh::MyMesh(mesh::Radio &radio, mesh::RNG &rng, mesh::RTCClock &rtc, SimpleMeshTables &tables, DataStore& store, AbstractUITask* ui)
     : BaseChatMesh(radio, *new ArduinoMillis(), rng, rtc, *new StaticPoolPacketManager(16), tables),
       _serial(NULL), telemetry(MAX_PACKET_PAYLOAD - 4), _store(&store), _ui(ui) {
@@ -1492,8 +1565,9 @@ MyMesh::MyMesh(mesh::Radio &radio, mesh::RNG &rng, mesh::RTCClock &rtc, SimpleMe
   offline_queue_len = 0;
   app_target_ver = 0;
   clearPendingReqs();
-  next_ack_idx = 0;
   sign_data = NULL;
+  blob_out = blob_in = NULL;
+  blob_out_len = blob_in_len = 0;
   dirty_contacts_expiry = 0;
   advert_paths = nullptr;  // PSRAM-allocated in begin()
   _rxlog = nullptr;        // PSRAM-allocated in begin()
@@ -1735,15 +1809,11 @@ void MyMesh::handleCmdFrame(size_t len) {
       } else {
         result = sendMessage(*recipient, msg_timestamp, attempt, text, expected_ack, est_timeout);
       }
-      // TODO: add expected ACK to table
       if (result == MSG_SEND_FAILED) {
         writeErrFrame(ERR_CODE_TABLE_FULL);
       } else {
         if (expected_ack) {
-          expected_ack_table[next_ack_idx].msg_sent = _ms->getMillis(); // add to circular table
-          expected_ack_table[next_ack_idx].ack = expected_ack;
-          expected_ack_table[next_ack_idx].contact = recipient;
-          next_ack_idx = (next_ack_idx + 1) % EXPECTED_ACK_TABLE_SIZE;
+          trackExpectedAck(*recipient, expected_ack);
         }
 
         out_frame[0] = RESP_CODE_SENT;
@@ -2356,6 +2426,79 @@ void MyMesh::handleCmdFrame(size_t len) {
     } else {
       writeErrFrame(ERR_CODE_BAD_STATE);
     }
+  } else if (cmd_frame[0] == CMD_BLOB_START) {
+    if (blob_out == NULL) {
+      blob_out = (uint8_t *)malloc(BLOB_MAX_SIZE);
+    }
+    blob_out_len = 0;
+    if (blob_out) {
+      out_frame[0] = RESP_CODE_BLOB_START;
+      out_frame[1] = 0; // reserved
+      uint32_t max_len = BLOB_MAX_SIZE;
+      memcpy(&out_frame[2], &max_len, 4);
+      _serial->writeFrame(out_frame, 6);
+    } else {
+      writeErrFrame(ERR_CODE_TABLE_FULL);
+    }
+  } else if (cmd_frame[0] == CMD_BLOB_DATA && len > 1) {
+    if (blob_out == NULL || blob_out_len + (len - 1) > BLOB_MAX_SIZE) {
+      writeErrFrame(blob_out == NULL ? ERR_CODE_BAD_STATE : ERR_CODE_TABLE_FULL); // error: too long
+    } else {
+      memcpy(&blob_out[blob_out_len], &cmd_frame[1], len - 1);
+      blob_out_len += (len - 1);
+      writeOKFrame();
+    }
+  } else if (cmd_frame[0] == CMD_BLOB_SEND && len >= 4) {
+    // [blob_type] [0] [pub_key(32)]  -- to a contact
+    // [blob_type] [1] [channel_idx]  -- to a channel
+    uint8_t blob_type = cmd_frame[1];
+    uint16_t xfer_id = 0;
+    bool found = false;
+    if (blob_out_len > 0 && cmd_frame[2] == 0 && len >= 3 + PUB_KEY_SIZE) {
+      ContactInfo *recipient = lookupContactByPubKey(&cmd_frame[3], PUB_KEY_SIZE);
+      if (recipient) {
+        found = true;
+        xfer_id = sendBlob(*recipient, blob_type, blob_out, blob_out_len);
+      }
+    } else if (blob_out_len > 0 && cmd_frame[2] == 1) {
+      ChannelDetails channel;
+      if (getChannel(cmd_frame[3], channel)) {
+        found = true;
+        xfer_id = sendChannelBlob(channel.channel, blob_type, blob_out, blob_out_len);
+      }
+    }
+    if (blob_out == NULL || blob_out_len == 0) {
+      writeErrFrame(ERR_CODE_BAD_STATE);   // nothing uploaded
+    } else if (!found) {
+      writeErrFrame(ERR_CODE_NOT_FOUND);
+    } else if (xfer_id == 0) {
+      writeErrFrame(ERR_CODE_TABLE_FULL);   // all transfer sessions busy
+    } else {
+      free(blob_out);   // transfer has its own copy
+      blob_out = NULL;
+      blob_out_len = 0;
+      out_frame[0] = RESP_CODE_BLOB_SENT;
+      memcpy(&out_frame[1], &xfer_id, 2);
+      _serial->writeFrame(out_frame, 3);
+    }
+  } else if (cmd_frame[0] == CMD_BLOB_READ && len >= 3) {
+    uint16_t offset;
+    memcpy(&offset, &cmd_frame[1], 2);
+    if (blob_in == NULL || offset >= blob_in_len) {
+      writeErrFrame(ERR_CODE_NOT_FOUND);
+    } else {
+      int n = blob_in_len - offset;
+      if (n > BLOB_READ_CHUNK) n = BLOB_READ_CHUNK;
+      out_frame[0] = RESP_CODE_BLOB_DATA;
+      memcpy(&out_frame[1], &offset, 2);
+      memcpy(&out_frame[3], &blob_in[offset], n);
+      _serial->writeFrame(out_frame, 3 + n);
+      if (offset + n >= blob_in_len) {   // app has read it all
+        free(blob_in);
+        blob_in = NULL;
+        blob_in_len = 0;
+      }
+    }
   } else if (cmd_frame[0] == CMD_SEND_TRACE_PATH && len > 10 && len - 10 < MAX_PACKET_PAYLOAD-5) {
     uint8_t path_len = len - 10;
     uint8_t flags = cmd_frame[9];
@@ -3349,6 +3492,24 @@ void MyMesh::checkCLIRescueCmd() {
           Serial.println("  Error: 0-64 (0=no limit)");
         }
 
+      } else if (memcmp(config, "contact.widehash ", 17) == 0) {
+        // set contact.widehash <name> on|off
+        char name[32];
+        StrHelper::strncpy(name, &config[17], sizeof(name));
+        char* sp = strrchr(name, ' ');
+        ContactInfo* c = NULL;
+        if (sp) {
+          *sp++ = 0;
+          c = searchContactsByPrefix(name);
+        }
+        if (c == NULL || (strcmp(sp, "on") != 0 && strcmp(sp, "off") != 0)) {
+          Serial.println("  Usage: set contact.widehash <name> on|off");
+        } else {
+          if (strcmp(sp, "on") == 0) c->flags |= CONTACT_FLAG_WIDE_HASH; else c->flags &= ~CONTACT_FLAG_WIDE_HASH;
+          dirty_contacts_expiry = futureMillis(LAZY_CONTACTS_WRITE_DELAY);
+          Serial.printf("  > widehash %s for %s\n", sp, c->name);
+        }
+
       } else {
         Serial.printf("  Error: unknown setting '%s' (try 'help')\n", config);
       }
@@ -3452,6 +3613,7 @@ void MyMesh::checkCLIRescueCmd() {
       Serial.println("    contact.autoadd          Show type toggles");
       Serial.println("    contact.autoadd <type> on|off  chat|repeater|room|sensor|overwrite");
       Serial.println("    contact.maxhops <0-64>   Max hops for auto-add (0=no limit)");
+      Serial.println("    contact.widehash <name> on|off  2-byte peer hashes (only if all repeaters on route are upgraded)");
 #ifdef HAS_4G_MODEM
       Serial.println("");
       Serial.println("  4G modem:");
@@ -3462,6 +3624,11 @@ void MyMesh::checkCLIRescueCmd() {
       Serial.println("    rebuild   Erase & rebuild filesystem");
       Serial.println("    erase     Format filesystem");
       Serial.println("    reboot    Restart device");
+      Serial.println("    power     Idle/wake histogram of the mesh task");
+      Serial.println("    acks      ACK delivery stats and latency histogram ('acks reset' to clear)");
+      Serial.println("    blobs     Fragmented blob transfer stats");
+      Serial.println("    routes    Route cache: failovers, candidates per contact");
+      Serial.println("    links     Link adaptation: SNR, fast SF switches per neighbour");
       Serial.println("    ls / cat / rm   File operations");
 #if defined(LilyGo_T5S3_EPaper_Pro)
       Serial.println("");
@@ -3628,6 +3795,58 @@ void MyMesh::checkCLIRescueCmd() {
       }
     }
 #endif
+    else if (strcmp(cli_command, "power") == 0) {
+      idleScheduler.print(Serial);
+    }
+    else if (strcmp(cli_command, "acks") == 0) {
+      const AckTracker& at = getAckTracker();
+      Serial.printf("  pending:   %d/%d\n", at.getNumActive(), ACK_TRACKER_SIZE);
+      Serial.printf("  delivered: %lu  failed: %lu  evicted: %lu\n", (unsigned long)at.getNumDelivered(),
+                    (unsigned long)at.getNumFailed(), (unsigned long)at.getNumEvicted());
+      Serial.printf("  retries:   %lu  (flood fallbacks: %lu)\n", (unsigned long)at.getNumRetries(),
+                    (unsigned long)at.getNumFloodFallbacks());
+      static const char* labels[ACK_LATENCY_BUCKETS] = { "<250ms", "<500ms", "<1s", "<2s", "<4s", "<8s", "<16s", "<32s", "longer" };
+      const uint16_t* hist = at.getLatencyHistogram();
+      for (int b = 0; b < ACK_LATENCY_BUCKETS; b++) {
+        Serial.printf("  %-7s %u\n", labels[b], hist[b]);
+      }
+    }
+    else if (strcmp(cli_command, "acks reset") == 0) {
+      resetAckStats();
+      Serial.println("  > ACK stats cleared");
+    }
+    else if (strcmp(cli_command, "blobs") == 0) {
+      const BlobTransfer& bt = getBlobTransfer();
+      Serial.printf("  blobs sent: %lu  failed: %lu  recv: %lu\n", (unsigned long)bt.getNumBlobsSent(),
+                    (unsigned long)bt.getNumBlobsFailed(), (unsigned long)bt.getNumBlobsRecv());
+      Serial.printf("  frags sent: %lu  resent: %lu  recv: %lu  dup: %lu\n", (unsigned long)bt.getNumFragsSent(),
+                    (unsigned long)bt.getNumFragsResent(), (unsigned long)bt.getNumFragsRecv(), (unsigned long)bt.getNumFragsDup());
+      Serial.printf("  frags dropped (buffers busy): %lu\n", (unsigned long)bt.getNumFragsBusy());
+      Serial.printf("  last goodput: %lu bytes/sec\n", (unsigned long)bt.getLastGoodput());
+    }
+    else if (strcmp(cli_command, "routes") == 0) {
+      const ContactRouteCache& rc = getRouteCache();
+      Serial.printf("  contacts:  %d/%d\n", rc.getNumContacts(), ROUTE_CACHE_SIZE);
+      Serial.printf("  failovers: %d\n", rc.getNumFailovers());
+      for (int i = 0; i < getNumContacts(); i++) {
+        ContactInfo c;
+        if (!getContactByIdx(i, c)) continue;
+        int n = rc.getNumCandidates(c.id.pub_key);
+        if (n > 0) Serial.printf("  %-24s %d route(s)\n", c.name, n);
+      }
+    }
+    else if (strcmp(cli_command, "links") == 0) {
+      const LinkAdapter& la = getLinkAdapter();
+      Serial.printf("  adaptation: %s  base SF: %d\n", LINK_ADAPTATION ? "on" : "off", (int)_prefs.sf);
+      for (int i = 0; i < LINK_TABLE_SIZE; i++) {
+        const LinkStats* l = la.getByIdx(i);
+        if (l->samples == 0) continue;
+        ContactInfo* c = lookupContactByPubKey(l->pub_key, sizeof(l->pub_key));
+        Serial.printf("  %-24s snr:%.1f n:%u sf:%u sw:%u fb:%u blobs:%u saved:%lums\n", c ? c->name : "?",
+                      l->snr_x4 / 4.0f, l->samples, l->last_sf, l->num_switches, l->num_fallbacks, l->blobs_ok,
+                      (unsigned long)l->airtime_saved);
+      }
+    }
     else if (strcmp(cli_command, "reboot") == 0) {
       board.reboot();  // doesn't return
     } else {
@@ -3674,6 +3893,19 @@ void MyMesh::checkSerialInterface() {
   }
 }
 
+void MyMesh::flushContacts() {
+#if !defined(NRF52_PLATFORM) && !defined(STM32_PLATFORM)
+  if (_store->isSaveInProgress()) {
+    while (_store->saveContactsChunk(20)) { }
+    _store->finishSaveContacts();
+  }
+#endif
+  if (dirty_contacts_expiry) {
+    saveContacts();
+    dirty_contacts_expiry = 0;
+  }
+}
+
 void MyMesh::loop() {
   BaseChatMesh::loop();
 
@@ -3736,6 +3968,27 @@ void MyMesh::loop() {
 #endif
 }
 
+// Timers of ours that loop() checks. The rest (acks, serial frames) are polled, and the mesh
+// task never waits longer than MESH_TASK_MAX_IDLE_MS
+uint32_t MyMesh::getIdleMillis() {
+#if !defined(NRF52_PLATFORM) && !defined(STM32_PLATFORM)
+  if (_store->isSaveInProgress()) return 0;   // a chunk per pass
+#endif
+  uint32_t idle = BaseChatMesh::getIdleMillis();
+  unsigned long now = millis();
+  if (dirty_contacts_expiry) {
+    long d = (long)(dirty_contacts_expiry - now);
+    if (d < 0) return 0;
+    if ((uint32_t)d + 1 < idle) idle = d + 1;
+  }
+  if (_discoveryActive) {
+    long d = (long)(_discoveryTimeout - now);
+    if (d < 0) return 0;
+    if ((uint32_t)d + 1 < idle) idle = d + 1;
+  }
+  return idle;
+}
+
 bool MyMesh::advert() {
   mesh::Packet* pkt;
   if (_prefs.advert_loc_policy == ADVERT_LOC_NONE) {
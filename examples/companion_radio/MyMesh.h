@@ -63,6 +63,10 @@
 #define OFFLINE_QUEUE_SIZE 16
 #endif
 
+#ifndef LINK_ADAPTATION
+#define LINK_ADAPTATION 0   // build flag: negotiate faster SF with strong zero-hop neighbours, for blob transfers
+#endif
+
 #ifndef BLE_NAME_PREFIX
 #define BLE_NAME_PREFIX "MeshCore-"
 #endif
@@ -72,9 +76,14 @@
 
 // Custom path lock flag — bit 7 of ContactInfo.flags
 // When set, onContactPathRecv skips auto-updating this contact's out_path.
-// Bits 0-6 remain available (bit 0 = favourite, bits 1-3 = telemetry perms).
+// Bits 0-5 remain available (bit 0 = favourite, bits 1-3 = telemetry perms).
 #define CONTACT_FLAG_CUSTOM_PATH  0x80
 
+// Wide hash opt-in — bit 6 of ContactInfo.flags
+// When set, try 2-byte peer hashes (PAYLOAD_VER_2) with this contact. Only for contacts
+// whose route is known to be all upgraded repeaters, falls back to 1-byte if they don't reply.
+#define CONTACT_FLAG_WIDE_HASH    0x40
+
 /* -------------------------------------------------------------------------------------- */
 
 #define REQ_TYPE_GET_STATUS             0x01 // same as _GET_STATS
@@ -151,6 +160,7 @@ public:
   void clearRxLog() { _rxlog_head = 0; _rxlog_count = 0; }
 
   void loop();
+  uint32_t getIdleMillis() override;
   void handleCmdFrame(size_t len);
   bool advert();
   void enterCLIRescue();
@@ -199,6 +209,9 @@ public:
   void setDeferSaves(bool defer) { _deferSaves = defer; }
   bool isDeferSaves() const { return _deferSaves; }
 
+  // Write pending / finish in-progress contact saves now (before power-off)
+  void flushContacts();
+
   // Notify that the user pressed a key — defers contact saves until idle.
   // Call from main.cpp keyboard handler on every keypress.
   void notifyUserInput() { _lastUserInput = millis(); }
@@ -252,6 +265,10 @@ protected:
   void onContactsFull() override;
   void onContactOverwrite(const uint8_t* pub_key) override;
   void onAdvertRecv(mesh::Packet* packet, const mesh::Identity& id, uint32_t timestamp, const uint8_t* app_data, size_t app_data_len) override;
+  bool isPathLocked(const ContactInfo& contact) const override { return (contact.flags & CONTACT_FLAG_CUSTOM_PATH) != 0; }
+  bool allowWidePeerHashes(const ContactInfo& contact) const override { return (contact.flags & CONTACT_FLAG_WIDE_HASH) != 0; }
+  uint8_t getBaseSpreadingFactor() const override { return LINK_ADAPTATION ? _prefs.sf : 0; }
+  void setRadioSpreadingFactor(uint8_t sf) override { radio_set_params(_prefs.freq, _prefs.bw, sf, _prefs.cr); }
   bool onContactPathRecv(ContactInfo& from, uint8_t* in_path, uint8_t in_path_len, uint8_t* out_path, uint8_t out_path_len, uint8_t extra_type, uint8_t* extra, uint8_t extra_len) override;
   void onDiscoveredContact(ContactInfo &contact, bool is_new, uint8_t path_len, const uint8_t* path) override;
   void onContactPathUpdated(const ContactInfo &contact) override;
@@ -279,6 +296,11 @@ protected:
   uint32_t calcFloodTimeoutMillisFor(uint32_t pkt_airtime_millis) const override;
   uint32_t calcDirectTimeoutMillisFor(uint32_t pkt_airtime_millis, uint8_t path_len) const override;
   void onSendTimeout() override;
+  void onReliableSendFailed(const ContactInfo& contact, uint32_t timestamp, const char* text) override;
+  void onContactBlobRecv(const ContactInfo& from, uint8_t blob_type, const uint8_t* data, size_t len) override;
+  void onChannelBlobRecv(const mesh::GroupChannel& channel, const uint8_t* sender_prefix, uint8_t blob_type, const uint8_t* data, size_t len) override;
+  void onBlobSendComplete(uint16_t xfer_id, bool success) override;
+  bool keepBlobIn(const uint8_t* data, size_t len);
 
   // DataStoreHost methods
   bool onContactLoaded(const ContactInfo& contact) override { return addContact(contact); }
@@ -345,6 +367,10 @@ private:
   uint8_t app_target_ver;
   uint8_t *sign_data;
   uint32_t sign_data_len;
+  uint8_t *blob_out;          // being uploaded by app (CMD_BLOB_DATA), until CMD_BLOB_SEND
+  uint16_t blob_out_len;
+  uint8_t *blob_in;           // last received blob, until app has read it (CMD_BLOB_READ)
+  uint16_t blob_in_len;
   unsigned long dirty_contacts_expiry;
 
   TransportKey send_scope;
@@ -374,15 +400,6 @@ private:
   int offline_queue_len;
   Frame offline_queue[OFFLINE_QUEUE_SIZE];
 
-  struct AckTableEntry {
-    unsigned long msg_sent;
-    uint32_t ack;
-    ContactInfo* contact;
-  };
-  #define EXPECTED_ACK_TABLE_SIZE 8
-  AckTableEntry expected_ack_table[EXPECTED_ACK_TABLE_SIZE]; // circular table
-  int next_ack_idx;
-
   #ifndef ADVERT_PATH_TABLE_SIZE
     #define ADVERT_PATH_TABLE_SIZE   1000
   #endif
@@ -10,6 +10,8 @@
 #endif
 #include <Mesh.h>
 #include "MyMesh.h"
+#include "MeshTask.h"
+#include "BootSequence.h"
 #include "variant.h"   // Board-specific defines (HAS_GPS, etc.)
 #include "target.h"    // For sensors, board, etc.
 #include "CPUPowerManager.h"
@@ -254,7 +256,7 @@
     }
 
     // Ensure in-memory contacts are flushed to SPIFFS first
-    the_mesh.saveContacts();
+    locked(the_mesh)->saveContacts();
 
     if (!SD.exists("/meshcore")) SD.mkdir("/meshcore");
 
@@ -280,14 +282,14 @@
       return -1;
     }
 
-    txt.printf("Meck Contacts Export  (%d total)\n", (int)the_mesh.getNumContacts());
+    txt.printf("Meck Contacts Export  (%d total)\n", (int)locked(the_mesh)->getNumContacts());
     txt.printf("========================================\n");
     txt.printf("%-5s  %-30s  %s\n", "Type", "Name", "PubKey (prefix)");
     txt.printf("----------------------------------------\n");
 
     ContactInfo c;
-    for (uint32_t i = 0; i < (uint32_t)the_mesh.getNumContacts(); i++) {
-      if (the_mesh.getContactByIdx(i, c)) {
+    for (uint32_t i = 0; i < (uint32_t)locked(the_mesh)->getNumContacts(); i++) {
+      if (locked(the_mesh)->getContactByIdx(i, c)) {
         const char* typeStr = "???";
         switch (c.type) {
           case ADV_TYPE_CHAT:     typeStr = "Chat"; break;
@@ -358,6 +360,8 @@
       c.id = mesh::Identity(pub_key);
       c.shared_secret_valid = false;
 
+      MeshLock lock;   // lookup + add as one step
+
       // Check if this contact already exists in the live table
       if (the_mesh.lookupContactByPubKey(pub_key, PUB_KEY_SIZE) != NULL) {
         skipped++;
@@ -379,11 +383,11 @@
 
     // Persist the merged set to SPIFFS
     if (added > 0) {
-      the_mesh.saveContacts();
+      locked(the_mesh)->saveContacts();
     }
 
     Serial.printf("Contacts import: %d added, %d already present, %d total\n",
-                  added, skipped, (int)the_mesh.getNumContacts());
+                  added, skipped, (int)locked(the_mesh)->getNumContacts());
     return added;
   }
 
@@ -404,7 +408,7 @@
     // Build timestamped filename: meshcore_contacts_YYYYMMDD_HHMM.json
     char jsonPath[64];
     uint32_t epoch = rtc_clock.getCurrentTime();
-    int8_t utcOff = the_mesh.getNodePrefs()->utc_offset_hours;
+    int8_t utcOff = locked(the_mesh)->getNodePrefs()->utc_offset_hours;
     time_t localEpoch = (time_t)epoch + (utcOff * 3600);
     struct tm tmBuf;
     gmtime_r(&localEpoch, &tmBuf);
@@ -423,7 +427,7 @@
     f.print("{\n  \"contacts\": [\n");
 
     int written = 0;
-    uint32_t total = the_mesh.getNumContacts();
+    uint32_t total = locked(the_mesh)->getNumContacts();
 
     // When indices is NULL, export all contacts (scan = rawIdx).
     // When indices is provided, scan iterates over the indices array.
@@ -433,7 +437,7 @@
       int rawIdx = (indices != NULL) ? indices[scan] : scan;
 
       ContactInfo c;
-      if (!the_mesh.getContactByIdx(rawIdx, c)) continue;
+      if (!locked(the_mesh)->getContactByIdx(rawIdx, c)) continue;
 
       if (written > 0) f.print(",\n");
 
@@ -569,6 +573,7 @@
         // End of contact object — try to import
         if (gotPubkey && gotType) {
           c.id = mesh::Identity(pubkey);
+          MeshLock lock;   // lookup + add as one step
           if (the_mesh.lookupContactByPubKey(pubkey, PUB_KEY_SIZE) != NULL) {
             skipped++;
           } else if (the_mesh.addContact(c)) {
@@ -655,11 +660,11 @@
     digitalWrite(SDCARD_CS, HIGH);
 
     if (added > 0) {
-      the_mesh.saveContacts();
+      locked(the_mesh)->saveContacts();
     }
 
     Serial.printf("JSON Import: %d added, %d skipped, %d total\n",
-                  added, skipped, (int)the_mesh.getNumContacts());
+                  added, skipped, (int)locked(the_mesh)->getNumContacts());
     return added;
   }
 
@@ -668,6 +673,7 @@
   // -----------------------------------------------------------------------
   int deleteSelectedContacts(const uint16_t* indices, int count) {
     // Delete in reverse order so indices remain valid
+    MeshLock lock;   // indices are only valid while the table doesn't change
     int deleted = 0;
     for (int i = count - 1; i >= 0; i--) {
       ContactInfo c;
@@ -680,11 +686,13 @@
     if (deleted > 0) {
       the_mesh.saveContacts();
     }
+    lock.release();
     Serial.printf("Deleted %d/%d selected contacts\n", deleted, count);
     return deleted;
   }
 
   int toggleFavouriteSelected(const uint16_t* indices, int count) {
+    MeshLock lock;   // cp points into the contacts table
     int toggled = 0;
     for (int i = 0; i < count; i++) {
       ContactInfo tmp;
@@ -699,6 +707,7 @@
     if (toggled > 0) {
       the_mesh.saveContacts();
     }
+    lock.release();
     Serial.printf("Toggled favourite on %d contacts\n", toggled);
     return toggled;
   }
@@ -1085,6 +1094,7 @@ static uint32_t _atoi(const char* sp) {
     #include "MapScreen.h"  // After BLE -- PNGdec headers conflict with BLE if included earlier
   #endif
   UITask ui_task(&board, &serial_interface);
+  QueuedUITask ui_events(&ui_task, &board, &serial_interface);   // mesh -> UI callbacks, delivered on UI task
   #ifdef MECK_AUDIO_VARIANT
   // Lets the alarm ringing screen (which only forward-declares UITask) query
   // the lock state without pulling in the full UITask header.
@@ -1096,7 +1106,7 @@ StdRNG fast_rng;
 SimpleMeshTables tables;
 MyMesh the_mesh(radio_driver, fast_rng, rtc_clock, tables, store
    #ifdef DISPLAY_CLASS
-      , &ui_task
+      , &ui_events
    #endif
 );
 
@@ -1183,6 +1193,7 @@ static void lastHeardToggleContact() {
   const AdvertPath* entry = lh->getSelectedEntry();
   if (!entry) return;
 
+  MeshLock lock;   // existing points into the contacts table
   ContactInfo* existing = the_mesh.lookupContactByPubKey(entry->pubkey_prefix, 8);
   if (existing) {
     // Double-confirm for favourites (bit 0 of flags)
@@ -1246,7 +1257,7 @@ static void lastHeardToggleContact() {
         if (board.isBacklightOn()) {
           board.backlightOff();
         } else {
-          uint8_t _blPct = the_mesh.getNodePrefs()->backlight_brightness_pct;
+          uint8_t _blPct = locked(the_mesh)->getNodePrefs()->backlight_brightness_pct;
           board.backlightSetBrightness((uint8_t)((_blPct * 255 + 50) / 100));
         }
         break;
@@ -1738,10 +1749,10 @@ static void lastHeardToggleContact() {
 #if defined(LilyGo_T5S3_EPaper_Pro)
         const char* dmName = chScr->getDMFilterName();
         if (dmName && dmName[0]) {
-          uint32_t numC = the_mesh.getNumContacts();
+          uint32_t numC = locked(the_mesh)->getNumContacts();
           ContactInfo ci;
           for (uint32_t j = 0; j < numC; j++) {
-            if (the_mesh.getContactByIdx(j, ci) && strcmp(ci.name, dmName) == 0) {
+            if (locked(the_mesh)->getContactByIdx(j, ci) && strcmp(ci.name, dmName) == 0) {
               char label[40];
               snprintf(label, sizeof(label), "DM: %s", dmName);
               ui_task.showVirtualKeyboard(VKB_DM, label, "", 137, j);
@@ -1758,7 +1769,7 @@ static void lastHeardToggleContact() {
       }
 #if defined(LilyGo_T5S3_EPaper_Pro)
       ChannelDetails ch;
-      if (the_mesh.getChannel(chIdx, ch)) {
+      if (locked(the_mesh)->getChannel(chIdx, ch)) {
         char label[40];
         snprintf(label, sizeof(label), "To: %s", ch.name);
         ui_task.showVirtualKeyboard(VKB_CHANNEL_MSG, label, "", 137, chIdx);
@@ -1906,14 +1917,127 @@ void halt() {
   while (1) ;
 }
 
+static void meshTaskLoop();
+
+// ---------------------------------------------------------------------------
+// Boot jobs -- startup work that runs from loop() once the home screen is up
+// (see BootSequence.h)
+// ---------------------------------------------------------------------------
+#if defined(ESP32) && !defined(WIFI_SSID) && defined(MECK_WIFI_COMPANION)
+static unsigned long bootWifiDeadline = 0;
+
+// Reads /web/wifi.cfg and starts the connect, then polls until associated
+static bool bootWifiJob(void*) {
+  if (bootWifiDeadline == 0) {
+    File f = SD.open("/web/wifi.cfg", FILE_READ);
+    if (!f) {
+      digitalWrite(SDCARD_CS, HIGH);
+      Serial.println("WiFi companion: no /web/wifi.cfg found (configure in Settings)");
+      return true;
+    }
+    String ssid = f.readStringUntil('\n'); ssid.trim();
+    String pass = f.readStringUntil('\n'); pass.trim();
+    f.close();
+    digitalWrite(SDCARD_CS, HIGH);
+    if (ssid.length() == 0) return true;
+
+    MESH_DEBUG_PRINTLN("boot - WiFi: connecting to '%s'", ssid.c_str());
+    WiFi.begin(ssid.c_str(), pass.c_str());
+    bootWifiDeadline = millis() + 10000;
+    return false;
+  }
+  if (WiFi.status() == WL_CONNECTED) {
+    Serial.printf("WiFi companion: connected, IP: %s\n", WiFi.localIP().toString().c_str());
+    return true;
+  }
+  if (millis() > bootWifiDeadline) {
+    Serial.println("WiFi companion: auto-connect failed (configure in Settings)");
+    return true;
+  }
+  return false;
+}
+#endif
+
+#ifdef MECK_AUDIO_VARIANT
+static bool bootSoundsJob(void*) {
+  copyBundledSoundsToSD();
+  return true;
+}
+#endif
+
+#if defined(LilyGo_TDeck_Pro) && defined(HAS_SDCARD)
+static bool bootBackupJob(void*) {
+  backupSettingsToSD();
+  return true;
+}
+
+#ifdef HAS_4G_MODEM
+static bool bootModemJob(void*) {
+  smsStore.begin();
+  smsContacts.begin();
+
+  // Tell SMS screen that SD is ready
+  SMSScreen* smsScr = (SMSScreen*)ui_task.getSMSScreen();
+  if (smsScr) {
+    smsScr->setSDReady(true);
+  }
+
+  // Start modem if enabled in config (default = enabled)
+  bool modemEnabled = ModemManager::loadEnabledConfig();
+  if (modemEnabled) {
+    modemManager.begin();
+    MESH_DEBUG_PRINTLN("boot - 4G modem manager started");
+  } else {
+    // Ensure modem power is off (kills red LED too)
+#if defined(LilyGo_TDeck_Pro_Max)
+    board.modemPowerOff();             // XL9555 6609_EN LOW
+#else
+    pinMode(MODEM_POWER_EN, OUTPUT);
+    digitalWrite(MODEM_POWER_EN, LOW);
+#endif
+    MESH_DEBUG_PRINTLN("boot - 4G modem disabled by config");
+  }
+  return true;
+}
+#endif
+#endif
+
+// Appends this boot's phase and job timings to /meshcore/boot.log
+#define BOOT_LOG_PATH  "/meshcore/boot.log"
+#define BOOT_LOG_MAX   16384
+
+static void writeBootLog() {
+#ifdef HAS_SDCARD
+  if (!sdCardReady) return;
+  if (!SD.exists("/meshcore")) SD.mkdir("/meshcore");
+
+  File f = SD.open(BOOT_LOG_PATH, FILE_READ);
+  if (f) {
+    size_t size = f.size();
+    f.close();
+    if (size > BOOT_LOG_MAX) SD.remove(BOOT_LOG_PATH);   // start over rather than grow forever
+  }
+  f = SD.open(BOOT_LOG_PATH, FILE_APPEND);
+  if (f) {
+    f.printf("--- %s, reset reason %d\n", FIRMWARE_VERSION, (int)esp_reset_reason());
+    bootProfiler.print(f);
+    bootJobs.print(f);
+    f.close();
+  }
+  digitalWrite(SDCARD_CS, HIGH);
+#endif
+}
+
 void setup() {
   Serial.begin(115200);
   delay(100);  // Give serial time to initialize
   MESH_DEBUG_PRINTLN("=== setup() - STARTING ===");
 
+  bootProfiler.phase("board");
   board.begin();
   MESH_DEBUG_PRINTLN("setup() - board.begin() done");
 
+  bootProfiler.phase("touch");
   // Initialize touch input (CST328) HERE, immediately after board.begin(),
   // while the I2C bus is freshly initialised and quiet -- mirroring LilyGo's
   // working example, which calls touch.begin() first thing. Running it later
@@ -1944,6 +2068,7 @@ void setup() {
 
 #ifdef DISPLAY_CLASS
   DisplayDriver* disp = NULL;
+  bootProfiler.phase("display");
   MESH_DEBUG_PRINTLN("setup() - about to call display.begin()");
   
   // =========================================================================
@@ -1986,12 +2111,14 @@ void setup() {
   }
 #endif
 
+  bootProfiler.phase("radio");
   MESH_DEBUG_PRINTLN("setup() - about to call radio_init()");
   if (!radio_init()) { 
     MESH_DEBUG_PRINTLN("setup() - radio_init() FAILED! Halting.");
     halt(); 
   }
   MESH_DEBUG_PRINTLN("setup() - radio_init() done");
+  radio_driver.setWakeHook(IdleScheduler::radioWake, &idleScheduler);   // packet wakes the idle mesh task
 
   // CPU frequency scaling -- drop to 80 MHz for idle mesh listening
   cpuPower.begin();
@@ -2075,6 +2202,7 @@ void setup() {
   MESH_DEBUG_PRINTLN("setup() - the_mesh.startInterface() done");
 
 #elif defined(ESP32)
+  bootProfiler.phase("spiffs");
   MESH_DEBUG_PRINTLN("setup() - ESP32 filesystem init - calling SPIFFS.begin()");
   if (!SPIFFS.begin(false)) {
     // First boot or corrupted partition -- format required (can take 1-2 minutes)
@@ -2116,6 +2244,7 @@ void setup() {
   }
   MESH_DEBUG_PRINTLN("setup() - SPIFFS.begin() done");
 
+  bootProfiler.phase("sd");
   // ---------------------------------------------------------------------------
   // Early SD card init -- needed BEFORE the_mesh.begin() so we can restore
   // settings from a previous firmware flash.  The display SPI bus is already
@@ -2204,11 +2333,20 @@ void setup() {
   }
   #endif
 
+  bootProfiler.phase("sd-assets");
+  // Unicode glyph packs (Cyrillic, Greek, CJK ...) for text the built-in fonts can't draw
+  #if (defined(LilyGo_TDeck_Pro) || defined(LilyGo_T5S3_EPaper_Pro)) && defined(HAS_SDCARD)
+  if (sdCardReady && disp) {
+    disp->loadGlyphPacks("/fonts");
+  }
+  #endif
+
   // Copy bundled notification sounds to SD card (audio variant only).
   // Skips files that already exist so user customisations are preserved.
+  // Nothing reads them until a notification plays, so it runs after boot.
   #ifdef MECK_AUDIO_VARIANT
   if (sdCardReady) {
-    copyBundledSoundsToSD();
+    bootJobs.add("sounds", bootSoundsJob, NULL);
   }
   #endif
 
@@ -2219,6 +2357,7 @@ void setup() {
   }
   #endif
 
+  bootProfiler.phase("mesh");
   MESH_DEBUG_PRINTLN("setup() - about to call store.begin()");
   store.begin();
   MESH_DEBUG_PRINTLN("setup() - store.begin() done");
@@ -2240,6 +2379,7 @@ void setup() {
 #endif
 
   // Boot-time config import: check for /meshcore/import.json on SD
+  bootProfiler.phase("import");
   #ifdef HAS_SDCARD
   if (sdCardReady) {
     int importResult = meckImportConfig(the_mesh,
@@ -2253,6 +2393,7 @@ void setup() {
   }
   #endif
 
+  bootProfiler.phase("interface");
 #ifdef WIFI_SSID
   MESH_DEBUG_PRINTLN("setup() - WiFi mode (compile-time credentials)");
   WiFi.begin(WIFI_SSID, WIFI_PWD);
@@ -2261,34 +2402,11 @@ void setup() {
   {
     // WiFi companion: load credentials from SD at runtime.
     // TCP server starts regardless — companion connects when WiFi comes up.
+    // The connect itself is a boot job, so setup() doesn't wait on it.
     MESH_DEBUG_PRINTLN("setup() - WiFi companion mode (runtime credentials)");
     WiFi.mode(WIFI_STA);
     if (sdCardReady) {
-      File f = SD.open("/web/wifi.cfg", FILE_READ);
-      if (f) {
-        String ssid = f.readStringUntil('\n'); ssid.trim();
-        String pass = f.readStringUntil('\n'); pass.trim();
-        f.close();
-        digitalWrite(SDCARD_CS, HIGH);
-        if (ssid.length() > 0) {
-          MESH_DEBUG_PRINTLN("setup() - WiFi: connecting to '%s'", ssid.c_str());
-          WiFi.begin(ssid.c_str(), pass.c_str());
-          unsigned long timeout = millis() + 3000;  // 3s max — non-critical, Settings can retry
-          while (WiFi.status() != WL_CONNECTED && millis() < timeout) {
-            yield();  // Feed WDT during wait
-            delay(50);
-          }
-          if (WiFi.status() == WL_CONNECTED) {
-            Serial.printf("WiFi companion: connected to %s, IP: %s\n",
-                          ssid.c_str(), WiFi.localIP().toString().c_str());
-          } else {
-            Serial.println("WiFi companion: auto-connect failed (configure in Settings)");
-          }
-        }
-      } else {
-        digitalWrite(SDCARD_CS, HIGH);
-        Serial.println("WiFi companion: no /web/wifi.cfg found (configure in Settings)");
-      }
+      bootJobs.add("wifi", bootWifiJob, NULL);
     }
     serial_interface.begin(TCP_PORT);
     MESH_DEBUG_PRINTLN("setup() - WiFi TCP server started on port %d", TCP_PORT);
@@ -2312,6 +2430,7 @@ void setup() {
   #error "need to define filesystem"
 #endif
 
+  bootProfiler.phase("sensors");
   MESH_DEBUG_PRINTLN("setup() - about to call sensors.begin()");
   sensors.begin();
   MESH_DEBUG_PRINTLN("setup() - sensors.begin() done");
@@ -2326,6 +2445,9 @@ void setup() {
       uint32_t gps_baud = the_mesh.getNodePrefs()->gps_baudrate;
       Serial.printf("GPS: prefs gps_baudrate=%lu (0=use default)\n", (unsigned long)gps_baud);
       if (gps_baud == 0) gps_baud = GPS_BAUDRATE;
+      #ifdef GNSS_UART_RX_BUF
+        Serial2.setRxBufferSize(GNSS_UART_RX_BUF);   // must precede begin()
+      #endif
       Serial2.begin(gps_baud, SERIAL_8N1, GPS_RX_PIN, GPS_TX_PIN);
       Serial.printf("GPS: Serial2 started at %lu baud (RX=%d TX=%d)\n",
                      (unsigned long)gps_baud, GPS_RX_PIN, GPS_TX_PIN);
@@ -2333,6 +2455,7 @@ void setup() {
   #endif
 
 #ifdef DISPLAY_CLASS
+  bootProfiler.phase("ui");
   MESH_DEBUG_PRINTLN("setup() - about to call ui_task.begin()");
   ui_task.begin(disp, &sensors, the_mesh.getNodePrefs());
   MESH_DEBUG_PRINTLN("setup() - ui_task.begin() done");
@@ -2371,6 +2494,7 @@ void setup() {
   #endif
 
   // Initialize T-Deck Pro keyboard
+  bootProfiler.phase("input");
   #if defined(LilyGo_TDeck_Pro)
     initKeyboard();
   #endif
@@ -2403,6 +2527,7 @@ void setup() {
     }
   #endif
 
+  bootProfiler.phase("clock");
   // RTC diagnostic + boot-time serial clock sync
   // Works on all Meck builds — T-Deck Pro has no hardware RTC and GPS may
   // not fix immediately; T5S3 has hardware RTC but it needs initial setting.
@@ -2417,52 +2542,21 @@ void setup() {
       // No valid time.  If a USB host has the serial port open (Serial
       // evaluates true on ESP32-S3 native CDC), request an automatic
       // clock sync.  The PlatformIO monitor filter "clock_sync" watches
-      // for MECK_CLOCK_REQ and responds immediately with the host time.
-      // Manual sync is also accepted: type "clock sync <epoch>" in any
-      // serial terminal.
+      // for MECK_CLOCK_REQ and responds with "clock sync <epoch>", which
+      // the serial CLI handles like a typed command -- no need to hold
+      // up boot waiting for it.
       if (Serial) {
         Serial.println("MECK_CLOCK_REQ");
-        Serial.println("  (Waiting 3s for clock sync from host...)");
-
-        char syncBuf[64];
-        int syncPos = 0;
-        unsigned long syncDeadline = millis() + 3000;
-        bool synced = false;
-
-        while (millis() < syncDeadline && !synced) {
-          while (Serial.available() && syncPos < (int)sizeof(syncBuf) - 1) {
-            char c = Serial.read();
-            if (c == '\r' || c == '\n') {
-              if (syncPos > 0) {
-                syncBuf[syncPos] = '\0';
-                if (memcmp(syncBuf, "clock sync ", 11) == 0) {
-                  uint32_t epoch = (uint32_t)strtoul(&syncBuf[11], nullptr, 10);
-                  if (epoch > 1704067200UL && epoch < 2082758400UL) {
-                    rtc_clock.setCurrentTime(epoch);
-                    Serial.printf("  > Clock synced to %lu\n", (unsigned long)epoch);
-                    synced = true;
-                  }
-                }
-                syncPos = 0;
-              }
-              break;
-            }
-            syncBuf[syncPos++] = c;
-          }
-          if (!synced) delay(10);
-        }
-        if (!synced) {
-          Serial.println("  > No clock sync received, continuing boot");
-          Serial.println("  > Use 'clock sync <epoch>' any time to sync later");
-        }
+        Serial.println("  > Use 'clock sync <epoch>' any time to sync");
       } else {
-        Serial.println("setup() - RTC not set, no serial host detected (skipping sync window)");
+        Serial.println("setup() - RTC not set, no serial host detected");
       }
     }
   }
   #endif
   // Now set up SD-dependent features: message history + text reader.
   // ---------------------------------------------------------------------------
+  bootProfiler.phase("sd-features");
   #if defined(LilyGo_TDeck_Pro) && defined(HAS_SDCARD)
   if (sdCardReady) {
     // Load persisted channel messages from SD
@@ -2474,14 +2568,12 @@ void setup() {
       }
     }
 
-    // Tell the text reader that SD is ready, then pre-index books at boot
+    // Tell the text reader that SD is ready. Books are indexed when the
+    // reader is first opened (enter()), not here: it's the slowest part of
+    // boot, and draws its own progress screens.
     TextReaderScreen* reader = (TextReaderScreen*)ui_task.getTextReaderScreen();
     if (reader) {
       reader->setSDReady(true);
-      if (disp) {
-        cpuPower.setBoost();  // Boost CPU for EPUB processing
-        reader->bootIndex(*disp);
-      }
     }
 
     // Tell notes screen that SD is ready
@@ -2496,36 +2588,11 @@ void setup() {
     MESH_DEBUG_PRINTLN("setup() - Audiobook player deferred (lazy init on first use)");
 
     // Do an initial settings backup to SD (captures any first-boot defaults)
-    backupSettingsToSD();
+    bootJobs.add("backup", bootBackupJob, NULL);
 
     // SMS / 4G modem init (after SD is ready)
     #ifdef HAS_4G_MODEM
-    {
-      smsStore.begin();
-      smsContacts.begin();
-
-      // Tell SMS screen that SD is ready
-      SMSScreen* smsScr = (SMSScreen*)ui_task.getSMSScreen();
-      if (smsScr) {
-        smsScr->setSDReady(true);
-      }
-
-      // Start modem if enabled in config (default = enabled)
-      bool modemEnabled = ModemManager::loadEnabledConfig();
-      if (modemEnabled) {
-        modemManager.begin();
-        MESH_DEBUG_PRINTLN("setup() - 4G modem manager started");
-      } else {
-        // Ensure modem power is off (kills red LED too)
-#if defined(LilyGo_TDeck_Pro_Max)
-        board.modemPowerOff();             // XL9555 6609_EN LOW
-#else
-        pinMode(MODEM_POWER_EN, OUTPUT);
-        digitalWrite(MODEM_POWER_EN, LOW);
-#endif
-        MESH_DEBUG_PRINTLN("setup() - 4G modem disabled by config");
-      }
-    }
+    bootJobs.add("modem", bootModemJob, NULL);
     #endif
   }
   #endif
@@ -2542,14 +2609,10 @@ void setup() {
       }
     }
 
-    // Text reader — set SD ready and pre-index books
+    // Text reader — set SD ready; books are indexed on first open
     TextReaderScreen* reader = (TextReaderScreen*)ui_task.getTextReaderScreen();
     if (reader) {
       reader->setSDReady(true);
-      if (disp) {
-        cpuPower.setBoost();
-        reader->bootIndex(*disp);
-      }
     }
 
     // Notes screen
@@ -2560,6 +2623,7 @@ void setup() {
     Serial.println("setup() - SD features initialized");
   }
   #endif
+  bootProfiler.phase("onboarding");
   // Check if node name is still the default hex prefix (first 4 bytes of pub key)
   // If so, launch onboarding wizard to set name and radio preset
   // ---------------------------------------------------------------------------
@@ -2577,6 +2641,7 @@ void setup() {
   }
   #endif
 
+  bootProfiler.phase("gps");
   // GPS power — honour saved pref, default to enabled on first boot.
   // GPS is critical for timesync on standalone variants without 4G.
   #if HAS_GPS
@@ -2593,8 +2658,11 @@ void setup() {
       // on subsequent boots). A module that doesn't recognise a given sentence
       // simply ignores it. Sent once here, after the module is powered.
       delay(300);  // allow the module to finish booting before accepting config
-      Serial2.print("$PCAS04,7*1E\r\n");     // GPS + GLONASS + BeiDou
-      Serial2.print("$PMTK869,1,1*35\r\n");  // EASY predicted ephemeris ON
+      gps.setConstellations(GNSS_GPS | GNSS_GLONASS | GNSS_BEIDOU);
+      gps.sendSentence("$PMTK869,1,1");        // EASY predicted ephemeris ON
+      #ifdef GPS_FIX_RATE_HZ
+        gps.setFixRate(GPS_FIX_RATE_HZ);
+      #endif
 #endif
       sensors.setSettingValue("gps", "1");
     } else {
@@ -2610,6 +2678,7 @@ void setup() {
   }
   #endif
 
+  bootProfiler.phase("late-init");
   // BLE starts disabled for standalone-first operation
   // User can toggle it from the Bluetooth home page (Enter or long-press)
   #if (defined(LilyGo_TDeck_Pro) || defined(LilyGo_T5S3_EPaper_Pro)) && defined(BLE_PIN_CODE)
@@ -2648,6 +2717,14 @@ void setup() {
                   p25?"yes":"no", p10?"yes":"no", p4?"yes":"no");
     if (p4) free(p4); if (p10) free(p10); if (p25) free(p25);
   }
+#ifdef DISPLAY_CLASS
+  ui_events.begin();
+#endif
+  bootProfiler.end();
+  mesh_task_begin(meshTaskLoop, &idleScheduler);   // from here on, mesh runs on its own task (when MESH_TASK)
+  bootProfiler.milestone(BOOT_RADIO_READY);
+  bootProfiler.print(Serial);
+
   MESH_DEBUG_PRINTLN("=== setup() - COMPLETE ===");
 }
 
@@ -2657,23 +2734,31 @@ void setup() {
 // Also pauses the mesh loop to prevent radio state confusion while standby.
 // ---------------------------------------------------------------------------
 #ifdef MECK_OTA_UPDATE
-extern RADIO_CLASS radio;  // Defined in target.cpp
-
 static bool otaRadioPaused = false;
 
 void otaPauseRadio() {
+  MeshLock lock;   // mesh task is between passes
   otaRadioPaused = true;
-  radio.standby();
+  radio_driver.idle();   // also keeps the Rx task from re-arming Rx
   Serial.println("OTA: Radio standby, mesh loop paused");
 }
 
 void otaResumeRadio() {
-  radio.startReceive();
-  otaRadioPaused = false;
+  MeshLock lock;
+  otaRadioPaused = false;   // next mesh pass (recvRaw) re-arms Rx
   Serial.println("OTA: Radio receive resumed, mesh loop active");
 }
 #endif
 
+// Runs on the mesh task (with mesh lock held), or from loop() when !MESH_TASK
+static void meshTaskLoop() {
+  #ifdef MECK_OTA_UPDATE
+  if (otaRadioPaused) return;
+  #endif
+  the_mesh.loop();
+  idleScheduler.deadline(the_mesh.getIdleMillis());
+}
+
 void loop() {
   // T-Echo Card: lazy Codec2 init from shallow stack context.
   // codec2_create needs ~3KB stack for FFT/trig init. The loop task
@@ -2711,7 +2796,9 @@ void loop() {
   }
   #endif
 
-  the_mesh.loop();
+#if !MESH_TASK
+  meshTaskLoop();
+#endif
 
   #ifdef LILYGO_TECHO_CARD
   if (_techoC2Debug > 0) {
@@ -2737,16 +2824,22 @@ void loop() {
   }
   #endif
 
+#ifdef DISPLAY_CLASS
+  ui_events.dispatch();   // queued mesh -> UI callbacks
+#endif
 
-  sensors.loop();
+  {
+    MeshLock lock;   // sensors are also read by the mesh (telemetry, adverts)
+    sensors.loop();
+  }
 
   // Satellite-count diagnostic (MAX): every 10s while GPS is on, print the
   // reported satellite count, fix state and NMEA rate so the multi-constellation
-  // change can be watched climbing. Remove once confirmed if you don't want it.
-#if defined(LilyGo_TDeck_Pro_Max) && HAS_GPS
+  // change can be watched climbing. Build with -D GPS_SAT_DIAG to enable.
+#if defined(LilyGo_TDeck_Pro_Max) && HAS_GPS && defined(GPS_SAT_DIAG)
   {
     static unsigned long lastSatDiag = 0;
-    if (the_mesh.getNodePrefs()->gps_enabled && millis() - lastSatDiag >= 10000) {
+    if (locked(the_mesh)->getNodePrefs()->gps_enabled && millis() - lastSatDiag >= 10000) {
       lastSatDiag = millis();
       auto* lp = sensors.getLocationProvider();
       if (lp) {
@@ -2791,6 +2884,7 @@ void loop() {
 
         // Always refresh contact markers (new contacts arrive via radio)
         ms->clearMarkers();
+        MeshLock lock;   // for the iteration
         ContactsIterator it = the_mesh.startContactsIterator();
         ContactInfo ci;
         while (it.hasNext(&the_mesh, ci)) {
@@ -2860,8 +2954,8 @@ void loop() {
       static unsigned long lastAlarmCheck = 0;
       if (millis() - lastAlarmCheck > ALARM_CHECK_INTERVAL_MS) {
         lastAlarmCheck = millis();
-        uint32_t rtcNow = the_mesh.getRTCClock()->getCurrentTime();
-        int fireSlot = alarmScr->checkAlarms(rtcNow, the_mesh.getNodePrefs()->utc_offset_hours);
+        uint32_t rtcNow = locked(the_mesh)->getRTCClock()->getCurrentTime();
+        int fireSlot = alarmScr->checkAlarms(rtcNow, locked(the_mesh)->getNodePrefs()->utc_offset_hours);
         if (fireSlot >= 0 && !alarmScr->isRinging()) {
           // If audiobook is playing, the alarm will take over the shared Audio*
           // object. The audiobook auto-saves bookmarks every 30s, so at most
@@ -3120,8 +3214,8 @@ void loop() {
           VoiceMessageScreen::PickContact pickBuf[40];
           int pickCount = 0;
           ContactInfo ci;
-          for (int idx = 0; idx < the_mesh.getNumContacts() && pickCount < 40; idx++) {
-            if (!the_mesh.getContactByIdx(idx, ci)) continue;
+          for (int idx = 0; idx < locked(the_mesh)->getNumContacts() && pickCount < 40; idx++) {
+            if (!locked(the_mesh)->getContactByIdx(idx, ci)) continue;
             if (ci.type != ADV_TYPE_CHAT) continue;  // Only chat nodes
             if (ci.name[0] == '\0') continue;
             pickBuf[pickCount].meshIdx = idx;
@@ -3158,12 +3252,13 @@ void loop() {
         voiceScr->formatEnvelope(envelope, sizeof(envelope), sessionId);
 
         ui_task.showAlert("Sending voice...", 10000);
-        bool dmOk = the_mesh.uiSendDirectMessage(sendIdx, envelope);
+        bool dmOk = locked(the_mesh)->uiSendDirectMessage(sendIdx, envelope);
         Serial.printf("Voice: VE3 DM '%s' to idx %d: %s\n",
                       envelope, sendIdx, dmOk ? "OK" : "FAIL");
 
         if (dmOk) {
           // Look up recipient for direct sendDirect calls
+          MeshLock lock;   // recipient points into the contacts table
           ContactInfo ci;
           the_mesh.getContactByIdx(sendIdx, ci);
           ContactInfo* recipient = the_mesh.lookupContactByPubKey(ci.id.pub_key, PUB_KEY_SIZE);
@@ -3203,7 +3298,7 @@ void loop() {
 
       // --- Auto-play incoming voice session when all packets received ---
       if (voiceScr->isIncomingReady()) {
-        the_mesh.setDeferSaves(false);  // Resume contact saves
+        locked(the_mesh)->setDeferSaves(false);  // Resume contact saves
         Serial.println("Voice: Incoming session complete — auto-playing");
         cpuPower.setBoost();
         if (voiceScr->playIncoming()) {
@@ -3218,10 +3313,10 @@ void loop() {
       // Safety timeout: if saves are deferred for more than 15s, resume them
       // (in case voice packets never arrive or session is abandoned)
       static unsigned long deferStarted = 0;
-      if (the_mesh.isDeferSaves()) {
+      if (locked(the_mesh)->isDeferSaves()) {
         if (deferStarted == 0) deferStarted = millis();
         if (millis() - deferStarted > 15000) {
-          the_mesh.setDeferSaves(false);
+          locked(the_mesh)->setDeferSaves(false);
           deferStarted = 0;
           Serial.println("Voice: Save defer timeout — resuming saves");
         }
@@ -3442,6 +3537,22 @@ void loop() {
   #endif
   #endif
 #endif
+
+  // First UI pass has drawn the home screen: deferred startup work can run
+  if (!bootJobs.isStarted()) {
+    bootProfiler.milestone(BOOT_HOME_SHOWN);
+    bootJobs.start();
+  }
+  bootJobs.loop();
+  {
+    static bool bootLogged = false;
+    if (!bootLogged && bootProfiler.getMilestone(BOOT_JOBS_DONE)) {
+      bootLogged = true;
+      bootJobs.print(Serial);
+      writeBootLog();
+    }
+  }
+
   rtc_clock.tick();
   // Periodic AGC reset - re-assert boosted RX gain to prevent sensitivity drift
   #ifdef MECK_OTA_UPDATE
@@ -3978,10 +4089,10 @@ void loop() {
                     // Conversation mode: open VKB DM compose
                     const char* dmName = chScr->getDMFilterName();
                     if (dmName && dmName[0]) {
-                      uint32_t numC = the_mesh.getNumContacts();
+                      uint32_t numC = locked(the_mesh)->getNumContacts();
                       ContactInfo ci;
                       for (uint32_t j = 0; j < numC; j++) {
-                        if (the_mesh.getContactByIdx(j, ci) && strcmp(ci.name, dmName) == 0) {
+                        if (locked(the_mesh)->getContactByIdx(j, ci) && strcmp(ci.name, dmName) == 0) {
                           char label[40];
                           snprintf(label, sizeof(label), "DM: %s", dmName);
                           #if defined(LilyGo_T5S3_EPaper_Pro)
@@ -4007,7 +4118,7 @@ void loop() {
                 } else {
                   // Open VKB for channel message compose
                   ChannelDetails ch;
-                  if (the_mesh.getChannel(chIdx, ch)) {
+                  if (locked(the_mesh)->getChannel(chIdx, ch)) {
                     char label[40];
                     snprintf(label, sizeof(label), "To: %s", ch.name);
                     #if defined(LilyGo_T5S3_EPaper_Pro)
@@ -4293,7 +4404,7 @@ void handleKeyboardInput() {
                 key >= 32 ? key : '?', key, composeMode);
   
   // Defer contact saves while user is actively pressing keys
-  the_mesh.notifyUserInput();
+  locked(the_mesh)->notifyUserInput();
 
 #if defined(LilyGo_TDeck_Pro_Max)
   // Alt+B toggles the e-ink frontlight (MAX only -- working backlight on IO41)
@@ -4306,7 +4417,7 @@ void handleKeyboardInput() {
   if (key == KB_KEY_KBD_BACKLIGHT) {
     static bool kbdBacklightOn = false;
     kbdBacklightOn = !kbdBacklightOn;
-    uint8_t kbPct = the_mesh.getNodePrefs()->kb_backlight_pct;
+    uint8_t kbPct = locked(the_mesh)->getNodePrefs()->kb_backlight_pct;
     analogWrite(KB_BL_PIN, kbdBacklightOn ? (uint8_t)((kbPct * 255 + 50) / 100) : 0);
     Serial.printf("Keyboard backlight %s\n", kbdBacklightOn ? "ON" : "OFF");
     return;
@@ -4450,7 +4561,7 @@ void handleKeyboardInput() {
         bool found = false;
         for (uint8_t prev = composeChannelIdx - 1; ; prev--) {
           ChannelDetails ch;
-          if (the_mesh.getChannel(prev, ch) && ch.name[0] != '\0') {
+          if (locked(the_mesh)->getChannel(prev, ch) && ch.name[0] != '\0') {
             composeChannelIdx = prev;
             found = true;
             break;
@@ -4461,7 +4572,7 @@ void handleKeyboardInput() {
           // Wrap to last valid channel
           for (uint8_t i = MAX_GROUP_CHANNELS - 1; i > 0; i--) {
             ChannelDetails ch;
-            if (the_mesh.getChannel(i, ch) && ch.name[0] != '\0') {
+            if (locked(the_mesh)->getChannel(i, ch) && ch.name[0] != '\0') {
               composeChannelIdx = i;
               break;
             }
@@ -4471,7 +4582,7 @@ void handleKeyboardInput() {
         // Wrap to last valid channel
         for (uint8_t i = MAX_GROUP_CHANNELS - 1; i > 0; i--) {
           ChannelDetails ch;
-          if (the_mesh.getChannel(i, ch) && ch.name[0] != '\0') {
+          if (locked(the_mesh)->getChannel(i, ch) && ch.name[0] != '\0') {
             composeChannelIdx = i;
             break;
           }
@@ -4487,7 +4598,7 @@ void handleKeyboardInput() {
       bool found = false;
       for (uint8_t next = composeChannelIdx + 1; next < MAX_GROUP_CHANNELS; next++) {
         ChannelDetails ch;
-        if (the_mesh.getChannel(next, ch) && ch.name[0] != '\0') {
+        if (locked(the_mesh)->getChannel(next, ch) && ch.name[0] != '\0') {
           composeChannelIdx = next;
           found = true;
           break;
@@ -4785,10 +4896,12 @@ void handleKeyboardInput() {
         ui_task.showAlert("No sections selected", 1500);
       } else {
         char exportedPath[64];
+        MeshLock lock;
         int result = meckExportConfig(the_mesh, flags,
                                       sensors.node_lat, sensors.node_lon,
                                       rtc_clock, sdCardReady,
                                       exportedPath, sizeof(exportedPath));
+        lock.release();
         if (result >= 0) {
           char buf[96];
           snprintf(buf, sizeof(buf), "Exported to %s", exportedPath);
@@ -4800,9 +4913,11 @@ void handleKeyboardInput() {
     }
     if (settings->isImportRequested()) {
       settings->clearImportRequest();
+      MeshLock lock;
       int added = meckImportConfig(the_mesh,
                                    sensors.node_lat, sensors.node_lon,
                                    sdCardReady);
+      lock.release();
       if (added > 0) {
         ui_task.showAlert("Config imported!", 2500);
       } else if (added == 0) {
@@ -4825,8 +4940,8 @@ void handleKeyboardInput() {
 
       ChannelDetails ch;
       ContactInfo contact;
-      if (the_mesh.getChannel(channelIdx, ch) && ch.name[0] != '\0'
-          && the_mesh.getContactByIdx(contactIdx, contact)) {
+      if (locked(the_mesh)->getChannel(channelIdx, ch) && ch.name[0] != '\0'
+          && locked(the_mesh)->getContactByIdx(contactIdx, contact)) {
         // Build share message: [MECK:CH]name|secret_hex
         char shareMsg[128];
         char hexSecret[33];
@@ -4834,11 +4949,11 @@ void handleKeyboardInput() {
         snprintf(shareMsg, sizeof(shareMsg), "%s%s|%s",
                  MECK_CH_PREFIX, ch.name, hexSecret);
 
-        if (the_mesh.uiSendDirectMessage((uint32_t)contactIdx, shareMsg)) {
+        if (locked(the_mesh)->uiSendDirectMessage((uint32_t)contactIdx, shareMsg)) {
           // Add sanitised version to DM conversation view
           char displayMsg[64];
           snprintf(displayMsg, sizeof(displayMsg), "Shared channel: %s", ch.name);
-          ui_task.addSentDM(contact.name, the_mesh.getNodePrefs()->node_name, displayMsg);
+          ui_task.addSentDM(contact.name, locked(the_mesh)->getNodePrefs()->node_name, displayMsg);
 
           char alertBuf[48];
           snprintf(alertBuf, sizeof(alertBuf), "Shared with %s", contact.name);
@@ -4862,7 +4977,7 @@ void handleKeyboardInput() {
       int cidx = admin->getContactIdx();
       uint8_t perms = admin->getPermissions() & 0x03;
       ContactInfo ci;
-      if (cidx >= 0 && perms > 0 && the_mesh.getContactByIdx(cidx, ci) && ci.type == ADV_TYPE_ROOM) {
+      if (cidx >= 0 && perms > 0 && locked(the_mesh)->getContactByIdx(cidx, ci) && ci.type == ADV_TYPE_ROOM) {
         ui_task.gotoDMConversation(ci.name, cidx, perms);
         Serial.printf("Nav: Admin -> conversation for %s\n", ci.name);
       } else {
@@ -5221,7 +5336,7 @@ void handleKeyboardInput() {
         Serial.printf("Audiobook: lazy init - free heap: %d, largest block: %d\n",
                        ESP.getFreeHeap(), ESP.getMaxAllocHeap());
         audio = new Audio();
-        AudiobookPlayerScreen* abScreen = new AudiobookPlayerScreen(&ui_task, audio, the_mesh.getNodePrefs());
+        AudiobookPlayerScreen* abScreen = new AudiobookPlayerScreen(&ui_task, audio, locked(the_mesh)->getNodePrefs());
         abScreen->setSDReady(sdCardReady);
         ui_task.setAudiobookScreen(abScreen);
         Serial.printf("Audiobook: init complete - free heap: %d\n", ESP.getFreeHeap());
@@ -5319,6 +5434,7 @@ void handleKeyboardInput() {
                                sensors.node_lon);
             // Populate contact markers via iterator
             ms->clearMarkers();
+            MeshLock lock;   // for the iteration
             ContactsIterator it = the_mesh.startContactsIterator();
             ContactInfo ci;
             int markerCount = 0;
@@ -5330,6 +5446,7 @@ void handleKeyboardInput() {
                 markerCount++;
               }
             }
+            lock.release();
             Serial.printf("MapScreen: %d contacts with GPS position\n", markerCount);
           }
         }
@@ -5558,10 +5675,10 @@ void handleKeyboardInput() {
         if (chScr2 && chScr2->isDMConversation()) {
           const char* dmName = chScr2->getDMFilterName();
           if (dmName && dmName[0]) {
-            uint32_t numC = the_mesh.getNumContacts();
+            uint32_t numC = locked(the_mesh)->getNumContacts();
             ContactInfo ci;
             for (uint32_t j = 0; j < numC; j++) {
-              if (the_mesh.getContactByIdx(j, ci) && strcmp(ci.name, dmName) == 0) {
+              if (locked(the_mesh)->getContactByIdx(j, ci) && strcmp(ci.name, dmName) == 0) {
                 composeDM = true;
                 composeDMContactIdx = (int)j;
                 strncpy(composeDMName, dmName, sizeof(composeDMName) - 1);
@@ -5609,6 +5726,7 @@ void handleKeyboardInput() {
         // Discovery screen: Enter adds selected node to contacts
         DiscoveryScreen* ds = (DiscoveryScreen*)ui_task.getDiscoveryScreen();
         int didx = ds->getSelectedIdx();
+        MeshLock lock;   // node points into the discovery list
         if (didx >= 0 && didx < the_mesh.getDiscoveredCount()) {
           const DiscoveredNode& node = the_mesh.getDiscovered(didx);
           if (node.already_in_contacts) {
@@ -5675,7 +5793,7 @@ void handleKeyboardInput() {
           if (cs2) cs2->invalidateCache();
           char alertBuf[48];
           snprintf(alertBuf, sizeof(alertBuf), "+%d imported (%d total)",
-                   added, (int)the_mesh.getNumContacts());
+                   added, (int)locked(the_mesh)->getNumContacts());
           ui_task.showAlert(alertBuf, 2500);
         } else if (added == 0) {
           ui_task.showAlert("No new contacts to add", 2000);
@@ -5696,7 +5814,7 @@ void handleKeyboardInput() {
       // Start discovery scan from home/contacts screen, or rescan on discovery screen
       else if (ui_task.isOnContactsScreen() || ui_task.isOnHomeScreen()) {
         Serial.println("Starting discovery scan...");
-        the_mesh.startDiscovery();
+        locked(the_mesh)->startDiscovery();
         ui_task.gotoDiscoveryScreen();
       } else if (ui_task.isOnDiscoveryScreen()) {
         ui_task.injectKey('f');  // pass through for rescan
@@ -5777,7 +5895,7 @@ void handleKeyboardInput() {
       }
       // Discovery screen: Q goes back to contacts (not home)
       if (ui_task.isOnDiscoveryScreen()) {
-        the_mesh.stopDiscovery();
+        locked(the_mesh)->stopDiscovery();
         Serial.println("Nav: Discovery -> Contacts");
         ui_task.gotoContactsScreen();
         break;
@@ -5925,7 +6043,7 @@ void drawComposeScreen() {
     snprintf(headerBuf, sizeof(headerBuf), "DM: %s", composeDMName);
   } else {
     ChannelDetails channel;
-    if (the_mesh.getChannel(composeChannelIdx, channel)) {
+    if (locked(the_mesh)->getChannel(composeChannelIdx, channel)) {
       snprintf(headerBuf, sizeof(headerBuf), "To: %s", channel.name);
     } else {
       snprintf(headerBuf, sizeof(headerBuf), "To: Channel %d", composeChannelIdx);
@@ -6063,9 +6181,9 @@ void sendComposedMessage() {
   if (composeDM) {
     // Direct message to a specific contact
     if (composeDMContactIdx >= 0) {
-      if (the_mesh.uiSendDirectMessage((uint32_t)composeDMContactIdx, utf8Buf)) {
+      if (locked(the_mesh)->uiSendDirectMessage((uint32_t)composeDMContactIdx, utf8Buf)) {
         // Add to channel screen so sent DM appears in conversation view
-        ui_task.addSentDM(composeDMName, the_mesh.getNodePrefs()->node_name, utf8Buf);
+        ui_task.addSentDM(composeDMName, locked(the_mesh)->getNodePrefs()->node_name, utf8Buf);
         ui_task.showAlert("DM sent!", 1500);
       } else {
         ui_task.showAlert("DM failed!", 1500);
@@ -6078,19 +6196,19 @@ void sendComposedMessage() {
 
   // Channel (group) message
   ChannelDetails channel;
-  if (the_mesh.getChannel(composeChannelIdx, channel)) {
+  if (locked(the_mesh)->getChannel(composeChannelIdx, channel)) {
     uint32_t timestamp = rtc_clock.getCurrentTime();
     int utf8Len = strlen(utf8Buf);
     
-    if (the_mesh.sendGroupMessage(timestamp, channel.channel, 
-                                   the_mesh.getNodePrefs()->node_name, 
+    if (locked(the_mesh)->sendGroupMessage(timestamp, channel.channel, 
+                                   locked(the_mesh)->getNodePrefs()->node_name, 
                                    utf8Buf, utf8Len)) {
       ui_task.addSentChannelMessage(composeChannelIdx, 
-                                     the_mesh.getNodePrefs()->node_name, 
+                                     locked(the_mesh)->getNodePrefs()->node_name, 
                                      utf8Buf);
       
-      the_mesh.queueSentChannelMessage(composeChannelIdx, timestamp,
-                                        the_mesh.getNodePrefs()->node_name,
+      locked(the_mesh)->queueSentChannelMessage(composeChannelIdx, timestamp,
+                                        locked(the_mesh)->getNodePrefs()->node_name,
                                         utf8Buf);
       
       ui_task.showAlert("Sent!", 1500);
@@ -6144,7 +6262,7 @@ void drawCardKBCompose() {
     snprintf(headerBuf, sizeof(headerBuf), "DM: %s", ckbComposeDMName);
   } else {
     ChannelDetails channel;
-    if (the_mesh.getChannel(ckbComposeChIdx, channel)) {
+    if (locked(the_mesh)->getChannel(ckbComposeChIdx, channel)) {
       snprintf(headerBuf, sizeof(headerBuf), "To: %s", channel.name);
     } else {
       snprintf(headerBuf, sizeof(headerBuf), "To: Channel %d", ckbComposeChIdx);
@@ -6247,8 +6365,8 @@ void sendCardKBMessage() {
   if (ckbComposeDM) {
     // Direct message
     if (ckbComposeDMIdx >= 0) {
-      if (the_mesh.uiSendDirectMessage((uint32_t)ckbComposeDMIdx, ckbComposeBuf)) {
-        ui_task.addSentDM(ckbComposeDMName, the_mesh.getNodePrefs()->node_name, ckbComposeBuf);
+      if (locked(the_mesh)->uiSendDirectMessage((uint32_t)ckbComposeDMIdx, ckbComposeBuf)) {
+        ui_task.addSentDM(ckbComposeDMName, locked(the_mesh)->getNodePrefs()->node_name, ckbComposeBuf);
         ui_task.showAlert("DM sent!", 1500);
       } else {
         ui_task.showAlert("DM failed!", 1500);
@@ -6259,18 +6377,18 @@ void sendCardKBMessage() {
   } else {
     // Channel message
     ChannelDetails channel;
-    if (the_mesh.getChannel(ckbComposeChIdx, channel)) {
+    if (locked(the_mesh)->getChannel(ckbComposeChIdx, channel)) {
       uint32_t timestamp = rtc_clock.getCurrentTime();
       int len = strlen(ckbComposeBuf);
 
-      if (the_mesh.sendGroupMessage(timestamp, channel.channel,
-                                     the_mesh.getNodePrefs()->node_name,
+      if (locked(the_mesh)->sendGroupMessage(timestamp, channel.channel,
+                                     locked(the_mesh)->getNodePrefs()->node_name,
                                      ckbComposeBuf, len)) {
         ui_task.addSentChannelMessage(ckbComposeChIdx,
-                                       the_mesh.getNodePrefs()->node_name,
+                                       locked(the_mesh)->getNodePrefs()->node_name,
                                        ckbComposeBuf);
-        the_mesh.queueSentChannelMessage(ckbComposeChIdx, timestamp,
-                                          the_mesh.getNodePrefs()->node_name,
+        locked(the_mesh)->queueSentChannelMessage(ckbComposeChIdx, timestamp,
+                                          locked(the_mesh)->getNodePrefs()->node_name,
                                           ckbComposeBuf);
         ui_task.showAlert("Sent!", 1500);
       } else {
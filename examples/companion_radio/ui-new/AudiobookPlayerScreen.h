@@ -33,6 +33,7 @@
 #include <vector>
 #include <algorithm>
 #include "M4BMetadata.h"
+#include "SDWriteScheduler.h"
 
 // Audio library — ESP32-audioI2S by schreibfaul1
 #include "Audio.h"
@@ -196,6 +197,12 @@ private:
   uint32_t    _durationSec;
   int         _currentChapter;
   unsigned long _lastPositionSave;
+
+  // Bookmark snapshot waiting for sdWriter
+  int      _bmJob = -1;
+  bool     _bmPending = false;
+  Bookmark _pendingBm;
+  String   _pendingBmPath;
   unsigned long _lastPosUpdate;
 
   // Deferred seek — applied after audio library reports stream ready
@@ -441,6 +448,7 @@ private:
   }
 
   void loadBookmark() {
+    if (_bmPending) sdWriter.flush(_bmJob);   // reopening a book before its bookmark was written
     String path = getBookmarkPath(_currentFile);
     if (isMusicPath()) {
       // Music files don't use bookmarks — delete any stale one and start at 0.
@@ -464,31 +472,51 @@ private:
     digitalWrite(SDCARD_CS, HIGH);
   }
 
+  // Snapshot the bookmark and queue the write, so pause/stop/track changes
+  // and the periodic auto-save don't wait on SD
   void saveBookmark() {
     if (!_bookOpen || _currentFile.length() == 0) return;
     if (isMusicPath()) return;  // Music files don't use bookmarks
 
+    String path = getBookmarkPath(_currentFile);
+    if (_bmPending && _pendingBmPath != path) {
+      sdWriter.flush(_bmJob);   // previous track's bookmark goes out first
+    }
+
+    memset(&_pendingBm, 0, sizeof(_pendingBm));
+    strncpy(_pendingBm.filename, _currentFile.c_str(), sizeof(_pendingBm.filename) - 1);
+    _pendingBm.positionSec = _currentPosSec;
+    _pendingBm.volume = _volume;
+    _pendingBmPath = path;
+    _bmPending = true;
+
+    if (_bmJob >= 0) sdWriter.markDirty(_bmJob);
+    else writePendingBookmark();
+  }
+
+  static bool bookmarkJob(void* ctx) {
+    ((AudiobookPlayerScreen*)ctx)->writePendingBookmark();
+    return true;
+  }
+
+  void writePendingBookmark() {
+    if (!_bmPending) return;
+    _bmPending = false;
+
     if (!SD.exists(AB_BOOKMARK_FOLDER)) {
       SD.mkdir(AB_BOOKMARK_FOLDER);
     }
 
-    String path = getBookmarkPath(_currentFile);
-    if (SD.exists(path.c_str())) SD.remove(path.c_str());
+    if (SD.exists(_pendingBmPath.c_str())) SD.remove(_pendingBmPath.c_str());
 
-    File f = SD.open(path.c_str(), FILE_WRITE);
+    File f = SD.open(_pendingBmPath.c_str(), FILE_WRITE);
     if (!f) return;
 
-    Bookmark bm;
-    memset(&bm, 0, sizeof(bm));
-    strncpy(bm.filename, _currentFile.c_str(), sizeof(bm.filename) - 1);
-    bm.positionSec = _currentPosSec;
-    bm.volume = _volume;
-
-    f.write((uint8_t*)&bm, sizeof(bm));
+    f.write((uint8_t*)&_pendingBm, sizeof(_pendingBm));
     f.close();
     digitalWrite(SDCARD_CS, HIGH);
 
-    Serial.printf("AB: Saved bookmark - pos %us\n", _currentPosSec);
+    Serial.printf("AB: Saved bookmark - pos %us\n", _pendingBm.positionSec);
   }
 
   // ---- File Scanning ----
@@ -1538,7 +1566,12 @@ public:
     freeCoverBitmap();
   }
 
-  void setSDReady(bool ready) { _sdReady = ready; }
+  void setSDReady(bool ready) {
+    _sdReady = ready;
+    if (ready && _bmJob < 0) {
+      _bmJob = sdWriter.registerJob("ab-bookmark", bookmarkJob, this, SD_WRITE_SOON);
+    }
+  }
 
   // ---- Audio Tick ----
   // Called from main loop() every iteration for uninterrupted playback.
@@ -4,6 +4,7 @@
 #include <helpers/ui/DisplayDriver.h>
 #include <helpers/ChannelDetails.h>
 #include <MeshCore.h>
+#include "../MeshTask.h"
 #include "ChannelScreen.h"
 
 #ifndef MAX_GROUP_CHANNELS
@@ -72,7 +73,7 @@ class ChannelPickerScreen : public UIScreen {
     tmp[n++] = 0xFF;  // DM inbox always first
     for (uint8_t i = 0; i < MAX_GROUP_CHANNELS; i++) {
       ChannelDetails ch;
-      if (the_mesh.getChannel(i, ch) && ch.name[0] != '\0') {
+      if (locked(the_mesh)->getChannel(i, ch) && ch.name[0] != '\0') {
         if (n < MAX_GROUP_CHANNELS + 1) tmp[n++] = i;
       }
     }
@@ -91,7 +92,7 @@ class ChannelPickerScreen : public UIScreen {
       return;
     }
     ChannelDetails ch;
-    if (the_mesh.getChannel(c, ch) && ch.name[0] != '\0') {
+    if (locked(the_mesh)->getChannel(c, ch) && ch.name[0] != '\0') {
       strncpy(buf, ch.name, bufLen - 1);
       buf[bufLen - 1] = '\0';
     } else {
@@ -271,7 +272,7 @@ public:
     // T-Deck Pro / MAX: Vertical list
     // Uses NodePrefs font helpers for large_font compatibility.
     // =================================================================
-    NodePrefs* prefs = the_mesh.getNodePrefs();
+    NodePrefs* prefs = locked(the_mesh)->getNodePrefs();
     int lineH = prefs->smallLineH();
     const int headerH = 14;
     const int footerH = 14;
@@ -532,7 +533,7 @@ public:
     return 2;  // Direct open on tap
 #else
     // T-Deck Pro / MAX list hit test -- uses NodePrefs for large_font compatibility
-    NodePrefs* prefs = the_mesh.getNodePrefs();
+    NodePrefs* prefs = locked(the_mesh)->getNodePrefs();
     int lineH = prefs->smallLineH();
     const int headerH = 14;
     const int footerH = 14;
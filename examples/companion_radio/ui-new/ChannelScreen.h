@@ -4,8 +4,10 @@
 #include <helpers/ui/DisplayDriver.h>
 #include <helpers/ChannelDetails.h>
 #include <MeshCore.h>
+#include "../MeshTask.h"
 #include <Packet.h>
 #include "EmojiSprites.h"
+#include "SDWriteScheduler.h"
 
 // SD card message persistence
 #if defined(HAS_SDCARD) && defined(ESP32)
@@ -20,6 +22,7 @@
 #define CHANNEL_MSG_TEXT_LEN 160
 #endif
 #define MSG_PATH_MAX 20  // Max repeater hops stored per message
+#define MSG_SAVE_CHUNK 60  // Records written per SD scheduler slice (~11 KB)
 
 #ifndef MAX_GROUP_CHANNELS
   #define MAX_GROUP_CHANNELS 20
@@ -89,6 +92,14 @@ private:
   int _msgsPerPage;   // Messages that fit on screen
   uint8_t _viewChannelIdx;  // Which channel we're currently viewing
   bool _sdReady;      // SD card is available for persistence
+  int _saveJob;       // sdWriter job for messages.bin (-1 until SD is ready)
+  int _saveIdx;       // Next record of an in-progress save (-1 = none)
+  int _saveCount;     // _msgCount / _newestIdx when the save started (written to the header)
+  int _saveNewest;
+  int _saveAdded;     // messages added since the save started (their slots are stale in this save)
+#if defined(HAS_SDCARD) && defined(ESP32)
+  File _saveFile;
+#endif
   bool _showPathOverlay;  // Show path detail overlay for last received msg
   int _pathScrollPos;     // Scroll offset within path overlay hop list
   int _pathHopsVisible;   // Hops that fit on screen (set during render)
@@ -123,6 +134,38 @@ private:
     return msg.channel_idx == 0xFF;
   }
 
+  // Messages in the current view, as ring indices in chronological order (oldest first).
+  // Appended to by addMessage(); only rebuilt when the view (channel / DM peer) changes
+  // or the store is reloaded/cleared, so render and input don't rescan the whole ring.
+  mutable int16_t _viewMsgs[CHANNEL_MSG_HISTORY_SIZE];
+  mutable int _viewCount;
+  mutable uint64_t _viewKey;    // currentViewKey() that _viewMsgs was built for
+  mutable bool _viewValid;
+
+  uint64_t currentViewKey() const {
+    bool byPeer = _viewChannelIdx == 0xFF && !_dmInboxMode && _dmFilterName[0] != '\0';
+    return ((uint64_t)_viewChannelIdx << 33) | ((uint64_t)byPeer << 32) | (byPeer ? peerHash(_dmFilterName) : 0);
+  }
+
+  const int16_t* getViewMsgs(int& count) const {
+    uint64_t key = currentViewKey();
+    if (!_viewValid || key != _viewKey) {
+      _viewCount = 0;
+      for (int i = _msgCount - 1; i >= 0; i--) {   // oldest first
+        int idx = _newestIdx - i;
+        while (idx < 0) idx += CHANNEL_MSG_HISTORY_SIZE;
+        idx = idx % CHANNEL_MSG_HISTORY_SIZE;
+        if (msgMatchesView(_messages[idx])) {
+          _viewMsgs[_viewCount++] = (int16_t)idx;
+        }
+      }
+      _viewKey = key;
+      _viewValid = true;
+    }
+    count = _viewCount;
+    return _viewMsgs;
+  }
+
   // Per-channel unread message counts (standalone mode)
   // Index 0..MAX_GROUP_CHANNELS-1 for channel messages
   // Index MAX_GROUP_CHANNELS for DMs (channel_idx == 0xFF)
@@ -131,9 +174,10 @@ private:
 public:
   ChannelScreen(UITask* task, mesh::RTCClock* rtc) 
     : _task(task), _rtc(rtc), _msgCount(0), _newestIdx(-1), _scrollPos(0), 
-      _msgsPerPage(6), _viewChannelIdx(0), _sdReady(false), _showPathOverlay(false), _pathScrollPos(0), _pathHopsVisible(20),
+      _msgsPerPage(6), _viewChannelIdx(0), _sdReady(false), _saveJob(-1), _saveIdx(-1), _saveCount(0), _saveNewest(-1), _saveAdded(0), _showPathOverlay(false), _pathScrollPos(0), _pathHopsVisible(20),
       _replySelectMode(false), _replySelectPos(-1), _replyChannelMsgCount(0),
-      _dmInboxMode(true), _dmInboxScroll(0), _dmContactIdx(-1), _dmContactPerms(0), _dmUnreadPtr(nullptr) {
+      _dmInboxMode(true), _dmInboxScroll(0), _dmContactIdx(-1), _dmContactPerms(0), _dmUnreadPtr(nullptr),
+      _viewCount(0), _viewKey(0), _viewValid(false) {
     _dmFilterName[0] = '\0';
     // Initialize all messages as invalid
     for (int i = 0; i < CHANNEL_MSG_HISTORY_SIZE; i++) {
@@ -146,7 +190,12 @@ public:
     memset(_unread, 0, sizeof(_unread));
   }
 
-  void setSDReady(bool ready) { _sdReady = ready; }
+  void setSDReady(bool ready) {
+    _sdReady = ready;
+    if (ready && _saveJob < 0) {
+      _saveJob = sdWriter.registerJob("messages", saveJob, this, SD_WRITE_NORMAL);
+    }
+  }
 
   // Add a new message to the history
   // peer_name: for DMs, the contact this message belongs to (sender for received, recipient for sent)
@@ -156,6 +205,14 @@ public:
                   bool suppressUnread = false, uint8_t scope_idx = 0xFF) {
     // Move to next slot in circular buffer
     _newestIdx = (_newestIdx + 1) % CHANNEL_MSG_HISTORY_SIZE;
+    if (_saveIdx >= 0) _saveAdded++;   // save in progress: this slot no longer matches its header
+
+    // Slot being overwritten is the oldest message, so if it's in the view it's at the front
+    bool viewCurrent = _viewValid && _viewKey == currentViewKey();
+    if (viewCurrent && _viewCount > 0 && _viewMsgs[0] == _newestIdx) {
+      memmove(&_viewMsgs[0], &_viewMsgs[1], (_viewCount - 1) * sizeof(_viewMsgs[0]));
+      _viewCount--;
+    }
     
     ChannelMessage* msg = &_messages[_newestIdx];
     msg->timestamp = _rtc->getCurrentTime();
@@ -187,6 +244,11 @@ public:
     if (_msgCount < CHANNEL_MSG_HISTORY_SIZE) {
       _msgCount++;
     }
+    if (!viewCurrent) {
+      _viewValid = false;
+    } else if (msgMatchesView(*msg)) {
+      _viewMsgs[_viewCount++] = (int16_t)_newestIdx;
+    }
     
     // Reset scroll to show newest message
     _scrollPos = 0;
@@ -211,12 +273,8 @@ public:
 
   // Get count of messages for the currently viewed channel
   int getMessageCountForChannel() const {
-    int count = 0;
-    for (int i = 0; i < CHANNEL_MSG_HISTORY_SIZE; i++) {
-      if (msgMatchesView(_messages[i])) {
-        count++;
-      }
-    }
+    int count;
+    getViewMsgs(count);
     return count;
   }
 
@@ -290,22 +348,8 @@ public:
   bool getReplySelectSender(char* senderBuf, int bufLen) {
     if (!_replySelectMode || _replySelectPos < 0) return false;
 
-    // Rebuild the channel message list (same logic as render)
-    static int rsMsgs[CHANNEL_MSG_HISTORY_SIZE];
-    int count = 0;
-    for (int i = 0; i < _msgCount && count < CHANNEL_MSG_HISTORY_SIZE; i++) {
-      int idx = _newestIdx - i;
-      while (idx < 0) idx += CHANNEL_MSG_HISTORY_SIZE;
-      idx = idx % CHANNEL_MSG_HISTORY_SIZE;
-      if (_messages[idx].valid && msgMatchesView(_messages[idx])) {
-        rsMsgs[count++] = idx;
-      }
-    }
-    // Reverse to chronological (oldest first)
-    for (int l = 0, r = count - 1; l < r; l++, r--) {
-      int t = rsMsgs[l]; rsMsgs[l] = rsMsgs[r]; rsMsgs[r] = t;
-    }
-
+    int count;
+    const int16_t* rsMsgs = getViewMsgs(count);   // chronological, same list as render
     if (_replySelectPos >= count) return false;
     int idx = rsMsgs[_replySelectPos];
     return extractSenderName(_messages[idx].text, senderBuf, bufLen);
@@ -315,20 +359,8 @@ public:
   ChannelMessage* getReplySelectMsg() {
     if (!_replySelectMode || _replySelectPos < 0) return nullptr;
 
-    static int rsMsgs[CHANNEL_MSG_HISTORY_SIZE];
-    int count = 0;
-    for (int i = 0; i < _msgCount && count < CHANNEL_MSG_HISTORY_SIZE; i++) {
-      int idx = _newestIdx - i;
-      while (idx < 0) idx += CHANNEL_MSG_HISTORY_SIZE;
-      idx = idx % CHANNEL_MSG_HISTORY_SIZE;
-      if (_messages[idx].valid && msgMatchesView(_messages[idx])) {
-        rsMsgs[count++] = idx;
-      }
-    }
-    for (int l = 0, r = count - 1; l < r; l++, r--) {
-      int t = rsMsgs[l]; rsMsgs[l] = rsMsgs[r]; rsMsgs[r] = t;
-    }
-
+    int count;
+    const int16_t* rsMsgs = getViewMsgs(count);
     if (_replySelectPos >= count) return nullptr;
     return &_messages[rsMsgs[_replySelectPos]];
   }
@@ -420,6 +452,7 @@ public:
       }
     }
     if (cleared > 0) {
+      _viewValid = false;
       // Reset unread counter for the cleared channel
       markChannelRead(channel_idx);
       // Reset scroll if we're viewing the cleared channel
@@ -443,49 +476,76 @@ public:
   // SD card persistence
   // -----------------------------------------------------------------------
 
-  // Save the entire message buffer to SD card.
+  // Schedule a save of the entire message buffer to SD card. Bursts of
+  // messages coalesce into one write, done a chunk at a time from the loop.
   // File: /meshcore/messages.bin  (~50 KB for 300 messages)
   void saveToSD() {
+    sdWriter.markDirty(_saveJob);
+  }
+
+  static bool saveJob(void* ctx) { return ((ChannelScreen*)ctx)->saveChunk(); }
+
+  // Write the next MSG_SAVE_CHUNK records.  Returns true when the file is complete.
+  bool saveChunk() {
 #if defined(HAS_SDCARD) && defined(ESP32)
-    if (!_sdReady) return;
+    if (!_sdReady) return true;
 
-    // Ensure directory exists
-    if (!SD.exists("/meshcore")) {
-      SD.mkdir("/meshcore");
-    }
+    if (_saveIdx < 0) {
+      // Ensure directory exists
+      if (!SD.exists("/meshcore")) {
+        SD.mkdir("/meshcore");
+      }
 
-    File f = SD.open(MSG_FILE_PATH, "w", true);
-    if (!f) {
-      Serial.println("ChannelScreen: SD save failed - can't open file");
-      return;
+      _saveFile = SD.open(MSG_FILE_PATH, "w", true);
+      if (!_saveFile) {
+        Serial.println("ChannelScreen: SD save failed - can't open file");
+        return true;
+      }
+
+      // Write header, from a snapshot taken now (records are written over several slices)
+      _saveCount  = _msgCount;
+      _saveNewest = _newestIdx;
+      _saveAdded  = 0;
+      MsgFileHeader hdr;
+      hdr.magic    = MSG_FILE_MAGIC;
+      hdr.version  = MSG_FILE_VERSION;
+      hdr.capacity = CHANNEL_MSG_HISTORY_SIZE;
+      hdr.count    = (uint16_t)_saveCount;
+      hdr.newestIdx = (int16_t)_saveNewest;
+      _saveFile.write((uint8_t*)&hdr, sizeof(hdr));
+      _saveIdx = 0;
     }
 
-    // Write header
-    MsgFileHeader hdr;
-    hdr.magic    = MSG_FILE_MAGIC;
-    hdr.version  = MSG_FILE_VERSION;
-    hdr.capacity = CHANNEL_MSG_HISTORY_SIZE;
-    hdr.count    = (uint16_t)_msgCount;
-    hdr.newestIdx = (int16_t)_newestIdx;
-    f.write((uint8_t*)&hdr, sizeof(hdr));
-
-    // Write all message slots (including invalid ones - preserves circular buffer layout)
-    for (int i = 0; i < CHANNEL_MSG_HISTORY_SIZE; i++) {
+    // Write message slots (including invalid ones - preserves circular buffer layout)
+    int end = min(_saveIdx + MSG_SAVE_CHUNK, CHANNEL_MSG_HISTORY_SIZE);
+    for (; _saveIdx < end; _saveIdx++) {
+      const ChannelMessage& m = _messages[_saveIdx];
       MsgFileRecord rec;
-      rec.timestamp   = _messages[i].timestamp;
-      rec.path_len    = _messages[i].path_len;
-      rec.channel_idx = _messages[i].channel_idx;
-      rec.valid       = _messages[i].valid ? 1 : 0;
-      rec.snr         = _messages[i].snr;
-      rec.dm_peer_hash = _messages[i].dm_peer_hash;
-      memcpy(rec.path, _messages[i].path, MSG_PATH_MAX);
-      memcpy(rec.text, _messages[i].text, CHANNEL_MSG_TEXT_LEN);
-      f.write((uint8_t*)&rec, sizeof(rec));
+      rec.timestamp   = m.timestamp;
+      rec.path_len    = m.path_len;
+      rec.channel_idx = m.channel_idx;
+      rec.valid       = m.valid ? 1 : 0;
+      // Slots refilled since the header was written would load as the oldest messages:
+      // leave them out, the save queued by their markDirty() writes them in order
+      int age = (_saveIdx - _saveNewest + CHANNEL_MSG_HISTORY_SIZE) % CHANNEL_MSG_HISTORY_SIZE;
+      if (_saveNewest < 0 || (age >= 1 && age <= _saveAdded) || _saveAdded >= CHANNEL_MSG_HISTORY_SIZE) rec.valid = 0;
+      rec.snr         = m.snr;
+      rec.dm_peer_hash = m.dm_peer_hash;
+      memcpy(rec.path, m.path, MSG_PATH_MAX);
+      memcpy(rec.text, m.text, CHANNEL_MSG_TEXT_LEN);
+      _saveFile.write((uint8_t*)&rec, sizeof(rec));
     }
 
-    f.close();
+    if (_saveIdx < CHANNEL_MSG_HISTORY_SIZE) {
+      digitalWrite(SDCARD_CS, HIGH);  // Release SD CS until the next slice
+      return false;
+    }
+
+    _saveFile.close();
+    _saveIdx = -1;
     digitalWrite(SDCARD_CS, HIGH);  // Release SD CS
 #endif
+    return true;
   }
 
   // Load message buffer from SD card.  Returns true if messages were loaded.
@@ -555,6 +615,7 @@ public:
     _msgCount   = (int)hdr.count;
     _newestIdx  = (int)hdr.newestIdx;
     _scrollPos  = 0;
+    _viewValid  = false;
 
     // Sanity-check restored state
     if (_newestIdx < -1 || _newestIdx >= CHANNEL_MSG_HISTORY_SIZE) _newestIdx = -1;
@@ -592,7 +653,7 @@ public:
         snprintf(hdr, sizeof(hdr), "DM: %s", _dmFilterName);
         display.print(hdr);
       }
-    } else if (the_mesh.getChannel(_viewChannelIdx, channel)) {
+    } else if (locked(the_mesh)->getChannel(_viewChannelIdx, channel)) {
       display.print(channel.name);
     } else {
       sprintf(tmp, "Channel %d", _viewChannelIdx);
@@ -645,10 +706,10 @@ public:
           inbox[found].newestTs = 0;
 
           // Look up name from contacts by matching peer hash
-          uint32_t numC = the_mesh.getNumContacts();
+          uint32_t numC = locked(the_mesh)->getNumContacts();
           ContactInfo ci;
           for (uint32_t c = 0; c < numC; c++) {
-            if (the_mesh.getContactByIdx(c, ci) && peerHash(ci.name) == h) {
+            if (locked(the_mesh)->getContactByIdx(c, ci) && peerHash(ci.name) == h) {
               strncpy(inbox[found].name, ci.name, 31);
               inbox[found].name[31] = '\0';
               break;
@@ -669,10 +730,10 @@ public:
       // Look up unread counts from per-contact array
       if (_dmUnreadPtr) {
         for (int e = 0; e < inboxCount; e++) {
-          uint32_t numC = the_mesh.getNumContacts();
+          uint32_t numC = locked(the_mesh)->getNumContacts();
           ContactInfo ci;
           for (uint32_t c = 0; c < numC; c++) {
-            if (the_mesh.getContactByIdx(c, ci) && peerHash(ci.name) == inbox[e].hash) {
+            if (locked(the_mesh)->getContactByIdx(c, ci) && peerHash(ci.name) == inbox[e].hash) {
               inbox[e].unreadCount = _dmUnreadPtr[c];
               break;
             }
@@ -692,8 +753,8 @@ public:
       }
 
       // Render inbox list
-      display.setTextSize(the_mesh.getNodePrefs()->smallTextSize());
-      int lineH = the_mesh.getNodePrefs()->smallLineH();
+      display.setTextSize(locked(the_mesh)->getNodePrefs()->smallTextSize());
+      int lineH = locked(the_mesh)->getNodePrefs()->smallLineH();
       int headerH = 14;
       int footerH = 14;
       int maxY = display.height() - footerH;
@@ -727,7 +788,7 @@ public:
 #if defined(LilyGo_T5S3_EPaper_Pro)
             display.fillRect(0, y, display.width(), lineH);
 #else
-            display.fillRect(0, y + the_mesh.getNodePrefs()->smallHighlightOff(), display.width(), lineH);
+            display.fillRect(0, y + locked(the_mesh)->getNodePrefs()->smallHighlightOff(), display.width(), lineH);
 #endif
             display.setColor(DisplayDriver::DARK);
           } else {
@@ -806,8 +867,8 @@ public:
     
     // --- Path detail overlay ---
     if (_showPathOverlay) {
-      display.setTextSize(the_mesh.getNodePrefs()->smallTextSize());
-      int lineH = the_mesh.getNodePrefs()->smallLineH();
+      display.setTextSize(locked(the_mesh)->getNodePrefs()->smallTextSize());
+      int lineH = locked(the_mesh)->getNodePrefs()->smallLineH();
       int y = 14;
       
       ChannelMessage* msg = getNewestReceivedMsg();
@@ -855,7 +916,7 @@ public:
         y += lineH;
 
         // Region (scoped channel messages only; session, not persisted)
-        const char* rgn = the_mesh.getScopeName(msg->scope_idx);
+        const char* rgn = locked(the_mesh)->getScopeName(msg->scope_idx);
         if (rgn) {
           display.setCursor(0, y);
           display.setColor(DisplayDriver::YELLOW);
@@ -923,13 +984,13 @@ public:
             
             // Try to resolve name: prefer repeaters, then any contact
             bool resolved = false;
-            int numContacts = the_mesh.getNumContacts();
+            int numContacts = locked(the_mesh)->getNumContacts();
             ContactInfo contact;
             char filteredName[32];
             
             // First pass: repeaters only
             for (uint32_t ci = 0; ci < numContacts && !resolved; ci++) {
-              if (the_mesh.getContactByIdx(ci, contact)) {
+              if (locked(the_mesh)->getContactByIdx(ci, contact)) {
                 if (memcmp(contact.id.pub_key, &msg->path[hopOffset], bytesPerHop) == 0
                     && contact.type == ADV_TYPE_REPEATER) {
                   display.setColor(DisplayDriver::GREEN);
@@ -942,7 +1003,7 @@ public:
             // Second pass: any contact type
             if (!resolved) {
               for (uint32_t ci = 0; ci < numContacts; ci++) {
-                if (the_mesh.getContactByIdx(ci, contact)) {
+                if (locked(the_mesh)->getContactByIdx(ci, contact)) {
                   if (memcmp(contact.id.pub_key, &msg->path[hopOffset], bytesPerHop) == 0) {
                     display.setColor(DisplayDriver::YELLOW);
                     display.translateUTF8ToBlocks(filteredName, contact.name, sizeof(filteredName));
@@ -1013,7 +1074,7 @@ public:
     }
     
     if (channelMsgCount == 0) {
-      display.setTextSize(the_mesh.getNodePrefs()->smallTextSize());  // Tiny font for body text
+      display.setTextSize(locked(the_mesh)->getNodePrefs()->smallTextSize());  // Tiny font for body text
       display.setCursor(0, 20);
       display.setColor(DisplayDriver::LIGHT);
       if (_viewChannelIdx == 0xFF) {
@@ -1050,8 +1111,8 @@ public:
       // =================================================================
       // DM Inbox: list of contacts/rooms you have DM history with
       // =================================================================
-      display.setTextSize(the_mesh.getNodePrefs()->smallTextSize());
-      int lineHeight = the_mesh.getNodePrefs()->smallLineH();
+      display.setTextSize(locked(the_mesh)->getNodePrefs()->smallTextSize());
+      int lineHeight = locked(the_mesh)->getNodePrefs()->smallLineH();
       int headerHeight = 14;
       int footerHeight = 14;
       int maxY = display.height() - footerHeight;
@@ -1131,7 +1192,7 @@ public:
 #if defined(LilyGo_T5S3_EPaper_Pro)
             display.fillRect(0, y, display.width(), lineHeight);
 #else
-            display.fillRect(0, y + the_mesh.getNodePrefs()->smallHighlightOff(), display.width(), lineHeight);
+            display.fillRect(0, y + locked(the_mesh)->getNodePrefs()->smallHighlightOff(), display.width(), lineHeight);
 #endif
             display.setColor(DisplayDriver::DARK);
           } else {
@@ -1169,8 +1230,8 @@ public:
       }
       display.setTextSize(1);
     } else {
-      display.setTextSize(the_mesh.getNodePrefs()->smallTextSize());  // Tiny font for message body
-      int lineHeight = the_mesh.getNodePrefs()->smallLineH();   // 8px font + 1px spacing
+      display.setTextSize(locked(the_mesh)->getNodePrefs()->smallTextSize());  // Tiny font for message body
+      int lineHeight = locked(the_mesh)->getNodePrefs()->smallLineH();   // 8px font + 1px spacing
       int headerHeight = 14;
       int footerHeight = 14;
       int scrollBarW = 4;   // Width of scroll indicator on right edge
@@ -1180,25 +1241,9 @@ public:
       
       int y = headerHeight;
       
-      // Build list of messages for this channel (newest first)
-      // Static to avoid 1200-byte stack allocation every render cycle
-      static int channelMsgs[CHANNEL_MSG_HISTORY_SIZE];
-      int numChannelMsgs = 0;
-      
-      for (int i = 0; i < _msgCount && numChannelMsgs < CHANNEL_MSG_HISTORY_SIZE; i++) {
-        int idx = _newestIdx - i;
-        while (idx < 0) idx += CHANNEL_MSG_HISTORY_SIZE;
-        idx = idx % CHANNEL_MSG_HISTORY_SIZE;
-        
-        if (msgMatchesView(_messages[idx])) {
-          channelMsgs[numChannelMsgs++] = idx;
-        }
-      }
-      
-      // Reverse to chronological order (oldest first, newest last at bottom)
-      for (int l = 0, r = numChannelMsgs - 1; l < r; l++, r--) {
-        int tmp = channelMsgs[l]; channelMsgs[l] = channelMsgs[r]; channelMsgs[r] = tmp;
-      }
+      // Messages for this channel, in chronological order (oldest first, newest last at bottom)
+      int numChannelMsgs;
+      const int16_t* channelMsgs = getViewMsgs(numChannelMsgs);
       
       // Cache for reply select input bounds
       _replyChannelMsgCount = numChannelMsgs;
@@ -1238,7 +1283,7 @@ public:
           #if defined(LilyGo_T5S3_EPaper_Pro)
           display.fillRect(0, y, contentW, maxFillH);
 #else
-          display.fillRect(0, y + the_mesh.getNodePrefs()->smallHighlightOff(), contentW, maxFillH);
+          display.fillRect(0, y + locked(the_mesh)->getNodePrefs()->smallHighlightOff(), contentW, maxFillH);
 #endif
         }
         
@@ -1264,7 +1309,7 @@ public:
           // The sentinels (0xFF direct-received, 0 locally-sent) do not encode it,
           // so fall back to this device's configured path hash size.
           int bphDisp = (msg->path_len == 0xFF || msg->path_len == 0)
-                          ? (the_mesh.getNodePrefs()->path_hash_mode + 1)
+                          ? (locked(the_mesh)->getNodePrefs()->path_hash_mode + 1)
                           : ((msg->path_len >> 6) + 1);
           if (age < 60) {
             sprintf(tmp, "(%dh)(%db) %ds ", hopsDisp, bphDisp, age);
@@ -1447,7 +1492,7 @@ public:
 #if defined(LilyGo_T5S3_EPaper_Pro)
             display.fillRect(0, y, contentW, maxFillH - usedH);
 #else
-            display.fillRect(0, y + the_mesh.getNodePrefs()->smallHighlightOff(), contentW, maxFillH - usedH);
+            display.fillRect(0, y + locked(the_mesh)->getNodePrefs()->smallHighlightOff(), contentW, maxFillH - usedH);
 #endif
           }
         }
@@ -1683,10 +1728,10 @@ public:
             _dmFilterName[0] = '\0';
             _dmContactIdx = -1;
             _dmContactPerms = 0;
-            uint32_t numC = the_mesh.getNumContacts();
+            uint32_t numC = locked(the_mesh)->getNumContacts();
             ContactInfo ci;
             for (uint32_t c2 = 0; c2 < numC; c2++) {
-              if (the_mesh.getContactByIdx(c2, ci) && peerHash(ci.name) == h) {
+              if (locked(the_mesh)->getContactByIdx(c2, ci) && peerHash(ci.name) == h) {
                 strncpy(_dmFilterName, ci.name, sizeof(_dmFilterName) - 1);
                 _dmFilterName[sizeof(_dmFilterName) - 1] = '\0';
                 _dmContactIdx = (int)c2;
@@ -1776,7 +1821,7 @@ public:
         // DM tab → go to last valid group channel
         for (uint8_t i = MAX_GROUP_CHANNELS - 1; i > 0; i--) {
           ChannelDetails ch;
-          if (the_mesh.getChannel(i, ch) && ch.name[0] != '\0') {
+          if (locked(the_mesh)->getChannel(i, ch) && ch.name[0] != '\0') {
             _viewChannelIdx = i;
             break;
           }
@@ -1787,7 +1832,7 @@ public:
         bool found = false;
         while (true) {
           ChannelDetails ch;
-          if (the_mesh.getChannel(prev, ch) && ch.name[0] != '\0') {
+          if (locked(the_mesh)->getChannel(prev, ch) && ch.name[0] != '\0') {
             _viewChannelIdx = prev;
             found = true;
             break;
@@ -1826,7 +1871,7 @@ public:
         bool found = false;
         for (uint8_t next = _viewChannelIdx + 1; next < MAX_GROUP_CHANNELS; next++) {
           ChannelDetails ch;
-          if (the_mesh.getChannel(next, ch) && ch.name[0] != '\0') {
+          if (locked(the_mesh)->getChannel(next, ch) && ch.name[0] != '\0') {
             _viewChannelIdx = next;
             found = true;
             break;
@@ -3,6 +3,8 @@
 #include <helpers/ui/UIScreen.h>
 #include <helpers/ui/DisplayDriver.h>
 #include <MeshCore.h>
+#include "../MeshTask.h"
+#include <algorithm>
 
 // Timestamps before this (Jan 1 2026 UTC) are treated as invalid/unsynced
 #define EPOCH_2026  1735689600UL
@@ -37,7 +39,7 @@ private:
   // We rebuild this on filter change or when entering the screen
   // Arrays allocated in PSRAM when available (supports 1000+ contacts)
   uint16_t* _filteredIdx;    // indices into contact table
-  uint32_t* _filteredTs;     // cached lastmod for sorting
+  uint32_t* _sortTs;         // cached lastmod for sorting, by raw contact index
   int _filteredCount;                  // how many contacts match current filter
   AdvertPath _hopBuf[40];    // recently heard advert paths for hop-count display
   int _hopBufCount;
@@ -92,35 +94,27 @@ private:
 
   void rebuildCache() {
     _filteredCount = 0;
-    uint32_t numContacts = the_mesh.getNumContacts();
+    uint32_t numContacts = locked(the_mesh)->getNumContacts();
     ContactInfo contact;
     for (uint32_t i = 0; i < numContacts && _filteredCount < MAX_CONTACTS; i++) {
-      if (the_mesh.getContactByIdx(i, contact)) {
+      if (locked(the_mesh)->getContactByIdx(i, contact)) {
         if (matchesFilter(contact.type, contact.flags)) {
-          _filteredIdx[_filteredCount] = (uint16_t)i;
+          _filteredIdx[_filteredCount++] = (uint16_t)i;
           // Use lastmod (our receive time) for sort/age; pre-2026 or zero → 0 sinks to bottom
-          _filteredTs[_filteredCount] = (contact.lastmod >= EPOCH_2026) ? contact.lastmod : 0;
-          _filteredCount++;
+          _sortTs[i] = (contact.lastmod >= EPOCH_2026) ? contact.lastmod : 0;
         }
       }
     }
-    // Sort by lastmod descending (most recently heard first; pre-2026/unsynced sink to bottom)
-    // Insertion sort — fine for up to ~1000 entries on ESP32
-    for (int i = 1; i < _filteredCount; i++) {
-      uint16_t tmpIdx = _filteredIdx[i];
-      uint32_t tmpTs  = _filteredTs[i];
-      int j = i - 1;
-      while (j >= 0 && _filteredTs[j] < tmpTs) {
-        _filteredIdx[j + 1] = _filteredIdx[j];
-        _filteredTs[j + 1]  = _filteredTs[j];
-        j--;
-      }
-      _filteredIdx[j + 1] = tmpIdx;
-      _filteredTs[j + 1]  = tmpTs;
-    }
+    // Sort by lastmod descending (most recently heard first; pre-2026/unsynced sink to bottom).
+    // Ties keep contact table order, same as the old (stable) insertion sort, but O(n log n)
+    // so thousands of contacts don't stall the UI on every filter change.
+    const uint32_t* ts = _sortTs;
+    std::sort(_filteredIdx, _filteredIdx + _filteredCount, [ts](uint16_t a, uint16_t b) {
+      return ts[a] != ts[b] ? ts[a] > ts[b] : a < b;
+    });
     _cacheValid = true;
     // Refresh hop-count cache from the 12 most recently heard adverts
-    _hopBufCount = the_mesh.getRecentlyHeard(_hopBuf, 40);
+    _hopBufCount = locked(the_mesh)->getRecentlyHeard(_hopBuf, 40);
     // Clamp scroll position
     if (_scrollPos >= _filteredCount) {
       _scrollPos = (_filteredCount > 0) ? _filteredCount - 1 : 0;
@@ -163,11 +157,11 @@ public:
       _selectMode(false), _hopBufCount(0) {
   #if defined(ESP32) && defined(BOARD_HAS_PSRAM)
     _filteredIdx = (uint16_t*)ps_calloc(MAX_CONTACTS, sizeof(uint16_t));
-    _filteredTs = (uint32_t*)ps_calloc(MAX_CONTACTS, sizeof(uint32_t));
+    _sortTs = (uint32_t*)ps_calloc(MAX_CONTACTS, sizeof(uint32_t));
     _selectedBits = (uint8_t*)ps_calloc((MAX_CONTACTS + 7) / 8, 1);
   #else
     _filteredIdx = new uint16_t[MAX_CONTACTS]();
-    _filteredTs = new uint32_t[MAX_CONTACTS]();
+    _sortTs = new uint32_t[MAX_CONTACTS]();
     _selectedBits = new uint8_t[(MAX_CONTACTS + 7) / 8]();
   #endif
   }
@@ -240,11 +234,11 @@ public:
   // Returns: 0=miss, 1=moved, 2=tapped current row.
   int selectRowAtVY(int vy) {
     if (_filteredCount == 0) return 0;
-    const int headerH = 14, footerH = 14, lineH = the_mesh.getNodePrefs()->smallLineH();
+    const int headerH = 14, footerH = 14, lineH = locked(the_mesh)->getNodePrefs()->smallLineH();
 #if defined(LilyGo_T5S3_EPaper_Pro)
     const int bodyTop = headerH;
 #else
-    const int bodyTop = headerH + the_mesh.getNodePrefs()->smallHighlightOff();
+    const int bodyTop = headerH + locked(the_mesh)->getNodePrefs()->smallHighlightOff();
 #endif
     if (vy < bodyTop || vy >= 128 - footerH) return 0;
 
@@ -273,7 +267,7 @@ public:
   uint8_t getSelectedContactType() const {
     if (_filteredCount == 0) return 0xFF;
     ContactInfo contact;
-    if (!the_mesh.getContactByIdx(_filteredIdx[_scrollPos], contact)) return 0xFF;
+    if (!locked(the_mesh)->getContactByIdx(_filteredIdx[_scrollPos], contact)) return 0xFF;
     return contact.type;
   }
 
@@ -282,7 +276,7 @@ public:
   bool getSelectedContactName(char* buf, size_t bufLen) const {
     if (_filteredCount == 0) return false;
     ContactInfo contact;
-    if (!the_mesh.getContactByIdx(_filteredIdx[_scrollPos], contact)) return false;
+    if (!locked(the_mesh)->getContactByIdx(_filteredIdx[_scrollPos], contact)) return false;
     strncpy(buf, contact.name, bufLen);
     buf[bufLen - 1] = '\0';
     return true;
@@ -307,9 +301,9 @@ public:
 
     // Count on right: All → total/max, filtered → matched/total
     if (_filter == FILTER_ALL) {
-      snprintf(tmp, sizeof(tmp), "%d/%d", (int)the_mesh.getNumContacts(), MAX_CONTACTS);
+      snprintf(tmp, sizeof(tmp), "%d/%d", (int)locked(the_mesh)->getNumContacts(), MAX_CONTACTS);
     } else {
-      snprintf(tmp, sizeof(tmp), "%d/%d", _filteredCount, (int)the_mesh.getNumContacts());
+      snprintf(tmp, sizeof(tmp), "%d/%d", _filteredCount, (int)locked(the_mesh)->getNumContacts());
     }
     display.setCursor(display.width() - display.getTextWidth(tmp) - 2, 0);
     display.print(tmp);
@@ -318,8 +312,8 @@ public:
     display.drawRect(0, 11, display.width(), 1);
 
     // === Body - contact rows ===
-    display.setTextSize(the_mesh.getNodePrefs()->smallTextSize());  // tiny font for compact rows
-    int lineHeight = the_mesh.getNodePrefs()->smallLineH();      // 8px font + 1px gap
+    display.setTextSize(locked(the_mesh)->getNodePrefs()->smallTextSize());  // tiny font for compact rows
+    int lineHeight = locked(the_mesh)->getNodePrefs()->smallLineH();      // 8px font + 1px gap
     int headerHeight = 14;
     int footerHeight = 14;
     int maxY = display.height() - footerHeight;
@@ -348,7 +342,7 @@ public:
 
       for (int i = startIdx; i < endIdx && y + lineHeight <= maxY; i++) {
         ContactInfo contact;
-        if (!the_mesh.getContactByIdx(_filteredIdx[i], contact)) continue;
+        if (!locked(the_mesh)->getContactByIdx(_filteredIdx[i], contact)) continue;
 
         bool selected = (i == _scrollPos);
         bool sel = _selectMode && isSelectedRaw(_filteredIdx[i]);
@@ -359,7 +353,7 @@ public:
 #if defined(LilyGo_T5S3_EPaper_Pro)
           display.fillRect(0, y, display.width(), lineHeight);
 #else
-          display.fillRect(0, y + the_mesh.getNodePrefs()->smallHighlightOff(), display.width(), lineHeight);
+          display.fillRect(0, y + locked(the_mesh)->getNodePrefs()->smallHighlightOff(), display.width(), lineHeight);
 #endif
           display.setColor(DisplayDriver::DARK);
         } else {
@@ -497,7 +491,7 @@ public:
   bool handleInput(char c) override {
     // Shift+W: page up
     if (c == 'W') {
-      int pageSize = (128 - 14 - 14) / the_mesh.getNodePrefs()->smallLineH();
+      int pageSize = (128 - 14 - 14) / locked(the_mesh)->getNodePrefs()->smallLineH();
       if (pageSize < 3) pageSize = 3;
       _scrollPos = max(0, _scrollPos - pageSize);
       return true;
@@ -512,7 +506,7 @@ public:
 
     // Shift+S: page down
     if (c == 'S') {
-      int pageSize = (128 - 14 - 14) / the_mesh.getNodePrefs()->smallLineH();
+      int pageSize = (128 - 14 - 14) / locked(the_mesh)->getNodePrefs()->smallLineH();
       if (pageSize < 3) pageSize = 3;
       _scrollPos = min(_filteredCount - 1, _scrollPos + pageSize);
       return true;
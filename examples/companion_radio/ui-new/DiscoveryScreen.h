@@ -4,6 +4,7 @@
 #include <helpers/ui/DisplayDriver.h>
 #include <helpers/AdvertDataHelpers.h>
 #include <MeshCore.h>
+#include "../MeshTask.h"
 
 // Forward declarations
 class UITask;
@@ -47,13 +48,13 @@ public:
   // Tap-to-select: given virtual Y, select discovered node row.
   // Returns: 0=miss, 1=moved, 2=tapped current row.
   int selectRowAtVY(int vy) {
-    int count = the_mesh.getDiscoveredCount();
+    int count = locked(the_mesh)->getDiscoveredCount();
     if (count == 0) return 0;
-    const int headerH = 14, footerH = 14, lineH = the_mesh.getNodePrefs()->smallLineH();
+    const int headerH = 14, footerH = 14, lineH = locked(the_mesh)->getNodePrefs()->smallLineH();
 #if defined(LilyGo_T5S3_EPaper_Pro)
     const int bodyTop = headerH;
 #else
-    const int bodyTop = headerH + the_mesh.getNodePrefs()->smallHighlightOff();
+    const int bodyTop = headerH + locked(the_mesh)->getNodePrefs()->smallHighlightOff();
 #endif
     if (vy < bodyTop || vy >= 128 - footerH) return 0;
 
@@ -71,8 +72,8 @@ public:
   }
 
   int render(DisplayDriver& display) override {
-    int count = the_mesh.getDiscoveredCount();
-    bool active = the_mesh.isDiscoveryActive();
+    int count = locked(the_mesh)->getDiscoveredCount();
+    bool active = locked(the_mesh)->isDiscoveryActive();
 
     // === Header ===
     display.setTextSize(1);
@@ -91,8 +92,8 @@ public:
     display.drawRect(0, 11, display.width(), 1);
 
     // === Body — discovered node rows ===
-    display.setTextSize(the_mesh.getNodePrefs()->smallTextSize());  // tiny font for compact rows
-    int lineHeight = the_mesh.getNodePrefs()->smallLineH();
+    display.setTextSize(locked(the_mesh)->getNodePrefs()->smallTextSize());  // tiny font for compact rows
+    int lineHeight = locked(the_mesh)->getNodePrefs()->smallLineH();
     int headerHeight = 14;
     int footerHeight = 14;
     int maxY = display.height() - footerHeight;
@@ -120,7 +121,7 @@ public:
       int endIdx = min(count, startIdx + maxVisible);
 
       for (int i = startIdx; i < endIdx && y + lineHeight <= maxY; i++) {
-        const DiscoveredNode& node = the_mesh.getDiscovered(i);
+        DiscoveredNode node = locked(the_mesh)->getDiscovered(i);   // copy, list is updated by mesh task
         bool selected = (i == _scrollPos);
 
         // Highlight selected row
@@ -129,7 +130,7 @@ public:
 #if defined(LilyGo_T5S3_EPaper_Pro)
           display.fillRect(0, y, display.width(), lineHeight);
 #else
-          display.fillRect(0, y + the_mesh.getNodePrefs()->smallHighlightOff(), display.width(), lineHeight);
+          display.fillRect(0, y + locked(the_mesh)->getNodePrefs()->smallHighlightOff(), display.width(), lineHeight);
 #endif
           display.setColor(DisplayDriver::DARK);
         } else {
@@ -215,11 +216,11 @@ public:
   }
 
   bool handleInput(char c) override {
-    int count = the_mesh.getDiscoveredCount();
+    int count = locked(the_mesh)->getDiscoveredCount();
 
     // Shift+W: page up
     if (c == 'W') {
-      int pageSize = (128 - 14 - 14) / the_mesh.getNodePrefs()->smallLineH();
+      int pageSize = (128 - 14 - 14) / locked(the_mesh)->getNodePrefs()->smallLineH();
       if (pageSize < 3) pageSize = 3;
       _scrollPos = max(0, _scrollPos - pageSize);
       return true;
@@ -234,7 +235,7 @@ public:
 
     // Shift+S: page down
     if (c == 'S') {
-      int pageSize = (128 - 14 - 14) / the_mesh.getNodePrefs()->smallLineH();
+      int pageSize = (128 - 14 - 14) / locked(the_mesh)->getNodePrefs()->smallLineH();
       if (pageSize < 3) pageSize = 3;
       _scrollPos = min(count - 1, _scrollPos + pageSize);
       return true;
@@ -249,7 +250,7 @@ public:
 
     // F - rescan (handled here as well as in main.cpp for consistency)
     if (c == 'f') {
-      the_mesh.startDiscovery();
+      locked(the_mesh)->startDiscovery();
       _scrollPos = 0;
       return true;
     }
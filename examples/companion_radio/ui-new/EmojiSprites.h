@@ -897,6 +897,22 @@ static inline const uint8_t* getEmojiSpriteSm(uint8_t escape_byte) {
   return (const uint8_t*)pgm_read_ptr(&EMOJI_SPRITES_SM[escape_byte - EMOJI_ESCAPE_START]);
 }
 
+// Sprite for a single code point (display driver glyph fallback, for text that
+// didn't go through emojiSanitize, eg. contact names). Two-codepoint emoji
+// (flags etc.) only match via their escape byte, so aren't found here.
+static const uint8_t* getEmojiSpriteForCodepoint(uint32_t cp, uint8_t& w, uint8_t& h) {
+  if (cp < 0x80) return nullptr;
+  w = EMOJI_SM_W;
+  h = EMOJI_SM_H;
+  for (int e = 0; e < EMOJI_COUNT; e++) {
+    if (EMOJI_CODEPOINTS[e].cp == cp && EMOJI_CODEPOINTS[e].cp2 == 0) return getEmojiSpriteSm(EMOJI_CODEPOINTS[e].escape);
+  }
+  for (int a = 0; a < EMOJI_ALIAS_COUNT; a++) {
+    if (EMOJI_ALIASES[a].cp == cp) return getEmojiSpriteSm(EMOJI_ALIASES[a].escape);
+  }
+  return nullptr;
+}
+
 static inline int emojiUtf8Cost(uint8_t escape_byte) {
   if (!isEmojiEscape(escape_byte)) return 1;
   int idx = escape_byte - EMOJI_ESCAPE_START;
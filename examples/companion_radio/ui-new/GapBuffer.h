@@ -0,0 +1,138 @@
+#pragma once
+
+#include <Arduino.h>
+#include <SD.h>
+
+// ============================================================================
+// GapBuffer - text storage for the notes editor
+// ============================================================================
+// Text lives in one block with a gap at the edit point:
+//
+//   [ text before gap | ...gap... | text after gap ]
+//
+// Typing at the cursor fills the gap and backspace widens it, so keystrokes
+// cost O(1) no matter how long the note is. Moving the edit point moves the
+// gap (a memmove of the distance moved, usually a few bytes). When the gap
+// is used up the block doubles, up to the max size. Byte i of the text is
+// at(i); nothing needs the text to be contiguous, files are read straight
+// into the gap and written from the two halves.
+// ============================================================================
+
+class GapBuffer {
+  char* _data;
+  int _cap;
+  int _maxCap;
+  int _gapStart;
+  int _gapEnd;
+
+  static char* allocBlock(int sz) {
+  #ifdef BOARD_HAS_PSRAM
+    return (char*)ps_malloc(sz);
+  #else
+    return (char*)malloc(sz);
+  #endif
+  }
+
+  void moveGap(int pos) {
+    if (pos < _gapStart) {
+      int n = _gapStart - pos;
+      memmove(&_data[_gapEnd - n], &_data[pos], n);
+      _gapStart -= n;
+      _gapEnd -= n;
+    } else if (pos > _gapStart) {
+      int n = pos - _gapStart;
+      memmove(&_data[_gapStart], &_data[_gapEnd], n);
+      _gapStart += n;
+      _gapEnd += n;
+    }
+  }
+
+  // Make room for at least 'need' more bytes in the gap
+  bool grow(int need) {
+    if (_gapEnd - _gapStart >= need) return true;
+    int newCap = _cap;
+    while (newCap - length() < need && newCap < _maxCap) newCap *= 2;
+    if (newCap > _maxCap) newCap = _maxCap;
+    if (newCap - length() < need) return false;
+
+    char* nd = allocBlock(newCap);
+    if (!nd) return false;
+    int tail = _cap - _gapEnd;
+    memcpy(nd, _data, _gapStart);
+    memcpy(&nd[newCap - tail], &_data[_gapEnd], tail);
+    free(_data);
+    _data = nd;
+    _gapEnd = newCap - tail;
+    _cap = newCap;
+    return true;
+  }
+
+public:
+  GapBuffer() : _data(nullptr), _cap(0), _maxCap(0), _gapStart(0), _gapEnd(0) {}
+  ~GapBuffer() { if (_data) free(_data); }
+
+  bool begin(int initialCap, int maxCap) {
+    _data = allocBlock(initialCap);
+    if (!_data) return false;
+    _cap = initialCap;
+    _maxCap = maxCap;
+    clear();
+    return true;
+  }
+
+  bool isValid() const { return _data != nullptr; }
+  int length() const { return _cap - (_gapEnd - _gapStart); }
+  int maxLength() const { return _maxCap - 1; }
+
+  char at(int i) const {
+    return i < _gapStart ? _data[i] : _data[i + (_gapEnd - _gapStart)];
+  }
+
+  void clear() {
+    _gapStart = 0;
+    _gapEnd = _cap;
+  }
+
+  bool insert(int pos, char c) {
+    if (length() >= maxLength() || !grow(1)) return false;
+    moveGap(pos);
+    _data[_gapStart++] = c;
+    return true;
+  }
+
+  // Remove the byte at pos
+  void erase(int pos) {
+    if (pos < 0 || pos >= length()) return;
+    moveGap(pos);
+    _gapEnd++;
+  }
+
+  // Copy [start, end) out into dst (no terminator), returns bytes copied
+  int copy(int start, int end, char* dst) const {
+    int n = 0;
+    for (int i = start; i < end; i++) dst[n++] = at(i);
+    return n;
+  }
+
+  // Replace contents with up to maxLength() bytes of file, read in chunks
+  // straight into the gap. Returns false if the file didn't fit.
+  bool load(File& file) {
+    clear();
+    const int CHUNK = 4096;
+    while (file.available()) {
+      if (!grow(CHUNK) && _gapEnd - _gapStart <= 1) return false;
+      int room = _gapEnd - _gapStart - 1;   // keep maxLength() semantics
+      int n = file.read((uint8_t*)&_data[_gapStart], room < CHUNK ? room : CHUNK);
+      if (n <= 0) break;
+      _gapStart += n;
+      if (length() >= maxLength()) return !file.available();
+    }
+    return true;
+  }
+
+  size_t save(File& file) const {
+    size_t n = file.write((const uint8_t*)_data, _gapStart);
+    n += file.write((const uint8_t*)&_data[_gapEnd], _cap - _gapEnd);
+    return n;
+  }
+};
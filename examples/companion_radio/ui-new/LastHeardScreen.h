@@ -4,6 +4,7 @@
 #include <helpers/ui/DisplayDriver.h>
 #include <helpers/AdvertDataHelpers.h>
 #include <MeshCore.h>
+#include "../MeshTask.h"
 
 extern MyMesh the_mesh;
 
@@ -60,7 +61,7 @@ public:
   // Check if selected node is already in contacts
   bool isSelectedInContacts() const {
     if (_scrollPos < 0 || _scrollPos >= _count) return false;
-    return the_mesh.lookupContactByPubKey(_entries[_scrollPos].pubkey_prefix, 8) != nullptr;
+    return locked(the_mesh)->lookupContactByPubKey(_entries[_scrollPos].pubkey_prefix, 8) != nullptr;
   }
 
   // Get selected entry (for add/delete operations)
@@ -73,11 +74,11 @@ public:
   // Returns: 0=miss, 1=moved, 2=tapped current row.
   int selectRowAtVY(int vy) {
     if (_count == 0) return 0;
-    const int headerH = 14, footerH = 14, lineH = the_mesh.getNodePrefs()->smallLineH();
+    const int headerH = 14, footerH = 14, lineH = locked(the_mesh)->getNodePrefs()->smallLineH();
 #if defined(LilyGo_T5S3_EPaper_Pro)
     const int bodyTop = headerH;
 #else
-    const int bodyTop = headerH + the_mesh.getNodePrefs()->smallHighlightOff();
+    const int bodyTop = headerH + locked(the_mesh)->getNodePrefs()->smallHighlightOff();
 #endif
     if (vy < bodyTop || vy >= 128 - footerH) return 0;
 
@@ -96,7 +97,7 @@ public:
 
   int render(DisplayDriver& display) override {
     // Refresh sorted list from mesh
-    _count = the_mesh.getRecentlyHeard(_entries, LAST_HEARD_DISPLAY_SIZE);
+    _count = locked(the_mesh)->getRecentlyHeard(_entries, LAST_HEARD_DISPLAY_SIZE);
 
     // Filter out empty entries (recv_timestamp == 0)
     int validCount = 0;
@@ -122,8 +123,8 @@ public:
     display.drawRect(0, 11, display.width(), 1);
 
     // === Body — node rows ===
-    display.setTextSize(the_mesh.getNodePrefs()->smallTextSize());
-    int lineHeight = the_mesh.getNodePrefs()->smallLineH();
+    display.setTextSize(locked(the_mesh)->getNodePrefs()->smallTextSize());
+    int lineHeight = locked(the_mesh)->getNodePrefs()->smallLineH();
     int headerHeight = 14;
     int footerHeight = 14;
     int maxY = display.height() - footerHeight;
@@ -152,7 +153,7 @@ public:
 #if defined(LilyGo_T5S3_EPaper_Pro)
           display.fillRect(0, y, display.width(), lineHeight);
 #else
-          display.fillRect(0, y + the_mesh.getNodePrefs()->smallHighlightOff(), display.width(), lineHeight);
+          display.fillRect(0, y + locked(the_mesh)->getNodePrefs()->smallHighlightOff(), display.width(), lineHeight);
 #endif
           display.setColor(DisplayDriver::DARK);
         } else {
@@ -172,9 +173,13 @@ public:
         char ageBuf[8];
         formatAge(now, entry.recv_timestamp, ageBuf, sizeof(ageBuf));
 
-        ContactInfo* ci = the_mesh.lookupContactByPubKey(entry.pubkey_prefix, 8);
-        bool inContacts = (ci != nullptr);
-        bool isFav = inContacts && (ci->flags & 0x01);
+        bool inContacts, isFav;
+        {
+          MeshLock lock;
+          ContactInfo* ci = the_mesh.lookupContactByPubKey(entry.pubkey_prefix, 8);
+          inContacts = (ci != nullptr);
+          isFav = inContacts && (ci->flags & 0x01);
+        }
         if (isFav) {
           snprintf(rightStr, sizeof(rightStr), "%s %dh [*]", ageBuf, entry.path_len & 63);
         } else if (inContacts) {
@@ -225,7 +230,7 @@ public:
   bool handleInput(char c) override {
     // Shift+W: page up
     if (c == 'W') {
-      int pageSize = (128 - 14 - 14) / the_mesh.getNodePrefs()->smallLineH();
+      int pageSize = (128 - 14 - 14) / locked(the_mesh)->getNodePrefs()->smallLineH();
       if (pageSize < 3) pageSize = 3;
       _scrollPos = max(0, _scrollPos - pageSize);
       return true;
@@ -238,7 +243,7 @@ public:
 
     // Shift+S: page down
     if (c == 'S') {
-      int pageSize = (128 - 14 - 14) / the_mesh.getNodePrefs()->smallLineH();
+      int pageSize = (128 - 14 - 14) / locked(the_mesh)->getNodePrefs()->smallLineH();
       if (pageSize < 3) pageSize = 3;
       _scrollPos = min(_count - 1, _scrollPos + pageSize);
       return true;
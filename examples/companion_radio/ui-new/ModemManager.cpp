@@ -46,7 +46,12 @@ void ModemManager::begin() {
   _tonesTransferred = false;
   _notifTonePlaying = false;
   _notifToneStartTime = 0;
-  _urcPos = 0;
+  _smsPollDue = false;
+  _smsListPending = false;
+  _cmglIdx = -1;
+  _numSmsDelete = 0;
+  _csqPending = false;
+  _csqPollDue = false;
   _imei[0] = '\0';
   _imsi[0] = '\0';
   _apn[0] = '\0';
@@ -57,7 +62,8 @@ void ModemManager::begin() {
   _recvQueue   = xQueueCreate(MODEM_RECV_QUEUE_SIZE, sizeof(SMSIncoming));
   _callCmdQueue = xQueueCreate(MODEM_CALL_CMD_QUEUE_SIZE, sizeof(CallCommand));
   _callEvtQueue = xQueueCreate(MODEM_CALL_EVT_QUEUE_SIZE, sizeof(CallEvent));
-  _uartMutex   = xSemaphoreCreateMutex();
+
+  registerURCs();
 
   // Launch background task on Core 0
   xTaskCreatePinnedToCore(
@@ -91,11 +97,13 @@ void ModemManager::shutdown() {
     vTaskDelay(pdMS_TO_TICKS(2000));  // Give time for AT+CHUP
   }
 
+  // Stop the task first, so this thread has the UART to itself
+  vTaskDelete(_taskHandle);
+  _taskHandle = nullptr;
+  _at.reset();   // drop whatever the task had in flight
+
   // Tell modem to power off gracefully
-  if (xSemaphoreTake(_uartMutex, pdMS_TO_TICKS(2000))) {
-    sendAT("AT+CPOF", "OK", 5000);
-    xSemaphoreGive(_uartMutex);
-  }
+  sendAT("AT+CPOF", "OK", 5000);
 
   // Cut modem power
 #if defined(LilyGo_TDeck_Pro_Max)
@@ -104,9 +112,6 @@ void ModemManager::shutdown() {
   digitalWrite(MODEM_POWER_EN, LOW);
 #endif
 
-  // Delete task
-  vTaskDelete(_taskHandle);
-  _taskHandle = nullptr;
   _state = ModemState::OFF;
 }
 
@@ -394,35 +399,47 @@ void ModemManager::resolveAPN() {
 //   BUSY                        -- outgoing call busy
 //   NO ANSWER                   -- outgoing call no answer
 //   +CMTI: "SM",<idx>          -- new SMS arrived
+//   +CREG: <stat>               -- registration changed (after AT+CREG=1)
 //   +AUDIOSTATE: audio play stop -- notification tone finished
 //
-// drainURCs() accumulates bytes into a line buffer and calls
-// processURCLine() for each complete line.
+// The ATChannel hands each of these to its subscriber as soon as the line
+// is complete, including while a command is waiting for its response.
 // ---------------------------------------------------------------------------
 
-void ModemManager::drainURCs() {
-  while (MODEM_SERIAL.available()) {
-    char c = MODEM_SERIAL.read();
+void ModemManager::registerURCs() {
+  if (_urcsRegistered) return;
+  _at.subscribe("RING",         onCallURC, this);
+  _at.subscribe("+CLIP:",       onCallURC, this);
+  _at.subscribe("NO CARRIER",   onCallURC, this);
+  _at.subscribe("BUSY",         onCallURC, this);
+  _at.subscribe("NO ANSWER",    onCallURC, this);
+  _at.subscribe("VOICE CALL:",  onCallURC, this);
+  _at.subscribe("+AUDIOSTATE:", onCallURC, this);
+  _at.subscribe("+CMTI:",       onSMSURC, this);
+  _at.subscribe("+CREG:",       onNetworkURC, this);
+  _urcsRegistered = true;
+}
 
-    // Accumulate into line buffer
-    if (c == '\n') {
-      // End of line -- process if non-empty
-      if (_urcPos > 0) {
-        // Trim trailing \r
-        while (_urcPos > 0 && _urcBuf[_urcPos - 1] == '\r') _urcPos--;
-        _urcBuf[_urcPos] = '\0';
+void ModemManager::onCallURC(void* ctx, const char* line) {
+  static_cast<ModemManager*>(ctx)->processURCLine(line);
+}
 
-        if (_urcPos > 0) {
-          processURCLine(_urcBuf);
-        }
-      }
-      _urcPos = 0;
-    } else if (c != '\r' || _urcPos > 0) {
-      // Accumulate (skip leading \r)
-      if (_urcPos < URC_BUF_SIZE - 1) {
-        _urcBuf[_urcPos++] = c;
-      }
-    }
+// +CMTI: "SM",<index> -- list unread messages now instead of at the next poll
+void ModemManager::onSMSURC(void* ctx, const char* line) {
+  MESH_DEBUG_PRINTLN("[Modem] URC: CMTI (new SMS)");
+  static_cast<ModemManager*>(ctx)->_smsPollDue = true;
+}
+
+// +CREG: <stat> -- 1 = home, 5 = roaming, anything else = no service
+void ModemManager::onNetworkURC(void* ctx, const char* line) {
+  ModemManager* self = static_cast<ModemManager*>(ctx);
+  int stat;
+  if (sscanf(line, "+CREG: %d", &stat) != 1) return;
+  MESH_DEBUG_PRINTLN("[Modem] URC: CREG stat=%d", stat);
+  if (stat == 1 || stat == 5) {
+    self->_csqPollDue = true;   // back on the network, refresh the bars
+  } else {
+    self->_csq = 99;            // show no signal until re-registered
   }
 }
 
@@ -507,16 +524,6 @@ void ModemManager::processURCLine(const char* line) {
     return;
   }
 
-  // --- +CMTI: new SMS indication ---
-  // +CMTI: "SM",<index>
-  // We don't need to act on this immediately since we poll for SMS,
-  // but we can trigger an early poll
-  if (strncmp(line, "+CMTI:", 6) == 0) {
-    MESH_DEBUG_PRINTLN("[Modem] URC: CMTI (new SMS)");
-    // Next SMS poll will pick it up; we just log it
-    return;
-  }
-
   // --- VOICE CALL: BEGIN -- A76xx-specific: audio path established ---
   if (strncmp(line, "VOICE CALL: BEGIN", 17) == 0) {
     MESH_DEBUG_PRINTLN("[Modem] URC: VOICE CALL: BEGIN");
@@ -788,79 +795,27 @@ bool ModemManager::transferTonesToModem() {
     // Small gap to let modem settle between delete and write
     vTaskDelay(pdMS_TO_TICKS(100));
 
-    // Drain any stale UART data before transfer
-    while (MODEM_SERIAL.available()) MODEM_SERIAL.read();
-
     // Transfer file via AT+CFTRANRX="path",<size>
-    // Modem responds with CONNECT, then expects <size> bytes of binary data,
-    // then responds with OK.
+    // Modem responds with CONNECT (or '>'), then expects <size> bytes of
+    // binary data, then responds with OK.
     char txCmd[80];
     snprintf(txCmd, sizeof(txCmd), "AT+CFTRANRX=\"%s\",%d", modemPath, (int)tone.size);
     MESH_DEBUG_PRINTLN("[Modem] Tone %d/%d: %s (%d bytes) -- sending...",
                        i + 1, MODEM_BUNDLED_TONE_COUNT, tone.filename, (int)tone.size);
 
-    Serial.printf("[Modem] TX: %s\n", txCmd);
-    MODEM_SERIAL.println(txCmd);
-
-    // Wait for CONNECT prompt (case-insensitive, also check for ">")
-    unsigned long start = millis();
-    bool gotPrompt = false;
-    bool gotError = false;
-    char promptBuf[128];
-    int ppos = 0;
-    while (millis() - start < 8000) {
-      while (MODEM_SERIAL.available()) {
-        char c = MODEM_SERIAL.read();
-        if (ppos < 127) { promptBuf[ppos++] = c; promptBuf[ppos] = '\0'; }
-        // Check for any known data-ready prompts
-        if (strstr(promptBuf, "CONNECT") || strstr(promptBuf, "connect") ||
-            c == '>') {
-          gotPrompt = true;
-          break;
-        }
-        if (strstr(promptBuf, "ERROR")) { gotError = true; break; }
-      }
-      if (gotPrompt || gotError) break;
-      vTaskDelay(pdMS_TO_TICKS(10));
-    }
-
-    if (!gotPrompt) {
-      // Log whatever we DID receive for debugging
-      MESH_DEBUG_PRINTLN("[Modem] Tone %d: no CONNECT/> prompt (got: [%s])",
-                         i + 1, ppos > 0 ? promptBuf : "TIMEOUT");
-      // Drain UART and recover
-      vTaskDelay(pdMS_TO_TICKS(1000));
-      while (MODEM_SERIAL.available()) MODEM_SERIAL.read();
-      continue;
-    }
-
-    MESH_DEBUG_PRINTLN("[Modem] Tone %d: got prompt, sending %d bytes...", i + 1, (int)tone.size);
-
-    // Send the binary WAV data from PROGMEM in chunks
-    const uint8_t* src = tone.data;
-    size_t remaining = tone.size;
-    const size_t CHUNK_SIZE = 256;
-
-    while (remaining > 0) {
-      size_t chunk = (remaining > CHUNK_SIZE) ? CHUNK_SIZE : remaining;
-      uint8_t buf[CHUNK_SIZE];
-      memcpy_P(buf, src, chunk);
-      MODEM_SERIAL.write(buf, chunk);
-      src += chunk;
-      remaining -= chunk;
-      // Brief yield to avoid starving other tasks during large transfers
-      if (remaining > 0) vTaskDelay(pdMS_TO_TICKS(5));
-    }
-
-    // Wait for OK response after transfer completes
-    if (waitResponse("OK", 15000, _atBuf, AT_BUF_SIZE)) {
+    ATRequest req;
+    req.cmd = txCmd;
+    req.timeout = 30000;         // 8s for the prompt, ~5s on the wire, 15s to store
+    req.payload = tone.data;     // flash is memory-mapped on ESP32, written as-is
+    req.payload_len = tone.size;
+    if (_at.exec(req, _atBuf, AT_BUF_SIZE) == AT_OK) {
       MESH_DEBUG_PRINTLN("[Modem] Tone %d: %s transferred OK", i + 1, tone.filename);
       successCount++;
     } else {
       MESH_DEBUG_PRINTLN("[Modem] Tone %d: %s transfer FAILED: %s", i + 1, tone.filename, _atBuf);
-      // Drain UART to recover modem state
+      // Let the modem drop out of data mode, then discard what it sent meanwhile
       vTaskDelay(pdMS_TO_TICKS(1000));
-      while (MODEM_SERIAL.available()) MODEM_SERIAL.read();
+      _at.reset();
     }
 
     // Delay between transfers to let modem flush to storage
@@ -1050,6 +1005,9 @@ restart:
     MESH_DEBUG_PRINTLN("[Modem] registration timeout - continuing anyway");
   }
 
+  // From here on, report registration changes as +CREG: <stat> URCs
+  sendAT("AT+CREG=1", "OK");
+
   // Query operator name
   // AT+COPS=3,0 sets the format to "long alphanumeric" so AT+COPS?
   // returns "Optus" instead of "50502"
@@ -1156,11 +1114,13 @@ restart:
 
   while (true) {
     // ================================================================
-    // Step 1: Drain URCs -- catch RING, NO CARRIER, +CLIP, +AUDIOSTATE
+    // Step 1: Poll the AT channel -- routes RING, NO CARRIER, +CLIP,
+    // +AUDIOSTATE, +CMTI, +CREG to their handlers and completes any
+    // queued SMS / signal commands.
     // This must run every iteration to avoid missing time-sensitive
     // events like incoming calls or call-ended notifications.
     // ================================================================
-    drainURCs();
+    _at.poll();
 
     // ================================================================
     // Step 1b: Ringtone -- play tone bursts while incoming call rings
@@ -1175,8 +1135,10 @@ restart:
     // ================================================================
     // Step 2: Process call commands from main loop
     // ================================================================
+    // Held while an SMS is going out, as the modem can't take ATD mid-CMGS
     CallCommand callCmd;
-    if (xQueueReceive(_callCmdQueue, &callCmd, 0) == pdTRUE) {
+    if (_state != ModemState::SENDING_SMS &&
+        xQueueReceive(_callCmdQueue, &callCmd, 0) == pdTRUE) {
       switch (callCmd.cmd) {
         case CallCmd::DIAL:
           if (_state == ModemState::READY) {
@@ -1214,7 +1176,7 @@ restart:
     // ================================================================
     // Step 3: Poll AT+CLCC during DIALING as fallback.
     // Primary detection is via "VOICE CALL: BEGIN" URC (handled by
-    // drainURCs/processURCLine above). CLCC polling is a safety net
+    // the AT channel / processURCLine above). CLCC polling is a safety net
     // in case the URC is missed or delayed.
     // Skip when paused to avoid Core 0 contention with WiFi TLS.
     // ================================================================
@@ -1242,7 +1204,7 @@ restart:
           // No +CLCC line in response -- no active calls
           // This shouldn't happen during DIALING unless the call ended
           // and we missed the URC. Check state and clean up.
-          // (NO CARRIER URC should have been caught by drainURCs)
+          // (NO CARRIER URC should have been caught by _at.poll())
         }
       }
       lastCLCCPoll = millis();
@@ -1251,37 +1213,46 @@ restart:
     // ================================================================
     // Step 4: SMS and signal polling (only when not in a call)
     // Skip when paused to avoid Core 0 contention with WiFi/TLS.
-    // The modem task's sendAT() calls (AT+CMGL 5s, AT+CSQ 2s) do
-    // tight UART poll loops that disrupt WiFi packet timing.
+    // These are queued on the AT channel and complete from _at.poll(),
+    // so a 30s AT+CMGS doesn't hold up URCs or call commands.
     // ================================================================
     if (!_paused && !isCallActive()) {
-      // Check for outgoing SMS in queue
+      // Start the next outgoing SMS once the previous one has completed
       SMSOutgoing outMsg;
-      if (xQueueReceive(_sendQueue, &outMsg, 0) == pdTRUE) {
-        _state = ModemState::SENDING_SMS;
-        bool ok = doSendSMS(outMsg.phone, outMsg.body);
-        MESH_DEBUG_PRINTLN("[Modem] SMS send %s to %s", ok ? "OK" : "FAIL", outMsg.phone);
-        _state = ModemState::READY;
+      if (_state == ModemState::READY && xQueueReceive(_sendQueue, &outMsg, 0) == pdTRUE) {
+        if (!doSendSMS(outMsg.phone, outMsg.body)) {
+          xQueueSendToFront(_sendQueue, &outMsg, 0);   // channel busy, retry next pass
+        }
       }
 
-      // Poll for incoming SMS periodically
-      if (millis() - lastSMSPoll > SMS_POLL_INTERVAL) {
+      // Poll for incoming SMS periodically, or straight away after +CMTI
+      if (_smsPollDue || millis() - lastSMSPoll > SMS_POLL_INTERVAL) {
+        _smsPollDue = false;
         pollIncomingSMS();
         lastSMSPoll = millis();
       }
     }
 
     // Periodic signal strength update (always, even during calls)
-    if (!_paused && millis() - lastCSQPoll > CSQ_POLL_INTERVAL) {
+    if (!_paused && (_csqPollDue || millis() - lastCSQPoll > CSQ_POLL_INTERVAL)) {
       // Only poll CSQ if not actively in a call (avoid interrupting audio)
       if (!isCallActive()) {
+        _csqPollDue = false;
         pollCSQ();
+        const ATStats& st = _at.getStats();
+        MESH_DEBUG_PRINTLN("[Modem] AT: %lu sent, %lu fail, %lu timeout, avg %lums, max %lums, queue max %lums, %lu URCs",
+                           (unsigned long)st.sent, (unsigned long)st.failed, (unsigned long)st.timeouts,
+                           (unsigned long)st.avgMillis(), (unsigned long)st.max_ms,
+                           (unsigned long)st.max_queue_ms, (unsigned long)st.urcs);
       }
       lastCSQPoll = millis();
     }
 
-    // Shorter delay during active call states for responsive URC handling
-    if (isCallActive()) {
+    // Shorter delay during active call states, or while commands are
+    // queued, so responses and URCs are handled promptly
+    if (!_at.isIdle()) {
+      vTaskDelay(pdMS_TO_TICKS(10));   // 10ms -- replies on their way
+    } else if (isCallActive()) {
       vTaskDelay(pdMS_TO_TICKS(100));  // 100ms -- responsive to URCs
     } else {
       vTaskDelay(pdMS_TO_TICKS(500));  // 500ms -- normal idle
@@ -1349,8 +1320,8 @@ bool ModemManager::modemPowerOn() {
   vTaskDelay(pdMS_TO_TICKS(500));
   MESH_DEBUG_PRINTLN("[Modem] UART started (ESP32 RX=%d TX=%d @ %d)", MODEM_TX, MODEM_RX, MODEM_BAUD);
 
-  // Drain any boot garbage from UART
-  while (MODEM_SERIAL.available()) MODEM_SERIAL.read();
+  // Attach the AT channel (also drains any boot garbage from UART)
+  _at.begin(MODEM_SERIAL, "[Modem]");
 
   // Test communication
   for (int i = 0; i < 10; i++) {
@@ -1370,177 +1341,182 @@ bool ModemManager::modemPowerOn() {
 // AT Command Helpers (called only from modem task)
 // ---------------------------------------------------------------------------
 
+// 'expect' other than "OK" is a result line that follows the OK (eg. "+CMQTTCONNECT:")
 bool ModemManager::sendAT(const char* cmd, const char* expect, uint32_t timeout_ms) {
-  // Before flushing, drain any pending URCs so we don't lose them
-  drainURCs();
-
-  Serial.printf("[Modem] TX: %s\n", cmd);
-  MODEM_SERIAL.println(cmd);
-  bool ok = waitResponse(expect, timeout_ms, _atBuf, AT_BUF_SIZE);
-  if (_atBuf[0]) {
-    int len = strlen(_atBuf);
-    while (len > 0 && (_atBuf[len-1] == '\r' || _atBuf[len-1] == '\n')) _atBuf[--len] = '\0';
-    Serial.printf("[Modem] RX: %s  [%s]\n", _atBuf, ok ? "OK" : "FAIL");
-  } else {
-    Serial.printf("[Modem] RX: (no response)  [TIMEOUT]\n");
-  }
-  return ok;
+  ATRequest req;
+  req.cmd = cmd;
+  req.timeout = timeout_ms;
+  if (expect && strcmp(expect, "OK") != 0) req.final_prefix = expect;
+  return _at.exec(req, _atBuf, AT_BUF_SIZE) == AT_OK;
 }
 
-bool ModemManager::waitResponse(const char* expect, uint32_t timeout_ms,
-                                 char* buf, size_t bufLen) {
-  unsigned long start = millis();
-  int pos = 0;
-
-  if (buf && bufLen > 0) buf[0] = '\0';
-
-  while (millis() - start < timeout_ms) {
-    while (MODEM_SERIAL.available()) {
-      char c = MODEM_SERIAL.read();
-      if (buf && pos < (int)bufLen - 1) {
-        buf[pos++] = c;
-        buf[pos] = '\0';
-      }
-      // Check for expected response in accumulated buffer
-      if (buf && expect && strstr(buf, expect)) {
-        return true;
-      }
-      // Also check for call-related URCs embedded in AT responses
-      // (e.g. NO CARRIER can arrive during an AT+CLCC response)
-      if (buf && strstr(buf, "NO CARRIER")) {
-        processURCLine("NO CARRIER");
-      }
-      if (buf && strstr(buf, "BUSY")) {
-        // Only process if we're in a call-related state
-        if (_state == ModemState::DIALING) {
-          processURCLine("BUSY");
-        }
-      }
-    }
-    vTaskDelay(pdMS_TO_TICKS(10));
-  }
-
-  // Timeout -- check one more time
-  if (buf && expect && strstr(buf, expect)) return true;
-  return false;
+void ModemManager::pollCSQ() {
+  if (_csqPending) return;
+  ATRequest req;
+  req.cmd = "AT+CSQ";
+  req.done = onCSQ;
+  req.ctx = this;
+  _csqPending = _at.submit(req);
 }
 
-void ModemManager::pollCSQ() {
-  if (sendAT("AT+CSQ", "OK", 2000)) {
-    char* p = strstr(_atBuf, "+CSQ:");
-    if (p) {
-      int csq, ber;
-      if (sscanf(p, "+CSQ: %d,%d", &csq, &ber) >= 1) {
-        _csq = csq;
-        MESH_DEBUG_PRINTLN("[Modem] CSQ=%d (bars=%d)", _csq, getSignalBars());
-      }
+void ModemManager::onCSQ(void* ctx, ATResult result, const char* resp) {
+  ModemManager* self = static_cast<ModemManager*>(ctx);
+  self->_csqPending = false;
+  if (result != AT_OK) return;
+
+  const char* p = strstr(resp, "+CSQ:");
+  if (p) {
+    int csq, ber;
+    if (sscanf(p, "+CSQ: %d,%d", &csq, &ber) >= 1) {
+      self->_csq = csq;
+      MESH_DEBUG_PRINTLN("[Modem] CSQ=%d (bars=%d)", csq, self->getSignalBars());
     }
   }
 }
 
 void ModemManager::pollIncomingSMS() {
-  // List all unread messages (wait for full OK response)
-  if (!sendAT("AT+CMGL=\"REC UNREAD\"", "OK", 5000)) return;
-
-  // Parse response: +CMGL: <index>,<stat>,<phone>,,<timestamp>\r\n<body>\r\n
-  char* p = _atBuf;
-  while ((p = strstr(p, "+CMGL:")) != nullptr) {
-    int idx;
-    char phone[SMS_PHONE_LEN];
+  if (_smsListPending) return;
+  flushSMSDeletes();   // any left over from the last listing go first
+  // List received messages, read or not: one that couldn't be queued last
+  // time is still on the SIM (now marked read), so it is picked up again.
+  // Records are parsed one at a time in onSMSListLine, not from the
+  // (AT_RESP_MAX bounded) response buffer.
+  ATRequest req;
+  req.cmd = "AT+CMGL=\"ALL\"";
+  req.timeout = 5000;
+  req.text_lines = true;   // body line after each +CMGL: header, taken verbatim
+  req.on_line = onSMSListLine;
+  req.done = onSMSList;
+  req.ctx = this;
+  _cmglIdx = -1;
+  _smsListPending = _at.submit(req);
+}
 
-    // Parse header line
-    char* lineEnd = strchr(p, '\n');
-    if (!lineEnd) break;
+// Header:  +CMGL: <index>,<stat>,<phone>,,<timestamp>
+// Body:    the line after it
+void ModemManager::onSMSListLine(void* ctx, const char* line) {
+  ModemManager* self = static_cast<ModemManager*>(ctx);
 
-    // Extract index
-    if (sscanf(p, "+CMGL: %d", &idx) != 1) { p = lineEnd + 1; continue; }
+  if (strncmp(line, "+CMGL:", 6) == 0) {
+    self->_cmglIdx = -1;   // unless header parses, skip the body that follows
+    int idx;
+    if (sscanf(line, "+CMGL: %d", &idx) != 1) return;
 
-    // Extract phone number
-    char* q1 = strchr(p + 7, '"');
-    if (!q1) { p = lineEnd + 1; continue; }
+    // Extract status and phone number
+    const char* q1 = strchr(line + 7, '"');
+    if (!q1) return;
     q1++;
-    char* q2 = strchr(q1, '"');
-    if (!q2) { p = lineEnd + 1; continue; }
-    char* q3 = strchr(q2 + 1, '"');
-    if (!q3) { p = lineEnd + 1; continue; }
+    const char* q2 = strchr(q1, '"');
+    if (!q2) return;
+    const char* q3 = strchr(q2 + 1, '"');
+    if (!q3) return;
     q3++;
-    char* q4 = strchr(q3, '"');
-    if (!q4) { p = lineEnd + 1; continue; }
+    const char* q4 = strchr(q3, '"');
+    if (!q4) return;
+    if (strncmp(q1, "REC ", 4) != 0) return;   // stored outgoing (STO), not ours to take
+
+    for (int i = 0; i < self->_numSmsDelete; i++) {
+      if (self->_smsDelete[i] == idx) return;   // already delivered, delete still to go out
+    }
     int phoneLen = q4 - q3;
     if (phoneLen >= SMS_PHONE_LEN) phoneLen = SMS_PHONE_LEN - 1;
-    memcpy(phone, q3, phoneLen);
-    phone[phoneLen] = '\0';
-
-    // Body is on the next line
-    p = lineEnd + 1;
-    char* bodyEnd = strchr(p, '\r');
-    if (!bodyEnd) bodyEnd = strchr(p, '\n');
-    if (!bodyEnd) break;
-
-    SMSIncoming incoming;
-    memset(&incoming, 0, sizeof(incoming));
-    strncpy(incoming.phone, phone, SMS_PHONE_LEN - 1);
-    int bodyLen = bodyEnd - p;
-    if (bodyLen >= SMS_BODY_LEN) bodyLen = SMS_BODY_LEN - 1;
-    memcpy(incoming.body, p, bodyLen);
-    incoming.body[bodyLen] = '\0';
-    incoming.timestamp = (uint32_t)time(nullptr);
-
-    // Queue for main loop
-    xQueueSend(_recvQueue, &incoming, 0);
-
-    // Delete the message from SIM
-    char delCmd[20];
-    snprintf(delCmd, sizeof(delCmd), "AT+CMGD=%d", idx);
-    sendAT(delCmd, "OK", 2000);
+    memcpy(self->_cmglPhone, q3, phoneLen);
+    self->_cmglPhone[phoneLen] = '\0';
+    self->_cmglIdx = idx;
+    return;
+  }
 
-    MESH_DEBUG_PRINTLN("[Modem] SMS received from %s: %.40s...", phone, incoming.body);
+  if (self->_cmglIdx < 0) return;   // not a body we want
+  int idx = self->_cmglIdx;
+  self->_cmglIdx = -1;
+
+  SMSIncoming incoming;
+  memset(&incoming, 0, sizeof(incoming));
+  strncpy(incoming.phone, self->_cmglPhone, SMS_PHONE_LEN - 1);
+  strncpy(incoming.body, line, SMS_BODY_LEN - 1);
+  incoming.timestamp = (uint32_t)time(nullptr);
+
+  // Queue for main loop. Only what was handed over is deleted from the SIM,
+  // the rest is left for the next listing.
+  if (self->_numSmsDelete >= SMS_DELETE_MAX) return;
+  if (xQueueSend(self->_recvQueue, &incoming, 0) != pdTRUE) {
+    MESH_DEBUG_PRINTLN("[Modem] SMS %d left on SIM, receive queue full", idx);
+    return;
+  }
+  self->_smsDelete[self->_numSmsDelete++] = (int16_t)idx;
+
+  MESH_DEBUG_PRINTLN("[Modem] SMS received from %s: %.40s...", incoming.phone, incoming.body);
+}
+
+void ModemManager::onSMSList(void* ctx, ATResult result, const char* resp) {
+  ModemManager* self = static_cast<ModemManager*>(ctx);
+  self->_smsListPending = false;
+  self->_cmglIdx = -1;
+  self->flushSMSDeletes();   // also after an error or timeout, for the records already queued
+}
 
-    p = bodyEnd + 1;
+// Delete delivered messages from the SIM by index, as far as the channel has
+// room (the rest go out before the next listing)
+void ModemManager::flushSMSDeletes() {
+  int n = 0;
+  while (n < _numSmsDelete && _at.getFree() > 1) {   // keep a slot for other work
+    char cmd[16];
+    snprintf(cmd, sizeof(cmd), "AT+CMGD=%d", _smsDelete[n]);
+    ATRequest del;
+    del.cmd = cmd;
+    del.timeout = 5000;
+    if (!_at.submit(del)) break;
+    n++;
+  }
+  if (n > 0) {
+    memmove(&_smsDelete[0], &_smsDelete[n], (_numSmsDelete - n) * sizeof(_smsDelete[0]));
+    _numSmsDelete -= n;
   }
 }
 
+// Queues AT+CMGF / AT+CMGS; the body goes out at the '>' prompt and
+// onSMSSent() puts the state back to READY. Returns false if the channel
+// has no room right now.
 bool ModemManager::doSendSMS(const char* phone, const char* body) {
   MESH_DEBUG_PRINTLN("[Modem] doSendSMS to=%s len=%d", phone, strlen(body));
+  if (_at.getFree() < 2) return false;
+
+  strncpy(_smsTo, phone, SMS_PHONE_LEN - 1);
+  _smsTo[SMS_PHONE_LEN - 1] = '\0';
+  int len = strlen(body);
+  if (len > SMS_BODY_LEN - 1) len = SMS_BODY_LEN - 1;
+  memcpy(_smsPayload, body, len);
+  _smsPayload[len] = 0x1A;   // Ctrl+Z to send
 
   // Set text mode (in case it was reset)
-  sendAT("AT+CMGF=1", "OK");
+  ATRequest mode;
+  mode.cmd = "AT+CMGF=1";
+  _at.submit(mode);
 
-  // Start SMS send
   char cmd[40];
   snprintf(cmd, sizeof(cmd), "AT+CMGS=\"%s\"", phone);
-  Serial.printf("[Modem] TX: %s\n", cmd);
-  MODEM_SERIAL.println(cmd);
-
-  // Wait for '>' prompt
-  unsigned long start = millis();
-  bool gotPrompt = false;
-  while (millis() - start < 5000) {
-    if (MODEM_SERIAL.available()) {
-      char c = MODEM_SERIAL.read();
-      if (c == '>') { gotPrompt = true; break; }
-    }
-    vTaskDelay(pdMS_TO_TICKS(10));
-  }
-  if (!gotPrompt) {
-    MESH_DEBUG_PRINTLN("[Modem] no '>' prompt for SMS send");
-    MODEM_SERIAL.write(0x1B);  // ESC to cancel
-    return false;
-  }
-
-  // Send body + Ctrl+Z
-  MESH_DEBUG_PRINTLN("[Modem] got '>' prompt, sending body...");
-  MODEM_SERIAL.print(body);
-  MODEM_SERIAL.write(0x1A);  // Ctrl+Z to send
+  ATRequest send;
+  send.cmd = cmd;
+  send.timeout = 35000;      // 5s for the '>' prompt, then up to 30s for the network
+  send.payload = _smsPayload;
+  send.payload_len = len + 1;
+  send.done = onSMSSent;
+  send.ctx = this;
+  _at.submit(send);
+
+  _state = ModemState::SENDING_SMS;
+  return true;
+}
 
-  // Wait for +CMGS or ERROR
-  if (waitResponse("+CMGS:", 30000, _atBuf, AT_BUF_SIZE)) {
-    MESH_DEBUG_PRINTLN("[Modem] SMS sent OK: %s", _atBuf);
-    return true;
+void ModemManager::onSMSSent(void* ctx, ATResult result, const char* resp) {
+  ModemManager* self = static_cast<ModemManager*>(ctx);
+  if (result == AT_OK) {
+    MESH_DEBUG_PRINTLN("[Modem] SMS send OK to %s", self->_smsTo);
+  } else {
+    MESH_DEBUG_PRINTLN("[Modem] SMS send FAIL to %s: %s", self->_smsTo, resp);
   }
-
-  MESH_DEBUG_PRINTLN("[Modem] SMS send timeout/error: %s", _atBuf);
-  return false;
+  // A call may have come in meanwhile; only undo our own state
+  if (self->_state == ModemState::SENDING_SMS) self->_state = ModemState::READY;
 }
 
 #endif // HAS_4G_MODEM
\ No newline at end of file
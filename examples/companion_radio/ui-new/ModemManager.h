@@ -5,6 +5,9 @@
 //
 // Runs AT commands on a dedicated FreeRTOS task (Core 0, priority 1) to never
 // block the mesh radio loop.  Communicates with main loop via lock-free queues.
+// All UART traffic goes through an ATChannel: URCs are routed to the call,
+// SMS and network handlers as they arrive, and SMS send/list and signal polls
+// are queued asynchronously so they don't hold up call handling.
 //
 // Supports: SMS send/receive, voice call dial/answer/hangup/DTMF,
 //           notification tone playback via AT+CCMXPLAY
@@ -22,6 +25,7 @@
 #include <freertos/task.h>
 #include <freertos/queue.h>
 #include <freertos/semphr.h>
+#include <helpers/esp32/ATChannel.h>
 #include "variant.h"
 #include "ApnDatabase.h"
 #include "ModemBundledSounds.h"
@@ -49,6 +53,7 @@
 // Queue sizes
 #define MODEM_SEND_QUEUE_SIZE  4
 #define MODEM_RECV_QUEUE_SIZE  8
+#define SMS_DELETE_MAX        16   // delivered SIM messages waiting for their AT+CMGD
 #define MODEM_CALL_CMD_QUEUE_SIZE  4
 #define MODEM_CALL_EVT_QUEUE_SIZE  4
 
@@ -207,6 +212,9 @@ public:
 
   static const char* stateToString(ModemState s);
 
+  // AT command counts and latency (modem task writes, read for diagnostics)
+  const ATStats& getATStats() const { return _at.getStats(); }
+
   // Persistent enable/disable config (SD file /sms/modem.cfg)
   static bool loadEnabledConfig();
   static void saveEnabledConfig(bool enabled);
@@ -249,24 +257,42 @@ private:
   QueueHandle_t _callCmdQueue = nullptr;   // main loop -> modem task
   QueueHandle_t _callEvtQueue = nullptr;   // modem task -> main loop
 
-  SemaphoreHandle_t _uartMutex = nullptr;
-
-  // URC line buffer (accumulated between AT commands)
-  static const int URC_BUF_SIZE = 256;
-  char _urcBuf[URC_BUF_SIZE];
-  int  _urcPos = 0;
+  // AT transport (owned by the modem task once it is running)
+  ATChannel _at;
+  bool _urcsRegistered = false;
+
+  // Async SMS / signal work in flight on the channel
+  char _smsTo[SMS_PHONE_LEN] = {0};
+  uint8_t _smsPayload[SMS_BODY_LEN + 1];   // body + Ctrl+Z, must outlive the AT+CMGS
+  volatile bool _smsPollDue = false;       // +CMTI arrived, list now rather than at next interval
+  bool _smsListPending = false;
+  int _cmglIdx = -1;                       // SIM index of the +CMGL record whose body is next, -1 = skip
+  char _cmglPhone[SMS_PHONE_LEN];
+  int16_t _smsDelete[SMS_DELETE_MAX];      // SIM indexes delivered to _recvQueue, not yet deleted
+  int _numSmsDelete = 0;
+  bool _csqPending = false;
+  volatile bool _csqPollDue = false;       // re-registered, refresh signal now
 
   // UART AT command helpers (called only from modem task)
   bool modemPowerOn();
   bool sendAT(const char* cmd, const char* expect, uint32_t timeout_ms = 2000);
-  bool waitResponse(const char* expect, uint32_t timeout_ms, char* buf = nullptr, size_t bufLen = 0);
   void pollCSQ();
   void pollIncomingSMS();
+  void flushSMSDeletes();
   bool doSendSMS(const char* phone, const char* body);
 
+  // Async completions (run from _at.poll() on the modem task)
+  static void onSMSSent(void* ctx, ATResult result, const char* resp);
+  static void onSMSListLine(void* ctx, const char* line);
+  static void onSMSList(void* ctx, ATResult result, const char* resp);
+  static void onCSQ(void* ctx, ATResult result, const char* resp);
+
   // URC (unsolicited result code) handling
-  void drainURCs();                // Read available UART data, process complete lines
-  void processURCLine(const char* line);  // Handle a single URC line
+  void registerURCs();
+  static void onCallURC(void* ctx, const char* line);
+  static void onSMSURC(void* ctx, const char* line);
+  static void onNetworkURC(void* ctx, const char* line);
+  void processURCLine(const char* line);  // Handle a single call/audio URC line
 
   // APN resolution (called from modem task during init)
   void resolveAPN();              // Auto-detect APN from network/IMSI/user config
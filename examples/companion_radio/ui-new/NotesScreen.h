@@ -5,6 +5,7 @@
 #include <SD.h>
 #include <vector>
 #include "Utf8CP437.h"
+#include "GapBuffer.h"
 #include "../NodePrefs.h"
 
 // Forward declarations
@@ -15,10 +16,17 @@ class UITask;
 // ============================================================================
 #define NOTES_FOLDER        "/notes"
 #define NOTES_MAX_FILES     30
-#define NOTES_BUF_SIZE      16384   // 16KB buffer (PSRAM-backed)
+#define NOTES_BUF_SIZE      16384   // Initial text buffer (PSRAM-backed), grows as needed
+#ifdef BOARD_HAS_PSRAM
+  #define NOTES_MAX_SIZE    (2 * 1024 * 1024)   // Largest note that will load
+#else
+  #define NOTES_MAX_SIZE    NOTES_BUF_SIZE
+#endif
 #define NOTES_FILENAME_MAX  40
 #define NOTES_RENAME_MAX    32      // Max rename buffer length
-#define NOTES_MAX_LINES     1024    // Max visual lines for cursor nav
+#define NOTES_MAX_LINES     1024    // Initial visual line index size, grows as needed
+#define NOTES_REWRAP_MAX    32      // Lines re-wrapped per edit before falling back to a full rebuild
+#define NOTES_LINE_BYTES    256     // Scratch for one visual line when rendering
 
 // ============================================================================
 // NotesScreen - Create, view, and edit .txt notes on SD card
@@ -44,7 +52,7 @@ class UITask;
 //   CONFIRM_DELETE: Enter = confirm delete, Q = cancel
 //
 // Filenames: RTC timestamp (note_YYYYMMDD_HHMM.txt) or sequential (note_001.txt)
-// Buffer: 16KB on PSRAM for longer notes
+// Buffer: gap buffer on PSRAM (see GapBuffer.h), starts at 16KB and grows
 // ============================================================================
 
 class NotesScreen : public UIScreen {
@@ -77,8 +85,7 @@ private:
 
   // Current note state
   String _currentFile;    // Filename (just name, not full path)
-  char* _buf;             // Note content buffer (PSRAM-backed)
-  int _bufLen;            // Current content length
+  GapBuffer _text;        // Note content (PSRAM-backed)
   int _cursorPos;         // Cursor byte position in buffer
   bool _dirty;            // Has unsaved changes
 
@@ -87,10 +94,13 @@ private:
   int _totalPages;
   std::vector<int> _pageOffsets;
 
-  // Editor visual lines (rebuilt on content/cursor change)
+  // Editor visual lines (full build on open, patched on each edit)
   struct EditorLine { int start; int end; };
   EditorLine* _editorLines;
+  int _editorLinesCap;
   int _numEditorLines;
+  bool _editorLinesValid;
+  EditorLine _rewrap[NOTES_REWRAP_MAX];
   int _editorScrollTop;   // First visible line index
 
   // Rename state
@@ -208,22 +218,21 @@ private:
     }
 
     unsigned long size = file.size();
-    int toRead = min((unsigned long)(NOTES_BUF_SIZE - 1), size);
-    _bufLen = file.readBytes(_buf, toRead);
-    _buf[_bufLen] = '\0';
+    bool complete = _text.load(file);
     file.close();
     digitalWrite(SDCARD_CS, HIGH);
 
     _currentFile = filename;
-    _cursorPos = _bufLen;
+    _cursorPos = _text.length();
+    _editorLinesValid = false;
     _dirty = false;
 
-    if (size >= NOTES_BUF_SIZE) {
+    if (!complete) {
       Serial.printf("Notes: Warning - %s truncated (%lu > %d)\n",
-                    filename.c_str(), size, NOTES_BUF_SIZE - 1);
+                    filename.c_str(), size, _text.length());
     }
 
-    Serial.printf("Notes: Loaded %s (%d bytes)\n", filename.c_str(), _bufLen);
+    Serial.printf("Notes: Loaded %s (%d bytes)\n", filename.c_str(), _text.length());
     return true;
   }
 
@@ -241,12 +250,12 @@ private:
       return false;
     }
 
-    file.write((uint8_t*)_buf, _bufLen);
+    _text.save(file);
     file.close();
     digitalWrite(SDCARD_CS, HIGH);
 
     _dirty = false;
-    Serial.printf("Notes: Saved %s (%d bytes)\n", _currentFile.c_str(), _bufLen);
+    Serial.printf("Notes: Saved %s (%d bytes)\n", _currentFile.c_str(), _text.length());
     return true;
   }
 
@@ -292,56 +301,66 @@ private:
     return true;
   }
 
+  // ---- Line Wrapping ----
+
+  // Find the end of the visual line starting at pos: word wrap at cpl chars,
+  // hard break at \n / \r\n. Sets lineEnd (exclusive) and nextStart. Returns
+  // false if the text ran out (at limit) before the line was finished.
+  bool wrapLine(int pos, int limit, int cpl, int& lineEnd, int& nextStart) const {
+    int len = _text.length();
+    int charCount = 0;
+    int lastBreak = -1;
+    bool inWord = false;
+
+    for (int i = pos; i < limit; i++) {
+      char c = _text.at(i);
+      if (c == '\n') { lineEnd = i; nextStart = i + 1; return true; }
+      if (c == '\r') {
+        lineEnd = i; nextStart = i + 1;
+        if (nextStart < len && _text.at(nextStart) == '\n') nextStart++;
+        return true;
+      }
+      if (c >= 32) {
+        if ((uint8_t)c >= 0x80 && (uint8_t)c < 0xC0) continue;
+        charCount++;
+        if (c == ' ' || c == '\t') { if (inWord) { lastBreak = i; inWord = false; } }
+        else if (c == '-') { if (inWord) lastBreak = i + 1; }
+        else inWord = true;
+        if (charCount >= cpl) {
+          if (lastBreak > pos) {
+            lineEnd = lastBreak; nextStart = lastBreak;
+            while (nextStart < len && (_text.at(nextStart) == ' ' || _text.at(nextStart) == '\t'))
+              nextStart++;
+          } else { lineEnd = i; nextStart = i; }
+          return true;
+        }
+      }
+    }
+    lineEnd = limit;
+    nextStart = limit;
+    return false;
+  }
+
   // ---- Pagination for Read Mode ----
 
   void buildPageIndex() {
     _pageOffsets.clear();
     _pageOffsets.push_back(0);
 
+    int len = _text.length();
     int pos = 0;
     int lineCount = 0;
 
-    while (pos < _bufLen) {
-      int lineEnd = pos;
-      int nextStart = pos;
-      int charCount = 0;
-      int lastBreak = -1;
-      bool inWord = false;
-
-      for (int i = pos; i < _bufLen; i++) {
-        char c = _buf[i];
-        if (c == '\n') { lineEnd = i; nextStart = i + 1; goto pageLineFound; }
-        if (c == '\r') {
-          lineEnd = i; nextStart = i + 1;
-          if (nextStart < _bufLen && _buf[nextStart] == '\n') nextStart++;
-          goto pageLineFound;
-        }
-        if (c >= 32) {
-          if ((uint8_t)c >= 0x80 && (uint8_t)c < 0xC0) continue;
-          charCount++;
-          if (c == ' ' || c == '\t') { if (inWord) { lastBreak = i; inWord = false; } }
-          else if (c == '-') { if (inWord) lastBreak = i + 1; }
-          else inWord = true;
-          if (charCount >= _charsPerLine) {
-            if (lastBreak > pos) {
-              lineEnd = lastBreak; nextStart = lastBreak;
-              while (nextStart < _bufLen && (_buf[nextStart] == ' ' || _buf[nextStart] == '\t'))
-                nextStart++;
-            } else { lineEnd = i; nextStart = i; }
-            goto pageLineFound;
-          }
-        }
-      }
-      break;
+    while (pos < len) {
+      int lineEnd, nextStart;
+      if (!wrapLine(pos, len, _charsPerLine, lineEnd, nextStart)) break;
 
-    pageLineFound:
       lineCount++;
       pos = nextStart;
       if (lineCount >= _linesPerPage) {
         _pageOffsets.push_back(pos);
         lineCount = 0;
       }
-      if (pos >= _bufLen) break;
     }
 
     _totalPages = _pageOffsets.size();
@@ -350,53 +369,41 @@ private:
     }
   }
 
-  // ---- Editor Line Building (for cursor navigation) ----
+  // ---- Editor Line Index (for cursor navigation) ----
+  // Built in full when a note is opened; after that each edit only re-wraps
+  // from the line before the edit until a line start lines up with the old
+  // index again (see rewrapAfterEdit), so typing cost doesn't grow with the note.
+
+  bool reserveEditorLines(int n) {
+    if (n <= _editorLinesCap) return true;
+    int newCap = _editorLinesCap > 0 ? _editorLinesCap : NOTES_MAX_LINES;
+    while (newCap < n) newCap *= 2;
+    #ifdef BOARD_HAS_PSRAM
+      EditorLine* nl = (EditorLine*)ps_malloc(sizeof(EditorLine) * newCap);
+    #else
+      EditorLine* nl = (EditorLine*)malloc(sizeof(EditorLine) * newCap);
+    #endif
+    if (!nl) return false;
+    memcpy(nl, _editorLines, sizeof(EditorLine) * _numEditorLines);
+    free(_editorLines);
+    _editorLines = nl;
+    _editorLinesCap = newCap;
+    return true;
+  }
 
   void buildEditorLines() {
     _numEditorLines = 0;
+    int len = _text.length();
     int pos = 0;
 
-    while (pos < _bufLen && _numEditorLines < NOTES_MAX_LINES) {
+    while (pos < len) {
+      if (_numEditorLines >= _editorLinesCap && !reserveEditorLines(_numEditorLines + 1)) break;
+      int lineEnd, nextStart;
+      wrapLine(pos, len, _editCharsPerLine, lineEnd, nextStart);
       _editorLines[_numEditorLines].start = pos;
-
-      int lineEnd = pos;
-      int nextStart = pos;
-      int charCount = 0;
-      int lastBreak = -1;
-      bool inWord = false;
-
-      for (int i = pos; i < _bufLen; i++) {
-        char c = _buf[i];
-        if (c == '\n') { lineEnd = i; nextStart = i + 1; goto edLineFound; }
-        if (c == '\r') {
-          lineEnd = i; nextStart = i + 1;
-          if (nextStart < _bufLen && _buf[nextStart] == '\n') nextStart++;
-          goto edLineFound;
-        }
-        if (c >= 32) {
-          if ((uint8_t)c >= 0x80 && (uint8_t)c < 0xC0) continue;
-          charCount++;
-          if (c == ' ' || c == '\t') { if (inWord) { lastBreak = i; inWord = false; } }
-          else if (c == '-') { if (inWord) lastBreak = i + 1; }
-          else inWord = true;
-          if (charCount >= _editCharsPerLine) {
-            if (lastBreak > pos) {
-              lineEnd = lastBreak; nextStart = lastBreak;
-              while (nextStart < _bufLen && (_buf[nextStart] == ' ' || _buf[nextStart] == '\t'))
-                nextStart++;
-            } else { lineEnd = i; nextStart = i; }
-            goto edLineFound;
-          }
-        }
-      }
-      lineEnd = _bufLen;
-      nextStart = _bufLen;
-
-    edLineFound:
       _editorLines[_numEditorLines].end = lineEnd;
       _numEditorLines++;
       pos = nextStart;
-      if (pos >= _bufLen) break;
     }
 
     // Ensure at least one line (empty buffer)
@@ -404,22 +411,69 @@ private:
       _editorLines[0] = {0, 0};
       _numEditorLines = 1;
     }
+    _editorLinesValid = true;
   }
 
-  // Find which editor line contains a buffer position
+  // Update line index after 'removed' bytes at pos were replaced by 'inserted' bytes
+  void rewrapAfterEdit(int pos, int removed, int inserted) {
+    if (!_editorLinesValid) return;   // full build on next render
+
+    int len = _text.length();
+    int delta = inserted - removed;
+    int first = max(0, lineForPos(pos) - 1);   // a word may now fit back on the previous line
+    int k = first + 1;                          // next old line to test for re-sync
+    int n = 0;
+    int p = _editorLines[first].start;
+
+    while (p < len) {
+      if (n >= NOTES_REWRAP_MAX) { buildEditorLines(); return; }   // big change, just rebuild
+      int lineEnd, nextStart;
+      wrapLine(p, len, _editCharsPerLine, lineEnd, nextStart);
+      _rewrap[n].start = p;
+      _rewrap[n].end = lineEnd;
+      n++;
+      p = nextStart;
+
+      // old lines starting past the edit have the same text after them, just shifted by delta;
+      // once a new line starts at one of those, the rest of the old index is still good
+      while (k < _numEditorLines && _editorLines[k].start < pos + removed) k++;
+      while (k < _numEditorLines && _editorLines[k].start + delta < p) k++;
+      if (k < _numEditorLines && _editorLines[k].start + delta == p) break;
+    }
+    if (p >= len) k = _numEditorLines;   // re-wrapped to the end
+
+    if (n == 0) {   // text now ends before line 'first'
+      _rewrap[n++] = {p, p};
+    }
+    int newCount = _numEditorLines - (k - first) + n;
+    if (!reserveEditorLines(newCount)) { buildEditorLines(); return; }
+    memmove(&_editorLines[first + n], &_editorLines[k], sizeof(EditorLine) * (_numEditorLines - k));
+    memcpy(&_editorLines[first], _rewrap, sizeof(EditorLine) * n);
+    for (int i = first + n; i < newCount; i++) {
+      _editorLines[i].start += delta;
+      _editorLines[i].end += delta;
+    }
+    _numEditorLines = newCount;
+    if (len == 0) _editorLines[0] = {0, 0};
+  }
+
+  // Find which editor line contains a buffer position (line starts are sorted)
   int lineForPos(int bufPos) {
-    for (int i = 0; i < _numEditorLines; i++) {
-      int nextStart = (i + 1 < _numEditorLines) ? _editorLines[i + 1].start : _bufLen + 1;
-      if (bufPos >= _editorLines[i].start && bufPos < nextStart) return i;
+    int lo = 0, hi = _numEditorLines - 1, found = 0;
+    while (lo <= hi) {
+      int mid = (lo + hi) / 2;
+      if (_editorLines[mid].start <= bufPos) { found = mid; lo = mid + 1; }
+      else hi = mid - 1;
     }
-    return max(0, _numEditorLines - 1);
+    return found;
   }
 
   // Count visual columns from line start to a buffer position
   int colForPos(int bufPos, int lineStart) {
     int col = 0;
-    for (int i = lineStart; i < bufPos && i < _bufLen; i++) {
-      uint8_t b = (uint8_t)_buf[i];
+    int len = _text.length();
+    for (int i = lineStart; i < bufPos && i < len; i++) {
+      uint8_t b = (uint8_t)_text.at(i);
       if (b >= 0x80 && b < 0xC0) continue;
       if (b == '\n' || b == '\r') break;
       col++;
@@ -429,12 +483,13 @@ private:
 
   // Find buffer position for a target column on a given line
   int posForCol(int targetCol, int lineIdx) {
-    if (lineIdx < 0 || lineIdx >= _numEditorLines) return _bufLen;
+    int len = _text.length();
+    if (lineIdx < 0 || lineIdx >= _numEditorLines) return len;
     int start = _editorLines[lineIdx].start;
     int end = _editorLines[lineIdx].end;
     int col = 0;
-    for (int i = start; i < end && i < _bufLen; i++) {
-      uint8_t b = (uint8_t)_buf[i];
+    for (int i = start; i < end && i < len; i++) {
+      uint8_t b = (uint8_t)_text.at(i);
       if (b >= 0x80 && b < 0xC0) continue;
       if (b == '\n' || b == '\r') return i;
       if (col >= targetCol) return i;
@@ -458,21 +513,17 @@ private:
   // ---- Cursor Operations ----
 
   void insertAtCursor(char c) {
-    if (_bufLen >= NOTES_BUF_SIZE - 1) return;
-    memmove(&_buf[_cursorPos + 1], &_buf[_cursorPos], _bufLen - _cursorPos);
-    _buf[_cursorPos] = c;
-    _bufLen++;
-    _buf[_bufLen] = '\0';
+    if (!_text.insert(_cursorPos, c)) return;
+    rewrapAfterEdit(_cursorPos, 0, 1);
     _cursorPos++;
     _dirty = true;
   }
 
   void deleteBeforeCursor() {
     if (_cursorPos <= 0) return;
-    memmove(&_buf[_cursorPos - 1], &_buf[_cursorPos], _bufLen - _cursorPos);
     _cursorPos--;
-    _bufLen--;
-    _buf[_bufLen] = '\0';
+    _text.erase(_cursorPos);
+    rewrapAfterEdit(_cursorPos, 1, 0);
     _dirty = true;
   }
 
@@ -605,59 +656,32 @@ private:
     display.setTextSize(_prefs->smallTextSize());
     display.setColor(DisplayDriver::LIGHT);
 
+    int len = _text.length();
     int pageStart = _pageOffsets[_currentPage];
     int pageEnd = (_currentPage + 1 < _totalPages)
                   ? _pageOffsets[_currentPage + 1]
-                  : _bufLen;
+                  : len;
 
     int y = 0;
     int lineCount = 0;
     int pos = pageStart;
     int maxY = display.height() - _footerHeight - _lineHeight;
+    char line[NOTES_LINE_BYTES];
 
-    while (pos < pageEnd && pos < _bufLen && lineCount < _linesPerPage && y <= maxY) {
-      int lineEnd = pos;
-      int nextStart = pos;
-      int charCount = 0;
-      int lastBreak = -1;
-      bool inWord = false;
-
-      for (int i = pos; i < pageEnd && i < _bufLen; i++) {
-        char c = _buf[i];
-        if (c == '\n') { lineEnd = i; nextStart = i + 1; goto renderLine; }
-        if (c == '\r') {
-          lineEnd = i; nextStart = i + 1;
-          if (nextStart < _bufLen && _buf[nextStart] == '\n') nextStart++;
-          goto renderLine;
-        }
-        if (c >= 32) {
-          if ((uint8_t)c >= 0x80 && (uint8_t)c < 0xC0) continue;
-          charCount++;
-          if (c == ' ' || c == '\t') { if (inWord) { lastBreak = i; inWord = false; } }
-          else if (c == '-') { if (inWord) lastBreak = i + 1; }
-          else inWord = true;
-          if (charCount >= _charsPerLine) {
-            if (lastBreak > pos) {
-              lineEnd = lastBreak; nextStart = lastBreak;
-              while (nextStart < _bufLen && (_buf[nextStart] == ' ' || _buf[nextStart] == '\t'))
-                nextStart++;
-            } else { lineEnd = i; nextStart = i; }
-            goto renderLine;
-          }
-        }
-      }
-      lineEnd = _bufLen;
-      nextStart = _bufLen;
+    while (pos < pageEnd && pos < len && lineCount < _linesPerPage && y <= maxY) {
+      int lineEnd, nextStart;
+      wrapLine(pos, pageEnd, _charsPerLine, lineEnd, nextStart);
 
-    renderLine:
       display.setCursor(0, y);
       char charStr[2] = {0, 0};
 
-      for (int j = pos; j < lineEnd && j < _bufLen;) {
-        uint8_t b = (uint8_t)_buf[j];
+      // Pull the line out of the gap buffer so the UTF-8 decoder sees contiguous bytes
+      int n = _text.copy(pos, min(lineEnd, pos + NOTES_LINE_BYTES), line);
+      for (int j = 0; j < n;) {
+        uint8_t b = (uint8_t)line[j];
         if (b < 32) { j++; continue; }
         if (b >= 0x80) {
-          uint32_t cp = decodeUtf8Char(_buf, lineEnd, &j);
+          uint32_t cp = decodeUtf8Char(line, n, &j);
           uint8_t glyph = unicodeToCP437(cp);
           if (glyph) { charStr[0] = (char)glyph; display.print(charStr); }
         } else {
@@ -694,8 +718,8 @@ private:
   }
 
   void renderEditor(DisplayDriver& display) {
-    // Rebuild visual lines and ensure cursor is visible
-    buildEditorLines();
+    // Visual lines are kept up to date by edits, only rebuild after load/layout change
+    if (!_editorLinesValid) buildEditorLines();
     ensureCursorVisible();
 
     // Header
@@ -741,7 +765,7 @@ private:
       // Render characters, inserting cursor at the right position
       bool cursorDrawn = false;
 
-      for (int j = lineStart; j < lineEnd && j < _bufLen; j++) {
+      for (int j = lineStart; j < lineEnd && j < _text.length(); j++) {
         // Draw cursor before this character if cursor is here
         if (li == cursorLine && j == _cursorPos && !cursorDrawn) {
           display.setColor(DisplayDriver::GREEN);
@@ -750,7 +774,7 @@ private:
           cursorDrawn = true;
         }
 
-        uint8_t b = (uint8_t)_buf[j];
+        uint8_t b = (uint8_t)_text.at(j);
         if (b < 32) continue;
         charStr[0] = (char)b;
         display.print(charStr);
@@ -767,7 +791,7 @@ private:
     }
 
     // If buffer is empty, show cursor at top
-    if (_bufLen == 0) {
+    if (_text.length() == 0) {
       display.setTextSize(_prefs->smallTextSize());
       display.setColor(DisplayDriver::GREEN);
       display.setCursor(0, textAreaTop);
@@ -796,7 +820,7 @@ private:
 #endif
 
     const char* right;
-    if (_bufLen == 0 || !_dirty) {
+    if (_text.length() == 0 || !_dirty) {
 #if defined(LilyGo_T5S3_EPaper_Pro)
       right = "Back";
 #else
@@ -977,10 +1001,10 @@ private:
 
     // Enter - switch to edit mode
     if (c == '\r' || c == 13) {
-      _cursorPos = _bufLen;
+      _cursorPos = _text.length();
       _editorScrollTop = 0;
       _mode = EDITING;
-      Serial.printf("Notes: Editing %s (%d bytes)\n", _currentFile.c_str(), _bufLen);
+      Serial.printf("Notes: Editing %s (%d bytes)\n", _currentFile.c_str(), _text.length());
       return true;
     }
 
@@ -1001,7 +1025,7 @@ private:
 
     // Enter - insert newline at cursor
     if (c == '\r' || c == 13) {
-      if (_bufLen < NOTES_BUF_SIZE - 2) {
+      if (_text.length() < _text.maxLength() - 1) {
         insertAtCursor('\n');
         return true;
       }
@@ -1009,7 +1033,7 @@ private:
     }
 
     // Regular printable character - insert at cursor
-    if (c >= 32 && c < 127 && _bufLen < NOTES_BUF_SIZE - 1) {
+    if (c >= 32 && c < 127 && _text.length() < _text.maxLength()) {
       insertAtCursor(c);
       return true;
     }
@@ -1097,8 +1121,8 @@ private:
       _rtcTime = _getTimeFn();
     }
     _currentFile = generateFilename();
-    _buf[0] = '\0';
-    _bufLen = 0;
+    _text.clear();
+    _editorLinesValid = false;
     _cursorPos = 0;
     _editorScrollTop = 0;
     _dirty = true;
@@ -1112,19 +1136,15 @@ public:
       _sdReady(false), _initialized(false), _lastFontPref(0), _display(nullptr),
       _charsPerLine(38), _linesPerPage(22), _lineHeight(5), _footerHeight(14),
       _editCharsPerLine(20), _editLineHeight(12), _editMaxLines(8),
-      _selectedFile(0), _buf(nullptr), _bufLen(0), _cursorPos(0),
+      _selectedFile(0), _cursorPos(0),
       _dirty(false), _currentPage(0), _totalPages(0),
-      _editorLines(nullptr), _numEditorLines(0), _editorScrollTop(0),
+      _editorLines(nullptr), _editorLinesCap(0), _numEditorLines(0),
+      _editorLinesValid(false), _editorScrollTop(0),
       _renameLen(0), _rtcTime(0), _utcOffset(0) {
 
     // Allocate main buffer on PSRAM if available
-    #ifdef BOARD_HAS_PSRAM
-      _buf = (char*)ps_malloc(NOTES_BUF_SIZE);
-    #else
-      _buf = (char*)malloc(NOTES_BUF_SIZE);
-    #endif
-    if (_buf) _buf[0] = '\0';
-    else Serial.println("Notes: FATAL - buffer allocation failed!");
+    if (!_text.begin(NOTES_BUF_SIZE, NOTES_MAX_SIZE))
+      Serial.println("Notes: FATAL - buffer allocation failed!");
 
     // Allocate editor lines array
     #ifdef BOARD_HAS_PSRAM
@@ -1132,12 +1152,12 @@ public:
     #else
       _editorLines = (EditorLine*)malloc(sizeof(EditorLine) * NOTES_MAX_LINES);
     #endif
+    if (_editorLines) _editorLinesCap = NOTES_MAX_LINES;
 
     _renameBuf[0] = '\0';
   }
 
   ~NotesScreen() {
-    if (_buf) free(_buf);
     if (_editorLines) free(_editorLines);
   }
 
@@ -1194,6 +1214,7 @@ public:
     int editTextAreaH = display.height() - 14 - 16;  // Header + footer
     _editMaxLines = editTextAreaH / _editLineHeight;
     if (_editMaxLines < 3) _editMaxLines = 3;
+    _editorLinesValid = false;
 
     display.setTextSize(1);
     _initialized = true;
@@ -1232,7 +1253,7 @@ public:
   bool isInFileList() const { return _mode == FILE_LIST; }
   bool isRenaming() const { return _mode == RENAMING; }
   bool isConfirmingDelete() const { return _mode == CONFIRM_DELETE; }
-  bool isEmpty() const { return _bufLen == 0; }
+  bool isEmpty() const { return _text.length() == 0; }
 
   // Touch: select file list row by virtual Y coordinate
   // Returns: 0 = outside list, 1 = moved selection, 2 = tapped same row (open)
@@ -1268,25 +1289,26 @@ public:
   void moveCursorLeft() {
     if (_cursorPos > 0) {
       _cursorPos--;
-      while (_cursorPos > 0 && (uint8_t)_buf[_cursorPos] >= 0x80 &&
-             (uint8_t)_buf[_cursorPos] < 0xC0) {
+      while (_cursorPos > 0 && (uint8_t)_text.at(_cursorPos) >= 0x80 &&
+             (uint8_t)_text.at(_cursorPos) < 0xC0) {
         _cursorPos--;
       }
     }
   }
 
   void moveCursorRight() {
-    if (_cursorPos < _bufLen) {
+    int len = _text.length();
+    if (_cursorPos < len) {
       _cursorPos++;
-      while (_cursorPos < _bufLen && (uint8_t)_buf[_cursorPos] >= 0x80 &&
-             (uint8_t)_buf[_cursorPos] < 0xC0) {
+      while (_cursorPos < len && (uint8_t)_text.at(_cursorPos) >= 0x80 &&
+             (uint8_t)_text.at(_cursorPos) < 0xC0) {
         _cursorPos++;
       }
     }
   }
 
   void moveCursorUp() {
-    buildEditorLines();
+    if (!_editorLinesValid) buildEditorLines();
     int curLine = lineForPos(_cursorPos);
     if (curLine > 0) {
       int col = colForPos(_cursorPos, _editorLines[curLine].start);
@@ -1295,7 +1317,7 @@ public:
   }
 
   void moveCursorDown() {
-    buildEditorLines();
+    if (!_editorLinesValid) buildEditorLines();
     int curLine = lineForPos(_cursorPos);
     if (curLine < _numEditorLines - 1) {
       int col = colForPos(_cursorPos, _editorLines[curLine].start);
@@ -1336,7 +1358,7 @@ public:
 
   void saveAndExit() {
     if (_dirty && _currentFile.length() > 0) {
-      if (_bufLen > 0) {
+      if (_text.length() > 0) {
         drawBriefSplash("Saving...");
         saveNote();
       } else if (_dirty) {
@@ -1361,8 +1383,8 @@ public:
     }
     _dirty = false;
     _currentFile = "";
-    _bufLen = 0;
-    _buf[0] = '\0';
+    _text.clear();
+    _editorLinesValid = false;
     _cursorPos = 0;
     _mode = FILE_LIST;
     _selectedFile = 0;
@@ -1370,7 +1392,7 @@ public:
   }
 
   void exitNotes() {
-    if (_dirty && _bufLen > 0) {
+    if (_dirty && _text.length() > 0) {
       saveNote();
     }
     _mode = FILE_LIST;
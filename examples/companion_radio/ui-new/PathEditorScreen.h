@@ -3,6 +3,7 @@
 #include <helpers/ui/UIScreen.h>
 #include <helpers/ui/DisplayDriver.h>
 #include <MeshCore.h>
+#include "../MeshTask.h"
 #include <Packet.h>
 
 // Forward declarations
@@ -74,10 +75,10 @@ private:
 
   void buildRepeaterList() {
     _repCount = 0;
-    uint32_t numContacts = the_mesh.getNumContacts();
+    uint32_t numContacts = locked(the_mesh)->getNumContacts();
     ContactInfo c;
     for (uint32_t i = 0; i < numContacts && _repCount < MAX_REPEATERS; i++) {
-      if (the_mesh.getContactByIdx(i, c)) {
+      if (locked(the_mesh)->getContactByIdx(i, c)) {
         if (c.type == ADV_TYPE_REPEATER) {
           _repIdx[_repCount++] = (uint16_t)i;
         }
@@ -89,10 +90,10 @@ private:
   bool findNameForHop(int hopIndex, char* name, size_t nameLen) const {
     if (hopIndex < 0 || hopIndex >= _hopCount) return false;
     int offset = hopIndex * _bytesPerHop;
-    uint32_t numContacts = the_mesh.getNumContacts();
+    uint32_t numContacts = locked(the_mesh)->getNumContacts();
     ContactInfo c;
     for (uint32_t i = 0; i < numContacts; i++) {
-      if (the_mesh.getContactByIdx(i, c)) {
+      if (locked(the_mesh)->getContactByIdx(i, c)) {
         bool match = true;
         for (int b = 0; b < _bytesPerHop; b++) {
           if (c.id.pub_key[b] != _pathBuf[offset + b]) {
@@ -162,7 +163,7 @@ private:
 
   bool isCustomPathSet() const {
     ContactInfo c;
-    if (!the_mesh.getContactByIdx(_contactIdx, c)) return false;
+    if (!locked(the_mesh)->getContactByIdx(_contactIdx, c)) return false;
     return (c.flags & CONTACT_FLAG_CUSTOM_PATH) != 0;
   }
 
@@ -193,7 +194,7 @@ public:
 
     // Load contact info
     ContactInfo c;
-    if (the_mesh.getContactByIdx(contactIdx, c)) {
+    if (locked(the_mesh)->getContactByIdx(contactIdx, c)) {
       strncpy(_contactName, c.name, sizeof(_contactName) - 1);
       _contactName[sizeof(_contactName) - 1] = '\0';
 
@@ -429,7 +430,7 @@ public:
 
       for (int i = startIdx; i < endIdx && y + lineH <= maxY; i++) {
         ContactInfo c;
-        if (!the_mesh.getContactByIdx(_repIdx[i], c)) continue;
+        if (!locked(the_mesh)->getContactByIdx(_repIdx[i], c)) continue;
 
         bool selected = (i == _repSel);
 
@@ -715,11 +716,11 @@ private:
       for (int h = 0; h < _hopCount && newHopCount < 8; h++) {
         int oldOffset = h * _bytesPerHop;
         // Try to find the contact that matches this hop
-        uint32_t numContacts = the_mesh.getNumContacts();
+        uint32_t numContacts = locked(the_mesh)->getNumContacts();
         ContactInfo c;
         bool found = false;
         for (uint32_t i = 0; i < numContacts; i++) {
-          if (the_mesh.getContactByIdx(i, c)) {
+          if (locked(the_mesh)->getContactByIdx(i, c)) {
             bool match = true;
             for (int b = 0; b < _bytesPerHop; b++) {
               if (c.id.pub_key[b] != _pathBuf[oldOffset + b]) {
@@ -765,7 +766,7 @@ private:
   void addHopFromContact(uint16_t contactTableIdx) {
     if (_hopCount >= 8) return;
     ContactInfo c;
-    if (!the_mesh.getContactByIdx(contactTableIdx, c)) return;
+    if (!locked(the_mesh)->getContactByIdx(contactTableIdx, c)) return;
 
     int offset = _hopCount * _bytesPerHop;
     if (offset + _bytesPerHop > MAX_PATH_SIZE) return;
@@ -783,23 +784,23 @@ private:
 
     if (_directLocked) {
       // Set as direct (0 hops) with lock — prevents flood routing
-      the_mesh.setCustomPath(_contactIdx, _pathBuf, 0, true);
+      locked(the_mesh)->setCustomPath(_contactIdx, _pathBuf, 0, true);
       Serial.printf("PathEditor: set DIRECT path for contact %d (%s)\n",
                      _contactIdx, _contactName);
     } else if (_hopCount > 0) {
       // Set custom path with lock
-      the_mesh.setCustomPath(_contactIdx, _pathBuf, encodePath(), true);
+      locked(the_mesh)->setCustomPath(_contactIdx, _pathBuf, encodePath(), true);
       Serial.printf("PathEditor: saved %d-hop %dB/hop path for contact %d (%s)\n",
                      _hopCount, _bytesPerHop, _contactIdx, _contactName);
     } else {
       // Clear custom path — revert to auto-discovery
-      the_mesh.clearCustomPath(_contactIdx);
+      locked(the_mesh)->clearCustomPath(_contactIdx);
       Serial.printf("PathEditor: cleared custom path for contact %d (%s)\n",
                      _contactIdx, _contactName);
     }
 
     // Trigger contact save to SD
-    the_mesh.saveContacts();
+    locked(the_mesh)->saveContacts();
     _dirty = false;
   }
 };
\ No newline at end of file
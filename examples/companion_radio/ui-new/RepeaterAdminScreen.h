@@ -3,6 +3,7 @@
 #include <helpers/ui/UIScreen.h>
 #include <helpers/ui/DisplayDriver.h>
 #include <MeshCore.h>
+#include "../MeshTask.h"
 
 // Forward declarations
 #include "../AbstractUITask.h"
@@ -369,13 +370,19 @@ private:
       }
 
       // Resolve hex prefix to contact name
+      char nameBuf[32];
       const char* nodeName = NULL;
       uint8_t pubkeyBytes[PUB_KEY_SIZE];
       int byteLen = hexLen / 2;
       if (byteLen > 0 && byteLen <= PUB_KEY_SIZE) {
         if (mesh::Utils::fromHex(pubkeyBytes, byteLen, hexPart)) {
+          MeshLock lock;
           ContactInfo* contact = the_mesh.lookupContactByPubKey(pubkeyBytes, byteLen);
-          if (contact && contact->name[0] != '\0') nodeName = contact->name;
+          if (contact && contact->name[0] != '\0') {
+            strncpy(nameBuf, contact->name, sizeof(nameBuf) - 1);
+            nameBuf[sizeof(nameBuf) - 1] = '\0';
+            nodeName = nameBuf;
+          }
         }
       }
 
@@ -490,7 +497,7 @@ public:
       // Auto-request telemetry (battery & temperature) after login
       if (!_telemRequested) {
         _telemRequested = true;
-        bool sent = the_mesh.uiSendTelemetryRequest(_contactIdx);
+        bool sent = locked(the_mesh)->uiSendTelemetryRequest(_contactIdx);
         Serial.printf("[Admin] Telemetry request %s for contact idx %d\n",
                       sent ? "sent" : "FAILED", _contactIdx);
       }
@@ -779,8 +786,8 @@ private:
   // =====================================================================
 
   void renderCategoryMenu(DisplayDriver& display, int y, int bodyHeight) {
-    display.setTextSize(the_mesh.getNodePrefs()->smallTextSize());
-    int lineHeight = the_mesh.getNodePrefs()->smallLineH();
+    display.setTextSize(locked(the_mesh)->getNodePrefs()->smallTextSize());
+    int lineHeight = locked(the_mesh)->getNodePrefs()->smallLineH();
 
     // Clock drift info line
     if (_serverTime > 0) {
@@ -864,8 +871,8 @@ private:
   // =====================================================================
 
   void renderCommandMenu(DisplayDriver& display, int y, int bodyHeight) {
-    display.setTextSize(the_mesh.getNodePrefs()->smallTextSize());
-    int lineHeight = the_mesh.getNodePrefs()->smallLineH();
+    display.setTextSize(locked(the_mesh)->getNodePrefs()->smallTextSize());
+    int lineHeight = locked(the_mesh)->getNodePrefs()->smallLineH();
     const AdminCategoryDef& cat = CATEGORIES[_catSel];
 
     // Category title
@@ -1027,7 +1034,7 @@ private:
     if (_pendingCmd) display.print(_pendingCmd->label);
 
     y += 14;
-    display.setTextSize(the_mesh.getNodePrefs()->smallTextSize());
+    display.setTextSize(locked(the_mesh)->getNodePrefs()->smallTextSize());
     display.setCursor(0, y);
 
     // Show the param value if one was collected
@@ -1035,7 +1042,7 @@ private:
       char preview[80];
       snprintf(preview, sizeof(preview), "Value: %s", _paramBuf);
       display.print(preview);
-      y += the_mesh.getNodePrefs()->smallLineH() + 1;
+      y += locked(the_mesh)->getNodePrefs()->smallLineH() + 1;
       display.setCursor(0, y);
     }
 
@@ -1073,8 +1080,8 @@ private:
   // =====================================================================
 
   void renderResponse(DisplayDriver& display, int y, int bodyHeight) {
-    display.setTextSize(the_mesh.getNodePrefs()->smallTextSize());
-    int lineHeight = the_mesh.getNodePrefs()->smallLineH();
+    display.setTextSize(locked(the_mesh)->getNodePrefs()->smallTextSize());
+    int lineHeight = locked(the_mesh)->getNodePrefs()->smallLineH();
 
     display.setColor((_state == STATE_ERROR) ? DisplayDriver::YELLOW : DisplayDriver::LIGHT);
 
@@ -1168,7 +1175,7 @@ private:
 #if defined(LilyGo_T5S3_EPaper_Pro)
       display.fillRect(0, y, display.width(), lineHeight);
 #else
-      display.fillRect(0, y + the_mesh.getNodePrefs()->smallHighlightOff(), display.width(), lineHeight);
+      display.fillRect(0, y + locked(the_mesh)->getNodePrefs()->smallHighlightOff(), display.width(), lineHeight);
 #endif
       display.setColor(DisplayDriver::DARK);
     } else if (warn) {
@@ -1190,7 +1197,7 @@ private:
   bool sendCommand(const char* cmd) {
     if (_contactIdx < 0 || !cmd || cmd[0] == '\0') return false;
 
-    if (the_mesh.uiSendCliCommand(_contactIdx, cmd)) {
+    if (locked(the_mesh)->uiSendCliCommand(_contactIdx, cmd)) {
       _state = STATE_COMMAND_PENDING;
       _cmdSentAt = millis();
       _response[0] = '\0';
@@ -1215,7 +1222,7 @@ inline bool RepeaterAdminScreen::doLogin() {
   if (_contactIdx < 0 || _pwdLen == 0) return false;
 
   uint32_t timeout_ms = 0;
-  if (the_mesh.uiLoginToRepeater(_contactIdx, _password, timeout_ms)) {
+  if (locked(the_mesh)->uiLoginToRepeater(_contactIdx, _password, timeout_ms)) {
     _state = STATE_LOGGING_IN;
     _cmdSentAt = millis();
     // Add a 5s buffer over the mesh estimate to account for blocking e-ink
@@ -3,6 +3,7 @@
 #include <helpers/ui/UIScreen.h>
 #include <helpers/ui/DisplayDriver.h>
 #include <MeshCore.h>
+#include "../MeshTask.h"
 
 class UITask;            // forward decl -- used only to navigate back to Settings
 extern MyMesh the_mesh;
@@ -14,6 +15,8 @@ extern MyMesh the_mesh;
 // size, hash, path, channel hash/name or From/To, the decoded line (for
 // decryptable channels), and SNR. Entries are shown newest-first; W/S scroll
 // by entry, Q returns to Settings (where the screen is opened from).
+// Below the header, a channel summary line (last 5 minutes) from the radio's
+// ChannelAnalytics: busy %, rx airtime %, collision estimate, noise floor.
 // ==========================================================================
 
 class RxLogScreen : public UIScreen {
@@ -61,7 +64,7 @@ class RxLogScreen : public UIScreen {
     if (y + lineH > maxY) return y;
 
     // Line 2: time (HH:MM:SS, device UTC offset) + size
-    int32_t local = (int32_t)e.timestamp + ((int32_t)the_mesh.getNodePrefs()->utc_offset_hours * 3600);
+    int32_t local = (int32_t)e.timestamp + ((int32_t)locked(the_mesh)->getNodePrefs()->utc_offset_hours * 3600);
     int hrs = (local / 3600) % 24;
     int mins = (local / 60) % 60;
     int secs = local % 60;
@@ -139,7 +142,7 @@ public:
   void resetScroll() { _scrollPos = 0; }
 
   int render(DisplayDriver& display) override {
-    int count = the_mesh.getRxLogCount();
+    int count = locked(the_mesh)->getRxLogCount();
     if (_scrollPos < 0) _scrollPos = 0;
     if (_scrollPos > count - 1) _scrollPos = (count > 0) ? count - 1 : 0;
 
@@ -152,27 +155,41 @@ public:
     display.print(hdr);
     display.drawRect(0, 11, display.width(), 1);
 
-    int headerHeight = 14;
+    ChannelStats cs;
+    radio_driver.getChannelStats(5, cs);
+    char chbuf[48];
+    snprintf(chbuf, sizeof(chbuf), "5m Busy %u%% Rx %u%% Coll %u%% NF %d", (unsigned)cs.busyPercent(),
+             (unsigned)cs.rxAirPercent(), (unsigned)cs.collisionPercent(), (int)cs.rssi_p10);
+    display.setColor(DisplayDriver::LIGHT);
+    display.drawTextEllipsized(0, 14, display.width(), chbuf);
+    display.drawRect(0, 25, display.width(), 1);
+
+    int headerHeight = 28;
     int footerHeight = 14;
     int maxY = display.height() - footerHeight;
     int y = headerHeight;
 
     if (count == 0) {
       display.setColor(DisplayDriver::LIGHT);
-      display.setCursor(4, 28);
+      display.setCursor(4, 32);
       display.print("No packets received yet");
-      display.setCursor(4, 38);
+      display.setCursor(4, 42);
       display.print("Packets appear as they arrive");
     } else {
-      display.setTextSize(the_mesh.getNodePrefs()->smallTextSize());
-      int lineH = the_mesh.getNodePrefs()->smallLineH();
+      display.setTextSize(locked(the_mesh)->getNodePrefs()->smallTextSize());
+      int lineH = locked(the_mesh)->getNodePrefs()->smallLineH();
 
       // Render blocks newest-first, starting at display index _scrollPos,
       // until the screen is full.
       for (int d = _scrollPos; d < count && y + lineH <= maxY; d++) {
-        const RxLogEntry* e = the_mesh.getRxLogEntry(count - 1 - d);
-        if (!e) break;
-        y = renderEntry(display, *e, y, lineH, maxY);
+        RxLogEntry e;
+        {
+          MeshLock lock;   // ring entries are overwritten as packets arrive
+          const RxLogEntry* src = the_mesh.getRxLogEntry(count - 1 - d);
+          if (!src) break;
+          e = *src;
+        }
+        y = renderEntry(display, e, y, lineH, maxY);
         y += 3;  // gap between entry blocks
       }
     }
@@ -194,7 +211,7 @@ public:
   }
 
   bool handleInput(char c) override {
-    int count = the_mesh.getRxLogCount();
+    int count = locked(the_mesh)->getRxLogCount();
 
     // Scroll up (toward newest)
     if (c == 'w' || c == 'W' || c == 0xF2) {
@@ -0,0 +1,105 @@
+#include "SDWriteScheduler.h"
+
+// Global singleton
+SDWriteScheduler sdWriter;
+
+int SDWriteScheduler::registerJob(const char* name, SDWriteFn fn, void* ctx, SDWritePriority prio) {
+  if (_numJobs >= SD_WRITE_MAX_JOBS) {
+    Serial.printf("SDWrite: job table full, '%s' will not be saved\n", name);
+    return -1;
+  }
+  Job& j = _jobs[_numJobs];
+  j.name = name;
+  j.fn = fn;
+  j.ctx = ctx;
+  j.due = 0;
+  j.prio = prio;
+  j.state = CLEAN;
+  j.redo = false;
+  return _numJobs++;
+}
+
+unsigned long SDWriteScheduler::delayFor(SDWritePriority prio) {
+  switch (prio) {
+    case SD_WRITE_SOON:   return SD_WRITE_DELAY_SOON;
+    case SD_WRITE_NORMAL: return SD_WRITE_DELAY_NORMAL;
+    default:              return SD_WRITE_DELAY_LAZY;
+  }
+}
+
+void SDWriteScheduler::markDirty(int id) {
+  if (id < 0 || id >= _numJobs) return;
+  Job& j = _jobs[id];
+  switch (j.state) {
+    case CLEAN:
+      j.state = DIRTY;
+      j.due = millis() + delayFor(j.prio);
+      _pending++;
+      break;
+    case DIRTY:
+      _coalesced++;   // keep the original due time, so latency stays bounded
+      break;
+    case RUNNING:
+      j.redo = true;
+      break;
+  }
+}
+
+bool SDWriteScheduler::isPending(int id) const {
+  return id >= 0 && id < _numJobs && _jobs[id].state != CLEAN;
+}
+
+// Running jobs first (finish what's started), then most urgent class, then earliest
+int SDWriteScheduler::nextDue(unsigned long now) const {
+  int best = -1;
+  for (int i = 0; i < _numJobs; i++) {
+    const Job& j = _jobs[i];
+    if (j.state == RUNNING) return i;
+    if (j.state != DIRTY || (long)(now - j.due) < 0) continue;
+    if (best < 0 || j.prio < _jobs[best].prio ||
+        (j.prio == _jobs[best].prio && (long)(j.due - _jobs[best].due) < 0)) {
+      best = i;
+    }
+  }
+  return best;
+}
+
+void SDWriteScheduler::runJob(int id) {
+  Job& j = _jobs[id];
+  if (!j.fn(j.ctx)) {
+    j.state = RUNNING;
+    return;
+  }
+  _writes++;
+  if (j.redo) {
+    j.redo = false;
+    j.state = DIRTY;
+    j.due = millis() + delayFor(j.prio);
+  } else {
+    j.state = CLEAN;
+    _pending--;
+  }
+}
+
+void SDWriteScheduler::loop() {
+  if (_pending == 0) return;
+
+  unsigned long start = millis();
+  int id;
+  while ((id = nextDue(millis())) >= 0) {
+    runJob(id);
+    if (millis() - start >= SD_WRITE_SLICE_MS) break;
+  }
+}
+
+void SDWriteScheduler::flush(int id) {
+  if (id < 0 || id >= _numJobs) return;
+  while (_jobs[id].state != CLEAN) runJob(id);
+}
+
+void SDWriteScheduler::flush() {
+  if (_pending == 0) return;
+  unsigned long start = millis();
+  for (int i = 0; i < _numJobs; i++) flush(i);
+  Serial.printf("SDWrite: flushed in %lums\n", millis() - start);
+}
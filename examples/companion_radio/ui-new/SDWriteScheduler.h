@@ -0,0 +1,89 @@
+#pragma once
+
+// =============================================================================
+// SDWriteScheduler - write-behind for SD card persistence
+//
+// Screens and stores register one job per file (a callback that writes it)
+// and call markDirty() instead of writing from the input path. loop() runs
+// jobs that have come due, most urgent class first, until its time slice is
+// used up, so repeated changes coalesce into one write and a key press never
+// waits on a multi-hundred-ms SD write.
+//
+// A job returns true when the file is written, or false to be called again
+// on the next loop() (for writing big files a chunk at a time). Marking a job
+// dirty while it is part way through queues one more full write after it.
+//
+// flush() is the barrier before sleep / power-off: runs everything pending.
+// =============================================================================
+
+#include <Arduino.h>
+
+#ifndef SD_WRITE_MAX_JOBS
+  #define SD_WRITE_MAX_JOBS      12
+#endif
+#ifndef SD_WRITE_SLICE_MS
+  #define SD_WRITE_SLICE_MS      20      // loop() stops starting jobs after this
+#endif
+#ifndef SD_WRITE_DELAY_SOON
+  #define SD_WRITE_DELAY_SOON    1000    // state the user would notice losing (read marks, bookmarks)
+#endif
+#ifndef SD_WRITE_DELAY_NORMAL
+  #define SD_WRITE_DELAY_NORMAL  5000    // message history
+#endif
+#ifndef SD_WRITE_DELAY_LAZY
+  #define SD_WRITE_DELAY_LAZY    30000   // periodic positions, caches
+#endif
+
+enum SDWritePriority : uint8_t {
+  SD_WRITE_SOON = 0,
+  SD_WRITE_NORMAL,
+  SD_WRITE_LAZY,
+};
+
+typedef bool (*SDWriteFn)(void* ctx);   // returns true when done
+
+class SDWriteScheduler {
+public:
+  // Returns job id, or -1 if the table is full
+  int registerJob(const char* name, SDWriteFn fn, void* ctx, SDWritePriority prio);
+
+  void markDirty(int id);
+  bool isPending(int id) const;
+
+  // Run jobs that are due, within SD_WRITE_SLICE_MS (call from main loop)
+  void loop();
+
+  // Write one job / everything now, regardless of due time
+  void flush(int id);
+  void flush();
+
+  bool hasPending() const { return _pending > 0; }
+  uint32_t getWriteCount() const { return _writes; }
+  uint32_t getCoalescedCount() const { return _coalesced; }
+
+private:
+  enum State : uint8_t { CLEAN, DIRTY, RUNNING };
+
+  struct Job {
+    const char* name;
+    SDWriteFn fn;
+    void* ctx;
+    unsigned long due;
+    SDWritePriority prio;
+    State state;
+    bool redo;       // marked dirty again while RUNNING
+  };
+
+  Job _jobs[SD_WRITE_MAX_JOBS];
+  int _numJobs = 0;
+  int _pending = 0;  // jobs DIRTY or RUNNING
+  uint32_t _writes = 0;
+  uint32_t _coalesced = 0;
+
+  static unsigned long delayFor(SDWritePriority prio);
+  int nextDue(unsigned long now) const;
+  void runJob(int id);
+};
+
+// Global singleton
+extern SDWriteScheduler sdWriter;
@@ -69,6 +69,7 @@ private:
   SMSMessage _msgs[SMS_MSG_PAGE_SIZE];
   int  _msgCount;
   int  _msgScrollPos;
+  int  _msgOffset;      // newest messages not loaded (paging back through history)
 
   // Compose state
   char _composeBuf[SMS_COMPOSE_MAX + 1];
@@ -113,17 +114,35 @@ private:
   }
 
   void refreshConversation() {
+    _msgOffset = 0;
     _msgCount = smsStore.loadMessages(_activePhone, _msgs, SMS_MSG_PAGE_SIZE);
     // Scroll to bottom (newest messages are at end now, chat-style)
     _msgScrollPos = (_msgCount > 3) ? _msgCount - 3 : 0;
   }
 
+  // Slide the loaded window half a page older/newer, keeping the same
+  // message under the scroll position. Returns false at either end.
+  bool pageConversation(bool older) {
+    int total = smsStore.getMessageCount(_activePhone);
+    int maxOffset = max(0, total - SMS_MSG_PAGE_SIZE);
+    int newOffset = _msgOffset + (older ? SMS_MSG_PAGE_SIZE / 2 : -SMS_MSG_PAGE_SIZE / 2);
+    newOffset = constrain(newOffset, 0, maxOffset);
+    if (newOffset == _msgOffset) return false;
+
+    int oldStart = max(0, total - _msgOffset - SMS_MSG_PAGE_SIZE);
+    int newStart = max(0, total - newOffset - SMS_MSG_PAGE_SIZE);
+    _msgCount = smsStore.loadMessages(_activePhone, _msgs, SMS_MSG_PAGE_SIZE, newOffset);
+    _msgOffset = newOffset;
+    _msgScrollPos = constrain(_msgScrollPos + oldStart - newStart, 0, max(0, _msgCount - 1));
+    return true;
+  }
+
 public:
   SMSScreen(UITask* task, NodePrefs* prefs = nullptr)
     : _task(task), _prefs(prefs), _view(APP_MENU)
     , _menuCursor(0)
     , _convCount(0), _inboxCursor(0), _inboxScrollTop(0)
-    , _msgCount(0), _msgScrollPos(0)
+    , _msgCount(0), _msgScrollPos(0), _msgOffset(0)
     , _composePos(0), _composeNewConversation(false)
     , _phoneInputPos(0), _enteringPhone(false)
     , _contactsCursor(0), _contactsScrollTop(0)
@@ -1357,10 +1376,12 @@ public:
   bool handleConversationInput(char c) {
     switch (c) {
       case 'w': case 'W':
+        if (_msgScrollPos == 0) pageConversation(true);
         if (_msgScrollPos > 0) _msgScrollPos--;
         return true;
 
       case 's': case 'S':
+        if (_msgScrollPos >= _msgCount - 1) pageConversation(false);
         if (_msgScrollPos < _msgCount - 1) _msgScrollPos++;
         return true;
 
@@ -1,6 +1,7 @@
 #ifdef HAS_4G_MODEM
 
 #include "SMSStore.h"
+#include "SDWriteScheduler.h"
 #include <Mesh.h>   // For MESH_DEBUG_PRINTLN
 #include "target.h" // For SDCARD_CS macro
 
@@ -14,6 +15,9 @@ void SMSStore::begin() {
     MESH_DEBUG_PRINTLN("[SMSStore] created %s", SMS_DIR);
   }
   _ready = true;
+  if (_readJob < 0) {
+    _readJob = sdWriter.registerJob("sms-read", readJob, this, SD_WRITE_SOON);
+  }
 
   // One-time migration: history saved before read-tracking existed has read=0,
   // which would otherwise all show as unread. Mark it read once, gated by a
@@ -23,26 +27,193 @@ void SMSStore::begin() {
     File m = SD.open(SMS_READ_MIGRATED, FILE_WRITE);
     if (m) m.close();
     digitalWrite(SDCARD_CS, HIGH);
+    SD.remove(SMS_INDEX_FILE);   // counts changed under it
+  }
+
+  if (!loadIndex()) {
+    rebuildIndex();
   }
 
-  MESH_DEBUG_PRINTLN("[SMSStore] ready");
+  MESH_DEBUG_PRINTLN("[SMSStore] ready, %d conversations", getConversationCount());
+}
+
+void SMSStore::sanitisePhone(const char* phone, char* out, size_t outLen) {
+  size_t j = 0;
+  for (int i = 0; phone[i] && j < outLen - 1; i++) {
+    char c = phone[i];
+    if ((c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')) {
+      out[j++] = c;
+    }
+  }
+  out[j] = '\0';
 }
 
 void SMSStore::phoneToFilename(const char* phone, char* out, size_t outLen) {
   // Convert phone number to safe filename: strip non-alphanumeric, prefix with dir
   // e.g. "+1234567890" -> "/sms/p1234567890.sms"
   char safe[SMS_PHONE_LEN];
-  int j = 0;
-  for (int i = 0; phone[i] && j < SMS_PHONE_LEN - 1; i++) {
-    char c = phone[i];
-    if ((c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')) {
-      safe[j++] = c;
+  sanitisePhone(phone, safe, sizeof(safe));
+  snprintf(out, outLen, "%s/p%s.sms", SMS_DIR, safe);
+}
+
+// ---------------------------------------------------------------------------
+// Inbox index
+// ---------------------------------------------------------------------------
+
+// Same file = same conversation, so match on the sanitised number
+int SMSStore::findEntry(const char* phone) const {
+  char key[SMS_PHONE_LEN], other[SMS_PHONE_LEN];
+  sanitisePhone(phone, key, sizeof(key));
+  for (int i = 0; i < _indexUsed; i++) {
+    if (_index[i].phone[0] == '\0') continue;
+    sanitisePhone(_index[i].phone, other, sizeof(other));
+    if (strcmp(key, other) == 0) return i;
+  }
+  return -1;
+}
+
+// Reuse a freed slot, or add one (growing the table)
+int SMSStore::allocEntry() {
+  for (int i = 0; i < _indexUsed; i++) {
+    if (_index[i].phone[0] == '\0') return i;
+  }
+  return appendEntry();
+}
+
+// Add a slot at the end, so RAM slot i stays file slot i
+int SMSStore::appendEntry() {
+  if (_indexUsed >= _indexCap) {
+    int newCap = _indexCap > 0 ? _indexCap * 2 : SMS_INDEX_INITIAL;
+#ifdef BOARD_HAS_PSRAM
+    SMSIndexEntry* ni = (SMSIndexEntry*)ps_malloc(newCap * sizeof(SMSIndexEntry));
+#else
+    SMSIndexEntry* ni = (SMSIndexEntry*)malloc(newCap * sizeof(SMSIndexEntry));
+#endif
+    if (!ni) return -1;
+    if (_index) {
+      memcpy(ni, _index, _indexUsed * sizeof(SMSIndexEntry));
+      free(_index);
     }
+    _index = ni;
+    _indexCap = newCap;
   }
-  safe[j] = '\0';
-  snprintf(out, outLen, "%s/p%s.sms", SMS_DIR, safe);
+  memset(&_index[_indexUsed], 0, sizeof(SMSIndexEntry));
+  return _indexUsed++;
+}
+
+// Rewrite one slot in place (the file is never rewritten as a whole after a rebuild)
+void SMSStore::writeEntry(int slot) {
+  File f = SD.open(SMS_INDEX_FILE, "r+");
+  if (!f) {
+    MESH_DEBUG_PRINTLN("[SMSStore] can't open %s", SMS_INDEX_FILE);
+    return;
+  }
+  f.seek(sizeof(SMSIndexHeader) + (size_t)slot * sizeof(SMSIndexEntry));
+  f.write((uint8_t*)&_index[slot], sizeof(SMSIndexEntry));
+  f.close();
+  digitalWrite(SDCARD_CS, HIGH);
 }
 
+bool SMSStore::loadIndex() {
+  File f = SD.open(SMS_INDEX_FILE, FILE_READ);
+  if (!f) return false;
+
+  SMSIndexHeader hdr;
+  if (f.read((uint8_t*)&hdr, sizeof(hdr)) != sizeof(hdr) ||
+      hdr.magic != SMS_INDEX_MAGIC || hdr.version != SMS_INDEX_VERSION ||
+      hdr.entrySize != sizeof(SMSIndexEntry)) {
+    f.close();
+    digitalWrite(SDCARD_CS, HIGH);
+    return false;
+  }
+
+  int slots = (f.size() - sizeof(hdr)) / sizeof(SMSIndexEntry);
+  _indexUsed = 0;
+  for (int i = 0; i < slots; i++) {   // freed slots are kept, writeEntry() addresses the file by slot
+    int slot = appendEntry();
+    if (slot < 0) break;
+    if (f.read((uint8_t*)&_index[slot], sizeof(SMSIndexEntry)) != sizeof(SMSIndexEntry)) {
+      _indexUsed--;
+      break;
+    }
+  }
+  f.close();
+  digitalWrite(SDCARD_CS, HIGH);
+  return true;
+}
+
+// Fill an index entry from a conversation file, scanning every record
+void SMSStore::scanFileInto(File& f, SMSIndexEntry& e) {
+  int numRecords = f.size() / sizeof(SMSRecord);
+  e.messageCount = numRecords;
+  e.unreadCount = 0;
+  e.firstUnread = numRecords;
+
+  SMSRecord rec;
+  f.seek(0);
+  for (int i = 0; i < numRecords; i++) {
+    if (f.read((uint8_t*)&rec, sizeof(SMSRecord)) != sizeof(SMSRecord)) break;
+    if (rec.isSent == 0 && rec.read == 0) {
+      if (e.unreadCount == 0) e.firstUnread = i;
+      e.unreadCount++;
+    }
+    if (i == numRecords - 1) {
+      strncpy(e.phone, rec.phone, SMS_PHONE_LEN - 1);
+      e.phone[SMS_PHONE_LEN - 1] = '\0';
+      strncpy(e.preview, rec.body, sizeof(e.preview) - 1);
+      e.preview[sizeof(e.preview) - 1] = '\0';
+      e.lastTimestamp = rec.timestamp;
+    }
+  }
+}
+
+// Build the index from scratch by scanning every conversation (first boot / upgrade)
+void SMSStore::rebuildIndex() {
+  unsigned long start = millis();
+  _indexUsed = 0;
+
+  File dir = SD.open(SMS_DIR);
+  if (dir && dir.isDirectory()) {
+    File entry;
+    while ((entry = dir.openNextFile())) {
+      if (!strstr(entry.name(), ".sms") || entry.size() < sizeof(SMSRecord)) {
+        entry.close();
+        continue;
+      }
+      int slot = allocEntry();
+      if (slot < 0) { entry.close(); break; }
+      scanFileInto(entry, _index[slot]);
+      if (_index[slot].phone[0] == '\0') _indexUsed--;   // unreadable
+      entry.close();
+    }
+    dir.close();
+  }
+
+  File f = SD.open(SMS_INDEX_FILE, FILE_WRITE);
+  if (f) {
+    SMSIndexHeader hdr = { SMS_INDEX_MAGIC, SMS_INDEX_VERSION, (uint16_t)sizeof(SMSIndexEntry) };
+    f.write((uint8_t*)&hdr, sizeof(hdr));
+    if (_indexUsed > 0) f.write((uint8_t*)_index, _indexUsed * sizeof(SMSIndexEntry));
+    f.close();
+  }
+  digitalWrite(SDCARD_CS, HIGH);
+
+  MESH_DEBUG_PRINTLN("[SMSStore] rebuilt index: %d conversations in %lums",
+                     _indexUsed, millis() - start);
+}
+
+int SMSStore::getConversationCount() const {
+  int n = 0;
+  for (int i = 0; i < _indexUsed; i++) {
+    if (_index[i].phone[0] != '\0') n++;
+  }
+  return n;
+}
+
+// ---------------------------------------------------------------------------
+// Messages
+// ---------------------------------------------------------------------------
+
 bool SMSStore::saveMessage(const char* phone, const char* body, bool isSent, uint32_t timestamp) {
   if (!_ready) return false;
 
@@ -72,80 +243,65 @@ bool SMSStore::saveMessage(const char* phone, const char* body, bool isSent, uin
   }
 
   size_t written = f.write((uint8_t*)&rec, sizeof(rec));
+  uint32_t numRecords = f.size() / sizeof(SMSRecord);
   f.close();
 
   // Release SD CS
   digitalWrite(SDCARD_CS, HIGH);
 
-  return written == sizeof(rec);
+  if (written != sizeof(rec)) return false;
+
+  // Update the conversation's index slot
+  int slot = findEntry(phone);
+  if (slot < 0) {
+    slot = allocEntry();
+    if (slot < 0) return true;   // message is saved; index rebuilds next boot if missing
+  }
+  SMSIndexEntry& e = _index[slot];
+  strncpy(e.phone, phone, SMS_PHONE_LEN - 1);
+  e.phone[SMS_PHONE_LEN - 1] = '\0';
+  strncpy(e.preview, rec.body, sizeof(e.preview) - 1);
+  e.preview[sizeof(e.preview) - 1] = '\0';
+  e.lastTimestamp = timestamp;
+  if (e.messageCount == 0 || e.unreadCount == 0) e.firstUnread = numRecords - 1;
+  e.messageCount = numRecords;
+  if (!isSent) e.unreadCount++;
+  writeEntry(slot);
+
+  return true;
 }
 
 int SMSStore::loadConversations(SMSConversation* out, int maxCount) {
   if (!_ready) return 0;
 
-  File dir = SD.open(SMS_DIR);
-  if (!dir || !dir.isDirectory()) return 0;
-
+  // Keep the maxCount most recent, insertion sorted (newest first)
   int count = 0;
-  File entry;
-  while ((entry = dir.openNextFile()) && count < maxCount) {
-    const char* name = entry.name();
-    // Only process .sms files
-    if (!strstr(name, ".sms")) { entry.close(); continue; }
-
-    size_t fileSize = entry.size();
-    if (fileSize < sizeof(SMSRecord)) { entry.close(); continue; }
-
-    int numRecords = fileSize / sizeof(SMSRecord);
-
-    // Scan all records: count unread received messages, keep the last for preview
-    SMSRecord rec;
-    SMSRecord lastRec;
-    memset(&lastRec, 0, sizeof(lastRec));
-    int unread = 0;
-    bool haveLast = false;
-    for (int i = 0; i < numRecords; i++) {
-      entry.seek((size_t)i * sizeof(SMSRecord));
-      if (entry.read((uint8_t*)&rec, sizeof(SMSRecord)) != sizeof(SMSRecord)) continue;
-      if (rec.isSent == 0 && rec.read == 0) unread++;
-      lastRec = rec;
-      haveLast = true;
-    }
-    if (!haveLast) { entry.close(); continue; }
-
-    SMSConversation& conv = out[count];
+  for (int i = 0; i < _indexUsed; i++) {
+    const SMSIndexEntry& e = _index[i];
+    if (e.phone[0] == '\0' || e.messageCount == 0) continue;
+
+    int pos = count;
+    while (pos > 0 && out[pos - 1].lastTimestamp < e.lastTimestamp) pos--;
+    if (pos >= maxCount) continue;
+    int last = (count < maxCount) ? count : maxCount - 1;
+    for (int j = last; j > pos; j--) out[j] = out[j - 1];
+    if (count < maxCount) count++;
+
+    SMSConversation& conv = out[pos];
     memset(&conv, 0, sizeof(SMSConversation));
-    strncpy(conv.phone, lastRec.phone, SMS_PHONE_LEN - 1);
-    strncpy(conv.preview, lastRec.body, 39);
+    strncpy(conv.phone, e.phone, SMS_PHONE_LEN - 1);
+    strncpy(conv.preview, e.preview, 39);
     conv.preview[39] = '\0';
-    conv.lastTimestamp = lastRec.timestamp;
-    conv.messageCount = numRecords;
-    conv.unreadCount = unread;
+    conv.lastTimestamp = e.lastTimestamp;
+    conv.messageCount = e.messageCount;
+    conv.unreadCount = e.unreadCount;
     conv.valid = true;
-
-    count++;
-    entry.close();
-  }
-  dir.close();
-
-  // Release SD CS
-  digitalWrite(SDCARD_CS, HIGH);
-
-  // Sort by most recent (simple bubble sort, small N)
-  for (int i = 0; i < count - 1; i++) {
-    for (int j = 0; j < count - 1 - i; j++) {
-      if (out[j].lastTimestamp < out[j + 1].lastTimestamp) {
-        SMSConversation tmp = out[j];
-        out[j] = out[j + 1];
-        out[j + 1] = tmp;
-      }
-    }
   }
 
   return count;
 }
 
-int SMSStore::loadMessages(const char* phone, SMSMessage* out, int maxCount) {
+int SMSStore::loadMessages(const char* phone, SMSMessage* out, int maxCount, int skipNewest) {
   if (!_ready) return 0;
 
   char filepath[64];
@@ -157,15 +313,24 @@ int SMSStore::loadMessages(const char* phone, SMSMessage* out, int maxCount) {
   size_t fileSize = f.size();
   int numRecords = fileSize / sizeof(SMSRecord);
 
-  // Load from end of file (most recent N messages), in chronological order
-  int startIdx = numRecords > maxCount ? numRecords - maxCount : 0;
+  // Self-heal: an append that lost power before its index update
+  int slot = findEntry(phone);
+  if (slot >= 0 && _index[slot].messageCount != (uint32_t)numRecords) {
+    scanFileInto(f, _index[slot]);
+    writeEntry(slot);
+  }
+
+  // Window of maxCount records ending skipNewest from the end, in chronological order
+  int endIdx = numRecords - skipNewest;
+  if (endIdx < 0) endIdx = 0;
+  int startIdx = endIdx > maxCount ? endIdx - maxCount : 0;
 
-  // Read chronologically (oldest first) for chat-style display
+  // Read chronologically (oldest first) for chat-style display; one seek, then sequential
   SMSRecord rec;
   int outIdx = 0;
-  for (int i = startIdx; i < numRecords && outIdx < maxCount; i++) {
-    f.seek(i * sizeof(SMSRecord));
-    if (f.read((uint8_t*)&rec, sizeof(SMSRecord)) != sizeof(SMSRecord)) continue;
+  f.seek((size_t)startIdx * sizeof(SMSRecord));
+  for (int i = startIdx; i < endIdx && outIdx < maxCount; i++) {
+    if (f.read((uint8_t*)&rec, sizeof(SMSRecord)) != sizeof(SMSRecord)) break;
 
     out[outIdx].timestamp = rec.timestamp;
     out[outIdx].isSent = rec.isSent != 0;
@@ -192,37 +357,33 @@ bool SMSStore::deleteConversation(const char* phone) {
 
   digitalWrite(SDCARD_CS, HIGH);
 
+  int slot = findEntry(phone);
+  if (slot >= 0) {
+    memset(&_index[slot], 0, sizeof(SMSIndexEntry));
+    writeEntry(slot);
+  }
   return ok;
 }
 
 int SMSStore::getMessageCount(const char* phone) {
   if (!_ready) return 0;
 
-  char filepath[64];
-  phoneToFilename(phone, filepath, sizeof(filepath));
-
-  File f = SD.open(filepath, FILE_READ);
-  if (!f) return 0;
-
-  int count = f.size() / sizeof(SMSRecord);
-  f.close();
-
-  digitalWrite(SDCARD_CS, HIGH);
-
-  return count;
+  int slot = findEntry(phone);
+  return slot >= 0 ? (int)_index[slot].messageCount : 0;
 }
 
-void SMSStore::markFileRead(const char* filepath) {
+void SMSStore::markFileRead(const char* filepath, uint32_t from, uint32_t upTo) {
   // In-place flag update: open read+write without truncating ("r+").
   // Caller releases SDCARD_CS afterwards.
   File f = SD.open(filepath, "r+");
   if (!f) return;
 
   size_t fileSize = f.size();
-  int numRecords = fileSize / sizeof(SMSRecord);
+  uint32_t numRecords = fileSize / sizeof(SMSRecord);
+  if (upTo > numRecords) upTo = numRecords;
 
   SMSRecord rec;
-  for (int i = 0; i < numRecords; i++) {
+  for (uint32_t i = from; i < upTo; i++) {
     f.seek((size_t)i * sizeof(SMSRecord));
     if (f.read((uint8_t*)&rec, sizeof(SMSRecord)) != sizeof(SMSRecord)) continue;
     if (rec.isSent == 0 && rec.read == 0) {
@@ -238,11 +399,48 @@ void SMSStore::markFileRead(const char* filepath) {
 void SMSStore::markConversationRead(const char* phone) {
   if (!_ready) return;
 
+  int slot = findEntry(phone);
+  if (slot < 0 || _index[slot].unreadCount == 0) return;
+  _index[slot].unreadCount = 0;   // inbox sees it now, files follow via sdWriter
+
+  for (int i = 0; i < _numPendingRead; i++) {
+    if (strcmp(_pendingRead[i].phone, phone) == 0) {
+      _pendingRead[i].upTo = _index[slot].messageCount;
+      return;   // already queued
+    }
+  }
+  if (_numPendingRead >= SMS_PENDING_READ) sdWriter.flush(_readJob);
+
+  PendingRead& p = _pendingRead[_numPendingRead++];
+  strncpy(p.phone, phone, SMS_PHONE_LEN - 1);
+  p.phone[SMS_PHONE_LEN - 1] = '\0';
+  p.from = _index[slot].firstUnread;
+  p.upTo = _index[slot].messageCount;
+
+  if (_readJob >= 0) sdWriter.markDirty(_readJob);
+  else readJob(this);
+}
+
+// Rewrite read flags from the first unread record only, then the index slot
+bool SMSStore::readJob(void* ctx) {
+  SMSStore* self = (SMSStore*)ctx;
   char filepath[64];
-  phoneToFilename(phone, filepath, sizeof(filepath));
-  markFileRead(filepath);
+  for (int i = 0; i < self->_numPendingRead; i++) {
+    const PendingRead& p = self->_pendingRead[i];
+    int slot = self->findEntry(p.phone);
+    if (slot < 0) continue;   // deleted meanwhile
+
+    SMSIndexEntry& e = self->_index[slot];
+    self->phoneToFilename(p.phone, filepath, sizeof(filepath));
+    self->markFileRead(filepath, p.from, p.upTo);
+    // if something arrived since the mark, saveMessage already pointed firstUnread at it
+    if (e.unreadCount == 0) e.firstUnread = e.messageCount;
+    self->writeEntry(slot);
+  }
+  self->_numPendingRead = 0;
 
   digitalWrite(SDCARD_CS, HIGH);
+  return true;
 }
 
 void SMSStore::migrateExistingAsRead() {
@@ -271,4 +469,4 @@ void SMSStore::migrateExistingAsRead() {
   digitalWrite(SDCARD_CS, HIGH);
 }
 
-#endif // HAS_4G_MODEM
\ No newline at end of file
+#endif // HAS_4G_MODEM
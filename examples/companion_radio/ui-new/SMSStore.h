@@ -7,6 +7,12 @@
 // Each conversation is a separate file named by phone number (sanitised).
 // Messages are appended as fixed-size records for simple random access.
 //
+// /sms/inbox.idx holds one fixed-size summary slot per conversation (last
+// message, counts, first unread record). It is loaded into RAM at begin()
+// and each append / read mark / delete rewrites just that slot, so the
+// inbox never has to open the conversation files. Rebuilt by scanning /sms
+// if missing or from another version.
+//
 // Guard: HAS_4G_MODEM
 // =============================================================================
 
@@ -23,6 +29,11 @@
 #define SMS_MAX_CONVERSATIONS 20
 #define SMS_DIR          "/sms"
 #define SMS_READ_MIGRATED "/sms/rdmig.dat"  // one-time read-state migration marker
+#define SMS_PENDING_READ  4   // conversations whose read marks wait for sdWriter
+#define SMS_INDEX_FILE   "/sms/inbox.idx"
+#define SMS_INDEX_MAGIC   0x58534D53  // "SMSX"
+#define SMS_INDEX_VERSION 1
+#define SMS_INDEX_INITIAL 32    // slots allocated up front, grows as needed
 
 // Fixed-size on-disk record (256 bytes, easy alignment)
 struct SMSRecord {
@@ -45,6 +56,22 @@ struct SMSMessage {
   char     body[SMS_BODY_LEN];
 };
 
+// Inbox index slot (on disk and in RAM). phone[0] == 0 = free slot.
+struct SMSIndexEntry {
+  char     phone[SMS_PHONE_LEN];  // as in the newest record
+  char     preview[40];           // newest message preview
+  uint32_t lastTimestamp;
+  uint32_t messageCount;          // records in the conversation file
+  uint32_t unreadCount;
+  uint32_t firstUnread;           // no unread records before this one
+};
+
+struct SMSIndexHeader {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t entrySize;
+};
+
 // Conversation summary for inbox view
 struct SMSConversation {
   char     phone[SMS_PHONE_LEN];
@@ -63,11 +90,12 @@ public:
   // Save a message (sent or received)
   bool saveMessage(const char* phone, const char* body, bool isSent, uint32_t timestamp);
 
-  // Load conversation list (sorted by most recent)
+  // Load the maxCount most recent conversations (sorted by most recent)
   int loadConversations(SMSConversation* out, int maxCount);
 
-  // Load messages for a specific phone number (chronological, oldest first)
-  int loadMessages(const char* phone, SMSMessage* out, int maxCount);
+  // Load up to maxCount messages for a phone number, skipping the
+  // skipNewest most recent (chronological, oldest first)
+  int loadMessages(const char* phone, SMSMessage* out, int maxCount, int skipNewest = 0);
 
   // Delete all messages for a phone number
   bool deleteConversation(const char* phone);
@@ -75,17 +103,44 @@ public:
   // Get total message count for a phone number
   int getMessageCount(const char* phone);
 
-  // Mark all received messages in a conversation as read (persisted to SD)
+  int getConversationCount() const;
+
+  // Mark all received messages in a conversation as read (persisted to SD
+  // shortly after by sdWriter; loadConversations() sees it immediately)
   void markConversationRead(const char* phone);
 
 private:
   bool _ready = false;
 
+  SMSIndexEntry* _index = nullptr;
+  int _indexCap = 0;
+  int _indexUsed = 0;     // slots in use or freed (file holds this many)
+
+  struct PendingRead {
+    char phone[SMS_PHONE_LEN];
+    uint32_t from, upTo;  // record range that was unread when marked
+  };
+  int _readJob = -1;
+  PendingRead _pendingRead[SMS_PENDING_READ];
+  int _numPendingRead = 0;
+
+  static bool readJob(void* ctx);
+
   // Convert phone number to safe filename
   void phoneToFilename(const char* phone, char* out, size_t outLen);
-
-  // Set read=1 on every received-unread record in a conversation file
-  void markFileRead(const char* filepath);
+  static void sanitisePhone(const char* phone, char* out, size_t outLen);
+
+  // Index
+  bool loadIndex();
+  void rebuildIndex();
+  void scanFileInto(File& f, SMSIndexEntry& e);
+  int findEntry(const char* phone) const;
+  int allocEntry();
+  int appendEntry();
+  void writeEntry(int slot);
+
+  // Set read=1 on received-unread records in [from, upTo) of a conversation file
+  void markFileRead(const char* filepath, uint32_t from = 0, uint32_t upTo = 0xFFFFFFFF);
 
   // One-time: mark all pre-existing history read (it pre-dates read tracking)
   void migrateExistingAsRead();
@@ -5,8 +5,10 @@
 #include <helpers/ChannelDetails.h>
 #include <helpers/TransportKeyStore.h>
 #include <MeshCore.h>
+#include "../MeshTask.h"
 #include "../NodePrefs.h"
 #include "MeckFonts.h"
+#include "SDWriteScheduler.h"
 #if defined(MECK_AUDIO_VARIANT) || defined(HAS_4G_MODEM)
 #include "NotifSounds.h"
 #endif
@@ -428,7 +430,7 @@ private:
         // Note: keeps AUTO_ADD_OVERWRITE_OLDEST bit unchanged
         break;
     }
-    the_mesh.savePrefs();
+    locked(the_mesh)->savePrefs();
     rebuildRows();  // show/hide sub-toggles
     Serial.printf("Settings: Contact mode = %s (manual=%d, autoadd=0x%02X)\n",
                   contactModeLabel(mode), _prefs->manual_add_contacts, _prefs->autoadd_config);
@@ -457,7 +459,7 @@ private:
       // gaps can appear after channel deletion if compaction is incomplete.
       for (uint8_t i = 0; i < MAX_GROUP_CHANNELS; i++) {
         ChannelDetails ch;
-        if (the_mesh.getChannel(i, ch) && ch.name[0] != '\0') {
+        if (locked(the_mesh)->getChannel(i, ch) && ch.name[0] != '\0') {
           addRow(ROW_CHANNEL, i);
         }
       }
@@ -632,6 +634,7 @@ private:
     }
 
     // Find next empty slot
+    MeshLock lock;
     for (uint8_t i = 0; i < MAX_GROUP_CHANNELS; i++) {
       ChannelDetails existing;
       if (!the_mesh.getChannel(i, existing) || existing.name[0] == '\0') {
@@ -646,6 +649,7 @@ private:
 
 
   void deleteChannel(uint8_t idx) {
+    MeshLock lock;   // compaction is one step for the mesh
     // Clear the channel by writing an empty ChannelDetails
     // Then compact: shift all channels above it down by one
     ChannelDetails empty;
@@ -678,10 +682,12 @@ private:
   // ---------------------------------------------------------------------------
 
   void applyRadioParams() {
+    MeshLock lock;   // radio is driven by the mesh task
     radio_set_params(_prefs->freq, _prefs->bw, _prefs->sf, _prefs->cr);
     radio_set_tx_power(_prefs->tx_power_dbm);
     the_mesh.savePrefs();
     the_mesh.resetRxPacketCount();   // zero the radio-page RX counter on radio param change
+    lock.release();
     _radioChanged = false;
     Serial.printf("Settings: Radio params applied - %.3f/%g/%d/%d TX:%d\n",
                   _prefs->freq, _prefs->bw, _prefs->sf, _prefs->cr, _prefs->tx_power_dbm);
@@ -1285,6 +1291,7 @@ public:
     display.drawTextCentered(display.width() / 2, 66, "Rebooting in 3 seconds...");
     display.endFrame();
 
+    sdWriter.flush();
     delay(3000);
     ESP.restart();
   }
@@ -2173,7 +2180,7 @@ public:
         case ROW_CHANNEL: {
           uint8_t chIdx = _rows[i].param;
           ChannelDetails ch;
-          if (the_mesh.getChannel(chIdx, ch)) {
+          if (locked(the_mesh)->getChannel(chIdx, ch)) {
             if (editing && _editMode == EDIT_TEXT) {
               // Editing scope for this channel
               snprintf(tmp, sizeof(tmp), " %s [%s_]", ch.name, _editBuf);
@@ -2255,7 +2262,7 @@ public:
         case ROW_PUB_KEY: {
           // Show first 8 bytes of pub key as hex (16 chars)
           char hexBuf[17];
-          mesh::Utils::toHex(hexBuf, the_mesh.self_id.pub_key, 8);
+          mesh::Utils::toHex(hexBuf, locked(the_mesh)->self_id.pub_key, 8);
           snprintf(tmp, sizeof(tmp), "Node ID: %s", hexBuf);
           display.print(tmp);
           break;
@@ -2346,7 +2353,7 @@ public:
       if (_confirmAction == 1) {
         uint8_t chIdx = _rows[_cursor].param;
         ChannelDetails ch;
-        the_mesh.getChannel(chIdx, ch);
+        locked(the_mesh)->getChannel(chIdx, ch);
         snprintf(tmp, sizeof(tmp), "Delete %s?", ch.name);
         display.drawTextCentered(display.width() / 2, by + 4, tmp);
       } else if (_confirmAction == 2) {
@@ -2750,7 +2757,7 @@ public:
           }
 
           ContactInfo ci_info;
-          if (the_mesh.getContactByIdx(_shareContacts[ci], ci_info)) {
+          if (locked(the_mesh)->getContactByIdx(_shareContacts[ci], ci_info)) {
             display.setCursor(bx + 4, iy + 1);
             if (ci_info.flags & 0x01) {
               display.print("* ");
@@ -3244,7 +3251,7 @@ public:
           if (_editPos > 0) {
             strncpy(_prefs->node_name, _editBuf, sizeof(_prefs->node_name));
             _prefs->node_name[31] = '\0';
-            the_mesh.savePrefs();
+            locked(the_mesh)->savePrefs();
             Serial.printf("Settings: Name set to '%s'\n", _prefs->node_name);
           }
           _editMode = EDIT_NONE;
@@ -3274,12 +3281,12 @@ public:
           _prefs->default_scope_name[30] = '\0';
           if (_editBuf[0]) {
             TransportKey key;
-            the_mesh.deriveScopeKey(_editBuf, key);
+            locked(the_mesh)->deriveScopeKey(_editBuf, key);
             memcpy(_prefs->default_scope_key, key.key, sizeof(_prefs->default_scope_key));
           } else {
             memset(_prefs->default_scope_key, 0, sizeof(_prefs->default_scope_key));
           }
-          the_mesh.savePrefs();
+          locked(the_mesh)->savePrefs();
           Serial.printf("Settings: Default scope set to '%s'\n",
                         _editBuf[0] ? _editBuf : "(unscoped)");
           _editMode = EDIT_NONE;
@@ -3287,11 +3294,11 @@ public:
           // Save per-channel scope
           uint8_t chIdx = _rows[_cursor].param;
           ChannelDetails ch;
-          if (the_mesh.getChannel(chIdx, ch)) {
+          if (locked(the_mesh)->getChannel(chIdx, ch)) {
             strncpy(ch.scope_name, _editBuf, sizeof(ch.scope_name));
             ch.scope_name[30] = '\0';
-            the_mesh.setChannel(chIdx, ch);
-            the_mesh.saveChannels();
+            locked(the_mesh)->setChannel(chIdx, ch);
+            locked(the_mesh)->saveChannels();
             Serial.printf("Settings: Channel %d scope set to '%s'\n",
                           chIdx, _editBuf[0] ? _editBuf : "(device default)");
           }
@@ -3389,21 +3396,21 @@ public:
           _editMode = EDIT_NONE;
         } else if (type == ROW_GPS_BAUD) {
           _prefs->gps_baudrate = GPS_BAUD_OPTIONS[_editPickerIdx];
-          the_mesh.savePrefs();
+          locked(the_mesh)->savePrefs();
           _editMode = EDIT_NONE;
           Serial.printf("Settings: GPS baud set to %lu (reboot to apply)\n",
                         (unsigned long)_prefs->gps_baudrate);
 #if defined(LilyGo_T5S3_EPaper_Pro) || defined(LilyGo_TDeck_Pro)
         } else if (type == ROW_AUTO_LOCK) {
           _prefs->auto_lock_minutes = AUTO_LOCK_OPTIONS[_editPickerIdx];
-          the_mesh.savePrefs();
+          locked(the_mesh)->savePrefs();
           _editMode = EDIT_NONE;
           Serial.printf("Settings: Auto lock = %s\n",
                         autoLockLabel(_prefs->auto_lock_minutes));
 #endif
         } else if (type == ROW_FONT_STYLE) {
           _prefs->ui_font_style = _editPickerIdx;
-          the_mesh.savePrefs();
+          locked(the_mesh)->savePrefs();
           _editMode = EDIT_NONE;
           Serial.printf("Settings: Font style = %s (%d)\n",
                         meckFontStyleName(_prefs->ui_font_style),
@@ -3516,19 +3523,19 @@ public:
             break;
           case ROW_UTC_OFFSET:
             _prefs->utc_offset_hours = (int8_t)constrain(_editInt, -12, 14);
-            the_mesh.savePrefs();
+            locked(the_mesh)->savePrefs();
             break;
           case ROW_BACKLIGHT_BRIGHTNESS:
             _prefs->backlight_brightness_pct = (uint8_t)constrain(_editInt, 5, 100);
-            the_mesh.savePrefs();
+            locked(the_mesh)->savePrefs();
             break;
           case ROW_KB_BACKLIGHT:
             _prefs->kb_backlight_pct = (uint8_t)constrain(_editInt, 5, 100);
-            the_mesh.savePrefs();
+            locked(the_mesh)->savePrefs();
             break;
           case ROW_PATH_HASH_SIZE:
             _prefs->path_hash_mode = (uint8_t)constrain(_editInt - 1, 0, 2);  // display 1-3, store 0-2
-            the_mesh.savePrefs();
+            locked(the_mesh)->savePrefs();
             break;
           default: break;
         }
@@ -3620,7 +3627,7 @@ public:
           break;
         case ROW_MSG_NOTIFY:
           _prefs->kb_flash_notify = _prefs->kb_flash_notify ? 0 : 1;
-          the_mesh.savePrefs();
+          locked(the_mesh)->savePrefs();
           Serial.printf("Settings: Msg flash notify = %s\n",
                         _prefs->kb_flash_notify ? "ON" : "OFF");
           break;
@@ -3635,20 +3642,20 @@ public:
           _prefs->lora_antenna = _prefs->lora_antenna ? 0 : 1;
           if (_prefs->lora_antenna) board.loraAntennaExternal();
           else                      board.loraAntennaInternal();
-          the_mesh.savePrefs();
+          locked(the_mesh)->savePrefs();
           Serial.printf("Settings: LoRa antenna = %s\n",
                         _prefs->lora_antenna ? "External" : "Internal");
           break;
 #endif
         case ROW_DARK_MODE:
           _prefs->dark_mode = _prefs->dark_mode ? 0 : 1;
-          the_mesh.savePrefs();
+          locked(the_mesh)->savePrefs();
           Serial.printf("Settings: Dark mode = %s\n",
                         _prefs->dark_mode ? "ON" : "OFF");
           break;
         case ROW_LARGE_FONT:
           _prefs->large_font = _prefs->large_font ? 0 : 1;
-          the_mesh.savePrefs();
+          locked(the_mesh)->savePrefs();
           Serial.printf("Settings: Font size = %s\n",
                         _prefs->large_font ? "LARGER" : "TINY");
           break;
@@ -3659,7 +3666,7 @@ public:
 #if defined(LilyGo_T5S3_EPaper_Pro)
         case ROW_PORTRAIT_MODE:
           _prefs->portrait_mode = _prefs->portrait_mode ? 0 : 1;
-          the_mesh.savePrefs();
+          locked(the_mesh)->savePrefs();
           Serial.printf("Settings: Portrait mode = %s\n",
                         _prefs->portrait_mode ? "ON" : "OFF");
           break;
@@ -3747,31 +3754,31 @@ public:
         // --- Contact sub-toggles (flip bit and save) ---
         case ROW_AUTOADD_CHAT:
           _prefs->autoadd_config ^= AUTO_ADD_CHAT;
-          the_mesh.savePrefs();
+          locked(the_mesh)->savePrefs();
           Serial.printf("Settings: Auto-add Chat = %s\n",
                         (_prefs->autoadd_config & AUTO_ADD_CHAT) ? "ON" : "OFF");
           break;
         case ROW_AUTOADD_REPEATER:
           _prefs->autoadd_config ^= AUTO_ADD_REPEATER;
-          the_mesh.savePrefs();
+          locked(the_mesh)->savePrefs();
           Serial.printf("Settings: Auto-add Repeater = %s\n",
                         (_prefs->autoadd_config & AUTO_ADD_REPEATER) ? "ON" : "OFF");
           break;
         case ROW_AUTOADD_ROOM:
           _prefs->autoadd_config ^= AUTO_ADD_ROOM_SERVER;
-          the_mesh.savePrefs();
+          locked(the_mesh)->savePrefs();
           Serial.printf("Settings: Auto-add Room = %s\n",
                         (_prefs->autoadd_config & AUTO_ADD_ROOM_SERVER) ? "ON" : "OFF");
           break;
         case ROW_AUTOADD_SENSOR:
           _prefs->autoadd_config ^= AUTO_ADD_SENSOR;
-          the_mesh.savePrefs();
+          locked(the_mesh)->savePrefs();
           Serial.printf("Settings: Auto-add Sensor = %s\n",
                         (_prefs->autoadd_config & AUTO_ADD_SENSOR) ? "ON" : "OFF");
           break;
         case ROW_AUTOADD_OVERWRITE:
           _prefs->autoadd_config ^= AUTO_ADD_OVERWRITE_OLDEST;
-          the_mesh.savePrefs();
+          locked(the_mesh)->savePrefs();
           Serial.printf("Settings: Overwrite oldest = %s\n",
                         (_prefs->autoadd_config & AUTO_ADD_OVERWRITE_OLDEST) ? "ON" : "OFF");
           break;
@@ -3872,7 +3879,7 @@ public:
           // Enter on a channel row → edit its region scope
           uint8_t chIdx = _rows[_cursor].param;
           ChannelDetails ch;
-          if (the_mesh.getChannel(chIdx, ch)) {
+          if (locked(the_mesh)->getChannel(chIdx, ch)) {
             startEditText(ch.scope_name);
           }
           break;
@@ -3905,7 +3912,7 @@ public:
         uint8_t chIdx = _rows[_cursor].param;
         uint8_t cur = _prefs->channel_notif[chIdx];
         _prefs->channel_notif[chIdx] = (cur + 1) % 3;
-        the_mesh.savePrefs();
+        locked(the_mesh)->savePrefs();
         const char* labels[] = {"All", "Mentions", "Off"};
         Serial.printf("Settings: Channel %d notif -> %s\n",
                       chIdx, labels[_prefs->channel_notif[chIdx]]);
@@ -3919,11 +3926,11 @@ public:
         _shareChannelIdx = _rows[_cursor].param;
         // Populate contact list with DM-capable contacts, favourites first
         _shareContactCount = 0;
-        int numContacts = the_mesh.getNumContacts();
+        int numContacts = locked(the_mesh)->getNumContacts();
         // First pass: favourites
         for (int ci = 0; ci < numContacts && _shareContactCount < SHARE_MAX_CONTACTS; ci++) {
           ContactInfo contact;
-          if (the_mesh.getContactByIdx(ci, contact) && contact.type == ADV_TYPE_CHAT
+          if (locked(the_mesh)->getContactByIdx(ci, contact) && contact.type == ADV_TYPE_CHAT
               && (contact.flags & 0x01)) {
             _shareContacts[_shareContactCount++] = ci;
           }
@@ -3932,7 +3939,7 @@ public:
         // Second pass: non-favourites
         for (int ci = 0; ci < numContacts && _shareContactCount < SHARE_MAX_CONTACTS; ci++) {
           ContactInfo contact;
-          if (the_mesh.getContactByIdx(ci, contact) && contact.type == ADV_TYPE_CHAT
+          if (locked(the_mesh)->getContactByIdx(ci, contact) && contact.type == ADV_TYPE_CHAT
               && !(contact.flags & 0x01)) {
             _shareContacts[_shareContactCount++] = ci;
           }
@@ -3942,8 +3949,8 @@ public:
           for (int a = start; a < end - 1; a++) {
             for (int b = a + 1; b < end; b++) {
               ContactInfo ca, cb;
-              the_mesh.getContactByIdx(_shareContacts[a], ca);
-              the_mesh.getContactByIdx(_shareContacts[b], cb);
+              locked(the_mesh)->getContactByIdx(_shareContacts[a], ca);
+              locked(the_mesh)->getContactByIdx(_shareContacts[b], cb);
               if (strcasecmp(ca.name, cb.name) > 0) {
                 int tmp = _shareContacts[a];
                 _shareContacts[a] = _shareContacts[b];
@@ -4034,7 +4041,7 @@ public:
         bool anyChannelScoped = false;
         for (uint8_t ci = 0; ci < MAX_GROUP_CHANNELS && !anyChannelScoped; ci++) {
           ChannelDetails ch;
-          if (the_mesh.getChannel(ci, ch) && ch.name[0] != '\0' && ch.scope_name[0] != '\0') {
+          if (locked(the_mesh)->getChannel(ci, ch) && ch.name[0] != '\0' && ch.scope_name[0] != '\0') {
             anyChannelScoped = true;
           }
         }
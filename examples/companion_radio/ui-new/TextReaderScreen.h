@@ -6,6 +6,7 @@
 #include <vector>
 #include "Utf8CP437.h"
 #include "EpubProcessor.h"
+#include "SDWriteScheduler.h"
 #include "../NodePrefs.h"
 
 // Forward declarations
@@ -404,6 +405,11 @@ private:
   uint8_t _lastFontPref;   // Font preference at last layout init (large_font | fontStyle<<4)
   uint8_t _fontKey;        // Current font key stored in .idx files for cache invalidation
   bool _bootIndexed;       // Boot-time pre-indexing done
+
+  // Reading position saved on close, written behind by sdWriter
+  int _posJob = -1;
+  String _pendingPosFile;
+  int _pendingPosPage = 0;
   DisplayDriver* _display; // Stored reference for splash screens
 
   // Display layout (calculated once from display metrics)
@@ -1014,9 +1020,26 @@ private:
                   actualFilename.c_str(), _totalPages);
   }
 
+  static bool posJob(void* ctx) {
+    TextReaderScreen* self = (TextReaderScreen*)ctx;
+    if (self->_pendingPosFile.length() > 0) {
+      self->saveReadingPosition(self->_pendingPosFile, self->_pendingPosPage);
+      self->_pendingPosFile = "";
+    }
+    return true;
+  }
+
   void closeBook() {
     if (!_fileOpen) return;
-    saveReadingPosition(_currentFile, _currentPage);
+
+    // Queue the position write; only one book's position is held, so write
+    // out any still pending for a different book first
+    if (_pendingPosFile.length() > 0 && _pendingPosFile != _currentFile) {
+      sdWriter.flush(_posJob);
+    }
+    _pendingPosFile = _currentFile;
+    _pendingPosPage = _currentPage;
+    sdWriter.markDirty(_posJob);
 
     for (int i = 0; i < (int)_fileCache.size(); i++) {
       if (_fileCache[i].filename == _currentFile) {
@@ -1696,16 +1719,21 @@ public:
 
   // ---- Public Interface ----
 
-  void setSDReady(bool ready) { _sdReady = ready; }
+  void setSDReady(bool ready) {
+    _sdReady = ready;
+    if (ready && _posJob < 0) {
+      _posJob = sdWriter.registerJob("reader-pos", posJob, this, SD_WRITE_SOON);
+    }
+  }
   bool isSDReady() const { return _sdReady; }
 
   // Called when entering the reader screen (press R).
-  // If boot indexing already ran, this is lightweight.
+  // The first entry indexes the library (deferred from boot); after that
+  // this is lightweight.
   void enter(DisplayDriver& display) {
     initLayout(display);
 
     if (_sdReady && !_bootIndexed) {
-      // Boot indexing didn't run (shouldn't happen, but safety fallback)
       bootIndex(display);
     }
 
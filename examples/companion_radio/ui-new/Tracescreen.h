@@ -3,6 +3,7 @@
 #include <helpers/ui/UIScreen.h>
 #include <helpers/ui/DisplayDriver.h>
 #include <MeshCore.h>
+#include "../MeshTask.h"
 #include <Packet.h>
 
 // Forward declarations
@@ -147,10 +148,10 @@ private:
   // Build repeater list from contacts
   void buildRepeaterList() {
     _repCount = 0;
-    uint32_t numContacts = the_mesh.getNumContacts();
+    uint32_t numContacts = locked(the_mesh)->getNumContacts();
     ContactInfo c;
     for (uint32_t i = 0; i < numContacts && _repCount < MAX_REPEATERS; i++) {
-      if (the_mesh.getContactByIdx(i, c)) {
+      if (locked(the_mesh)->getContactByIdx(i, c)) {
         if (c.type == ADV_TYPE_REPEATER) {
           _repIdx[_repCount++] = (uint16_t)i;
         }
@@ -160,11 +161,11 @@ private:
 
   // Look up contact name from hash prefix
   bool findNameForHash(const uint8_t* hash, int hashLen, char* name, size_t nameLen) const {
-    uint32_t numContacts = the_mesh.getNumContacts();
+    uint32_t numContacts = locked(the_mesh)->getNumContacts();
     ContactInfo c;
     // First pass: repeaters only
     for (uint32_t i = 0; i < numContacts; i++) {
-      if (the_mesh.getContactByIdx(i, c) && c.type == ADV_TYPE_REPEATER) {
+      if (locked(the_mesh)->getContactByIdx(i, c) && c.type == ADV_TYPE_REPEATER) {
         if (memcmp(c.id.pub_key, hash, hashLen) == 0) {
           strncpy(name, c.name, nameLen);
           name[nameLen - 1] = '\0';
@@ -174,7 +175,7 @@ private:
     }
     // Second pass: any contact
     for (uint32_t i = 0; i < numContacts; i++) {
-      if (the_mesh.getContactByIdx(i, c)) {
+      if (locked(the_mesh)->getContactByIdx(i, c)) {
         if (memcmp(c.id.pub_key, hash, hashLen) == 0) {
           strncpy(name, c.name, nameLen);
           name[nameLen - 1] = '\0';
@@ -566,7 +567,7 @@ private:
         int idx = _repScroll + vi;
         uint16_t contactIdx = _repIdx[idx];
         ContactInfo c;
-        if (!the_mesh.getContactByIdx(contactIdx, c)) continue;
+        if (!locked(the_mesh)->getContactByIdx(contactIdx, c)) continue;
 
         char prefix = (idx == _repSel) ? '>' : ' ';
         display.setCursor(0, y);
@@ -897,7 +898,7 @@ private:
     if (c == '\r' || c == 13) {
       if (_repCount > 0 && _repSel >= 0 && _repSel < _repCount) {
         ContactInfo contact;
-        if (the_mesh.getContactByIdx(_repIdx[_repSel], contact)) {
+        if (locked(the_mesh)->getContactByIdx(_repIdx[_repSel], contact)) {
           int offset = _hopCount * _bytesPerHop;
           memcpy(&_pathBuf[offset], contact.id.pub_key, _bytesPerHop);
           _hopCount++;
@@ -951,6 +952,8 @@ private:
   bool sendTrace() {
     if (_hopCount <= 0) return true;
 
+    MeshLock lock;   // create + send as one step
+
     // Generate random tag and auth code
     the_mesh.getRNG()->random((uint8_t*)&_traceTag, 4);
     the_mesh.getRNG()->random((uint8_t*)&_traceAuth, 4);
@@ -971,6 +974,7 @@ private:
 
     // sendDirect for TRACE appends path to payload and sets path_len=0
     the_mesh.sendDirect(pkt, _pathBuf, pathByteLen);
+    lock.release();
 
     _traceSentAt = millis();
     _state = STATE_RUNNING;
@@ -1,8 +1,11 @@
 #include "UITask.h"
 #include <helpers/TxtDataHelpers.h>
+#include <helpers/ui/UIWidgets.h>
 #include "../MyMesh.h"
+#include "../MeshTask.h"
 #if !defined(LILYGO_TECHO_LITE) && !defined(LILYGO_TECHO_CARD)
 #include "NotesScreen.h"
+#include "SDWriteScheduler.h"
 #endif
 #include "RepeaterAdminScreen.h"
 #include "PathEditorScreen.h"
@@ -326,7 +329,10 @@ void renderBatteryIndicator(DisplayDriver& display, uint16_t batteryMilliVolts,
       sensors_lpp.reset();
       sensors_nb = 0;
       sensors_lpp.addVoltage(TELEM_CHANNEL_SELF, (float)board.getBattMilliVolts() / 1000.0f);
-      sensors.querySensors(0xFF, sensors_lpp);
+      {
+        MeshLock lock;   // sensors are also queried by the mesh (telemetry requests)
+        sensors.querySensors(0xFF, sensors_lpp);
+      }
       LPPReader reader (sensors_lpp.getBuffer(), sensors_lpp.getSize());
       uint8_t channel, type;
       while(reader.readHeader(channel, type)) {
@@ -508,10 +514,10 @@ public:
         display.drawTextCentered(display.width() / 2, y, "< Connected >");
         y += _node_prefs->smallLineH() - 1;
 #ifdef BLE_PIN_CODE
-      } else if (_task->isSerialEnabled() && the_mesh.getBLEPin() != 0) {
+      } else if (_task->isSerialEnabled() && locked(the_mesh)->getBLEPin() != 0) {
         display.setColor(DisplayDriver::RED);
         display.setTextSize(2);
-        sprintf(tmp, "Pin:%d", the_mesh.getBLEPin());
+        sprintf(tmp, "Pin:%d", locked(the_mesh)->getBLEPin());
         display.drawTextCentered(display.width() / 2, y, tmp);
 #if defined(LILYGO_TECHO_LITE)
         y += 14;  // Compact
@@ -756,7 +762,7 @@ public:
 #endif // LILYGO_TECHO_LITE
 #endif
     } else if (_page == HomePage::RECENT) {
-      the_mesh.getRecentlyHeard(recent, UI_RECENT_LIST_SIZE);
+      locked(the_mesh)->getRecentlyHeard(recent, UI_RECENT_LIST_SIZE);
       display.setColor(DisplayDriver::GREEN);
       int y = 20;
       for (int i = 0; i < UI_RECENT_LIST_SIZE; i++, y += 11) {
@@ -810,7 +816,7 @@ public:
       sprintf(tmp, "Noise floor: %d", radio_driver.getNoiseFloor());
       display.print(tmp);
       display.setCursor(0, 64);
-      sprintf(tmp, "RX packets: %u", (unsigned)the_mesh.getRxPacketCount());
+      sprintf(tmp, "RX packets: %u", (unsigned)locked(the_mesh)->getRxPacketCount());
       display.print(tmp);
 #ifdef BLE_PIN_CODE
     } else if (_page == HomePage::BLUETOOTH) {
@@ -830,10 +836,10 @@ public:
 #else
         display.drawTextCentered(display.width() / 2, 53, "< Connected >");
 #endif
-      } else if (_task->isSerialEnabled() && the_mesh.getBLEPin() != 0) {
+      } else if (_task->isSerialEnabled() && locked(the_mesh)->getBLEPin() != 0) {
         display.setColor(DisplayDriver::RED);
         display.setTextSize(2);
-        sprintf(tmp, "Pin:%d", the_mesh.getBLEPin());
+        sprintf(tmp, "Pin:%d", locked(the_mesh)->getBLEPin());
 #if defined(LilyGo_T5S3_EPaper_Pro)
         display.drawTextCentered(display.width() / 2, 64, tmp);
 #else
@@ -1191,7 +1197,7 @@ public:
       if (c == KEY_ENTER) {
         // Save and exit
         Serial.printf("UTC offset saving: %d\n", _node_prefs->utc_offset_hours);
-        the_mesh.savePrefs();
+        locked(the_mesh)->savePrefs();
         _editing_utc = false;
         _task->showAlert("UTC offset saved", 800);
         Serial.println("UTC offset save complete");
@@ -1264,7 +1270,7 @@ public:
 #endif
     if (c == KEY_ENTER && _page == HomePage::ADVERT) {
       _task->notify(UIEventType::ack);
-      if (the_mesh.advert()) {
+      if (locked(the_mesh)->advert()) {
         _task->showAlert("Advert sent!", 1000);
       } else {
         _task->showAlert("Advert failed..", 1000);
@@ -1307,9 +1313,32 @@ class LockScreen : public UIScreen {
   mesh::RTCClock* _rtc;
   NodePrefs* _node_prefs;
 
+  // retained widgets -- content changes at most once a minute
+  UIWidgetGroup _widgets;
+  UILabel _clock;
+  UILabel _info;
+#if defined(LilyGo_T5S3_EPaper_Pro)
+  UILabel _hint;
+#endif
+
 public:
   LockScreen(UITask* task, mesh::RTCClock* rtc, NodePrefs* node_prefs)
-    : _task(task), _rtc(rtc), _node_prefs(node_prefs) {}
+    : _task(task), _rtc(rtc), _node_prefs(node_prefs),
+      _clock(0, 55, 40, 5, DisplayDriver::LIGHT, UILabel::CENTER),
+      _info(0, 108, 12, 1, DisplayDriver::GREEN, UILabel::CENTER)
+#if defined(LilyGo_T5S3_EPaper_Pro)
+      , _hint(0, 120, 10, 1, DisplayDriver::LIGHT, UILabel::CENTER)
+#endif
+  {
+    _widgets.add(&_clock);
+    _widgets.add(&_info);
+#if defined(LilyGo_T5S3_EPaper_Pro)
+    _hint.set("Hold button to unlock");
+    _widgets.add(&_hint);
+#endif
+  }
+
+  void invalidate() { _widgets.invalidateAll(); }
 
   int render(DisplayDriver& display) override {
     uint32_t now = _rtc->getCurrentTime();
@@ -1325,16 +1354,11 @@ public:
     }
 
     // ---- Huge clock: HH:MM on one line ----
-#if defined(LilyGo_T5S3_EPaper_Pro)
-    display.setTextSize(5);  // T5S3: FreeSansBold24pt × 5
-#else
-    display.setTextSize(5);  // T-Deck Pro: FreeSansBold12pt at GxEPD 2× scale
-#endif
-    display.setColor(DisplayDriver::LIGHT);
-    display.drawTextCentered(display.width() / 2, 55, timeBuf);
+    // (T5S3: FreeSansBold24pt × 5, T-Deck Pro: FreeSansBold12pt at GxEPD 2× scale)
+    _clock.moveTo(display.width() / 2, 55);
+    _clock.set(timeBuf);
 
     // ---- Battery + unread on one line ----
-    display.setTextSize(1);
     {
       int pct = 0;
 #if HAS_BQ27220
@@ -1355,17 +1379,19 @@ public:
       } else {
         sprintf(infoBuf, "%d%%", pct);
       }
-      display.setColor(DisplayDriver::GREEN);
-      display.drawTextCentered(display.width() / 2, 108, infoBuf);
+      _info.moveTo(display.width() / 2, 108);
+      _info.set(infoBuf);
     }
 
     // ---- Unlock hint ----
 #if defined(LilyGo_T5S3_EPaper_Pro)
-    display.setTextSize(_node_prefs->smallTextSize());
-    display.setColor(DisplayDriver::LIGHT);
-    display.drawTextCentered(display.width() / 2, 120, "Hold button to unlock");
+    _hint.moveTo(display.width() / 2, 120);
+    _hint.setTextSize(_node_prefs->smallTextSize());
 #endif
 
+    _widgets.render(display);   // only changed labels get re-measured
+    display.setTextSize(1);
+
     return 30000;
   }
 
@@ -1389,6 +1415,9 @@ void UITask::begin(DisplayDriver* display, SensorManager* sensors, NodePrefs* no
 
   _node_prefs = node_prefs;
 
+  // Emoji in text outside the channel view (names etc.) fall back to the sprites
+  if (_display != NULL) _display->setGlyphSpriteLookup(getEmojiSpriteForCodepoint);
+
   // Initialize message dedup ring buffer
   memset(_dedup, 0, sizeof(_dedup));
   _dedupIdx = 0;
@@ -1534,7 +1563,7 @@ void UITask::dismissBootHint() {
   // Persist so hint never shows again
   if (_node_prefs) {
     _node_prefs->hint_shown = 1;
-    the_mesh.savePrefs();
+    locked(the_mesh)->savePrefs();
   }
   _next_refresh = millis() + 100;
   Serial.println("[UI] Boot hint dismissed");
@@ -1611,7 +1640,7 @@ void UITask::newMsg(uint8_t path_len, const char* from_name, const char* text, i
   uint8_t channel_idx = 0xFF;  // Default: unknown/contact message
   for (uint8_t i = 0; i < MAX_GROUP_CHANNELS; i++) {
     ChannelDetails ch;
-    if (the_mesh.getChannel(i, ch) && strcmp(ch.name, from_name) == 0) {
+    if (locked(the_mesh)->getChannel(i, ch) && strcmp(ch.name, from_name) == 0) {
       channel_idx = i;
       break;
     }
@@ -1712,10 +1741,10 @@ void UITask::newMsg(uint8_t path_len, const char* from_name, const char* text, i
   bool isRoomMsg = false;
   if (channel_idx == 0xFF) {
     // Check if sender is a room server
-    uint32_t numContacts = the_mesh.getNumContacts();
+    uint32_t numContacts = locked(the_mesh)->getNumContacts();
     ContactInfo senderContact;
     for (uint32_t ci = 0; ci < numContacts; ci++) {
-      if (the_mesh.getContactByIdx(ci, senderContact) && strcmp(senderContact.name, from_name) == 0) {
+      if (locked(the_mesh)->getContactByIdx(ci, senderContact) && strcmp(senderContact.name, from_name) == 0) {
         if (senderContact.type == ADV_TYPE_ROOM) isRoomMsg = true;
         break;
       }
@@ -1746,10 +1775,10 @@ void UITask::newMsg(uint8_t path_len, const char* from_name, const char* text, i
   // Per-contact DM unread tracking: find contact index by name
   // Skip increment when companion app is connected (user sees DMs there)
   if (channel_idx == 0xFF && _dmUnread && !hasConnection()) {
-    uint32_t numContacts = the_mesh.getNumContacts();
+    uint32_t numContacts = locked(the_mesh)->getNumContacts();
     ContactInfo contact;
     for (uint32_t ci = 0; ci < numContacts; ci++) {
-      if (the_mesh.getContactByIdx(ci, contact) && strcmp(contact.name, from_name) == 0) {
+      if (locked(the_mesh)->getContactByIdx(ci, contact) && strcmp(contact.name, from_name) == 0) {
         if (_dmUnread[ci] < 255) _dmUnread[ci]++;
         break;
       }
@@ -1828,6 +1857,10 @@ void UITask::setCurrScreen(UIScreen* c) {
 */
 void UITask::shutdown(bool restart){
 
+  // Write-behind barrier: nothing queued for SD may be lost to the power-off
+  sdWriter.flush();
+  locked(the_mesh)->flushContacts();
+
   #ifdef PIN_BUZZER
   /* note: we have a choice here -
      we can do a blocking buzzer.loop() with non-deterministic consequences
@@ -1876,6 +1909,7 @@ void UITask::shutdown(bool restart){
     #endif
 
     // Power off LoRa radio, display, and board
+    mesh_lock();   // mesh task stays out of the radio from here on (not released)
     radio_driver.powerOff();
     _display->turnOff();
 
@@ -2118,10 +2152,13 @@ if (curr) curr->poll();
       // Defer display refresh while BLE is actively transferring contacts.
       // E-ink partial update blocks for ~820ms, stalling the BLE send queue
       // and adding ~1.6s of dead time to a full contact sync.
+      // (T5S3 with async refresh: endFrame() doesn't block, so no need)
       if (_notifAudioActive) {
         _next_refresh = millis() + 200;  // Defer e-ink refresh during notif tone (SPI bus contention)
+#if !defined(LilyGo_T5S3_EPaper_Pro) || !EPD_ASYNC_REFRESH
       } else if (_serial != NULL && _serial->hasPendingData()) {
         _next_refresh = millis() + 500;  // Re-check in 500ms
+#endif
       } else {
       // Sync dark mode with prefs (settings toggle takes effect here)
 #if defined(LilyGo_T5S3_EPaper_Pro) || defined(LilyGo_TDeck_Pro)
@@ -2371,6 +2408,7 @@ if (curr) curr->poll();
         delay(700);  // Allow e-ink refresh to complete
         _display->turnOff();
       }
+      sdWriter.flush();
       Serial.println("[POWERSAVE] Entering light sleep (locked+idle)");
       board.sleep(1800);  // Light sleep up to 30 min
       // ── CPU resumes here on wake ──
@@ -2401,6 +2439,9 @@ if (curr) curr->poll();
   vibration.loop();
 #endif
 
+  // Deferred SD writes (message history, read marks, bookmarks)
+  sdWriter.loop();
+
 #ifdef AUTO_SHUTDOWN_MILLIVOLTS
   if (millis() > next_batt_chck) {
     uint16_t milliVolts = getBattMilliVolts();
@@ -2447,7 +2488,7 @@ char UITask::checkDisplayOn(char c) {
 
 char UITask::handleLongPress(char c) {
   if (millis() - ui_started_at < 8000) {   // long press in first 8 seconds since startup -> CLI/rescue
-    the_mesh.enterCLIRescue();
+    locked(the_mesh)->enterCLIRescue();
     c = 0;   // consume event
   }
 #if defined(LilyGo_T5S3_EPaper_Pro)
@@ -2512,6 +2553,7 @@ void UITask::lockScreen() {
   if (_locked) return;
   _locked = true;
   _screenBeforeLock = curr;
+  ((LockScreen*)lock_screen)->invalidate();   // portrait/text size may have changed since last shown
   setCurrScreen(lock_screen);
   // Ensure display is on so lock screen renders (auto-off may have turned it off)
   if (_display != NULL && !_display->isOn()) {
@@ -2574,15 +2616,15 @@ void UITask::onVKBSubmit() {
       if (strlen(text) == 0) break;
 
       ChannelDetails channel;
-      if (the_mesh.getChannel(idx, channel)) {
+      if (locked(the_mesh)->getChannel(idx, channel)) {
         uint32_t timestamp = rtc_clock.getCurrentTime();
         int textLen = strlen(text);
-        if (the_mesh.sendGroupMessage(timestamp, channel.channel,
-                                       the_mesh.getNodePrefs()->node_name,
+        if (locked(the_mesh)->sendGroupMessage(timestamp, channel.channel,
+                                       locked(the_mesh)->getNodePrefs()->node_name,
                                        text, textLen)) {
-          addSentChannelMessage(idx, the_mesh.getNodePrefs()->node_name, text);
-          the_mesh.queueSentChannelMessage(idx, timestamp,
-                                            the_mesh.getNodePrefs()->node_name, text);
+          addSentChannelMessage(idx, locked(the_mesh)->getNodePrefs()->node_name, text);
+          locked(the_mesh)->queueSentChannelMessage(idx, timestamp,
+                                            locked(the_mesh)->getNodePrefs()->node_name, text);
           showAlert("Sent!", 1500);
         } else {
           showAlert("Send failed!", 1500);
@@ -2595,17 +2637,17 @@ void UITask::onVKBSubmit() {
       if (strlen(text) == 0) break;
 
       bool dmSuccess = false;
-      if (the_mesh.uiSendDirectMessage((uint32_t)idx, text)) {
+      if (locked(the_mesh)->uiSendDirectMessage((uint32_t)idx, text)) {
         // Add to channel screen so sent DM appears in conversation view
         ContactInfo dmRecipient;
-        if (the_mesh.getContactByIdx(idx, dmRecipient)) {
-          addSentDM(dmRecipient.name, the_mesh.getNodePrefs()->node_name, text);
+        if (locked(the_mesh)->getContactByIdx(idx, dmRecipient)) {
+          addSentDM(dmRecipient.name, locked(the_mesh)->getNodePrefs()->node_name, text);
         }
         dmSuccess = true;
       }
       // Return to DM conversation if we have contact info
       ContactInfo dmContact;
-      if (the_mesh.getContactByIdx(idx, dmContact)) {
+      if (locked(the_mesh)->getContactByIdx(idx, dmContact)) {
         ChannelScreen* cs = (ChannelScreen*)channel_screen;
         uint8_t savedPerms = (cs && cs->isDMConversation()) ? cs->getDMContactPerms() : 0;
         gotoDMConversation(dmContact.name, idx, savedPerms);
@@ -2643,7 +2685,7 @@ void UITask::onVKBSubmit() {
       if (strlen(text) > 0) {
         strncpy(_node_prefs->node_name, text, sizeof(_node_prefs->node_name) - 1);
         _node_prefs->node_name[sizeof(_node_prefs->node_name) - 1] = '\0';
-        the_mesh.savePrefs();
+        locked(the_mesh)->savePrefs();
         showAlert("Name saved", 1000);
       }
       if (_screenBeforeVKB) setCurrScreen(_screenBeforeVKB);
@@ -2828,7 +2870,7 @@ void UITask::toggleGPS() {
         #endif
         notify(UIEventType::ack);
       }
-      the_mesh.savePrefs();
+      locked(the_mesh)->savePrefs();
       showAlert(_node_prefs->gps_enabled ? "GPS: Enabled" : "GPS: Disabled", 800);
       _next_refresh = 0;
     }
@@ -2845,7 +2887,7 @@ void UITask::toggleBuzzer() {
       buzzer.quiet(true);
     }
     _node_prefs->buzzer_quiet = buzzer.isQuiet();
-    the_mesh.savePrefs();
+    locked(the_mesh)->savePrefs();
     showAlert(buzzer.isQuiet() ? "Buzzer: OFF" : "Buzzer: ON", 800);
     _next_refresh = 0;  // trigger refresh
   #endif
@@ -3172,7 +3214,7 @@ void UITask::gotoRepeaterAdmin(int contactIdx) {
   // Get contact name for the screen header
   ContactInfo contact;
   char name[32] = "Unknown";
-  if (the_mesh.getContactByIdx(contactIdx, contact)) {
+  if (locked(the_mesh)->getContactByIdx(contactIdx, contact)) {
     strncpy(name, contact.name, sizeof(name) - 1);
     name[sizeof(name) - 1] = '\0';
   }
@@ -3248,7 +3290,7 @@ void UITask::gotoRxLogScreen() {
 
 void UITask::gotoTraceScreen() {
   TraceScreen* ts = (TraceScreen*)trace_screen;
-  ts->enter(the_mesh.getNodePrefs()->path_hash_mode);
+  ts->enter(locked(the_mesh)->getNodePrefs()->path_hash_mode);
   setCurrScreen(trace_screen);
   if (_display != NULL && !_display->isOn()) {
     _display->turnOn();
@@ -3357,7 +3399,7 @@ void UITask::onAdminLoginResult(bool success, uint8_t permissions, uint32_t serv
         // Skip redirect if user explicitly pressed L to get to admin.
         if (!_skipRoomRedirect) {
           ContactInfo contact;
-          if (the_mesh.getContactByIdx(cidx, contact) && contact.type == ADV_TYPE_ROOM) {
+          if (locked(the_mesh)->getContactByIdx(cidx, contact) && contact.type == ADV_TYPE_ROOM) {
             uint8_t maskedPerms = permissions & 0x03;
             gotoDMConversation(contact.name, cidx, maskedPerms);
             return;
@@ -2,6 +2,10 @@
 
 // =============================================================================
 // CellularMQTT — A7682E Modem + MQTT via native AT commands
+//
+// AT traffic goes through an ATChannel (shared with the companion's
+// ModemManager). Publishes are queued as TOPIC/PAYLOAD/PUB chains and complete
+// in the background, incoming messages arrive as routed +CMQTTRX URCs.
 // =============================================================================
 
 #ifdef HAS_4G_MODEM
@@ -14,6 +18,7 @@
 #include <freertos/task.h>
 #include <freertos/queue.h>
 #include <freertos/semphr.h>
+#include <helpers/esp32/ATChannel.h>
 #include "variant.h"
 #include "ApnDatabase.h"
 
@@ -37,6 +42,7 @@
 #define MQTT_RECONNECT_MAX   300000
 
 #define MQTT_PUB_FAIL_MAX    5
+#define MQTT_PUB_PIPELINE    2     // publishes queued on the AT channel at once
 
 #define OTA_CHUNK_SIZE       1024
 
@@ -170,12 +176,24 @@ private:
   static const int AT_BUF_SIZE = 512;
   char _atBuf[AT_BUF_SIZE];
 
-  static const int URC_BUF_SIZE = 600;
-  char _urcBuf[URC_BUF_SIZE];
-  int _urcPos = 0;
+  // AT transport (owned by the cell task once it is running)
+  ATChannel _at;
+  bool _urcsRegistered = false;
+
+  // Publishes in flight -- topic/payload must outlive their AT commands
+  struct PubSlot {
+    CellularMQTT* owner;
+    bool busy;
+    char topic[MQTT_TOPIC_MAX];
+    char payload[MQTT_PAYLOAD_MAX];
+  };
+  PubSlot _pub[MQTT_PUB_PIPELINE] = {};
+
+  // OTA: where the current AT+HTTPREAD chunk goes
+  uint8_t* _httpDest = nullptr;
+  int _httpWant = 0;
+  int _httpGot = -1;   // -1 until the data has arrived
 
-  enum MqttRxState { RX_IDLE, RX_WAIT_TOPIC, RX_WAIT_PAYLOAD };
-  MqttRxState _rxState = RX_IDLE;
   int _rxTopicLen = 0;
   int _rxPayloadLen = 0;
   char _rxTopic[MQTT_TOPIC_MAX];
@@ -190,9 +208,9 @@ private:
   // --- Modem UART helpers ---
   bool modemPowerOn();
   bool sendAT(const char* cmd, const char* expect, uint32_t timeout_ms = 2000);
-  bool waitResponse(const char* expect, uint32_t timeout_ms, char* buf = nullptr, size_t bufLen = 0);
-  bool waitPrompt(uint32_t timeout_ms = 5000);
-  void drainURCs();
+  bool sendWithPrompt(const char* cmd, const char* data, int len, uint32_t timeout_ms);
+  void registerURCs();
+  static void onMqttURC(void* ctx, const char* line);
   void processURCLine(const char* line);
 
   // --- Data connection ---
@@ -203,7 +221,9 @@ private:
   bool mqttStart();
   bool mqttConnect();
   bool mqttSubscribe(const char* topic);
-  bool mqttPublish(const char* topic, const char* payload);
+  bool canPublish() const;
+  bool mqttPublish(const char* topic, const char* payload);   // queues, false if no room
+  static void onPublished(void* ctx, ATResult result, const char* resp);
   void mqttDisconnect();
 
   // --- URC handlers ---
@@ -212,13 +232,16 @@ private:
   void handleMqttRxPayload(const char* data, int len);
   void handleMqttRxEnd();
   void handleMqttConnLost(const char* line);
+  static void onRxTopic(void* ctx, const uint8_t* data, int len);
+  static void onRxPayload(void* ctx, const uint8_t* data, int len);
 
   // --- OTA operations (modem task only) ---
   void performOTA();
   int  httpGet(const char* url);
   bool httpReadChunk(int offset, int len, uint8_t* dest, int* bytesRead);
   void httpTerm();
-  int  readRawBytes(uint8_t* dest, int count, uint32_t timeout_ms);
+  static void onHttpRead(void* ctx, const char* line);
+  static void onHttpData(void* ctx, const uint8_t* data, int len);
 
   // --- Task ---
   static void taskEntry(void* param);
@@ -192,6 +192,8 @@ uint8_t MyMesh::handleAnonClockReq(const mesh::Identity& sender, uint32_t sender
     reply_data[8] |= 0x01;  // is bridge, type UART
 #elif WITH_ESPNOW_BRIDGE
     reply_data[8] |= 0x03;  // is bridge, type ESP-NOW
+#elif defined(WITH_IP_BRIDGE)
+    reply_data[8] |= 0x05;  // is bridge, type IP
 #endif
     if (_prefs.disable_fwd) {   // is this repeater currently disabled
       reply_data[8] |= 0x80;  // is disabled
@@ -798,6 +800,9 @@ MyMesh::MyMesh(mesh::MainBoard &board, mesh::Radio &radio, mesh::MillisecondCloc
 #if defined(WITH_ESPNOW_BRIDGE)
       , bridge(&_prefs, _mgr, &rtc)
 #endif
+#if defined(WITH_IP_BRIDGE)
+      , bridge(&_prefs, WITH_IP_BRIDGE, IP_BRIDGE_HOST, IP_BRIDGE_PORT, _mgr, &rtc)
+#endif
 {
   last_millis = 0;
   uptime_millis = 0;
@@ -1209,9 +1214,49 @@ void MyMesh::handleCommand(uint32_t sender_timestamp, char *command, char *reply
       } else {
         strcpy(reply, "Err - not found");
       }
+    } else if (n == 2 && strcmp(parts[1], "stats") == 0) {
+      sprintf(reply, " match:%lu hot:%lu cached:%lu hmac:%lu", (unsigned long) region_map.getNumMatchCalls(),
+              (unsigned long) region_map.getNumHotMatches(), (unsigned long) region_map.getNumCachedMatches(),
+              (unsigned long) region_map.getNumMatchHMACs());
     } else {
       strcpy(reply, "Err - ??");
     }
+  } else if (strcmp(command, "stats-peers") == 0) {
+    uint32_t searches = getNumPeerSearches();
+    uint32_t avg_x10 = searches ? (getNumPeerCandidates() * 10) / searches : 0;
+    sprintf(reply, "searches:%lu avg:%lu.%lu max:%u macfail:%lu wide:%lu", (unsigned long) searches,
+            (unsigned long) (avg_x10 / 10), (unsigned long) (avg_x10 % 10), (uint32_t) getMaxPeerCandidates(),
+            (unsigned long) getNumPeerMACFails(), (unsigned long) getNumPeerWideRecv());
+  } else if (strcmp(command, "stats-channel") == 0 || memcmp(command, "stats-channel ", 14) == 0) {
+    int mins = command[13] ? atoi(&command[14]) : 1;   // window, in minutes
+    if (mins < 1) mins = 1;
+    if (mins > CHAN_HISTORY_MINUTES) mins = CHAN_HISTORY_MINUTES;
+    ChannelStats cs;
+    radio_driver.getChannelStats(mins, cs);
+    sprintf(reply, "%dm busy:%u%% lbt:%u%% rx:%u%% tx:%u%% coll:%u%% rssi:%d/%d/%d", mins,
+            (uint32_t) cs.busyPercent(), (uint32_t) cs.lbtBusyPercent(), (uint32_t) cs.rxAirPercent(),
+            (uint32_t) cs.txAirPercent(), (uint32_t) cs.collisionPercent(), (int) cs.rssi_p10, (int) cs.rssi_p50, (int) cs.rssi_p90);
+  } else if (strcmp(command, "stats-power") == 0) {
+    idleScheduler.formatStats(reply, 160);
+  } else if (strcmp(command, "clear stats-power") == 0) {
+    idleScheduler.resetStats();
+    strcpy(reply, "OK");
+#ifdef WITH_BRIDGE
+  } else if (strcmp(command, "stats-bridge") == 0) {
+    BridgeTables::shared().formatStats(reply, 160);
+  } else if (strcmp(command, "clear stats-bridge") == 0) {
+    BridgeTables::shared().resetStats();
+    strcpy(reply, "OK");
+#endif
+#ifdef WITH_IP_BRIDGE
+  } else if (strcmp(command, "stats-bridge ip") == 0) {
+    const IPBridgeStats& bs = bridge.getStats();
+    sprintf(reply, "peers:%d tx:%lu/%lu drop:%lu rx:%lu/%lu auth:%lu replay:%lu stale:%lu rate:%lu conn:%lu",
+            bridge.getNumConnected(), (unsigned long) bs.tx_packets, (unsigned long) bs.tx_frames,
+            (unsigned long) bs.tx_dropped, (unsigned long) bs.rx_packets, (unsigned long) bs.rx_frames,
+            (unsigned long) bs.auth_failed, (unsigned long) bs.replayed, (unsigned long) bs.stale,
+            (unsigned long) bs.rate_dropped, (unsigned long) bs.connects);
+#endif
   } else if (memcmp(command, "set path.hash.mode ", 19) == 0) {
     int mode = atoi(&command[19]);
     if (mode >= 0 && mode <= 2) {
@@ -1295,4 +1340,21 @@ if (pkt) sendFlood(pkt, (uint32_t)0, (uint8_t)(_prefs.path_hash_mode + 1));
 // To check if there is pending work
 bool MyMesh::hasPendingWork() const {
   return _mgr->getOutboundCount(0xFFFFFFFF) > 0;
+}
+
+// How long loop() can be left (radio interrupts aside): the Dispatcher's queues and timers, plus ours
+uint32_t MyMesh::getIdleMillis() {
+  uint32_t idle = mesh::Mesh::getIdleMillis();
+  unsigned long timers[] = { next_local_advert, next_flood_advert, set_radio_at, revert_radio_at, dirty_contacts_expiry };
+  unsigned long now = _ms->getMillis();
+  for (int i = 0; i < sizeof(timers) / sizeof(timers[0]); i++) {
+    if (timers[i] == 0) continue;   // not set
+    long d = (long)(timers[i] - now);
+    uint32_t t = d >= 0 ? (uint32_t)d + 1 : 0;
+    if (t < idle) idle = t;
+  }
+#ifdef WITH_BRIDGE
+  if (bridge.isRunning() && idle > REPEATER_BRIDGE_POLL_MS) idle = REPEATER_BRIDGE_POLL_MS;   // bridge is polled
+#endif
+  return idle;
 }
\ No newline at end of file
@@ -23,11 +23,17 @@
 #define WITH_BRIDGE
 #endif
 
+#ifdef WITH_IP_BRIDGE
+#include "helpers/bridges/IPBridge.h"
+#define WITH_BRIDGE
+#endif
+
 #include <helpers/AdvertDataHelpers.h>
 #include <helpers/ArduinoHelpers.h>
 #include <helpers/ClientACL.h>
 #include <helpers/CommonCLI.h>
 #include <helpers/IdentityStore.h>
+#include <helpers/IdleScheduler.h>
 #include <helpers/SimpleMeshTables.h>
 #include <helpers/StaticPoolPacketManager.h>
 #include <helpers/StatsFormatHelper.h>
@@ -60,6 +66,10 @@ struct RepeaterStats {
   #define MAX_CLIENTS           32
 #endif
 
+#ifndef REPEATER_BRIDGE_POLL_MS
+  #define REPEATER_BRIDGE_POLL_MS   10   // bridge has no wake-up, so loop() can't idle longer than this
+#endif
+
 struct NeighbourInfo {
   mesh::Identity id;
   uint32_t advert_timestamp;
@@ -112,6 +122,8 @@ class MyMesh : public mesh::Mesh, public CommonCLICallbacks {
   RS232Bridge bridge;
 #elif defined(WITH_ESPNOW_BRIDGE)
   ESPNowBridge bridge;
+#elif defined(WITH_IP_BRIDGE)
+  IPBridge bridge;
 #endif
 
   void putNeighbour(const mesh::Identity& id, uint32_t timestamp, float snr);
@@ -233,4 +245,5 @@ public:
 
   // To check if there is pending work
   bool hasPendingWork() const;
+  uint32_t getIdleMillis() override;
 };
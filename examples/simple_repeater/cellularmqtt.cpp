@@ -45,15 +45,19 @@ void CellularMQTT::begin() {
   _uartMutex = xSemaphoreCreateMutex();
   _telemetryMutex = xSemaphoreCreateMutex();
 
+  registerURCs();
+
   xTaskCreatePinnedToCore(taskEntry, "cell", CELL_TASK_STACK_SIZE,
                           this, CELL_TASK_PRIORITY, &_taskHandle, CELL_TASK_CORE);
 }
 
 void CellularMQTT::stop() {
   if (!_taskHandle) return;
-  mqttDisconnect();
+  // Stop the task first, so this thread has the UART to itself
   vTaskDelete(_taskHandle);
   _taskHandle = nullptr;
+  _at.reset();
+  mqttDisconnect();
   _state = CellState::OFF;
 }
 
@@ -199,7 +203,7 @@ bool CellularMQTT::modemPowerOn() {
   MODEM_SERIAL.begin(MODEM_BAUD, SERIAL_8N1, MODEM_TX, MODEM_RX);
   vTaskDelay(pdMS_TO_TICKS(500));
 
-  while (MODEM_SERIAL.available()) MODEM_SERIAL.read();
+  _at.begin(MODEM_SERIAL, "[Cell]");   // also drains boot garbage
 
   for (int i = 0; i < 10; i++) {
     if (sendAT("AT", "OK", 1500)) {
@@ -217,100 +221,42 @@ bool CellularMQTT::modemPowerOn() {
 // AT command helpers
 // ---------------------------------------------------------------------------
 
+// 'expect' other than "OK" is a result line that follows the OK (eg. "+HTTPACTION:")
 bool CellularMQTT::sendAT(const char* cmd, const char* expect, uint32_t timeout_ms) {
-  drainURCs();
-  Serial.printf("[Cell] TX: %s\n", cmd);
-  MODEM_SERIAL.println(cmd);
-  bool ok = waitResponse(expect, timeout_ms, _atBuf, AT_BUF_SIZE);
-  int len = strlen(_atBuf);
-  while (len > 0 && (_atBuf[len-1] == '\r' || _atBuf[len-1] == '\n')) _atBuf[--len] = '\0';
-  if (_atBuf[0]) {
-    Serial.printf("[Cell] RX: %.120s [%s]\n", _atBuf, ok ? "OK" : "FAIL");
-  }
-  return ok;
+  ATRequest req;
+  req.cmd = cmd;
+  req.timeout = timeout_ms;
+  if (expect && strcmp(expect, "OK") != 0) req.final_prefix = expect;
+  return _at.exec(req, _atBuf, AT_BUF_SIZE) == AT_OK;
 }
 
-bool CellularMQTT::waitResponse(const char* expect, uint32_t timeout_ms,
-                                  char* buf, size_t bufLen) {
-  unsigned long start = millis();
-  int pos = 0;
-  if (buf && bufLen > 0) buf[0] = '\0';
-
-  while (millis() - start < timeout_ms) {
-    while (MODEM_SERIAL.available()) {
-      char c = MODEM_SERIAL.read();
-      if (buf && pos < (int)bufLen - 1) {
-        buf[pos++] = c;
-        buf[pos] = '\0';
-      }
-      if (buf && expect && strstr(buf, expect)) return true;
-      if (buf && strstr(buf, "ERROR")) return false;
-    }
-    vTaskDelay(pdMS_TO_TICKS(10));
-  }
-  if (buf && expect && strstr(buf, expect)) return true;
-  return false;
-}
-
-bool CellularMQTT::waitPrompt(uint32_t timeout_ms) {
-  unsigned long start = millis();
-  while (millis() - start < timeout_ms) {
-    while (MODEM_SERIAL.available()) {
-      char c = MODEM_SERIAL.read();
-      if (c == '>') return true;
-    }
-    vTaskDelay(pdMS_TO_TICKS(10));
-  }
-  return false;
+// Commands that prompt with '>' for data (topic, URL), then answer OK
+bool CellularMQTT::sendWithPrompt(const char* cmd, const char* data, int len, uint32_t timeout_ms) {
+  ATRequest req;
+  req.cmd = cmd;
+  req.timeout = timeout_ms;
+  req.payload = (const uint8_t*)data;
+  req.payload_len = len;
+  return _at.exec(req, _atBuf, AT_BUF_SIZE) == AT_OK;
 }
 
 // ---------------------------------------------------------------------------
 // URC handling
 // ---------------------------------------------------------------------------
 
-void CellularMQTT::drainURCs() {
-  while (MODEM_SERIAL.available()) {
-    char c = MODEM_SERIAL.read();
-
-    if (_rxState == RX_WAIT_TOPIC) {
-      if (_urcPos < _rxTopicLen && _urcPos < MQTT_TOPIC_MAX - 1) {
-        _rxTopic[_urcPos] = c;
-      }
-      _urcPos++;
-      if (_urcPos >= _rxTopicLen) {
-        _rxTopic[min(_rxTopicLen, MQTT_TOPIC_MAX - 1)] = '\0';
-        handleMqttRxTopic(_rxTopic, _rxTopicLen);
-        _urcPos = 0;
-        _rxState = RX_IDLE;
-      }
-      continue;
-    }
-
-    if (_rxState == RX_WAIT_PAYLOAD) {
-      if (_urcPos < _rxPayloadLen && _urcPos < MQTT_PAYLOAD_MAX - 1) {
-        _rxPayload[_urcPos] = c;
-      }
-      _urcPos++;
-      if (_urcPos >= _rxPayloadLen) {
-        _rxPayload[min(_rxPayloadLen, MQTT_PAYLOAD_MAX - 1)] = '\0';
-        handleMqttRxPayload(_rxPayload, _rxPayloadLen);
-        _urcPos = 0;
-        _rxState = RX_IDLE;
-      }
-      continue;
-    }
+void CellularMQTT::registerURCs() {
+  if (_urcsRegistered) return;
+  _at.subscribe("+CMQTTRXSTART:",   onMqttURC, this);
+  _at.subscribe("+CMQTTRXTOPIC:",   onMqttURC, this);
+  _at.subscribe("+CMQTTRXPAYLOAD:", onMqttURC, this);
+  _at.subscribe("+CMQTTRXEND:",     onMqttURC, this);
+  _at.subscribe("+CMQTTCONNLOST:",  onMqttURC, this);
+  _at.subscribe("+HTTPREAD:",       onHttpRead, this);   // data can follow the OK
+  _urcsRegistered = true;
+}
 
-    if (c == '\n') {
-      if (_urcPos > 0) {
-        while (_urcPos > 0 && _urcBuf[_urcPos - 1] == '\r') _urcPos--;
-        _urcBuf[_urcPos] = '\0';
-        if (_urcPos > 0) processURCLine(_urcBuf);
-      }
-      _urcPos = 0;
-    } else if (c != '\r' || _urcPos > 0) {
-      if (_urcPos < URC_BUF_SIZE - 1) _urcBuf[_urcPos++] = c;
-    }
-  }
+void CellularMQTT::onMqttURC(void* ctx, const char* line) {
+  static_cast<CellularMQTT*>(ctx)->processURCLine(line);
 }
 
 void CellularMQTT::processURCLine(const char* line) {
@@ -318,12 +264,12 @@ void CellularMQTT::processURCLine(const char* line) {
     handleMqttRxStart(line);
     return;
   }
+  // Topic and payload follow their length line as raw bytes
   if (strncmp(line, "+CMQTTRXTOPIC:", 14) == 0) {
     int client, tlen;
     if (sscanf(line, "+CMQTTRXTOPIC: %d,%d", &client, &tlen) == 2) {
       _rxTopicLen = tlen;
-      _urcPos = 0;
-      _rxState = RX_WAIT_TOPIC;
+      _at.captureRaw((uint8_t*)_rxTopic, tlen, MQTT_TOPIC_MAX - 1, onRxTopic, this);
     }
     return;
   }
@@ -331,8 +277,7 @@ void CellularMQTT::processURCLine(const char* line) {
     int client, plen;
     if (sscanf(line, "+CMQTTRXPAYLOAD: %d,%d", &client, &plen) == 2) {
       _rxPayloadLen = plen;
-      _urcPos = 0;
-      _rxState = RX_WAIT_PAYLOAD;
+      _at.captureRaw((uint8_t*)_rxPayload, plen, MQTT_PAYLOAD_MAX - 1, onRxPayload, this);
     }
     return;
   }
@@ -346,6 +291,18 @@ void CellularMQTT::processURCLine(const char* line) {
   }
 }
 
+void CellularMQTT::onRxTopic(void* ctx, const uint8_t* data, int len) {
+  CellularMQTT* self = static_cast<CellularMQTT*>(ctx);
+  self->_rxTopic[len] = '\0';
+  self->handleMqttRxTopic(self->_rxTopic, self->_rxTopicLen);
+}
+
+void CellularMQTT::onRxPayload(void* ctx, const uint8_t* data, int len) {
+  CellularMQTT* self = static_cast<CellularMQTT*>(ctx);
+  self->_rxPayload[len] = '\0';
+  self->handleMqttRxPayload(self->_rxPayload, self->_rxPayloadLen);
+}
+
 // ---------------------------------------------------------------------------
 // MQTT receive handlers
 // ---------------------------------------------------------------------------
@@ -539,49 +496,25 @@ bool CellularMQTT::mqttConnect() {
   Serial.printf("[Cell] TX: AT+CMQTTCONNECT=0,\"ssl://%s:%d\",...\n",
                 _config.broker, _config.port);
                 Serial.printf("[Cell] Full cmd (%d chars): %s\n", strlen(cmd), cmd);
-  MODEM_SERIAL.println(cmd);
 
-  // Wait for +CMQTTCONNECT URC (any result code, not just success)
-  // Don't use waitResponse — it bails on "ERROR" before we see the code
-  unsigned long start = millis();
-  int pos = 0;
-  _atBuf[0] = '\0';
-
-  while (millis() - start < 30000) {
-    while (MODEM_SERIAL.available()) {
-      char c = MODEM_SERIAL.read();
-      if (pos < AT_BUF_SIZE - 1) {
-        _atBuf[pos++] = c;
-        _atBuf[pos] = '\0';
-      }
-      // Check for the URC regardless of what else is in the buffer
-      char* p = strstr(_atBuf, "+CMQTTCONNECT:");
-      if (p) {
-        // Give it a moment to complete the line
-        vTaskDelay(pdMS_TO_TICKS(100));
-        while (MODEM_SERIAL.available() && pos < AT_BUF_SIZE - 1) {
-          _atBuf[pos++] = MODEM_SERIAL.read();
-          _atBuf[pos] = '\0';
-        }
-
-        int client, result;
-        if (sscanf(p, "+CMQTTCONNECT: %d,%d", &client, &result) == 2) {
-          Serial.printf("[Cell] MQTT connect result: %d\n", result);
-          if (result == 0) {
-            Serial.println("[Cell] MQTT connected!");
-            return true;
-          }
-        }
-        Serial.printf("[Cell] MQTT connect failed (code from URC): %.80s\n", p);
-        return false;
+  // Completes on the +CMQTTCONNECT result line (any result code), not the OK
+  sendAT(cmd, "+CMQTTCONNECT:", 30000);
+
+  char* p = strstr(_atBuf, "+CMQTTCONNECT:");
+  if (p) {
+    int client, result;
+    if (sscanf(p, "+CMQTTCONNECT: %d,%d", &client, &result) == 2) {
+      Serial.printf("[Cell] MQTT connect result: %d\n", result);
+      if (result == 0) {
+        Serial.println("[Cell] MQTT connected!");
+        return true;
       }
     }
-    vTaskDelay(pdMS_TO_TICKS(50));
+    Serial.printf("[Cell] MQTT connect failed (code from URC): %.80s\n", p);
+    return false;
   }
 
-  // Timeout — dump what we got
-  int len = strlen(_atBuf);
-  while (len > 0 && (_atBuf[len-1] == '\r' || _atBuf[len-1] == '\n')) _atBuf[--len] = '\0';
+  // Timeout / ERROR — dump what we got
   Serial.printf("[Cell] MQTT connect timeout. Buffer: %.200s\n", _atBuf);
   return false;
 }
@@ -590,59 +523,80 @@ bool CellularMQTT::mqttSubscribe(const char* topic) {
   int tlen = strlen(topic);
   char cmd[80];
   snprintf(cmd, sizeof(cmd), "AT+CMQTTSUB=0,%d,1", tlen);
-  MODEM_SERIAL.println(cmd);
-
-  if (!waitPrompt(5000)) {
-    Serial.println("[Cell] No prompt for CMQTTSUB");
+  if (!sendWithPrompt(cmd, topic, tlen, 15000)) {
+    Serial.printf("[Cell] CMQTTSUB failed: %.80s\n", _atBuf);
     return false;
   }
+  return true;
+}
 
-  MODEM_SERIAL.write((const uint8_t*)topic, tlen);
-  return waitResponse("OK", 10000, _atBuf, AT_BUF_SIZE);
+bool CellularMQTT::canPublish() const {
+  if (_at.getFree() < 3) return false;
+  for (int i = 0; i < MQTT_PUB_PIPELINE; i++) {
+    if (!_pub[i].busy) return true;
+  }
+  return false;
 }
 
+// Queues the topic / payload / publish steps back to back; each step only
+// runs if the one before it succeeded. onPublished() gets the outcome.
 bool CellularMQTT::mqttPublish(const char* topic, const char* payload) {
-  int tlen = strlen(topic);
-  int plen = strlen(payload);
+  if (!canPublish()) return false;
+
+  PubSlot* slot = nullptr;
+  for (int i = 0; i < MQTT_PUB_PIPELINE; i++) {
+    if (!_pub[i].busy) { slot = &_pub[i]; break; }
+  }
+  slot->owner = this;
+  slot->busy = true;
+  strncpy(slot->topic, topic, MQTT_TOPIC_MAX - 1);
+  slot->topic[MQTT_TOPIC_MAX - 1] = '\0';
+  strncpy(slot->payload, payload, MQTT_PAYLOAD_MAX - 1);
+  slot->payload[MQTT_PAYLOAD_MAX - 1] = '\0';
 
   // Step 1: Set topic
   char cmd[80];
-  snprintf(cmd, sizeof(cmd), "AT+CMQTTTOPIC=0,%d", tlen);
-  MODEM_SERIAL.println(cmd);
-  if (!waitPrompt(5000)) {
-    _pubFailCount++;
-    Serial.println("[Cell] No prompt for CMQTTTOPIC");
-    return false;
-  }
-  MODEM_SERIAL.write((const uint8_t*)topic, tlen);
-  if (!waitResponse("OK", 5000, _atBuf, AT_BUF_SIZE)) {
-    _pubFailCount++;
-    return false;
-  }
+  snprintf(cmd, sizeof(cmd), "AT+CMQTTTOPIC=0,%d", (int)strlen(slot->topic));
+  ATRequest topicReq;
+  topicReq.cmd = cmd;
+  topicReq.timeout = 10000;
+  topicReq.payload = (const uint8_t*)slot->topic;
+  topicReq.payload_len = strlen(slot->topic);
+  _at.submit(topicReq);
 
   // Step 2: Set payload
-  snprintf(cmd, sizeof(cmd), "AT+CMQTTPAYLOAD=0,%d", plen);
-  MODEM_SERIAL.println(cmd);
-  if (!waitPrompt(5000)) {
-    _pubFailCount++;
-    return false;
-  }
-  MODEM_SERIAL.write((const uint8_t*)payload, plen);
-  if (!waitResponse("OK", 5000, _atBuf, AT_BUF_SIZE)) {
-    _pubFailCount++;
-    return false;
-  }
+  snprintf(cmd, sizeof(cmd), "AT+CMQTTPAYLOAD=0,%d", (int)strlen(slot->payload));
+  ATRequest payloadReq;
+  payloadReq.cmd = cmd;
+  payloadReq.timeout = 10000;
+  payloadReq.payload = (const uint8_t*)slot->payload;
+  payloadReq.payload_len = strlen(slot->payload);
+  payloadReq.chain = true;
+  _at.submit(payloadReq);
 
   // Step 3: Publish QoS 1, 60s timeout
-  if (!sendAT("AT+CMQTTPUB=0,1,60", "OK", 15000)) {
-    _pubFailCount++;
-    Serial.printf("[Cell] Publish failed (%d consecutive)\n", _pubFailCount);
-    return false;
-  }
+  ATRequest pubReq;
+  pubReq.cmd = "AT+CMQTTPUB=0,1,60";
+  pubReq.timeout = 15000;
+  pubReq.chain = true;
+  pubReq.done = onPublished;
+  pubReq.ctx = slot;
+  _at.submit(pubReq);
+  return true;
+}
 
+void CellularMQTT::onPublished(void* ctx, ATResult result, const char* resp) {
+  PubSlot* slot = static_cast<PubSlot*>(ctx);
+  CellularMQTT* self = slot->owner;
+  slot->busy = false;
+
+  if (result != AT_OK) {
+    self->_pubFailCount++;
+    Serial.printf("[Cell] Publish failed (%d consecutive)\n", self->_pubFailCount);
+    return;
+  }
   // Success — reset failure counter
-  _pubFailCount = 0;
-  return true;
+  self->_pubFailCount = 0;
 }
 
 void CellularMQTT::mqttDisconnect() {
@@ -655,18 +609,6 @@ void CellularMQTT::mqttDisconnect() {
 // OTA — HTTP download via A7682E + ESP32 flash
 // ---------------------------------------------------------------------------
 
-int CellularMQTT::readRawBytes(uint8_t* dest, int count, uint32_t timeout_ms) {
-  unsigned long start = millis();
-  int received = 0;
-  while (received < count && millis() - start < timeout_ms) {
-    while (MODEM_SERIAL.available() && received < count) {
-      dest[received++] = MODEM_SERIAL.read();
-    }
-    if (received < count) vTaskDelay(pdMS_TO_TICKS(5));
-  }
-  return received;
-}
-
 int CellularMQTT::httpGet(const char* url) {
   sendAT("AT+HTTPTERM", "OK", 2000);
   vTaskDelay(pdMS_TO_TICKS(500));
@@ -679,14 +621,7 @@ int CellularMQTT::httpGet(const char* url) {
   int urlLen = strlen(url);
   char cmd[40];
   snprintf(cmd, sizeof(cmd), "AT+HTTPPARA=\"URL\",%d", urlLen);
-  MODEM_SERIAL.println(cmd);
-  if (!waitPrompt(5000)) {
-    Serial.println("[OTA] No prompt for HTTPPARA URL");
-    httpTerm();
-    return -1;
-  }
-  MODEM_SERIAL.write((const uint8_t*)url, urlLen);
-  if (!waitResponse("OK", 10000, _atBuf, AT_BUF_SIZE)) {
+  if (!sendWithPrompt(cmd, url, urlLen, 15000)) {
     Serial.println("[OTA] HTTPPARA URL failed");
     httpTerm();
     return -1;
@@ -698,40 +633,19 @@ int CellularMQTT::httpGet(const char* url) {
 
   sendAT("AT+HTTPPARA=\"REDIR\",1", "OK", 2000);
 
-  MODEM_SERIAL.println("AT+HTTPACTION=0");
-
-  unsigned long start = millis();
-  int pos = 0;
-  _atBuf[0] = '\0';
-
-  while (millis() - start < 180000) {
-    while (MODEM_SERIAL.available()) {
-      char c = MODEM_SERIAL.read();
-      if (pos < AT_BUF_SIZE - 1) {
-        _atBuf[pos++] = c;
-        _atBuf[pos] = '\0';
-      }
-      char* p = strstr(_atBuf, "+HTTPACTION:");
-      if (p) {
-        vTaskDelay(pdMS_TO_TICKS(100));
-        while (MODEM_SERIAL.available() && pos < AT_BUF_SIZE - 1) {
-          _atBuf[pos++] = MODEM_SERIAL.read();
-          _atBuf[pos] = '\0';
-        }
-
-        int method, status, contentLen;
-        if (sscanf(p, "+HTTPACTION: %d,%d,%d", &method, &status, &contentLen) == 3) {
-          Serial.printf("[OTA] HTTP status=%d content_length=%d\n", status, contentLen);
-          if (status == 200 && contentLen > 0) {
-            return contentLen;
-          }
-          Serial.printf("[OTA] HTTP download failed (status %d)\n", status);
-          httpTerm();
-          return -1;
-        }
+  // OK comes straight away, +HTTPACTION: <method>,<status>,<len> once downloaded
+  if (sendAT("AT+HTTPACTION=0", "+HTTPACTION:", 180000)) {
+    char* p = strstr(_atBuf, "+HTTPACTION:");
+    int method, status, contentLen;
+    if (p && sscanf(p, "+HTTPACTION: %d,%d,%d", &method, &status, &contentLen) == 3) {
+      Serial.printf("[OTA] HTTP status=%d content_length=%d\n", status, contentLen);
+      if (status == 200 && contentLen > 0) {
+        return contentLen;
       }
+      Serial.printf("[OTA] HTTP download failed (status %d)\n", status);
+      httpTerm();
+      return -1;
     }
-    vTaskDelay(pdMS_TO_TICKS(100));
   }
 
   Serial.println("[OTA] HTTP download timeout");
@@ -739,53 +653,57 @@ int CellularMQTT::httpGet(const char* url) {
   return -1;
 }
 
+// "+HTTPREAD: <len>" is followed by <len> raw bytes; a trailing "+HTTPREAD: 0"
+// marks the end. Arrives as a response line or, after the OK, as a URC.
+void CellularMQTT::onHttpRead(void* ctx, const char* line) {
+  CellularMQTT* self = static_cast<CellularMQTT*>(ctx);
+  int actualLen = 0;
+  sscanf(line, "+HTTPREAD: %d", &actualLen);
+  if (actualLen <= 0 || !self->_httpDest || self->_httpGot >= 0) return;
+
+  if (actualLen > self->_httpWant) {
+    Serial.printf("[OTA] Bad HTTPREAD len: %d\n", actualLen);
+    self->_httpGot = 0;
+    return;
+  }
+  self->_at.captureRaw(self->_httpDest, actualLen, self->_httpWant, onHttpData, self);
+}
+
+void CellularMQTT::onHttpData(void* ctx, const uint8_t* data, int len) {
+  static_cast<CellularMQTT*>(ctx)->_httpGot = len;
+}
+
 bool CellularMQTT::httpReadChunk(int offset, int len, uint8_t* dest, int* bytesRead) {
   *bytesRead = 0;
+  _httpDest = dest;
+  _httpWant = len;
+  _httpGot = -1;
 
   char cmd[40];
   snprintf(cmd, sizeof(cmd), "AT+HTTPREAD=%d,%d", offset, len);
-  MODEM_SERIAL.println(cmd);
-
+  ATRequest req;
+  req.cmd = cmd;
+  req.timeout = 10000;
+  req.on_line = onHttpRead;
+  req.ctx = this;
+  bool ok = _at.exec(req, _atBuf, AT_BUF_SIZE) == AT_OK;
+
+  // The data may still be on its way if the OK came first
   unsigned long start = millis();
-  int pos = 0;
-  _atBuf[0] = '\0';
-
-  while (millis() - start < 10000) {
-    while (MODEM_SERIAL.available()) {
-      char c = MODEM_SERIAL.read();
-      if (pos < AT_BUF_SIZE - 1) {
-        _atBuf[pos++] = c;
-        _atBuf[pos] = '\0';
-      }
-
-      char* p = strstr(_atBuf, "+HTTPREAD:");
-      if (p) {
-        char* nl = strchr(p, '\n');
-        if (nl) {
-          int actualLen = 0;
-          sscanf(p, "+HTTPREAD: %d", &actualLen);
-          if (actualLen <= 0 || actualLen > len) {
-            Serial.printf("[OTA] Bad HTTPREAD len: %d\n", actualLen);
-            return false;
-          }
-
-          int got = readRawBytes(dest, actualLen, 15000);
-          if (got != actualLen) {
-            Serial.printf("[OTA] Short read: got %d expected %d\n", got, actualLen);
-            return false;
-          }
+  while (ok && _httpGot < 0 && millis() - start < 15000) {
+    _at.poll();
+    vTaskDelay(pdMS_TO_TICKS(5));
+  }
+  _httpDest = nullptr;
 
-          *bytesRead = actualLen;
-          waitResponse("OK", 3000, _atBuf, AT_BUF_SIZE);
-          return true;
-        }
-      }
-    }
-    vTaskDelay(pdMS_TO_TICKS(10));
+  if (!ok || _httpGot < 0) {
+    Serial.println("[OTA] HTTPREAD timeout");
+    return false;
   }
+  if (_httpGot == 0) return false;
 
-  Serial.println("[OTA] HTTPREAD timeout");
-  return false;
+  *bytesRead = _httpGot;
+  return true;
 }
 
 void CellularMQTT::httpTerm() {
@@ -1062,7 +980,7 @@ restart:
       continue;
     }
 
-    drainURCs();
+    _at.poll();
 
     // Health check: too many consecutive publish failures = silent disconnect
     if (_pubFailCount >= MQTT_PUB_FAIL_MAX && _state == CellState::CONNECTED) {
@@ -1099,10 +1017,10 @@ restart:
       Serial.println("[Cell] Reconnected");
     }
 
-    // Publish queued responses
+    // Publish queued responses (as many as the pipeline has room for)
     if (_state == CellState::CONNECTED) {
       MQTTResponse rsp;
-      while (xQueueReceive(_rspQueue, &rsp, 0) == pdTRUE) {
+      while (canPublish() && xQueueReceive(_rspQueue, &rsp, 0) == pdTRUE) {
         mqttPublish(rsp.topic, rsp.payload);
       }
     }
@@ -1116,8 +1034,8 @@ restart:
       lastCSQ = millis();
     }
 
-    // Periodic telemetry publish
-    if (_state == CellState::CONNECTED && millis() - lastTelem > TELEMETRY_INTERVAL) {
+    // Periodic telemetry publish (waits for pipeline room rather than dropping)
+    if (_state == CellState::CONNECTED && canPublish() && millis() - lastTelem > TELEMETRY_INTERVAL) {
       TelemetryData td;
       if (xSemaphoreTake(_telemetryMutex, pdMS_TO_TICKS(50))) {
         memcpy(&td, &_telemetry, sizeof(td));
@@ -1145,9 +1063,15 @@ restart:
 
       mqttPublish(_topicTelem, json);
       lastTelem = millis();
+
+      const ATStats& st = _at.getStats();
+      Serial.printf("[Cell] AT: %lu sent, %lu fail, %lu timeout, avg %lums, max %lums, queue max %lums\n",
+                    (unsigned long)st.sent, (unsigned long)st.failed, (unsigned long)st.timeouts,
+                    (unsigned long)st.avgMillis(), (unsigned long)st.max_ms, (unsigned long)st.max_queue_ms);
     }
 
-    vTaskDelay(pdMS_TO_TICKS(200));
+    // Poll quickly while publishes are in flight
+    vTaskDelay(pdMS_TO_TICKS(_at.isIdle() ? 200 : 10));
   }
 }
 
@@ -35,6 +35,13 @@ static char command[160];
 unsigned long lastActive = 0; // mark last active time
 unsigned long nextSleepinSecs = 120; // next sleep in seconds. The first sleep (if enabled) is after 2 minutes from boot
 
+#ifndef REPEATER_IDLE_WAIT_MS
+  #define REPEATER_IDLE_WAIT_MS     5     // longest wait between loop() passes while awake (serial CLI, UI, sensors are polled)
+#endif
+#ifndef POWERSAVE_MAX_SLEEP_SECS
+  #define POWERSAVE_MAX_SLEEP_SECS  1800
+#endif
+
 #if (defined(HAS_4G_MODEM) || defined(MECK_WIFI_REMOTE)) && (defined(HAS_SDCARD) || defined(SDCARD_CS))
 static bool sdCardReady = false;
 #endif
@@ -60,6 +67,8 @@ void setup() {
   if (!radio_init()) {
     halt();
   }
+  idleScheduler.begin();
+  radio_driver.setWakeHook(IdleScheduler::radioWake, &idleScheduler);   // a packet ends any idle wait early
 
   fast_rng.begin(radio_get_rng_seed());
 
@@ -319,16 +328,19 @@ void loop() {
 #endif
   rtc_clock.tick();
 
+  // Idle until the mesh next has work (queued packets, advert and other timers), or a packet arrives
+  idleScheduler.deadline(the_mesh.getIdleMillis());
+
 #if !defined(HAS_4G_MODEM) && !defined(MECK_WIFI_REMOTE)
   if (the_mesh.getNodePrefs()->powersaving_enabled &&
       the_mesh.millisHasNowPassed(lastActive + nextSleepinSecs * 1000)) {
-    if (!the_mesh.hasPendingWork()) {
-      board.sleep(1800);
+    idleScheduler.sleep(board, POWERSAVE_MAX_SLEEP_SECS * 1000UL, REPEATER_IDLE_WAIT_MS);
+    if (idleScheduler.getLastWake() != IDLE_WAKE_DEADLINE) {   // woken by a packet: stay up a bit, eg. for replies
       lastActive = millis();
       nextSleepinSecs = 5;
-    } else {
-      nextSleepinSecs += 5;
     }
+    return;
   }
 #endif
+  idleScheduler.wait(REPEATER_IDLE_WAIT_MS);
 }
\ No newline at end of file
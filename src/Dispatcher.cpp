@@ -126,6 +126,42 @@ void Dispatcher::loop() {
   checkSend();
 }
 
+// millis until millisHasNowPassed(timestamp), 0 if already passed
+static uint32_t millisUntil(unsigned long timestamp, unsigned long now) {
+  long d = (long)(timestamp - now);
+  return d >= 0 ? (uint32_t)d + 1 : 0;
+}
+
+uint32_t Dispatcher::getIdleMillis() {
+  unsigned long now = _ms->getMillis();
+  if (!_radio->isInRecvMode() && !outbound) return 0;   // Rx needs restarting, or stuck check pending
+
+  uint32_t idle = _radio->getIdleMillis();
+  if (idle == 0) return 0;
+
+  if (outbound) {   // Tx done raises the same interrupt as Rx
+    uint32_t t = millisUntil(outbound_expiry, now);
+    if (t < idle) idle = t;
+    return idle;
+  }
+
+  // NOTE: noise floor calibration is best effort, it doesn't keep us awake
+  uint32_t t;
+  if (getAGCResetInterval() > 0) {
+    t = millisUntil(next_agc_reset_time, now);
+    if (t < idle) idle = t;
+  }
+  t = _mgr->millisToNextInbound(now);
+  if (t < idle) idle = t;
+  t = _mgr->millisToNextOutbound(now);
+  if (t != IDLE_NO_DEADLINE) {
+    uint32_t silence = millisUntil(next_tx_time, now);   // can't send before then anyway
+    if (silence > t) t = silence;
+    if (t < idle) idle = t;
+  }
+  return idle;
+}
+
 void Dispatcher::checkRecv() {
   Packet* pkt;
   float score;
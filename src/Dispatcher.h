@@ -6,6 +6,8 @@
 #include <Utils.h>
 #include <string.h>
 
+#define IDLE_NO_DEADLINE   0xFFFFFFFF   // getIdleMillis() etc: nothing scheduled
+
 namespace mesh {
 
 /**
@@ -63,6 +65,11 @@ public:
 
   virtual int getNoiseFloor() const { return 0; }
 
+  /**
+   * \returns  recent channel congestion, 0..100 (percent of time channel was sensed busy)
+   */
+  virtual uint8_t getChannelBusyPercent() const { return 0; }
+
   virtual void triggerNoiseFloorCalibrate(int threshold) { }
 
   virtual void resetAGC() { }
@@ -76,6 +83,11 @@ public:
 
   virtual float getLastRSSI() const { return 0; }
   virtual float getLastSNR() const { return 0; }
+
+  /**
+   * \returns  millis the radio can be left alone for (an interrupt will signal a packet), 0 if it needs polling now.
+  */
+  virtual uint32_t getIdleMillis() { return 0; }
 };
 
 /**
@@ -95,6 +107,12 @@ public:
   virtual Packet* removeOutboundByIdx(int i) = 0;
   virtual void queueInbound(Packet* packet, uint32_t scheduled_for) = 0;
   virtual Packet* getNextInbound(uint32_t now) = 0;
+
+  /**
+   * \returns  millis until the earliest queued packet is due, 0 if one is due now, IDLE_NO_DEADLINE if queue is empty.
+  */
+  virtual uint32_t millisToNextOutbound(uint32_t now) const { return getOutboundCount(0xFFFFFFFF) > 0 ? 0 : IDLE_NO_DEADLINE; }
+  virtual uint32_t millisToNextInbound(uint32_t now) const { return 0; }   // unknown, assume due
 };
 
 typedef uint32_t  DispatcherAction;
@@ -173,6 +191,12 @@ public:
   void begin();
   void loop();
 
+  /**
+   * \returns  millis until loop() next has work to do (0 = now), assuming no packet arrives in the meantime.
+   *          Sub-classes add their own timers.
+  */
+  virtual uint32_t getIdleMillis();
+
   Packet* obtainNewPacket();
   void releasePacket(Packet* packet);
   void sendPacket(Packet* packet, uint8_t priority, uint32_t delay_millis=0);
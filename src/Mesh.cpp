@@ -27,19 +27,23 @@ uint8_t Mesh::getExtraAckTransmitCount() const {
 }
 
 uint32_t Mesh::getCADFailRetryDelay() const {
-  return _rng->nextInt(1, 4)*120;
+  return _rng->nextInt(1, 4 + _radio->getChannelBusyPercent() / 20)*120;   // back off further when channel is congested
 }
 
 int Mesh::searchPeersByHash(const uint8_t* hash) {
   return 0;  // not found
 }
 
+int Mesh::searchPeersByHash(const uint8_t* hash, uint8_t hash_size) {
+  return searchPeersByHash(hash);  // legacy sub-classes only match on first byte (MAC check still applies)
+}
+
 int Mesh::searchChannelsByHash(const uint8_t* hash, GroupChannel channels[], int max_matches) {
   return 0;  // not found
 }
 
 DispatcherAction Mesh::onRecvPacket(Packet* pkt) {
-  if (pkt->getPayloadVer() > PAYLOAD_VER_1) {  // not supported in this firmware version
+  if (pkt->getPayloadVer() > PAYLOAD_VER_2 || (pkt->getPayloadVer() == PAYLOAD_VER_2 && !pkt->isPeerDatagram())) {  // not supported in this firmware version
     MESH_DEBUG_PRINTLN("%s Mesh::onRecvPacket(): unsupported packet version", getLogDateTime());
     return ACTION_RELEASE;
   }
@@ -133,8 +137,10 @@ DispatcherAction Mesh::onRecvPacket(Packet* pkt) {
     case PAYLOAD_TYPE_RESPONSE:
     case PAYLOAD_TYPE_TXT_MSG: {
       int i = 0;
-      uint8_t dest_hash = pkt->payload[i++];
-      uint8_t src_hash = pkt->payload[i++];
+      uint8_t hash_sz = pkt->getPeerHashSize();
+      uint8_t dest_hash[PEER_HASH_SIZE_V2], src_hash[PEER_HASH_SIZE_V2];
+      memcpy(dest_hash, &pkt->payload[i], hash_sz); i += hash_sz;
+      memcpy(src_hash, &pkt->payload[i], hash_sz); i += hash_sz;
 
       uint8_t* macAndData = &pkt->payload[i];   // MAC + encrypted data 
       if (i + CIPHER_MAC_SIZE >= pkt->payload_len) {
@@ -144,9 +150,14 @@ DispatcherAction Mesh::onRecvPacket(Packet* pkt) {
         //       For flood mode, the path may not be the 'best' in terms of hops.
         // FUTURE: could send back multiple paths, using createPathReturn(), and let sender choose which to use(?)
 
-        if (self_id.isHashMatch(&dest_hash)) {
-          // scan contacts DB, for all matching hashes of 'src_hash' (max 4 matches supported ATM)
-          int num = searchPeersByHash(&src_hash);
+        if (self_id.isHashMatch(dest_hash, hash_sz)) {
+          // scan contacts DB, for all matching hashes of 'src_hash' (max MAX_SEARCH_RESULTS matches)
+          int num = hash_sz == PATH_HASH_SIZE ? searchPeersByHash(src_hash) : searchPeersByHash(src_hash, hash_sz);
+          n_peer_searches++;
+          n_peer_candidates += num;
+          if (num > max_peer_candidates) max_peer_candidates = num;
+          if (hash_sz > PATH_HASH_SIZE) n_peer_wide_recv++;
+
           // for each matching contact, try to decrypt data
           bool found = false;
           for (int j = 0; j < num; j++) {
@@ -167,7 +178,7 @@ DispatcherAction Mesh::onRecvPacket(Packet* pkt) {
                 if (onPeerPathRecv(pkt, j, secret, path, path_len, extra_type, extra, extra_len)) {
                   if (pkt->isRouteFlood()) {
                     // send a reciprocal return path to sender, but send DIRECTLY!
-                    mesh::Packet* rpath = createPathReturn(&src_hash, secret, pkt->path, pkt->path_len, 0, NULL, 0);
+                    mesh::Packet* rpath = createPathReturn(src_hash, secret, pkt->path, pkt->path_len, 0, NULL, 0, hash_sz);
                     if (rpath) sendDirect(rpath, path, path_len, 500);
                   }
                 }
@@ -177,11 +188,12 @@ DispatcherAction Mesh::onRecvPacket(Packet* pkt) {
               found = true;
               break;
             }
+            n_peer_mac_fails++;   // hash collision, wasted a decrypt attempt
           }
           if (found) {
             pkt->markDoNotRetransmit();  // packet was for this node, so don't retransmit
           } else {
-            MESH_DEBUG_PRINTLN("%s recv matches no peers, src_hash=%02X", getLogDateTime(), (uint32_t)src_hash);
+            MESH_DEBUG_PRINTLN("%s recv matches no peers, src_hash=%02X", getLogDateTime(), (uint32_t)src_hash[0]);
           }
         }
         action = routeRecvPacket(pkt);
@@ -306,8 +318,43 @@ DispatcherAction Mesh::onRecvPacket(Packet* pkt) {
             onAckRecv(&tmp, ack_crc);
             //action = routeRecvPacket(&tmp);  // NOTE: currently not needed, as multipart ACKs not sent Flood
           }
-        } else {
-          // FUTURE: other multipart types??
+        } else if (type == MULTIPART_TYPE_PEER_FRAG && !_tables->hasSeen(pkt)) {
+          int i = 1;
+          const uint8_t* dest_hash = &pkt->payload[i]; i += PATH_HASH_SIZE;
+          const uint8_t* src_hash = &pkt->payload[i]; i += PATH_HASH_SIZE;
+
+          if (i + CIPHER_MAC_SIZE < pkt->payload_len && self_id.isHashMatch(dest_hash)) {
+            int num = searchPeersByHash(src_hash);
+            for (int j = 0; j < num; j++) {
+              uint8_t secret[PUB_KEY_SIZE];
+              getPeerSharedSecret(secret, j);
+
+              uint8_t data[MAX_PACKET_PAYLOAD];
+              int len = Utils::MACThenDecrypt(secret, data, &pkt->payload[i], pkt->payload_len - i);
+              if (len > 0) {  // success!
+                if (onPeerFragmentRecv(pkt, j, secret, data, len)) pkt->markDoNotRetransmit();
+                break;
+              }
+            }
+          }
+          action = routeRecvPacket(pkt);
+        } else if (type == MULTIPART_TYPE_GRP_FRAG && !_tables->hasSeen(pkt)) {
+          int i = 1;
+          const uint8_t* channel_hash = &pkt->payload[i]; i += PATH_HASH_SIZE;
+
+          if (i + CIPHER_MAC_SIZE < pkt->payload_len) {
+            GroupChannel channels[4];
+            int num = searchChannelsByHash(channel_hash, channels, 4);
+            for (int j = 0; j < num; j++) {
+              uint8_t data[MAX_PACKET_PAYLOAD];
+              int len = Utils::MACThenDecrypt(channels[j].secret, data, &pkt->payload[i], pkt->payload_len - i);
+              if (len > 0) {  // success!
+                onGroupFragmentRecv(pkt, channels[j], data, len);
+                break;
+              }
+            }
+          }
+          action = routeRecvPacket(pkt);
         }
       }
       break;
@@ -368,6 +415,11 @@ DispatcherAction Mesh::forwardMultipartDirect(Packet* pkt) {
       removeSelfFromPath(&tmp);
       routeDirectRecvAcks(&tmp, ((uint32_t)remaining + 1) * 300);  // expect multipart ACKs 300ms apart (x2)
     }
+  } else if ((type == MULTIPART_TYPE_PEER_FRAG || type == MULTIPART_TYPE_GRP_FRAG) && !_tables->hasSeen(pkt)) {
+    removeSelfFromPath(pkt);
+
+    uint32_t d = getDirectRetransmitDelay(pkt);
+    return ACTION_RETRANSMIT_DELAYED(1, d);  // slightly lower priority than other routed traffic, so bulk transfers don't starve it
   }
   return ACTION_RELEASE;
 }
@@ -438,14 +490,15 @@ Packet* Mesh::createAdvert(const LocalIdentity& id, const uint8_t* app_data, siz
 
 #define MAX_COMBINED_PATH  (MAX_PACKET_PAYLOAD - 2 - CIPHER_BLOCK_SIZE)
 
-Packet* Mesh::createPathReturn(const Identity& dest, const uint8_t* secret, const uint8_t* path, uint8_t path_len, uint8_t extra_type, const uint8_t*extra, size_t extra_len) {
-  uint8_t dest_hash[PATH_HASH_SIZE];
-  dest.copyHashTo(dest_hash);
-  return createPathReturn(dest_hash, secret, path, path_len, extra_type, extra, extra_len);
+Packet* Mesh::createPathReturn(const Identity& dest, const uint8_t* secret, const uint8_t* path, uint8_t path_len, uint8_t extra_type, const uint8_t*extra, size_t extra_len, uint8_t hash_size) {
+  uint8_t dest_hash[PEER_HASH_SIZE_V2];
+  dest.copyHashTo(dest_hash, hash_size);
+  return createPathReturn(dest_hash, secret, path, path_len, extra_type, extra, extra_len, hash_size);
 }
 
-Packet* Mesh::createPathReturn(const uint8_t* dest_hash, const uint8_t* secret, const uint8_t* path, uint8_t path_len, uint8_t extra_type, const uint8_t*extra, size_t extra_len) {
-  if (path_len + extra_len + 5 > MAX_COMBINED_PATH) return NULL;  // too long!!
+Packet* Mesh::createPathReturn(const uint8_t* dest_hash, const uint8_t* secret, const uint8_t* path, uint8_t path_len, uint8_t extra_type, const uint8_t*extra, size_t extra_len, uint8_t hash_size) {
+  if (hash_size != PATH_HASH_SIZE && hash_size != PEER_HASH_SIZE_V2) return NULL;   // unsupported
+  if (path_len + extra_len + 5 + 2*(hash_size - PATH_HASH_SIZE) > MAX_COMBINED_PATH) return NULL;  // too long!!
 
   Packet* packet = obtainNewPacket();
   if (packet == NULL) {
@@ -453,10 +506,11 @@ Packet* Mesh::createPathReturn(const uint8_t* dest_hash, const uint8_t* secret,
     return NULL;
   }
   packet->header = (PAYLOAD_TYPE_PATH << PH_TYPE_SHIFT);  // ROUTE_TYPE_* set later
+  if (hash_size == PEER_HASH_SIZE_V2) packet->header |= (PAYLOAD_VER_2 << PH_VER_SHIFT);
 
   int len = 0;
-  memcpy(&packet->payload[len], dest_hash, PATH_HASH_SIZE); len += PATH_HASH_SIZE;  // dest hash
-  len += self_id.copyHashTo(&packet->payload[len]);  // src hash
+  memcpy(&packet->payload[len], dest_hash, hash_size); len += hash_size;  // dest hash
+  len += self_id.copyHashTo(&packet->payload[len], hash_size);  // src hash
 
   {
     int data_len = 0;
@@ -481,9 +535,10 @@ Packet* Mesh::createPathReturn(const uint8_t* dest_hash, const uint8_t* secret,
   return packet;
 }
 
-Packet* Mesh::createDatagram(uint8_t type, const Identity& dest, const uint8_t* secret, const uint8_t* data, size_t data_len) {
+Packet* Mesh::createDatagram(uint8_t type, const Identity& dest, const uint8_t* secret, const uint8_t* data, size_t data_len, uint8_t hash_size) {
+  if (hash_size != PATH_HASH_SIZE && hash_size != PEER_HASH_SIZE_V2) return NULL;   // unsupported
   if (type == PAYLOAD_TYPE_TXT_MSG || type == PAYLOAD_TYPE_REQ || type == PAYLOAD_TYPE_RESPONSE) {
-    if (data_len + CIPHER_MAC_SIZE + CIPHER_BLOCK_SIZE-1 > MAX_PACKET_PAYLOAD) return NULL;
+    if (data_len + 2*(hash_size - PATH_HASH_SIZE) + CIPHER_MAC_SIZE + CIPHER_BLOCK_SIZE-1 > MAX_PACKET_PAYLOAD) return NULL;
   } else {
     return NULL;  // invalid type
   }
@@ -494,10 +549,11 @@ Packet* Mesh::createDatagram(uint8_t type, const Identity& dest, const uint8_t*
     return NULL;
   }
   packet->header = (type << PH_TYPE_SHIFT);  // ROUTE_TYPE_* set later
+  if (hash_size == PEER_HASH_SIZE_V2) packet->header |= (PAYLOAD_VER_2 << PH_VER_SHIFT);
 
   int len = 0;
-  len += dest.copyHashTo(&packet->payload[len]);  // dest hash
-  len += self_id.copyHashTo(&packet->payload[len]);  // src hash
+  len += dest.copyHashTo(&packet->payload[len], hash_size);  // dest hash
+  len += self_id.copyHashTo(&packet->payload[len], hash_size);  // src hash
   len += Utils::encryptThenMAC(secret, &packet->payload[len], data, data_len);
 
   packet->payload_len = len;
@@ -582,6 +638,49 @@ Packet* Mesh::createMultiAck(uint32_t ack_crc, uint8_t remaining) {
   return packet;
 }
 
+Packet* Mesh::createPeerFragment(const Identity& dest, const uint8_t* secret, const uint8_t* data, size_t data_len, uint8_t remaining) {
+  size_t enc_len = (data_len + CIPHER_BLOCK_SIZE-1) / CIPHER_BLOCK_SIZE * CIPHER_BLOCK_SIZE;  // padded to whole blocks
+  if (1 + 2*PATH_HASH_SIZE + CIPHER_MAC_SIZE + enc_len > MAX_PACKET_PAYLOAD) return NULL;  // too long
+
+  Packet* packet = obtainNewPacket();
+  if (packet == NULL) {
+    MESH_DEBUG_PRINTLN("%s Mesh::createPeerFragment(): error, packet pool empty", getLogDateTime());
+    return NULL;
+  }
+  packet->header = (PAYLOAD_TYPE_MULTIPART << PH_TYPE_SHIFT);  // ROUTE_TYPE_* set later
+
+  int len = 0;
+  packet->payload[len++] = ((remaining > 15 ? 15 : remaining) << 4) | MULTIPART_TYPE_PEER_FRAG;
+  len += dest.copyHashTo(&packet->payload[len]);  // dest hash
+  len += self_id.copyHashTo(&packet->payload[len]);  // src hash
+  len += Utils::encryptThenMAC(secret, &packet->payload[len], data, data_len);
+
+  packet->payload_len = len;
+
+  return packet;
+}
+
+Packet* Mesh::createGroupFragment(const GroupChannel& channel, const uint8_t* data, size_t data_len, uint8_t remaining) {
+  size_t enc_len = (data_len + CIPHER_BLOCK_SIZE-1) / CIPHER_BLOCK_SIZE * CIPHER_BLOCK_SIZE;  // padded to whole blocks
+  if (1 + PATH_HASH_SIZE + CIPHER_MAC_SIZE + enc_len > MAX_PACKET_PAYLOAD) return NULL;  // too long
+
+  Packet* packet = obtainNewPacket();
+  if (packet == NULL) {
+    MESH_DEBUG_PRINTLN("%s Mesh::createGroupFragment(): error, packet pool empty", getLogDateTime());
+    return NULL;
+  }
+  packet->header = (PAYLOAD_TYPE_MULTIPART << PH_TYPE_SHIFT);  // ROUTE_TYPE_* set later
+
+  int len = 0;
+  packet->payload[len++] = ((remaining > 15 ? 15 : remaining) << 4) | MULTIPART_TYPE_GRP_FRAG;
+  memcpy(&packet->payload[len], channel.hash, PATH_HASH_SIZE); len += PATH_HASH_SIZE;
+  len += Utils::encryptThenMAC(channel.secret, &packet->payload[len], data, data_len);
+
+  packet->payload_len = len;
+
+  return packet;
+}
+
 Packet* Mesh::createRawData(const uint8_t* data, size_t len) {
   if (len > sizeof(Packet::payload)) return NULL;  // invalid arg
 
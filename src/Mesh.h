@@ -27,6 +27,8 @@ class Mesh : public Dispatcher {
   RTCClock* _rtc;
   RNG* _rng;
   MeshTables* _tables;
+  uint32_t n_peer_searches, n_peer_candidates, n_peer_mac_fails, n_peer_wide_recv;
+  uint8_t max_peer_candidates;
 
   void removeSelfFromPath(Packet* packet);
   void routeDirectRecvAcks(Packet* packet, uint32_t delay_millis);
@@ -76,6 +78,13 @@ protected:
    */
   virtual int searchPeersByHash(const uint8_t* hash);
 
+  /**
+   * \brief  Perform search of local DB of peers/contacts, by a (possibly) wider hash. (PAYLOAD_VER_2)
+   *         Default impl just matches on the first byte, sub-classes should override to narrow the search.
+   * \returns  Number of peers with matching hash
+   */
+  virtual int searchPeersByHash(const uint8_t* hash, uint8_t hash_size);
+
   /**
    * \brief  lookup the ECDH shared-secret between this node and peer by idx (calculate if necessary)
    * \param  dest_secret  destination array to copy the secret (must be PUB_KEY_SIZE bytes)
@@ -159,6 +168,20 @@ protected:
   */
   virtual void onGroupDataRecv(Packet* packet, uint8_t type, const GroupChannel& channel, uint8_t* data, size_t len) { }
 
+  /**
+   * \brief  A (now decrypted) MULTIPART fragment has been received from a known peer.
+   *         NOTE: these can be received multiple times, via different routes
+   * \param  sender_idx  index of peer, [0..n) where n is what searchPeersByHash() returned
+   * \param  secret   the pre-calculated shared-secret (handy for sending status back)
+   * \returns  true, if fragment was accepted (ie. packet should NOT be retransmitted)
+  */
+  virtual bool onPeerFragmentRecv(Packet* packet, int sender_idx, const uint8_t* secret, uint8_t* data, size_t len) { return false; }
+
+  /**
+   * \brief  A (now decrypted) MULTIPART fragment has been received for a group channel.
+  */
+  virtual void onGroupFragmentRecv(Packet* packet, const GroupChannel& channel, uint8_t* data, size_t len) { }
+
   /**
    * \brief  A simple ACK packet has been received.
    *         NOTE: same ACK can be received multiple times, via different routes
@@ -168,6 +191,7 @@ protected:
   Mesh(Radio& radio, MillisecondClock& ms, RNG& rng, RTCClock& rtc, PacketManager& mgr, MeshTables& tables)
     : Dispatcher(radio, ms, mgr), _rng(&rng), _rtc(&rtc), _tables(&tables)
   {
+    resetPeerStats();
   }
 
   MeshTables* getTables() const { return _tables; }
@@ -181,14 +205,27 @@ public:
   RNG* getRNG() const { return _rng; }
   RTCClock* getRTCClock() const { return _rtc; }
 
+  // peer resolution stats (ie. candidates tried per received peer datagram)
+  uint32_t getNumPeerSearches() const { return n_peer_searches; }
+  uint32_t getNumPeerCandidates() const { return n_peer_candidates; }
+  uint32_t getNumPeerMACFails() const { return n_peer_mac_fails; }
+  uint32_t getNumPeerWideRecv() const { return n_peer_wide_recv; }
+  uint8_t getMaxPeerCandidates() const { return max_peer_candidates; }
+  void resetPeerStats() {
+    n_peer_searches = n_peer_candidates = n_peer_mac_fails = n_peer_wide_recv = 0;
+    max_peer_candidates = 0;
+  }
+
   Packet* createAdvert(const LocalIdentity& id, const uint8_t* app_data=NULL, size_t app_data_len=0);
-  Packet* createDatagram(uint8_t type, const Identity& dest, const uint8_t* secret, const uint8_t* data, size_t len);
+  Packet* createDatagram(uint8_t type, const Identity& dest, const uint8_t* secret, const uint8_t* data, size_t len, uint8_t hash_size=PATH_HASH_SIZE);
   Packet* createAnonDatagram(uint8_t type, const LocalIdentity& sender, const Identity& dest, const uint8_t* secret, const uint8_t* data, size_t data_len);
   Packet* createGroupDatagram(uint8_t type, const GroupChannel& channel, const uint8_t* data, size_t data_len);
   Packet* createAck(uint32_t ack_crc);
   Packet* createMultiAck(uint32_t ack_crc, uint8_t remaining);
-  Packet* createPathReturn(const uint8_t* dest_hash, const uint8_t* secret, const uint8_t* path, uint8_t path_len, uint8_t extra_type, const uint8_t*extra, size_t extra_len);
-  Packet* createPathReturn(const Identity& dest, const uint8_t* secret, const uint8_t* path, uint8_t path_len, uint8_t extra_type, const uint8_t*extra, size_t extra_len);
+  Packet* createPeerFragment(const Identity& dest, const uint8_t* secret, const uint8_t* data, size_t data_len, uint8_t remaining);
+  Packet* createGroupFragment(const GroupChannel& channel, const uint8_t* data, size_t data_len, uint8_t remaining);
+  Packet* createPathReturn(const uint8_t* dest_hash, const uint8_t* secret, const uint8_t* path, uint8_t path_len, uint8_t extra_type, const uint8_t*extra, size_t extra_len, uint8_t hash_size=PATH_HASH_SIZE);
+  Packet* createPathReturn(const Identity& dest, const uint8_t* secret, const uint8_t* path, uint8_t path_len, uint8_t extra_type, const uint8_t*extra, size_t extra_len, uint8_t hash_size=PATH_HASH_SIZE);
   Packet* createRawData(const uint8_t* data, size_t len);
   Packet* createTrace(uint32_t tag, uint32_t auth_code, uint8_t flags = 0);
   Packet* createControlData(const uint8_t* data, size_t len);
@@ -40,6 +40,11 @@ namespace mesh {
 #define  BD_STARTUP_NORMAL     0  // getStartupReason() codes
 #define  BD_STARTUP_RX_PACKET  1
 
+#define  BD_WAKE_NONE          0  // sleepMillis() codes: didn't sleep
+#define  BD_WAKE_TIMER         1
+#define  BD_WAKE_RADIO         2
+#define  BD_WAKE_OTHER         3  // button, etc
+
 class MainBoard {
 public:
   virtual uint16_t getBattMilliVolts() = 0;
@@ -53,6 +58,7 @@ public:
   virtual void reboot() = 0;
   virtual void powerOff() { /* no op */ }
   virtual void sleep(uint32_t secs)  { /* no op */ }
+  virtual uint8_t sleepMillis(uint32_t ms) { return BD_WAKE_NONE; }   // light sleep, radio packet wakes early
   virtual uint32_t getGpio() { return 0; }
   virtual void setGpio(uint32_t values) {}
   virtual uint8_t getStartupReason() const = 0;
@@ -27,16 +27,23 @@ namespace mesh {
 #define PAYLOAD_TYPE_ANON_REQ    0x07    // generic request (prefixed with dest_hash, ephemeral pub_key, MAC) (enc data: ...)
 #define PAYLOAD_TYPE_PATH        0x08    // returned path (prefixed with dest/src hashes, MAC) (enc data: path, extra)
 #define PAYLOAD_TYPE_TRACE       0x09    // trace a path, collecting SNI for each hop
-#define PAYLOAD_TYPE_MULTIPART   0x0A    // packet is one of a set of packets
+#define PAYLOAD_TYPE_MULTIPART   0x0A    // packet is one of a set of packets (payload[0] = remaining << 4 | inner type)
 #define PAYLOAD_TYPE_CONTROL     0x0B    // a control/discovery packet
 //...
 #define PAYLOAD_TYPE_RAW_CUSTOM   0x0F    // custom packet as raw bytes, for applications with custom encryption, payloads, etc
 
+// MULTIPART inner types, ie. what follows payload[0]
+#define MULTIPART_TYPE_ACK       PAYLOAD_TYPE_ACK        // ack_crc (4 bytes)
+#define MULTIPART_TYPE_PEER_FRAG PAYLOAD_TYPE_REQ        // fragment of a blob, to a peer (dest/src hashes, MAC) (enc data: frag header, data)
+#define MULTIPART_TYPE_GRP_FRAG  PAYLOAD_TYPE_GRP_DATA   // fragment of a blob, to a group (channel hash, MAC) (enc data: frag header, data)
+
 #define PAYLOAD_VER_1       0x00   // 1-byte src/dest hashes, 2-byte MAC
-#define PAYLOAD_VER_2       0x01   // FUTURE (eg. 2-byte hashes, 4-byte MAC ??)
+#define PAYLOAD_VER_2       0x01   // 2-byte src/dest hashes, 2-byte MAC (only for peer datagrams: REQ, RESPONSE, TXT_MSG, PATH)
 #define PAYLOAD_VER_3       0x02   // FUTURE
 #define PAYLOAD_VER_4       0x03   // FUTURE
 
+#define PEER_HASH_SIZE_V2   2      // src/dest hash size for PAYLOAD_VER_2
+
 /**
  * \brief  The fundamental transmission unit.
 */
@@ -77,6 +84,19 @@ public:
    */
   uint8_t getPayloadVer() const { return (header >> PH_VER_SHIFT) & PH_VER_MASK; }
 
+  /**
+   * \returns  true, if payload is prefixed with dest/src hashes of peers
+   */
+  bool isPeerDatagram() const {
+    uint8_t t = getPayloadType();
+    return t == PAYLOAD_TYPE_REQ || t == PAYLOAD_TYPE_RESPONSE || t == PAYLOAD_TYPE_TXT_MSG || t == PAYLOAD_TYPE_PATH;
+  }
+
+  /**
+   * \returns  size of the dest/src hashes, for peer datagrams
+   */
+  uint8_t getPeerHashSize() const { return getPayloadVer() == PAYLOAD_VER_2 ? PEER_HASH_SIZE_V2 : PATH_HASH_SIZE; }
+
   void markDoNotRetransmit() { header = 0xFF; }
   bool isMarkedDoNotRetransmit() const { return header == 0xFF; }
 
@@ -0,0 +1,133 @@
+#include "AckTracker.h"
+
+static_assert(ACK_INDEX_SIZE > ACK_TRACKER_SIZE*ACK_TRACKER_MAX_ATTEMPTS, "ACK index must always have an empty slot");
+static_assert(ACK_TRACKER_SIZE < ACK_INDEX_EMPTY, "ACK_TRACKER_SIZE too large");
+
+AckTracker::AckTracker() {
+  memset(_msgs, 0, sizeof(_msgs));
+  for (int i = 0; i < ACK_INDEX_SIZE; i++) {
+    _index[i].msg_idx = ACK_INDEX_EMPTY;
+  }
+  _num_active = 0;
+  resetStats();
+}
+
+void AckTracker::resetStats() {
+  _num_delivered = _num_failed = _num_retries = _num_flood_fallbacks = _num_evicted = 0;
+  memset(_latency_hist, 0, sizeof(_latency_hist));
+}
+
+void AckTracker::indexPut(uint32_t ack, int msg_idx) {
+  int i = slotFor(ack);
+  while (_index[i].msg_idx != ACK_INDEX_EMPTY && _index[i].ack != ack) {   // linear probing
+    i = (i + 1) & (ACK_INDEX_SIZE - 1);
+  }
+  _index[i].ack = ack;
+  _index[i].msg_idx = msg_idx;
+}
+
+void AckTracker::indexRemove(uint32_t ack) {
+  int i = slotFor(ack);
+  while (_index[i].msg_idx != ACK_INDEX_EMPTY) {
+    if (_index[i].ack == ack) break;
+    i = (i + 1) & (ACK_INDEX_SIZE - 1);
+  }
+  if (_index[i].msg_idx == ACK_INDEX_EMPTY) return;  // not found
+
+  // backward-shift deletion, so probe sequences stay unbroken (no tombstones)
+  int j = i;
+  while (true) {
+    j = (j + 1) & (ACK_INDEX_SIZE - 1);
+    if (_index[j].msg_idx == ACK_INDEX_EMPTY) break;
+
+    int home = slotFor(_index[j].ack);
+    bool between = (i <= j) ? (i < home && home <= j) : (i < home || home <= j);
+    if (!between) {
+      _index[i] = _index[j];
+      i = j;
+    }
+  }
+  _index[i].msg_idx = ACK_INDEX_EMPTY;
+}
+
+void AckTracker::release(int msg_idx) {
+  auto m = &_msgs[msg_idx];
+  if (!m->isActive()) return;
+
+  for (int k = 0; k < m->num_acks; k++) {
+    indexRemove(m->acks[k]);
+  }
+  memset(m, 0, sizeof(*m));
+  _num_active--;
+}
+
+PendingMsg* AckTracker::add(const uint8_t* pub_key, uint32_t ack, uint32_t timestamp, const char* text, uint8_t flags) {
+  if (ack == 0) return NULL;
+
+  int idx = -1;
+  for (int i = 0; i < ACK_TRACKER_SIZE; i++) {
+    if (!_msgs[i].isActive()) { idx = i; break; }
+  }
+  if (idx < 0) {   // full, evict oldest entry that isn't ours to retry
+    for (int i = 0; i < ACK_TRACKER_SIZE; i++) {
+      if (_msgs[i].flags & PENDING_FLAG_RETRY) continue;
+      if (idx < 0 || (long)(_msgs[i].first_sent - _msgs[idx].first_sent) < 0) idx = i;
+    }
+    if (idx < 0) return NULL;   // table is full
+
+    release(idx);
+    _num_evicted++;
+  }
+
+  auto m = &_msgs[idx];
+  memcpy(m->pub_key, pub_key, sizeof(m->pub_key));
+  m->acks[0] = ack;
+  m->num_acks = 1;
+  m->flags = flags;
+  m->direct_fails = 0;
+  m->timestamp = timestamp;
+  if (text) {
+    strncpy(m->text, text, ACK_TRACKER_TEXT_LEN);
+    m->text[ACK_TRACKER_TEXT_LEN] = 0;
+  }
+  indexPut(ack, idx);
+  _num_active++;
+  return m;
+}
+
+bool AckTracker::addAttempt(PendingMsg* msg, uint32_t ack) {
+  if (!msg->isActive() || msg->num_acks >= ACK_TRACKER_MAX_ATTEMPTS || ack == 0) return false;
+
+  msg->acks[msg->num_acks++] = ack;
+  indexPut(ack, msg - _msgs);
+  return true;
+}
+
+PendingMsg* AckTracker::find(uint32_t ack) const {
+  int i = slotFor(ack);
+  while (_index[i].msg_idx != ACK_INDEX_EMPTY) {
+    if (_index[i].ack == ack) return (PendingMsg *) &_msgs[_index[i].msg_idx];
+    i = (i + 1) & (ACK_INDEX_SIZE - 1);
+  }
+  return NULL;  // not found
+}
+
+bool AckTracker::complete(uint32_t ack, unsigned long now, uint8_t* pub_key, uint32_t& latency_millis) {
+  auto m = find(ack);
+  if (m == NULL) return false;
+
+  latency_millis = now - m->first_sent;
+  memcpy(pub_key, m->pub_key, sizeof(m->pub_key));
+
+  int b = 0;
+  uint32_t limit = 250;
+  while (b < ACK_LATENCY_BUCKETS - 1 && latency_millis >= limit) {
+    b++;
+    limit <<= 1;
+  }
+  if (_latency_hist[b] < 0xFFFF) _latency_hist[b]++;
+  _num_delivered++;
+
+  release(m - _msgs);
+  return true;
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <Arduino.h>   // needed for PlatformIO
+#include <Mesh.h>
+
+#ifndef ACK_TRACKER_SIZE   // messages in flight (~200 bytes each)
+  #if defined(ESP32) && defined(BOARD_HAS_PSRAM)
+    #define ACK_TRACKER_SIZE        32
+  #elif defined(NRF52_PLATFORM) || defined(STM32_PLATFORM)
+    #define ACK_TRACKER_SIZE         8
+  #else
+    #define ACK_TRACKER_SIZE        16
+  #endif
+#endif
+
+#define ACK_TRACKER_MAX_ATTEMPTS     4   // attempt numbers 0..3 (ie. those encoded in header bits)
+
+// hash slots, power of 2 and > ACK_TRACKER_SIZE*ACK_TRACKER_MAX_ATTEMPTS
+#if ACK_TRACKER_SIZE <= 8
+  #define ACK_INDEX_BITS             6
+#elif ACK_TRACKER_SIZE <= 16
+  #define ACK_INDEX_BITS             7
+#elif ACK_TRACKER_SIZE <= 32
+  #define ACK_INDEX_BITS             8
+#else
+  #define ACK_INDEX_BITS            10
+#endif
+#define ACK_INDEX_SIZE             (1 << ACK_INDEX_BITS)
+#define ACK_INDEX_EMPTY         0xFFFF
+#define ACK_TRACKER_TEXT_LEN       (10*CIPHER_BLOCK_SIZE)   // same as MAX_TEXT_LEN
+#define ACK_LATENCY_BUCKETS          9   // <250ms, <500ms, <1s, <2s, <4s, <8s, <16s, <32s, longer
+
+#define PENDING_FLAG_RETRY        0x01   // device retries this message (otherwise, app does)
+#define PENDING_FLAG_LAST_FLOOD   0x02   // most recent attempt was sent flood
+
+struct PendingMsg {
+  uint8_t pub_key[8];      // recipient (prefix), zeroes = unused slot
+  uint32_t acks[ACK_TRACKER_MAX_ATTEMPTS];   // expected ACK of each attempt (any of them completes)
+  uint8_t num_acks;
+  uint8_t flags;
+  uint8_t direct_fails;
+  uint32_t timestamp;      // sender timestamp, re-used on each attempt
+  unsigned long first_sent;
+  unsigned long next_retry;   // or expiry, if not PENDING_FLAG_RETRY
+  char text[ACK_TRACKER_TEXT_LEN+1];
+
+  bool isActive() const { return num_acks > 0; }
+  uint8_t getAttempt() const { return num_acks - 1; }
+};
+
+/**
+ * \brief  Messages awaiting ACK, looked up via a hash index on the expected ACK (of any attempt),
+ *     plus delivery stats and a latency histogram.
+ */
+class AckTracker {
+  PendingMsg _msgs[ACK_TRACKER_SIZE];
+  struct IndexSlot {
+    uint32_t ack;
+    uint16_t msg_idx;   // ACK_INDEX_EMPTY = empty
+  } _index[ACK_INDEX_SIZE];
+  int _num_active;
+
+  uint32_t _num_delivered, _num_failed, _num_retries, _num_flood_fallbacks, _num_evicted;
+  uint16_t _latency_hist[ACK_LATENCY_BUCKETS];
+
+  static int slotFor(uint32_t ack) { return (ack * 2654435761u) >> (32 - ACK_INDEX_BITS); }   // Fibonacci hashing, top bits
+  void indexPut(uint32_t ack, int msg_idx);
+  void indexRemove(uint32_t ack);
+  void release(int msg_idx);
+
+public:
+  AckTracker();
+
+  /**
+   * \brief  start tracking a message (evicts the oldest non-retry entry if full)
+   * \returns  NULL if table is full of messages being retried
+   */
+  PendingMsg* add(const uint8_t* pub_key, uint32_t ack, uint32_t timestamp, const char* text, uint8_t flags);
+
+  /**
+   * \brief  register the expected ACK of a new attempt of 'msg'
+   */
+  bool addAttempt(PendingMsg* msg, uint32_t ack);
+
+  PendingMsg* find(uint32_t ack) const;
+
+  /**
+   * \brief  the ACK was received, remove from table and record delivery latency
+   * \returns  copy of the delivered entry's recipient prefix in 'pub_key', and latency
+   */
+  bool complete(uint32_t ack, unsigned long now, uint8_t* pub_key, uint32_t& latency_millis);
+
+  void fail(PendingMsg* msg) { _num_failed++; release(msg - _msgs); }
+  void expire(PendingMsg* msg) { release(msg - _msgs); }
+  void countRetry(bool flood_fallback) { _num_retries++; if (flood_fallback) _num_flood_fallbacks++; }
+
+  int getNumActive() const { return _num_active; }
+  PendingMsg* getByIdx(int i) { return &_msgs[i]; }
+
+  uint32_t getNumDelivered() const { return _num_delivered; }
+  uint32_t getNumFailed() const { return _num_failed; }
+  uint32_t getNumRetries() const { return _num_retries; }
+  uint32_t getNumFloodFallbacks() const { return _num_flood_fallbacks; }
+  uint32_t getNumEvicted() const { return _num_evicted; }
+  const uint16_t* getLatencyHistogram() const { return _latency_hist; }
+  void resetStats();
+};
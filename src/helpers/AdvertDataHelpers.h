@@ -16,6 +16,12 @@
 #define ADV_FEAT2_MASK        0x40   // FUTURE
 #define ADV_NAME_MASK         0x80
 
+// FEAT1 bits
+// NOTE: FEAT1/FEAT2 are reserved upstream for future use. Only bit 1 is claimed here, and it is only sent
+//       when the node has DM compression enabled, so by default adverts carry no FEAT1 field at all.
+//       Bit 0 (0x0001) is unused, was briefly a wide-hash flag. Bits 2..15 are free.
+#define ADV_FEAT1_TXT_COMPRESS  0x0002   // node accepts, and sends, TXT_TYPE_COMPRESSED messages
+
 class AdvertDataBuilder {
   uint8_t _type;
   bool _has_loc;
@@ -16,11 +16,49 @@ void BaseChatMesh::sendFloodScoped(const mesh::GroupChannel& channel, mesh::Pack
   sendFlood(pkt, delay_millis, getPathHashSize());
 }
 
+uint16_t BaseChatMesh::getSelfFeat1() const {
+  // NOTE: zero means the FEAT1 field is left out of the advert altogether (2 bytes more for the name)
+  uint16_t feat1 = 0;
+  if (allowDirectCompression()) feat1 |= ADV_FEAT1_TXT_COMPRESS;
+  return feat1;
+}
+
+uint8_t BaseChatMesh::getPeerHashSizeFor(const ContactInfo& recipient) {
+  // NOTE: 'recipient' may be a copy, so track state in our own contacts[] entry
+  auto c = lookupContactByPubKey(recipient.id.pub_key, PUB_KEY_SIZE);
+  if (c == NULL || c->wide_hash_failed) return PATH_HASH_SIZE;
+
+  if (c->wide_hash_deadline && millisHasNowPassed(c->wide_hash_deadline)) {
+    onWideHashNoReply(*c);
+    return PATH_HASH_SIZE;
+  }
+  // only if they've reached us with PAYLOAD_VER_2 (so must support it), or the user opted in for this contact
+  if (c->peer_hash_size != PEER_HASH_SIZE_V2 && !allowWidePeerHashes(*c)) return PATH_HASH_SIZE;
+
+  if (c->wide_hash_deadline == 0) c->wide_hash_deadline = futureMillis(WIDE_HASH_REPLY_MILLIS);
+  return PEER_HASH_SIZE_V2;
+}
+
+void BaseChatMesh::onWideHashReply(ContactInfo& from, const mesh::Packet* packet) {
+  from.wide_hash_deadline = 0;   // they're replying, so whatever we sent got through
+  if (packet->getPayloadVer() == PAYLOAD_VER_2 && !from.wide_hash_failed) from.peer_hash_size = PEER_HASH_SIZE_V2;
+}
+
+void BaseChatMesh::onWideHashNoReply(ContactInfo& contact) {
+  if (contact.wide_hash_deadline == 0) return;   // not using PAYLOAD_VER_2 with them
+
+  MESH_DEBUG_PRINTLN("no reply to PAYLOAD_VER_2, using 1-byte hashes with: %s", contact.name);
+  contact.wide_hash_deadline = 0;
+  contact.wide_hash_failed = true;   // until reboot, adverts don't undo this
+  contact.peer_hash_size = PATH_HASH_SIZE;
+}
+
 mesh::Packet* BaseChatMesh::createSelfAdvert(const char* name) {
   uint8_t app_data[MAX_ADVERT_DATA_SIZE];
   uint8_t app_data_len;
   {
     AdvertDataBuilder builder(ADV_TYPE_CHAT, name);
+    builder.setFeat1(getSelfFeat1());
     app_data_len = builder.encodeTo(app_data);
   }
 
@@ -32,6 +70,7 @@ mesh::Packet* BaseChatMesh::createSelfAdvert(const char* name, double lat, doubl
   uint8_t app_data_len;
   {
     AdvertDataBuilder builder(ADV_TYPE_CHAT, name, lat, lon);
+    builder.setFeat1(getSelfFeat1());
     app_data_len = builder.encodeTo(app_data);
   }
 
@@ -173,6 +212,18 @@ void BaseChatMesh::onAdvertRecv(mesh::Packet* packet, const mesh::Identity& id,
     }
     from->last_advert_timestamp = timestamp;
     from->lastmod = getRTCClock()->getCurrentTime();
+    from->peer_feat1 = parser.getFeat1();
+
+  if (packet->isRouteFlood() && mesh::Packet::isValidPathLen(packet->path_len)) {
+    // the reverse of the advert's flood path is a (probable) route back to them
+    uint8_t bph = (packet->path_len >> 6) + 1;
+    uint8_t hops = packet->path_len & 63;
+    uint8_t rev[MAX_PATH_SIZE];
+    for (int h = 0; h < hops; h++) {
+      memcpy(&rev[h * bph], &packet->path[(hops - 1 - h) * bph], bph);
+    }
+    routes.addPath(from->id.pub_key, rev, packet->path_len, ROUTE_SRC_ADVERT, _ms->getMillis());
+  }
 
   onDiscoveredContact(*from, is_new, packet->path_len, packet->path);       // let UI know
 }
@@ -187,6 +238,16 @@ int BaseChatMesh::searchPeersByHash(const uint8_t* hash) {
   return n;
 }
 
+int BaseChatMesh::searchPeersByHash(const uint8_t* hash, uint8_t hash_size) {
+  int n = 0;
+  for (int i = 0; i < num_contacts && n < MAX_SEARCH_RESULTS; i++) {
+    if (contacts[i].id.isHashMatch(hash, hash_size)) {
+      matching_peer_indexes[n++] = i;
+    }
+  }
+  return n;
+}
+
 void BaseChatMesh::getPeerSharedSecret(uint8_t* dest_secret, int peer_idx) {
   int i = matching_peer_indexes[peer_idx];
   if (i >= 0 && i < num_contacts) {
@@ -204,11 +265,22 @@ void BaseChatMesh::onPeerDataRecv(mesh::Packet* packet, uint8_t type, int sender
   }
 
   ContactInfo& from = contacts[i];
+  uint8_t hash_sz = packet->getPeerHashSize();   // reply in same format
+  onWideHashReply(from, packet);
+  updateLinkQuality(from, packet);
 
   if (type == PAYLOAD_TYPE_TXT_MSG && len > 5) {
     uint32_t timestamp;
     memcpy(&timestamp, data, 4);  // timestamp (by sender's RTC clock - which could be wrong)
     uint8_t flags = data[4] >> 2;   // message attempt number, and other flags
+    if (flags == TXT_TYPE_COMPRESSED) {
+      if (!expandCompressedText(data, len)) {
+        MESH_DEBUG_PRINTLN("onPeerDataRecv: invalid compressed text");
+        return;
+      }
+      flags = TXT_TYPE_PLAIN;
+      from.peer_feat1 |= ADV_FEAT1_TXT_COMPRESS;   // they obviously support it (even if their last advert didn't say)
+    }
 
     // len can be > original length, but 'text' will be padded with zeroes
     data[len] = 0; // need to make a C string again, with null terminator
@@ -223,7 +295,7 @@ void BaseChatMesh::onPeerDataRecv(mesh::Packet* packet, uint8_t type, int sender
       if (packet->isRouteFlood()) {
         // let this sender know path TO here, so they can use sendDirect(), and ALSO encode the ACK
         mesh::Packet* path = createPathReturn(from.id, secret, packet->path, packet->path_len,
-                                                PAYLOAD_TYPE_ACK, (uint8_t *) &ack_hash, 4);
+                                                PAYLOAD_TYPE_ACK, (uint8_t *) &ack_hash, 4, hash_sz);
         if (path) sendFloodScoped(from, path, TXT_ACK_DELAY);
       } else {
         sendAckTo(from, ack_hash);
@@ -234,7 +306,7 @@ void BaseChatMesh::onPeerDataRecv(mesh::Packet* packet, uint8_t type, int sender
 
       if (packet->isRouteFlood()) {
         // let this sender know path TO here, so they can use sendDirect() (NOTE: no ACK as extra)
-        mesh::Packet* path = createPathReturn(from.id, secret, packet->path, packet->path_len, 0, NULL, 0);
+        mesh::Packet* path = createPathReturn(from.id, secret, packet->path, packet->path_len, 0, NULL, 0, hash_sz);
         if (path) sendFloodScoped(from, path);
       }
     } else if (flags == TXT_TYPE_SIGNED_PLAIN) {
@@ -250,7 +322,7 @@ void BaseChatMesh::onPeerDataRecv(mesh::Packet* packet, uint8_t type, int sender
       if (packet->isRouteFlood()) {
         // let this sender know path TO here, so they can use sendDirect(), and ALSO encode the ACK
         mesh::Packet* path = createPathReturn(from.id, secret, packet->path, packet->path_len,
-                                                PAYLOAD_TYPE_ACK, (uint8_t *) &ack_hash, 4);
+                                                PAYLOAD_TYPE_ACK, (uint8_t *) &ack_hash, 4, hash_sz);
         if (path) sendFloodScoped(from, path, TXT_ACK_DELAY);
       } else {
         sendAckTo(from, ack_hash);
@@ -266,10 +338,10 @@ void BaseChatMesh::onPeerDataRecv(mesh::Packet* packet, uint8_t type, int sender
       if (packet->isRouteFlood()) {
         // let this sender know path TO here, so they can use sendDirect(), and ALSO encode the response
         mesh::Packet* path = createPathReturn(from.id, secret, packet->path, packet->path_len,
-                                              PAYLOAD_TYPE_RESPONSE, temp_buf, reply_len);
+                                              PAYLOAD_TYPE_RESPONSE, temp_buf, reply_len, hash_sz);
         if (path) sendFloodScoped(from, path, SERVER_RESPONSE_DELAY);
       } else {
-        mesh::Packet* reply = createDatagram(PAYLOAD_TYPE_RESPONSE, from.id, secret, temp_buf, reply_len);
+        mesh::Packet* reply = createDatagram(PAYLOAD_TYPE_RESPONSE, from.id, secret, temp_buf, reply_len, hash_sz);
         if (reply) {
           if (from.out_path_len != OUT_PATH_UNKNOWN) {  // we have an out_path, so send DIRECT
             sendDirect(reply, from.out_path, from.out_path_len, SERVER_RESPONSE_DELAY);
@@ -296,22 +368,28 @@ bool BaseChatMesh::onPeerPathRecv(mesh::Packet* packet, int sender_idx, const ui
   }
 
   ContactInfo& from = contacts[i];
+  onWideHashReply(from, packet);
+  updateLinkQuality(from, packet);
 
   return onContactPathRecv(from, packet->path, packet->path_len, path, path_len, extra_type, extra, extra_len);
 }
 
 bool BaseChatMesh::onContactPathRecv(ContactInfo& from, uint8_t* in_path, uint8_t in_path_len, uint8_t* out_path, uint8_t out_path_len, uint8_t extra_type, uint8_t* extra, uint8_t extra_len) {
-  // NOTE: default impl, we just replace the current 'out_path' regardless, whenever sender sends us a new out_path.
-  // FUTURE: could store multiple out_paths per contact, and try to find which is the 'best'(?)
+  // NOTE: default impl, we take the new 'out_path', but also keep it as a candidate in the route cache,
+  //       and switch to a better scoring candidate if we know of one.
   from.out_path_len = out_path_len;
   mesh::Packet::copyPath(from.out_path, out_path, out_path_len);  // store a copy of path, for sendDirect()
   from.lastmod = getRTCClock()->getCurrentTime();
 
+  routes.addPath(from.id.pub_key, out_path, out_path_len, ROUTE_SRC_PATH, _ms->getMillis());
+  selectBestRoute(from);   // newest path may not be the best one we know of
+
   onContactPathUpdated(from);
 
   if (extra_type == PAYLOAD_TYPE_ACK && extra_len >= 4) {
     // also got an encoded ACK!
     if (processAck(extra) != NULL) {
+      checkRouteProbeAck(extra);
       txt_send_timeout = 0;   // matched one we're waiting for, cancel timeout timer
     }
   } else if (extra_type == PAYLOAD_TYPE_RESPONSE && extra_len > 0) {
@@ -323,6 +401,8 @@ bool BaseChatMesh::onContactPathRecv(ContactInfo& from, uint8_t* in_path, uint8_
 void BaseChatMesh::onAckRecv(mesh::Packet* packet, uint32_t ack_crc) {
   ContactInfo* from;
   if ((from = processAck((uint8_t *)&ack_crc)) != NULL) {
+    checkRouteProbeAck((uint8_t *)&ack_crc);
+    from->wide_hash_deadline = 0;   // our message got through
     txt_send_timeout = 0;   // matched one we're waiting for, cancel timeout timer
     packet->markDoNotRetransmit();   // ACK was for this node, so don't retransmit
 
@@ -333,10 +413,98 @@ void BaseChatMesh::onAckRecv(mesh::Packet* packet, uint32_t ack_crc) {
   }
 }
 
+void BaseChatMesh::startRouteProbe(const ContactInfo& recipient, uint32_t ack, uint32_t timeout_millis) {
+  RouteProbe* p = &route_probes[0];   // find unused slot, or replace the oldest probe
+  for (int i = 0; i < ROUTE_MAX_PROBES; i++) {
+    if (route_probes[i].ack == 0) { p = &route_probes[i]; break; }
+    if ((long)(route_probes[i].sent - p->sent) < 0) p = &route_probes[i];
+  }
+  p->ack = ack;
+  p->sent = _ms->getMillis();
+  p->timeout = futureMillis(timeout_millis);
+  memcpy(p->pub_key, recipient.id.pub_key, sizeof(p->pub_key));
+  p->path_len = mesh::Packet::copyPath(p->path, recipient.out_path, recipient.out_path_len);
+}
+
+void BaseChatMesh::checkRouteProbeAck(const uint8_t* ack) {
+  for (int i = 0; i < ROUTE_MAX_PROBES; i++) {
+    auto p = &route_probes[i];
+    if (p->ack == 0 || memcmp(ack, &p->ack, 4) != 0) continue;
+
+    routes.onDelivered(p->pub_key, p->path, p->path_len, _ms->getMillis() - p->sent, _ms->getMillis());
+    p->ack = 0;
+  }
+}
+
+void BaseChatMesh::checkRouteProbes() {
+  for (int i = 0; i < ROUTE_MAX_PROBES; i++) {
+    if (route_probes[i].ack && millisHasNowPassed(route_probes[i].timeout)) {
+      onRouteProbeTimeout(route_probes[i]);
+    }
+  }
+}
+
+void BaseChatMesh::onRouteProbeTimeout(RouteProbe& probe) {
+  probe.ack = 0;
+
+  routes.onFailed(probe.pub_key, probe.path, probe.path_len);
+
+  auto contact = lookupContactByPubKey(probe.pub_key, sizeof(probe.pub_key));
+  if (contact) onWideHashNoReply(*contact);   // legacy repeaters on route may be dropping PAYLOAD_VER_2
+
+  if (contact && contact->out_path_len == probe.path_len
+      && memcmp(contact->out_path, probe.path, mesh::Packet::getPathByteLenFor(probe.path_len)) == 0) {
+    if (selectBestRoute(*contact)) {   // fail-over to next best candidate (if any), before app resorts to flood
+      routes.countFailover();
+      onContactPathUpdated(*contact);
+    }
+  }
+}
+
+bool BaseChatMesh::selectBestRoute(ContactInfo& contact) {
+  if (isPathLocked(contact)) return false;
+
+  uint8_t path[MAX_PATH_SIZE];
+  uint8_t path_len = routes.getBestPath(contact.id.pub_key, path, _ms->getMillis());
+  if (path_len == OUT_PATH_UNKNOWN) return false;   // no usable candidates, leave as is
+
+  if (path_len == contact.out_path_len && memcmp(path, contact.out_path, mesh::Packet::getPathByteLenFor(path_len)) == 0) {
+    return false;   // unchanged
+  }
+  contact.out_path_len = mesh::Packet::copyPath(contact.out_path, path, path_len);
+  return true;
+}
+
+void BaseChatMesh::learnRouteFromTrace(const uint8_t* path_hashes, uint8_t path_len, uint8_t flags) {
+  // only round-trip traces, ie. A,B,X,B,A, where X is the destination contact
+  if ((flags & 0x03) > 1) return;   // only 1 and 2 byte trace hashes map to a path hash mode
+
+  uint8_t bph = 1 << (flags & 0x03);
+  uint8_t hops = path_len / bph;
+  if ((hops & 1) == 0 || hops / 2 > 63) return;
+
+  uint8_t mid = hops / 2;
+  for (int h = 0; h < mid; h++) {
+    if (memcmp(&path_hashes[h * bph], &path_hashes[(hops - 1 - h) * bph], bph) != 0) return;  // not symmetric
+  }
+
+  const uint8_t* dest_hash = &path_hashes[mid * bph];
+  ContactInfo* dest = NULL;
+  for (int i = 0; i < num_contacts; i++) {
+    if (contacts[i].id.isHashMatch(dest_hash, bph)) {
+      if (dest) return;   // ambiguous hash
+      dest = &contacts[i];
+    }
+  }
+  if (dest) {
+    routes.addPath(dest->id.pub_key, path_hashes, (uint8_t)(mid | ((bph - 1) << 6)), ROUTE_SRC_TRACE, _ms->getMillis());
+  }
+}
+
 void BaseChatMesh::handleReturnPathRetry(const ContactInfo& contact, const uint8_t* path, uint8_t path_len) {
   // NOTE: simplest impl is just to re-send a reciprocal return path to sender (DIRECTLY)
   //        override this method in various firmwares, if there's a better strategy
-  mesh::Packet* rpath = createPathReturn(contact.id, contact.getSharedSecret(self_id), path, path_len, 0, NULL, 0);
+  mesh::Packet* rpath = createPathReturn(contact.id, contact.getSharedSecret(self_id), path, path_len, 0, NULL, 0, getPeerHashSizeFor(contact));
   if (rpath) sendDirect(rpath, contact.out_path, contact.out_path_len, 3000);   // 3 second delay
 }
 
@@ -352,7 +520,23 @@ int BaseChatMesh::searchChannelsByHash(const uint8_t* hash, mesh::GroupChannel d
 }
 #endif
 
+bool BaseChatMesh::expandCompressedText(uint8_t* data, size_t& len) {
+  char text[MAX_TEXT_LEN+1];
+  int n = TxtCompressor::decompress(&data[5], len - 5, text, MAX_TEXT_LEN);
+  if (n <= 0) return false;
+
+  // re-write as TXT_TYPE_PLAIN, so rest of processing (eg. ACK hash) is as if not compressed
+  data[4] = (data[4] & 3) | (TXT_TYPE_PLAIN << 2);
+  memcpy(&data[5], text, n);
+  len = 5 + n;
+  return true;
+}
+
 void BaseChatMesh::onGroupDataRecv(mesh::Packet* packet, uint8_t type, const mesh::GroupChannel& channel, uint8_t* data, size_t len) {
+  if (type == PAYLOAD_TYPE_GRP_TXT && len > 5 && (data[4] >> 2) == TXT_TYPE_COMPRESSED && !expandCompressedText(data, len)) {
+    MESH_DEBUG_PRINTLN("onGroupDataRecv: invalid compressed text");
+    return;
+  }
   uint8_t txt_type = data[4];
   if (type == PAYLOAD_TYPE_GRP_TXT && len > 5 && (txt_type >> 2) == 0) {  // 0 = plain text msg
     uint32_t timestamp;
@@ -380,12 +564,21 @@ mesh::Packet* BaseChatMesh::composeMsgPacket(const ContactInfo& recipient, uint3
   mesh::Utils::sha256((uint8_t *)&expected_ack, 4, temp, 5 + text_len, self_id.pub_key, PUB_KEY_SIZE);
 
   int len = 5 + text_len;
+  if (allowDirectCompression() && (recipient.peer_feat1 & ADV_FEAT1_TXT_COMPRESS)) {
+    uint8_t packed[MAX_TEXT_LEN];
+    int n = TxtCompressor::compress(text, text_len, packed, text_len - 1);
+    if (n > 0) {   // only if it's smaller
+      temp[4] |= (TXT_TYPE_COMPRESSED << 2);
+      memcpy(&temp[5], packed, n);
+      len = 5 + n;
+    }
+  }
   if (attempt > 3) {
     temp[len++] = 0;  // null terminator
     temp[len++] = attempt;  // hide attempt number at tail end of payload
   }
 
-  return createDatagram(PAYLOAD_TYPE_TXT_MSG, recipient.id, recipient.getSharedSecret(self_id), temp, len);
+  return createDatagram(PAYLOAD_TYPE_TXT_MSG, recipient.id, recipient.getSharedSecret(self_id), temp, len, getPeerHashSizeFor(recipient));
 }
 
 int  BaseChatMesh::sendMessage(const ContactInfo& recipient, uint32_t timestamp, uint8_t attempt, const char* text, uint32_t& expected_ack, uint32_t& est_timeout) {
@@ -403,10 +596,367 @@ int  BaseChatMesh::sendMessage(const ContactInfo& recipient, uint32_t timestamp,
     sendDirect(pkt, recipient.out_path, recipient.out_path_len);
     txt_send_timeout = futureMillis(est_timeout = calcDirectTimeoutMillisFor(t, recipient.out_path_len));
     rc = MSG_SEND_SENT_DIRECT;
+
+    startRouteProbe(recipient, expected_ack, est_timeout);   // measure this route
+  }
+  return rc;
+}
+
+int  BaseChatMesh::sendMessageReliable(const ContactInfo& recipient, uint32_t timestamp, const char* text, uint32_t& expected_ack, uint32_t& est_timeout) {
+  int rc = sendMessage(recipient, timestamp, 0, text, expected_ack, est_timeout);
+  if (rc == MSG_SEND_FAILED) return rc;
+
+  auto m = pending_acks.add(recipient.id.pub_key, expected_ack, timestamp, text, PENDING_FLAG_RETRY);
+  if (m) {
+    m->first_sent = _ms->getMillis();
+    m->next_retry = futureMillis(est_timeout);
+    if (rc == MSG_SEND_SENT_FLOOD) m->flags |= PENDING_FLAG_LAST_FLOOD;
+  } else {
+    MESH_DEBUG_PRINTLN("sendMessageReliable: ACK table full, no retries for this msg");
   }
   return rc;
 }
 
+void BaseChatMesh::trackExpectedAck(const ContactInfo& recipient, uint32_t expected_ack) {
+  auto m = pending_acks.add(recipient.id.pub_key, expected_ack, 0, NULL, 0);
+  if (m) {
+    m->first_sent = _ms->getMillis();
+    m->next_retry = futureMillis(ACK_TRACK_EXPIRY_MILLIS);
+  }
+}
+
+bool BaseChatMesh::completeExpectedAck(const uint8_t* ack, uint32_t& trip_time, ContactInfo*& contact) {
+  uint32_t ack_crc;
+  memcpy(&ack_crc, ack, 4);
+
+  uint8_t pub_key[8];
+  if (!pending_acks.complete(ack_crc, _ms->getMillis(), pub_key, trip_time)) return false;
+
+  contact = lookupContactByPubKey(pub_key, sizeof(pub_key));
+  return true;
+}
+
+void BaseChatMesh::checkPendingAcks() {
+  if (pending_acks.getNumActive() == 0) return;
+
+  for (int i = 0; i < ACK_TRACKER_SIZE; i++) {
+    auto m = pending_acks.getByIdx(i);
+    if (!m->isActive() || !millisHasNowPassed(m->next_retry)) continue;
+
+    if ((m->flags & PENDING_FLAG_RETRY) == 0) {   // app is responsible for retries
+      pending_acks.expire(m);
+      continue;
+    }
+    auto contact = lookupContactByPubKey(m->pub_key, sizeof(m->pub_key));
+    if (contact == NULL) {
+      pending_acks.fail(m);   // contact has been removed
+      continue;
+    }
+    if (m->num_acks >= ACK_TRACKER_MAX_ATTEMPTS) {
+      onReliableSendFailed(*contact, m->timestamp, m->text);
+      pending_acks.fail(m);
+      continue;
+    }
+
+    if ((m->flags & PENDING_FLAG_LAST_FLOOD) == 0) m->direct_fails++;
+
+    onWideHashNoReply(*contact);   // legacy repeaters on route may be dropping PAYLOAD_VER_2
+    bool fallback = false;
+    if (contact->out_path_len != OUT_PATH_UNKNOWN && m->direct_fails >= RELIABLE_FLOOD_AFTER && !isPathLocked(*contact)) {
+      resetPathTo(*contact);   // direct routes aren't working, re-discover via flood
+      onContactPathUpdated(*contact);
+      fallback = true;
+    }
+
+    uint32_t ack, est_timeout;
+    int rc = sendMessage(*contact, m->timestamp, m->num_acks, m->text, ack, est_timeout);
+    if (rc == MSG_SEND_FAILED) {   // eg. packet pool exhausted, try again shortly
+      m->next_retry = futureMillis(1000);
+      continue;
+    }
+    pending_acks.addAttempt(m, ack);
+    pending_acks.countRetry(fallback);
+    if (rc == MSG_SEND_SENT_FLOOD) {
+      m->flags |= PENDING_FLAG_LAST_FLOOD;
+    } else {
+      m->flags &= ~PENDING_FLAG_LAST_FLOOD;
+    }
+
+    uint32_t backoff = est_timeout << m->getAttempt();   // exponential backoff
+    if (backoff > RELIABLE_MAX_BACKOFF_MILLIS) backoff = RELIABLE_MAX_BACKOFF_MILLIS;
+    m->next_retry = futureMillis(backoff + getRNG()->nextInt(0, 500));
+  }
+}
+
+uint16_t BaseChatMesh::sendBlob(const ContactInfo& recipient, uint8_t blob_type, const uint8_t* data, size_t len) {
+  auto s = blobs.startPeer(recipient.id.pub_key, blob_type, data, len, _ms->getMillis());
+  if (s == NULL) return 0;
+
+  requestFastLink(recipient, s);
+  return s->xfer_id;
+}
+
+uint16_t BaseChatMesh::sendChannelBlob(const mesh::GroupChannel& channel, uint8_t blob_type, const uint8_t* data, size_t len) {
+  auto s = blobs.startGroup(channel, blob_type, data, len, _ms->getMillis());
+  return s ? s->xfer_id : 0;
+}
+
+void BaseChatMesh::sendToContact(const ContactInfo& contact, mesh::Packet* pkt, uint32_t delay_millis) {
+  if (contact.out_path_len == OUT_PATH_UNKNOWN) {
+    sendFloodScoped(contact, pkt, delay_millis);
+  } else {
+    sendDirect(pkt, contact.out_path, contact.out_path_len, delay_millis);
+  }
+}
+
+bool BaseChatMesh::onPeerFragmentRecv(mesh::Packet* packet, int sender_idx, const uint8_t* secret, uint8_t* data, size_t len) {
+  int i = matching_peer_indexes[sender_idx];
+  if (i < 0 || i >= num_contacts) {
+    MESH_DEBUG_PRINTLN("onPeerFragmentRecv: Invalid sender idx: %d", i);
+    return false;
+  }
+  ContactInfo& from = contacts[i];
+  updateLinkQuality(from, packet);
+
+  uint8_t kind = data[0] & FRAG_KIND_MASK;
+  if (kind == FRAG_KIND_STATUS) {
+    auto s = blobs.onStatus(from.id.pub_key, data, len);
+    if (s && blobs.isOutComplete(s)) {
+      uint16_t xfer_id = s->xfer_id;
+      if (links.isPeer(from.id.pub_key) && links.getXferId() == xfer_id) links.finish(_ms->getMillis());
+      links.recordBlobOK(from.id.pub_key);
+      blobs.finishOut(s, true, _ms->getMillis());
+      onBlobSendComplete(xfer_id, true);
+    }
+    return true;
+  }
+  if (kind == FRAG_KIND_LINK_REQ) {
+    onLinkRequest(from, secret, data, len);
+    return true;
+  }
+  if (kind == FRAG_KIND_LINK_RESP) {
+    onLinkResponse(from, packet, data, len);
+    return true;
+  }
+  if (kind != FRAG_KIND_DATA) return true;  // unknown kind (FUTURE)
+
+  bool completed;
+  auto s = blobs.onData(from.id.pub_key, 0, data, len, _ms->getMillis(), completed);
+  if (s == NULL) return true;
+
+  if (completed) {
+    from.lastmod = getRTCClock()->getCurrentTime(); // update last heard time
+    links.recordBlobOK(from.id.pub_key);
+    onContactBlobRecv(from, s->blob_type, s->data, s->total_len);
+  }
+  if (completed || (data[0] & FRAG_FLAG_STATUS_REQ)) {
+    uint8_t status[16];
+    int n = blobs.writeStatus(s, status);
+    mesh::Packet* reply = createPeerFragment(from.id, secret, status, n, 0);
+    if (reply) {
+      bool fast_link = links.isSwitched() && links.isPeer(from.id.pub_key) && links.getXferId() == s->xfer_id;
+      if (fast_link) {
+        uint32_t airtime = _radio->getEstAirtimeFor(reply->getRawLength());
+        links.addAirtimeSaved(airtime, getBaseSpreadingFactor());
+        if (completed) links.finish(_ms->getMillis() + TXT_ACK_DELAY + airtime*2 + LINK_SWITCH_GUARD_MILLIS);   // revert once final STATUS is out
+      }
+      sendToContact(from, reply, TXT_ACK_DELAY);
+    }
+  }
+  return true;
+}
+
+void BaseChatMesh::onGroupFragmentRecv(mesh::Packet* packet, const mesh::GroupChannel& channel, uint8_t* data, size_t len) {
+  if ((data[0] & FRAG_KIND_MASK) != FRAG_KIND_DATA) return;
+
+  bool completed;
+  auto s = blobs.onData(NULL, channel.hash[0], data, len, _ms->getMillis(), completed);
+  if (s && completed) {
+    onChannelBlobRecv(channel, s->src_key, s->blob_type, s->data, s->total_len);
+  }
+}
+
+void BaseChatMesh::updateLinkQuality(const ContactInfo& from, const mesh::Packet* packet) {
+  // only packets heard directly from the contact say anything about the link to it
+  bool zero_hop = packet->isRouteFlood() ? (packet->path_len & 63) == 0 : isZeroHopNeighbour(from);
+  if (zero_hop) links.recordSNR(from.id.pub_key, packet->getSNR(), _ms->getMillis());
+  if (links.isPeer(from.id.pub_key)) links.onPeerHeard();
+}
+
+static uint8_t calcFastLinkWindowSecs(uint32_t base_airtime, uint8_t base_sf, uint8_t sf, uint16_t num_frags) {
+  // airtime roughly halves per SF step, allow for STATUS replies and some re-sends
+  uint32_t airtime = base_airtime >> (base_sf - sf);
+  uint32_t secs = (airtime * (num_frags + num_frags / BLOB_WINDOW_SIZE + 1) * 2) / 1000 + 1;
+  return secs > LINK_MAX_WINDOW_SECS ? LINK_MAX_WINDOW_SECS : secs;   // rest of a long transfer continues at base SF
+}
+
+void BaseChatMesh::requestFastLink(const ContactInfo& contact, const BlobOutSession* s) {
+  uint8_t base_sf = getBaseSpreadingFactor();
+  if (base_sf == 0 || links.isActive() || s->total_len < LINK_ADAPT_MIN_BYTES || !isZeroHopNeighbour(contact)) return;
+
+  unsigned long now = _ms->getMillis();
+  uint8_t sf = links.pickFastSF(contact.id.pub_key, base_sf, now);
+  if (sf == 0) return;   // link not good enough
+
+  uint8_t req[6];
+  int i = 0;
+  req[i++] = FRAG_KIND_LINK_REQ;
+  memcpy(&req[i], &s->xfer_id, 2); i += 2;
+  req[i++] = sf;
+  req[i++] = calcFastLinkWindowSecs(_radio->getEstAirtimeFor(MAX_TRANS_UNIT), base_sf, sf, s->num_frags);
+  req[i++] = base_sf;   // peer must be on the same channel SF
+
+  mesh::Packet* pkt = createPeerFragment(contact.id, contact.getSharedSecret(self_id), req, i, 0);
+  if (pkt) {
+    sendToContact(contact, pkt);
+    links.startRequest(contact.id.pub_key, sf, s->xfer_id, now);
+  }
+}
+
+void BaseChatMesh::onLinkRequest(const ContactInfo& from, const uint8_t* secret, const uint8_t* data, size_t len) {
+  if (len < 6) return;
+
+  uint16_t xfer_id;
+  memcpy(&xfer_id, &data[1], 2);
+  uint8_t sf = data[3];
+  uint8_t peer_base_sf = data[5];
+  uint32_t window_secs = data[4] > LINK_MAX_WINDOW_SECS ? LINK_MAX_WINDOW_SECS : data[4];
+
+  unsigned long now = _ms->getMillis();
+  uint8_t base_sf = getBaseSpreadingFactor();
+  uint8_t resp_sf = 0;   // reject
+  bool is_repeat = false;
+  if (base_sf && peer_base_sf == base_sf && sf >= LinkAdapter::minFastSF(base_sf) && sf < base_sf && isZeroHopNeighbour(from)) {
+    if (links.isPeer(from.id.pub_key) && links.getXferId() == xfer_id) {
+      resp_sf = links.getSF();   // our LINK_RESP was lost
+      is_repeat = true;
+    } else if (!links.isActive()) {
+      uint8_t best = links.pickFastSF(from.id.pub_key, base_sf, now);
+      if (best && sf >= best) resp_sf = sf;   // our end of the link can support it too
+    }
+  }
+
+  uint8_t resp[4];
+  int i = 0;
+  resp[i++] = FRAG_KIND_LINK_RESP;
+  memcpy(&resp[i], &xfer_id, 2); i += 2;
+  resp[i++] = resp_sf;
+
+  mesh::Packet* reply = createPeerFragment(from.id, secret, resp, i, 0);
+  if (reply == NULL) return;
+
+  uint32_t airtime = _radio->getEstAirtimeFor(reply->getRawLength());
+  sendToContact(from, reply);
+  if (resp_sf && !is_repeat) {   // switch once the LINK_RESP has gone out on base SF
+    links.accept(from.id.pub_key, resp_sf, xfer_id, now + airtime*2 + LINK_SWITCH_GUARD_MILLIS, window_secs * 1000);
+  }
+}
+
+void BaseChatMesh::onLinkResponse(const ContactInfo& from, const mesh::Packet* packet, const uint8_t* data, size_t len) {
+  if (len < 4) return;
+
+  uint16_t xfer_id;
+  memcpy(&xfer_id, &data[1], 2);
+  uint8_t sf = data[3];
+  if (!links.isPending(xfer_id) || !links.isPeer(from.id.pub_key)) return;   // late, or not ours
+
+  BlobOutSession* s = NULL;
+  for (int i = 0; i < BLOB_MAX_OUT_SESSIONS; i++) {
+    if (blobs.getOut(i)->xfer_id == xfer_id) { s = blobs.getOut(i); break; }
+  }
+  uint8_t base_sf = getBaseSpreadingFactor();
+  if (s == NULL || base_sf == 0 || sf != links.getSF()) {   // rejected
+    links.cancel();
+    return;
+  }
+
+  unsigned long now = _ms->getMillis();
+  uint32_t window_secs = calcFastLinkWindowSecs(_radio->getEstAirtimeFor(MAX_TRANS_UNIT), base_sf, sf, s->num_frags);
+  links.onAccepted(now, window_secs * 1000);
+  s->next_send = now + _radio->getEstAirtimeFor(packet->getRawLength())*2 + LINK_SWITCH_GUARD_MILLIS;   // peer switches after its LINK_RESP
+}
+
+void BaseChatMesh::checkFastLink() {
+  uint8_t base_sf = getBaseSpreadingFactor();
+  if (base_sf == 0) return;
+
+  uint8_t sf = links.checkTimers(base_sf, _ms->getMillis());
+  if (sf) {
+    MESH_DEBUG_PRINTLN("checkFastLink: radio now on SF%d", (uint32_t)sf);
+    setRadioSpreadingFactor(sf);
+  }
+}
+
+void BaseChatMesh::checkBlobTransfers() {
+  unsigned long now = _ms->getMillis();
+  blobs.expireIn(now);
+
+  for (int i = 0; i < BLOB_MAX_OUT_SESSIONS; i++) {
+    auto s = blobs.getOut(i);
+    if (s->xfer_id == 0) continue;
+
+    const ContactInfo* contact = NULL;
+    bool fast_link = false;
+    if (!s->is_group) {
+      if (links.isPending(s->xfer_id)) continue;   // wait for peer's LINK_RESP (or timeout)
+
+      fast_link = links.isSwitched() && links.getXferId() == s->xfer_id;
+      contact = lookupContactByPubKey(s->dest_key, sizeof(s->dest_key));
+      bool timed_out = s->awaiting_status && (long)(now - s->status_timeout) >= 0;
+      if (timed_out && fast_link) {
+        links.fallback(now);   // revert to base SF, and re-send window from there
+        s->next_send = now + LINK_SWITCH_GUARD_MILLIS;
+        fast_link = false;
+      }
+      if (contact == NULL || (timed_out && !blobs.onStatusTimeout(s))) {
+        uint16_t xfer_id = s->xfer_id;
+        if (links.getXferId() == xfer_id) links.finish(now);
+        blobs.finishOut(s, false, now);
+        onBlobSendComplete(xfer_id, false);
+        continue;
+      }
+    }
+
+    uint32_t airtime = _radio->getEstAirtimeFor(MAX_TRANS_UNIT);
+    uint32_t status_timeout = airtime * BLOB_WINDOW_SIZE;
+    if (contact) {
+      status_timeout += contact->out_path_len == OUT_PATH_UNKNOWN ? calcFloodTimeoutMillisFor(airtime)
+                                                                   : calcDirectTimeoutMillisFor(airtime, contact->out_path_len);
+    }
+
+    uint8_t frag[MAX_PACKET_PAYLOAD];
+    int len = blobs.nextFragment(s, self_id.pub_key, frag, now, status_timeout);
+    if (len == 0) continue;
+
+    mesh::Packet* pkt;
+    if (s->is_group) {
+      pkt = createGroupFragment(s->channel, frag, len, 0);
+      if (pkt) sendFloodScoped(s->channel, pkt);
+    } else {
+      pkt = createPeerFragment(contact->id, contact->getSharedSecret(self_id), frag, len, 0);
+      if (pkt) {
+        if (fast_link) links.addAirtimeSaved(_radio->getEstAirtimeFor(pkt->getRawLength()), getBaseSpreadingFactor());
+        sendToContact(*contact, pkt);
+      }
+    }
+    if (pkt == NULL) {   // packet pool exhausted, fragment wasn't sent, so give up rather than wait on a STATUS for it
+      MESH_DEBUG_PRINTLN("checkBlobTransfers: unable to create fragment, xfer_id=%d failed", (uint32_t)s->xfer_id);
+      uint16_t xfer_id = s->xfer_id;
+      if (links.getXferId() == xfer_id) links.finish(now);
+      blobs.finishOut(s, false, now);
+      onBlobSendComplete(xfer_id, false);
+      continue;
+    }
+    s->next_send = now + airtime;   // pace fragments, so outbound queue doesn't fill up
+
+    if (s->is_group && blobs.isOutComplete(s)) {
+      uint16_t xfer_id = s->xfer_id;
+      blobs.finishOut(s, true, now);
+      onBlobSendComplete(xfer_id, true);
+    }
+  }
+}
+
 int  BaseChatMesh::sendCommandData(const ContactInfo& recipient, uint32_t timestamp, uint8_t attempt, const char* text, uint32_t& est_timeout) {
   int text_len = strlen(text);
   if (text_len > MAX_TEXT_LEN) return MSG_SEND_FAILED;
@@ -416,7 +966,7 @@ int  BaseChatMesh::sendCommandData(const ContactInfo& recipient, uint32_t timest
   temp[4] = (attempt & 3) | (TXT_TYPE_CLI_DATA << 2);
   memcpy(&temp[5], text, text_len + 1);
 
-  auto pkt = createDatagram(PAYLOAD_TYPE_TXT_MSG, recipient.id, recipient.getSharedSecret(self_id), temp, 5 + text_len);
+  auto pkt = createDatagram(PAYLOAD_TYPE_TXT_MSG, recipient.id, recipient.getSharedSecret(self_id), temp, 5 + text_len, getPeerHashSizeFor(recipient));
   if (pkt == NULL) return MSG_SEND_FAILED;
 
   uint32_t t = _radio->getEstAirtimeFor(pkt->getRawLength());
@@ -446,7 +996,18 @@ bool BaseChatMesh::sendGroupMessage(uint32_t timestamp, mesh::GroupChannel& chan
   memcpy(ep, text, text_len);
   ep[text_len] = 0;  // null terminator
 
-  auto pkt = createGroupDatagram(PAYLOAD_TYPE_GRP_TXT, channel, temp, 5 + prefix_len + text_len);
+  int len = 5 + prefix_len + text_len;
+  if (allowChannelCompression(channel)) {
+    uint8_t packed[MAX_TEXT_LEN];
+    int n = TxtCompressor::compress((const char *) &temp[5], prefix_len + text_len, packed, prefix_len + text_len - 1);
+    if (n > 0) {   // only if it's smaller
+      temp[4] = (TXT_TYPE_COMPRESSED << 2);
+      memcpy(&temp[5], packed, n);
+      len = 5 + n;
+    }
+  }
+
+  auto pkt = createGroupDatagram(PAYLOAD_TYPE_GRP_TXT, channel, temp, len);
   if (pkt) {
     sendFloodScoped(channel, pkt);
     return true;
@@ -557,7 +1118,7 @@ int  BaseChatMesh::sendRequest(const ContactInfo& recipient, const uint8_t* req_
     memcpy(temp, &tag, 4);   // mostly an extra blob to help make packet_hash unique
     memcpy(&temp[4], req_data, data_len);
 
-    pkt = createDatagram(PAYLOAD_TYPE_REQ, recipient.id, recipient.getSharedSecret(self_id), temp, 4 + data_len);
+    pkt = createDatagram(PAYLOAD_TYPE_REQ, recipient.id, recipient.getSharedSecret(self_id), temp, 4 + data_len, getPeerHashSizeFor(recipient));
   }
   if (pkt) {
     uint32_t t = _radio->getEstAirtimeFor(pkt->getRawLength());
@@ -584,7 +1145,7 @@ int  BaseChatMesh::sendRequest(const ContactInfo& recipient, uint8_t req_type, u
     memset(&temp[5], 0, 4);  // reserved (possibly for 'since' param)
     getRNG()->random(&temp[9], 4);   // random blob to help make packet-hash unique
 
-    pkt = createDatagram(PAYLOAD_TYPE_REQ, recipient.id, recipient.getSharedSecret(self_id), temp, sizeof(temp));
+    pkt = createDatagram(PAYLOAD_TYPE_REQ, recipient.id, recipient.getSharedSecret(self_id), temp, sizeof(temp), getPeerHashSizeFor(recipient));
   }
   if (pkt) {
     uint32_t t = _radio->getEstAirtimeFor(pkt->getRawLength());
@@ -707,7 +1268,7 @@ void BaseChatMesh::checkConnections() {
       // calc expected ACK reply
       mesh::Utils::sha256((uint8_t *)&connections[i].expected_ack, 4, data, 9, self_id.pub_key, PUB_KEY_SIZE);
 
-      auto pkt = createDatagram(PAYLOAD_TYPE_REQ, contact->id, contact->getSharedSecret(self_id), data, 9);
+      auto pkt = createDatagram(PAYLOAD_TYPE_REQ, contact->id, contact->getSharedSecret(self_id), data, 9, getPeerHashSizeFor(*contact));
       if (pkt) {
         sendDirect(pkt, contact->out_path, contact->out_path_len);
       }
@@ -719,6 +1280,9 @@ void BaseChatMesh::checkConnections() {
 }
 
 void BaseChatMesh::resetPathTo(ContactInfo& recipient) {
+  if (recipient.out_path_len != OUT_PATH_UNKNOWN) {
+    routes.removePath(recipient.id.pub_key, recipient.out_path, recipient.out_path_len);   // keep the other candidates
+  }
   recipient.out_path_len = OUT_PATH_UNKNOWN;
 }
 
@@ -771,6 +1335,10 @@ bool BaseChatMesh::addContact(const ContactInfo& contact) {
   if (dest) {
     *dest = contact;
     dest->shared_secret_valid = false; // mark shared_secret as needing calculation
+    dest->peer_hash_size = PATH_HASH_SIZE;   // until they reach us with PAYLOAD_VER_2
+    dest->wide_hash_failed = false;
+    dest->wide_hash_deadline = 0;
+    dest->peer_feat1 = 0;
     return true;  // success
   }
   return false;
@@ -783,6 +1351,8 @@ bool BaseChatMesh::removeContact(ContactInfo& contact) {
   }
   if (idx >= num_contacts) return false;   // not found
 
+  routes.remove(contacts[idx].id.pub_key);
+
   // remove from contacts array
   num_contacts--;
   while (idx < num_contacts) {
@@ -878,6 +1448,10 @@ void BaseChatMesh::loop() {
     onSendTimeout();
     txt_send_timeout = 0;
   }
+  checkRouteProbes();
+  checkPendingAcks();
+  checkFastLink();
+  checkBlobTransfers();
 
   if (_pendingLoopback) {
     onRecvPacket(_pendingLoopback);  // loop-back, as if received over radio
@@ -8,9 +8,34 @@
 #define MAX_TEXT_LEN    (10*CIPHER_BLOCK_SIZE)  // must be LESS than (MAX_PACKET_PAYLOAD - 4 - CIPHER_MAC_SIZE - 1)
 
 #include "ContactInfo.h"
+#include "ContactRouteCache.h"
+#include "AckTracker.h"
+#include "BlobTransfer.h"
+#include "LinkAdapter.h"
+#include "TxtCompressor.h"
 
 #define MAX_SEARCH_RESULTS   8
 
+#ifndef RELIABLE_FLOOD_AFTER
+  #define RELIABLE_FLOOD_AFTER    2   // failed direct attempts, before falling back to flood
+#endif
+#define RELIABLE_MAX_BACKOFF_MILLIS  60000
+
+#ifndef CHANNEL_TXT_COMPRESSION
+  #define CHANNEL_TXT_COMPRESSION  0   // channel members can't be negotiated with, so off unless all nodes support it
+#endif
+#ifndef DM_TXT_COMPRESSION
+  #define DM_TXT_COMPRESSION       0   // 1 = advertise ADV_FEAT1_TXT_COMPRESS, and compress DMs to contacts that do too
+#endif
+#define ACK_TRACK_EXPIRY_MILLIS      (5*60*1000UL)   // for messages the app is retrying
+#ifndef WIDE_HASH_REPLY_MILLIS
+  #define WIDE_HASH_REPLY_MILLIS  20000   // no reply to a PAYLOAD_VER_2 send within this, assume a legacy repeater dropped it
+#endif
+
+#ifndef LINK_ADAPT_MIN_BYTES
+  #define LINK_ADAPT_MIN_BYTES   (4*BLOB_FRAG_SIZE)   // smaller blobs aren't worth the negotiation
+#endif
+
 #define MSG_SEND_FAILED       0
 #define MSG_SEND_SENT_FLOOD   1
 #define MSG_SEND_SENT_DIRECT  2
@@ -70,9 +95,31 @@ class BaseChatMesh : public mesh::Mesh {
   mesh::Packet* _pendingLoopback;
   uint8_t temp_buf[MAX_TRANS_UNIT];
   ConnectionInfo connections[MAX_CONNECTIONS];
+  ContactRouteCache routes;
+  AckTracker pending_acks;
+  BlobTransfer blobs;
+  LinkAdapter links;
+
+  RouteProbe route_probes[ROUTE_MAX_PROBES];   // DIRECT text sends awaiting ACK (for route scoring)
 
+  bool expandCompressedText(uint8_t* data, size_t& len);
   mesh::Packet* composeMsgPacket(const ContactInfo& recipient, uint32_t timestamp, uint8_t attempt, const char *text, uint32_t& expected_ack);
   void sendAckTo(const ContactInfo& dest, uint32_t ack_hash);
+  void startRouteProbe(const ContactInfo& recipient, uint32_t ack, uint32_t timeout_millis);
+  void checkRouteProbeAck(const uint8_t* ack);
+  void checkRouteProbes();
+  void onRouteProbeTimeout(RouteProbe& probe);
+  void checkPendingAcks();
+  void checkBlobTransfers();
+  void updateLinkQuality(const ContactInfo& from, const mesh::Packet* packet);
+  bool isZeroHopNeighbour(const ContactInfo& contact) const {
+    return contact.out_path_len != OUT_PATH_UNKNOWN && (contact.out_path_len & 63) == 0;
+  }
+  void requestFastLink(const ContactInfo& contact, const BlobOutSession* s);
+  void onLinkRequest(const ContactInfo& from, const uint8_t* secret, const uint8_t* data, size_t len);
+  void onLinkResponse(const ContactInfo& from, const mesh::Packet* packet, const uint8_t* data, size_t len);
+  void checkFastLink();
+  void sendToContact(const ContactInfo& contact, mesh::Packet* pkt, uint32_t delay_millis=0);
 
 protected:
   BaseChatMesh(mesh::Radio& radio, mesh::MillisecondClock& ms, mesh::RNG& rng, mesh::RTCClock& rtc, mesh::PacketManager& mgr, mesh::MeshTables& tables)
@@ -86,6 +133,7 @@ protected:
     num_channels = 0;
   #endif
     txt_send_timeout = 0;
+    memset(route_probes, 0, sizeof(route_probes));
     _pendingLoopback = NULL;
     memset(connections, 0, sizeof(connections));
   }
@@ -104,6 +152,8 @@ protected:
     contacts = new ContactInfo[MAX_CONTACTS]();
     sort_array = new int[MAX_CONTACTS]();
   #endif
+    routes.begin();
+    blobs.begin(getRNG()->nextInt(1, 0xFFFF));
   }
   void populateContactFromAdvert(ContactInfo& ci, const mesh::Identity& id, const AdvertDataParser& parser, uint32_t timestamp);
   ContactInfo* allocateContactSlot(); // helper to find slot for new contact
@@ -129,6 +179,33 @@ protected:
   virtual uint8_t onContactRequest(const ContactInfo& contact, uint32_t sender_timestamp, const uint8_t* data, uint8_t len, uint8_t* reply) = 0;
   virtual void onContactResponse(const ContactInfo& contact, const uint8_t* data, uint8_t len) = 0;
   virtual void handleReturnPathRetry(const ContactInfo& contact, const uint8_t* path, uint8_t path_len);
+  virtual bool isPathLocked(const ContactInfo& contact) const { return false; }   // true = don't auto-switch out_path
+  virtual bool allowWidePeerHashes(const ContactInfo& contact) const { return false; }   // true = try PAYLOAD_VER_2 with this contact
+  virtual bool allowChannelCompression(const mesh::GroupChannel& channel) const { return CHANNEL_TXT_COMPRESSION != 0; }
+  virtual bool allowDirectCompression() const { return DM_TXT_COMPRESSION != 0; }
+  uint16_t getSelfFeat1() const;
+  uint8_t getPeerHashSizeFor(const ContactInfo& recipient);
+  void onWideHashReply(ContactInfo& from, const mesh::Packet* packet);
+  void onWideHashNoReply(ContactInfo& contact);
+
+  // Multipath route cache
+  bool selectBestRoute(ContactInfo& contact);
+  void learnRouteFromTrace(const uint8_t* path_hashes, uint8_t path_len, uint8_t flags);
+  const ContactRouteCache& getRouteCache() const { return routes; }
+
+  // ACK tracking
+  void trackExpectedAck(const ContactInfo& recipient, uint32_t expected_ack);   // app does the retries
+  bool completeExpectedAck(const uint8_t* ack, uint32_t& trip_time, ContactInfo*& contact);
+  virtual void onReliableSendFailed(const ContactInfo& contact, uint32_t timestamp, const char* text) { }
+
+  // Blob transfers (fragmented)
+  virtual void onContactBlobRecv(const ContactInfo& from, uint8_t blob_type, const uint8_t* data, size_t len) { }
+  virtual void onChannelBlobRecv(const mesh::GroupChannel& channel, const uint8_t* sender_prefix, uint8_t blob_type, const uint8_t* data, size_t len) { }
+  virtual void onBlobSendComplete(uint16_t xfer_id, bool success) { }
+
+  // Link adaptation (faster SF to zero-hop neighbours, for blob transfers)
+  virtual uint8_t getBaseSpreadingFactor() const { return 0; }   // zero = not supported
+  virtual void setRadioSpreadingFactor(uint8_t sf) { }
 
   virtual uint8_t getPathHashSize() const = 0;
   virtual void sendFloodScoped(const ContactInfo& recipient, mesh::Packet* pkt, uint32_t delay_millis=0);
@@ -141,6 +218,7 @@ protected:
   // Mesh overrides
   void onAdvertRecv(mesh::Packet* packet, const mesh::Identity& id, uint32_t timestamp, const uint8_t* app_data, size_t app_data_len) override;
   int searchPeersByHash(const uint8_t* hash) override;
+  int searchPeersByHash(const uint8_t* hash, uint8_t hash_size) override;
   void getPeerSharedSecret(uint8_t* dest_secret, int peer_idx) override;
   void onPeerDataRecv(mesh::Packet* packet, uint8_t type, int sender_idx, const uint8_t* secret, uint8_t* data, size_t len) override;
   bool onPeerPathRecv(mesh::Packet* packet, int sender_idx, const uint8_t* secret, uint8_t* path, uint8_t path_len, uint8_t extra_type, uint8_t* extra, uint8_t extra_len) override;
@@ -149,6 +227,8 @@ protected:
   int searchChannelsByHash(const uint8_t* hash, mesh::GroupChannel channels[], int max_matches) override;
 #endif
   void onGroupDataRecv(mesh::Packet* packet, uint8_t type, const mesh::GroupChannel& channel, uint8_t* data, size_t len) override;
+  bool onPeerFragmentRecv(mesh::Packet* packet, int sender_idx, const uint8_t* secret, uint8_t* data, size_t len) override;
+  void onGroupFragmentRecv(mesh::Packet* packet, const mesh::GroupChannel& channel, uint8_t* data, size_t len) override;
 
   // Connections
   bool startConnection(const ContactInfo& contact, uint16_t keep_alive_secs);
@@ -162,6 +242,13 @@ public:
   mesh::Packet* createSelfAdvert(const char* name);
   mesh::Packet* createSelfAdvert(const char* name, double lat, double lon);
   int  sendMessage(const ContactInfo& recipient, uint32_t timestamp, uint8_t attempt, const char* text, uint32_t& expected_ack, uint32_t& est_timeout);
+  int  sendMessageReliable(const ContactInfo& recipient, uint32_t timestamp, const char* text, uint32_t& expected_ack, uint32_t& est_timeout);
+  const AckTracker& getAckTracker() const { return pending_acks; }
+  void resetAckStats() { pending_acks.resetStats(); }
+  uint16_t sendBlob(const ContactInfo& recipient, uint8_t blob_type, const uint8_t* data, size_t len);   // returns xfer_id, or zero if failed
+  uint16_t sendChannelBlob(const mesh::GroupChannel& channel, uint8_t blob_type, const uint8_t* data, size_t len);
+  const BlobTransfer& getBlobTransfer() const { return blobs; }
+  const LinkAdapter& getLinkAdapter() const { return links; }
   int  sendCommandData(const ContactInfo& recipient, uint32_t timestamp, uint8_t attempt, const char* text, uint32_t& est_timeout);
   bool sendGroupMessage(uint32_t timestamp, mesh::GroupChannel& channel, const char* sender_name, const char* text, int text_len);
   int  sendLogin(const ContactInfo& recipient, const char* password, uint32_t& est_timeout);
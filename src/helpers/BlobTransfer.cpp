@@ -0,0 +1,281 @@
+#include "BlobTransfer.h"
+
+BlobTransfer::BlobTransfer() {
+  memset(_out, 0, sizeof(_out));
+  memset(_in, 0, sizeof(_in));
+  _next_xfer_id = 1;
+  _blobs_sent = _blobs_failed = _blobs_recv = 0;
+  _frags_sent = _frags_resent = _frags_recv = _frags_dup = _frags_busy = 0;
+  _last_goodput = 0;
+}
+
+uint8_t* BlobTransfer::allocBuffer() {
+#if defined(ESP32) && defined(BOARD_HAS_PSRAM)
+  return (uint8_t *) ps_malloc(BLOB_MAX_SIZE);
+#else
+  return (uint8_t *) malloc(BLOB_MAX_SIZE);
+#endif
+}
+
+BlobOutSession* BlobTransfer::allocOut(const uint8_t* data, size_t len, uint8_t blob_type, unsigned long now) {
+  if (len == 0 || len > BLOB_MAX_SIZE) return NULL;
+
+  BlobOutSession* s = NULL;
+  for (int i = 0; i < BLOB_MAX_OUT_SESSIONS; i++) {
+    if (_out[i].xfer_id == 0) { s = &_out[i]; break; }
+  }
+  if (s == NULL) return NULL;   // all busy
+
+  if (s->data == NULL) {
+    s->data = allocBuffer();   // buffers are kept, for next transfer
+    if (s->data == NULL) return NULL;
+  }
+  memcpy(s->data, data, len);
+  s->total_len = len;
+  s->num_frags = (len + BLOB_FRAG_SIZE - 1) / BLOB_FRAG_SIZE;
+  s->blob_type = blob_type;
+  s->base = s->next_idx = s->sent_hwm = 0;
+  s->window_sent = 0;
+  s->retries = 0;
+  s->awaiting_status = false;
+  s->next_send = s->started = now;
+  s->frags_sent = 0;
+  memset(s->acked, 0, sizeof(s->acked));
+
+  if (_next_xfer_id == 0) _next_xfer_id++;
+  s->xfer_id = _next_xfer_id++;
+  return s;
+}
+
+BlobOutSession* BlobTransfer::startPeer(const uint8_t* pub_key, uint8_t blob_type, const uint8_t* data, size_t len, unsigned long now) {
+  auto s = allocOut(data, len, blob_type, now);
+  if (s) {
+    s->is_group = false;
+    memcpy(s->dest_key, pub_key, sizeof(s->dest_key));
+  }
+  return s;
+}
+
+BlobOutSession* BlobTransfer::startGroup(const mesh::GroupChannel& channel, uint8_t blob_type, const uint8_t* data, size_t len, unsigned long now) {
+  auto s = allocOut(data, len, blob_type, now);
+  if (s) {
+    s->is_group = true;
+    s->channel = channel;
+  }
+  return s;
+}
+
+int BlobTransfer::nextFragment(BlobOutSession* s, const uint8_t* sender_prefix, uint8_t* dest, unsigned long now, uint32_t status_timeout) {
+  if (s->xfer_id == 0 || s->awaiting_status || (long)(now - s->next_send) < 0) return 0;
+
+  int idx = s->next_idx;
+  while (idx < s->num_frags && isBitSet(s->acked, idx)) idx++;   // skip the ACKed ones
+  if (idx >= s->num_frags) return 0;
+
+  uint8_t flags = 0;
+  if (s->is_group) {
+    setBit(s->acked, idx);   // no STATUS for groups, fire and forget
+  } else {
+    s->window_sent++;
+    int nxt = idx + 1;
+    while (nxt < s->num_frags && isBitSet(s->acked, nxt)) nxt++;
+    if (s->window_sent >= BLOB_WINDOW_SIZE || nxt >= s->num_frags) {   // end of this window
+      flags |= FRAG_FLAG_STATUS_REQ;
+      s->awaiting_status = true;
+      s->status_timeout = now + status_timeout;
+    }
+  }
+  s->next_idx = idx + 1;
+
+  int i = 0;
+  dest[i++] = FRAG_KIND_DATA | flags;
+  memcpy(&dest[i], &s->xfer_id, 2); i += 2;
+  uint16_t frag_idx = idx;
+  memcpy(&dest[i], &frag_idx, 2); i += 2;
+  memcpy(&dest[i], &s->total_len, 2); i += 2;
+  dest[i++] = s->blob_type;
+  if (s->is_group) {
+    memcpy(&dest[i], sender_prefix, FRAG_GRP_PREFIX_SIZE); i += FRAG_GRP_PREFIX_SIZE;
+  }
+  int offset = idx * BLOB_FRAG_SIZE;
+  int len = s->total_len - offset;
+  if (len > BLOB_FRAG_SIZE) len = BLOB_FRAG_SIZE;
+  memcpy(&dest[i], &s->data[offset], len); i += len;
+
+  s->frags_sent++;
+  _frags_sent++;
+  if (idx < s->sent_hwm) {
+    _frags_resent++;
+  } else {
+    s->sent_hwm = idx + 1;
+  }
+  return i;
+}
+
+bool BlobTransfer::isOutComplete(const BlobOutSession* s) const {
+  if (s->is_group) {
+    return s->next_idx >= s->num_frags;
+  }
+  return s->base >= s->num_frags;
+}
+
+void BlobTransfer::finishOut(BlobOutSession* s, bool success, unsigned long now) {
+  if (success) {
+    _blobs_sent++;
+    unsigned long elapsed = now - s->started;
+    _last_goodput = ((uint32_t)s->total_len * 1000) / (elapsed ? elapsed : 1);
+  } else {
+    _blobs_failed++;
+  }
+  s->xfer_id = 0;
+}
+
+bool BlobTransfer::onStatusTimeout(BlobOutSession* s) {
+  if (++s->retries > BLOB_MAX_RETRIES) return false;
+
+  // re-send window, from first un-ACKed
+  s->awaiting_status = false;
+  s->next_idx = s->base;
+  s->window_sent = 0;
+  return true;
+}
+
+BlobOutSession* BlobTransfer::onStatus(const uint8_t* pub_key, const uint8_t* data, size_t len) {
+  if (len < 9) return NULL;
+
+  uint16_t xfer_id, base;
+  uint32_t bitmap;
+  memcpy(&xfer_id, &data[1], 2);
+  memcpy(&base, &data[3], 2);
+  memcpy(&bitmap, &data[5], 4);
+
+  for (int i = 0; i < BLOB_MAX_OUT_SESSIONS; i++) {
+    auto s = &_out[i];
+    if (s->xfer_id == 0 || s->xfer_id != xfer_id || s->is_group || memcmp(s->dest_key, pub_key, sizeof(s->dest_key)) != 0) continue;
+
+    if (base > s->num_frags) base = s->num_frags;
+    for (int k = s->base; k < base; k++) setBit(s->acked, k);
+    for (int k = 0; k < 32 && base + 1 + k < s->num_frags; k++) {
+      if (bitmap & (1UL << k)) setBit(s->acked, base + 1 + k);
+    }
+    while (s->base < s->num_frags && isBitSet(s->acked, s->base)) s->base++;
+
+    // start next window (missing frags first)
+    s->awaiting_status = false;
+    s->retries = 0;
+    s->next_idx = s->base;
+    s->window_sent = 0;
+    return s;
+  }
+  return NULL;   // unknown/finished transfer
+}
+
+BlobInSession* BlobTransfer::onData(const uint8_t* src_key, uint8_t channel_hash, const uint8_t* data, size_t len, unsigned long now, bool& completed) {
+  completed = false;
+
+  bool is_group = src_key == NULL;
+  int hdr_len = FRAG_DATA_HDR_SIZE + (is_group ? FRAG_GRP_PREFIX_SIZE : 0);
+  if (len < hdr_len) return NULL;
+
+  uint16_t xfer_id, frag_idx, total_len;
+  memcpy(&xfer_id, &data[1], 2);
+  memcpy(&frag_idx, &data[3], 2);
+  memcpy(&total_len, &data[5], 2);
+  uint8_t blob_type = data[7];
+
+  uint8_t key[8];
+  memset(key, 0, sizeof(key));
+  if (is_group) {
+    memcpy(key, &data[FRAG_DATA_HDR_SIZE], FRAG_GRP_PREFIX_SIZE);
+  } else {
+    memcpy(key, src_key, sizeof(key));
+  }
+
+  if (xfer_id == 0 || total_len == 0 || total_len > BLOB_MAX_SIZE) return NULL;
+  uint16_t num_frags = (total_len + BLOB_FRAG_SIZE - 1) / BLOB_FRAG_SIZE;
+  if (frag_idx >= num_frags) return NULL;
+
+  int offset = frag_idx * BLOB_FRAG_SIZE;
+  int frag_len = total_len - offset;
+  if (frag_len > BLOB_FRAG_SIZE) frag_len = BLOB_FRAG_SIZE;
+  if (len - hdr_len < frag_len) return NULL;   // truncated
+
+  BlobInSession* s = NULL;
+  for (int i = 0; i < BLOB_MAX_IN_SESSIONS; i++) {
+    auto t = &_in[i];
+    if (t->xfer_id == xfer_id && t->is_group == is_group && memcmp(t->src_key, key, sizeof(key)) == 0
+        && (!is_group || t->channel_hash == channel_hash)) {
+      s = t;
+      break;
+    }
+  }
+  if (s == NULL) {   // new transfer, find a free, expired or completed (least recently active) buffer
+    for (int i = 0; i < BLOB_MAX_IN_SESSIONS; i++) {
+      auto t = &_in[i];
+      if (t->xfer_id == 0 || now - t->last_activity > BLOB_RECV_TIMEOUT_MILLIS) { s = t; break; }
+      if (t->complete && (s == NULL || (long)(t->last_activity - s->last_activity) < 0)) s = t;
+    }
+    if (s == NULL) {   // all busy reassembling, don't abort one of them
+      _frags_busy++;
+      return NULL;
+    }
+    if (s->data == NULL) {
+      s->data = allocBuffer();
+      if (s->data == NULL) return NULL;
+    }
+    s->xfer_id = xfer_id;
+    s->is_group = is_group;
+    s->channel_hash = channel_hash;
+    memcpy(s->src_key, key, sizeof(key));
+    s->blob_type = blob_type;
+    s->total_len = total_len;
+    s->num_frags = num_frags;
+    s->num_recv = 0;
+    s->complete = false;
+    memset(s->recvd, 0, sizeof(s->recvd));
+  } else if (s->total_len != total_len) {
+    return NULL;   // inconsistent
+  }
+  s->last_activity = now;
+
+  if (s->complete || isBitSet(s->recvd, frag_idx)) {
+    _frags_dup++;   // eg. our STATUS was lost
+    return s;
+  }
+  memcpy(&s->data[offset], &data[hdr_len], frag_len);
+  setBit(s->recvd, frag_idx);
+  s->num_recv++;
+  _frags_recv++;
+
+  if (s->num_recv >= s->num_frags) {
+    s->complete = true;   // NOTE: keep session until it expires, so duplicates still get a STATUS
+    completed = true;
+    _blobs_recv++;
+  }
+  return s;
+}
+
+int BlobTransfer::writeStatus(const BlobInSession* s, uint8_t* dest) const {
+  uint16_t base = 0;
+  while (base < s->num_frags && isBitSet(s->recvd, base)) base++;
+
+  uint32_t bitmap = 0;
+  for (int k = 0; k < 32 && base + 1 + k < s->num_frags; k++) {
+    if (isBitSet(s->recvd, base + 1 + k)) bitmap |= (1UL << k);
+  }
+
+  int i = 0;
+  dest[i++] = FRAG_KIND_STATUS;
+  memcpy(&dest[i], &s->xfer_id, 2); i += 2;
+  memcpy(&dest[i], &base, 2); i += 2;
+  memcpy(&dest[i], &bitmap, 4); i += 4;
+  return i;
+}
+
+void BlobTransfer::expireIn(unsigned long now) {
+  for (int i = 0; i < BLOB_MAX_IN_SESSIONS; i++) {
+    if (_in[i].xfer_id && now - _in[i].last_activity > BLOB_RECV_TIMEOUT_MILLIS) {
+      _in[i].xfer_id = 0;
+    }
+  }
+}
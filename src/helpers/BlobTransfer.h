@@ -0,0 +1,144 @@
+#pragma once
+
+#include <Arduino.h>   // needed for PlatformIO
+#include <Mesh.h>
+
+#ifndef BLOB_MAX_SIZE
+  #if defined(ESP32) && defined(BOARD_HAS_PSRAM)
+    #define BLOB_MAX_SIZE    32768
+  #else
+    #define BLOB_MAX_SIZE     4096
+  #endif
+#endif
+
+#define BLOB_FRAG_SIZE        160   // data bytes per fragment. Peer: 1+2+2 + MAC + AES(8+160) = 181, group: 1+1 + MAC + AES(8+4+160) = 180
+#define BLOB_MAX_FRAGS        ((BLOB_MAX_SIZE + BLOB_FRAG_SIZE - 1) / BLOB_FRAG_SIZE)
+
+#ifndef BLOB_WINDOW_SIZE
+  #define BLOB_WINDOW_SIZE      4   // fragments sent before waiting for a STATUS
+#endif
+#define BLOB_MAX_OUT_SESSIONS   2
+#define BLOB_MAX_IN_SESSIONS    2
+#define BLOB_MAX_RETRIES        5   // consecutive STATUS timeouts, before giving up
+#define BLOB_RECV_TIMEOUT_MILLIS  60000   // reassembly buffers are released after this long idle
+
+// fragment header (first byte of decrypted fragment data)
+#define FRAG_KIND_DATA       0x00   // xfer_id(2), frag_idx(2), total_len(2), blob_type(1), [sender prefix(4) if group], data
+#define FRAG_KIND_STATUS     0x01   // xfer_id(2), base(2), bitmap(4)  -- base = num contiguous frags received
+#define FRAG_KIND_LINK_REQ   0x02   // xfer_id(2), sf(1), window_secs(1)  -- propose faster SF for this transfer
+#define FRAG_KIND_LINK_RESP  0x03   // xfer_id(2), sf(1)  -- sf = 0 means rejected
+#define FRAG_KIND_MASK       0x0F
+#define FRAG_FLAG_STATUS_REQ 0x80   // sender wants a STATUS reply
+
+#define FRAG_DATA_HDR_SIZE      8
+#define FRAG_GRP_PREFIX_SIZE    4
+
+#define BLOB_ENC_LEN(n)   (((n) + CIPHER_BLOCK_SIZE-1) / CIPHER_BLOCK_SIZE * CIPHER_BLOCK_SIZE)
+static_assert(1 + 2*PATH_HASH_SIZE + CIPHER_MAC_SIZE + BLOB_ENC_LEN(FRAG_DATA_HDR_SIZE + BLOB_FRAG_SIZE) <= MAX_PACKET_PAYLOAD, "peer fragment too big");
+static_assert(1 + PATH_HASH_SIZE + CIPHER_MAC_SIZE + BLOB_ENC_LEN(FRAG_DATA_HDR_SIZE + FRAG_GRP_PREFIX_SIZE + BLOB_FRAG_SIZE) <= MAX_PACKET_PAYLOAD, "group fragment too big");
+
+struct BlobOutSession {
+  uint16_t xfer_id;         // zero = unused
+  uint8_t blob_type;
+  bool is_group;
+  uint8_t dest_key[8];      // peer pub_key prefix (peer transfers)
+  mesh::GroupChannel channel;   // (group transfers)
+  uint8_t* data;
+  uint16_t total_len;
+  uint16_t num_frags;
+  uint16_t base;            // all frags before this are ACKed
+  uint16_t next_idx;        // where to continue scanning for un-ACKed frags (in current window)
+  uint16_t sent_hwm;        // frags below this have been sent at least once
+  uint8_t window_sent;
+  uint8_t retries;
+  bool awaiting_status;
+  unsigned long next_send;
+  unsigned long status_timeout;
+  unsigned long started;
+  uint32_t frags_sent;
+  uint8_t acked[(BLOB_MAX_FRAGS + 7) / 8];
+};
+
+struct BlobInSession {
+  uint16_t xfer_id;         // zero = unused
+  uint8_t blob_type;
+  bool is_group;
+  bool complete;
+  uint8_t src_key[8];       // peer pub_key prefix, or group sender prefix
+  uint8_t channel_hash;
+  uint8_t* data;
+  uint16_t total_len;
+  uint16_t num_frags;
+  uint16_t num_recv;
+  unsigned long last_activity;
+  uint8_t recvd[(BLOB_MAX_FRAGS + 7) / 8];
+};
+
+/**
+ * \brief  Fragmentation and reassembly of large blobs, sent as MULTIPART fragments.
+ *     Peer transfers are windowed, and the receiver replies to each window with a STATUS (cumulative base + bitmap),
+ *     so only missing fragments are re-sent (selective repeat). Group transfers are sent once, without STATUS.
+ *     This class just keeps the session state, the owning Mesh creates and sends the packets.
+ */
+class BlobTransfer {
+  BlobOutSession _out[BLOB_MAX_OUT_SESSIONS];
+  BlobInSession _in[BLOB_MAX_IN_SESSIONS];
+  uint16_t _next_xfer_id;
+
+  // stats
+  uint32_t _blobs_sent, _blobs_failed, _blobs_recv;
+  uint32_t _frags_sent, _frags_resent, _frags_recv, _frags_dup;
+  uint32_t _frags_busy;     // dropped, all reassembly buffers in use
+  uint32_t _last_goodput;   // bytes/sec, of last completed outbound transfer
+
+  static bool isBitSet(const uint8_t* bits, int i) { return (bits[i >> 3] & (1 << (i & 7))) != 0; }
+  static void setBit(uint8_t* bits, int i) { bits[i >> 3] |= (1 << (i & 7)); }
+  static uint8_t* allocBuffer();
+
+  BlobOutSession* allocOut(const uint8_t* data, size_t len, uint8_t blob_type, unsigned long now);
+
+public:
+  BlobTransfer();
+
+  void begin(uint16_t first_xfer_id) { _next_xfer_id = first_xfer_id; }   // should be random, so restarts don't re-use IDs
+
+  BlobOutSession* startPeer(const uint8_t* pub_key, uint8_t blob_type, const uint8_t* data, size_t len, unsigned long now);
+  BlobOutSession* startGroup(const mesh::GroupChannel& channel, uint8_t blob_type, const uint8_t* data, size_t len, unsigned long now);
+  BlobOutSession* getOut(int idx) { return &_out[idx]; }
+
+  /**
+   * \brief  fills 'dest' with the next fragment to send for given session (if any).
+   * \param  sender_prefix  own pub_key, for group fragments
+   * \returns  length of fragment data, or zero if nothing to send (yet)
+   */
+  int nextFragment(BlobOutSession* s, const uint8_t* sender_prefix, uint8_t* dest, unsigned long now, uint32_t status_timeout);
+  bool isOutComplete(const BlobOutSession* s) const;
+  void finishOut(BlobOutSession* s, bool success, unsigned long now);
+  bool onStatusTimeout(BlobOutSession* s);   // returns false if should give up
+
+  /**
+   * \brief  process a STATUS from peer
+   * \returns  the session it applies to, or NULL
+   */
+  BlobOutSession* onStatus(const uint8_t* pub_key, const uint8_t* data, size_t len);
+
+  /**
+   * \brief  process a DATA fragment
+   * \param  src_key  peer pub_key prefix, or NULL for group fragments (sender prefix is in fragment)
+   * \returns  the reassembly session, or NULL if fragment was rejected
+   */
+  BlobInSession* onData(const uint8_t* src_key, uint8_t channel_hash, const uint8_t* data, size_t len, unsigned long now, bool& completed);
+  int writeStatus(const BlobInSession* s, uint8_t* dest) const;
+  void releaseIn(BlobInSession* s) { s->xfer_id = 0; }
+  void expireIn(unsigned long now);
+
+  uint32_t getNumBlobsSent() const { return _blobs_sent; }
+  uint32_t getNumBlobsFailed() const { return _blobs_failed; }
+  uint32_t getNumBlobsRecv() const { return _blobs_recv; }
+  uint32_t getNumFragsSent() const { return _frags_sent; }
+  uint32_t getNumFragsResent() const { return _frags_resent; }
+  uint32_t getNumFragsRecv() const { return _frags_recv; }
+  uint32_t getNumFragsDup() const { return _frags_dup; }
+  uint32_t getNumFragsBusy() const { return _frags_busy; }
+  uint32_t getLastGoodput() const { return _last_goodput; }
+};
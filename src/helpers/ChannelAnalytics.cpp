@@ -0,0 +1,94 @@
+#include "ChannelAnalytics.h"
+
+#define BUCKET_MILLIS      60000UL
+#define INVALID_MINUTE     0xFFFFFFFF
+
+ChannelAnalytics::ChannelAnalytics() {
+  begin(0);
+}
+
+void ChannelAnalytics::begin(unsigned long now) {
+  memset(_buckets, 0, sizeof(_buckets));
+  for (int i = 0; i < CHAN_HISTORY_MINUTES; i++) _buckets[i].minute = INVALID_MINUTE;
+  _started = now;
+  _busy_x256 = 0;
+}
+
+ChannelBucket* ChannelAnalytics::current(unsigned long now) {
+  uint32_t minute = now / BUCKET_MILLIS;
+  ChannelBucket* b = &_buckets[minute % CHAN_HISTORY_MINUTES];
+  if (b->minute != minute) {   // stale bucket from an earlier hour, recycle it
+    memset(b, 0, sizeof(*b));
+    b->minute = minute;
+  }
+  return b;
+}
+
+void ChannelAnalytics::addRSSISample(int16_t rssi, bool busy, unsigned long now) {
+  ChannelBucket* b = current(now);
+  b->samples++;
+  if (busy) b->busy_samples++;
+
+  int bin = (rssi - CHAN_RSSI_BIN_MIN) / CHAN_RSSI_BIN_WIDTH;
+  if (bin < 0) bin = 0;
+  if (bin >= CHAN_RSSI_BINS) bin = CHAN_RSSI_BINS - 1;
+  b->rssi_hist[bin]++;
+
+  _busy_x256 -= _busy_x256 >> 6;   // EWMA, time constant of ~64 samples
+  if (busy) _busy_x256 += 25600 >> 6;
+}
+
+void ChannelAnalytics::addLBTCheck(bool busy, unsigned long now) {
+  ChannelBucket* b = current(now);
+  b->lbt_checks++;
+  if (busy) b->lbt_busy++;
+}
+
+void ChannelAnalytics::addRxPacket(uint32_t airtime, unsigned long now) {
+  ChannelBucket* b = current(now);
+  b->rx_good++;
+  b->rx_airtime += airtime;
+}
+
+void ChannelAnalytics::getStats(int minutes, ChannelStats& dest, unsigned long now) const {
+  memset(&dest, 0, sizeof(dest));
+  if (minutes < 1) minutes = 1;
+  if (minutes > CHAN_HISTORY_MINUTES) minutes = CHAN_HISTORY_MINUTES;
+
+  uint32_t cur_minute = now / BUCKET_MILLIS;
+  uint32_t hist[CHAN_RSSI_BINS];
+  memset(hist, 0, sizeof(hist));
+
+  for (int i = 0; i < minutes; i++) {
+    if (cur_minute < (uint32_t)i) break;
+    const ChannelBucket* b = &_buckets[(cur_minute - i) % CHAN_HISTORY_MINUTES];
+    if (b->minute != cur_minute - i) continue;   // no activity recorded in that minute
+
+    dest.samples += b->samples;
+    dest.busy_samples += b->busy_samples;
+    dest.lbt_checks += b->lbt_checks;
+    dest.lbt_busy += b->lbt_busy;
+    dest.rx_good += b->rx_good;
+    dest.rx_errors += b->rx_errors;
+    dest.rx_detects += b->rx_detects;
+    dest.rx_airtime += b->rx_airtime;
+    dest.tx_airtime += b->tx_airtime;
+    for (int k = 0; k < CHAN_RSSI_BINS; k++) hist[k] += b->rssi_hist[k];
+  }
+
+  dest.span_millis = (minutes - 1) * BUCKET_MILLIS + (now % BUCKET_MILLIS);
+  if (dest.span_millis > now - _started) dest.span_millis = now - _started;
+
+  // percentiles, from the histogram
+  uint32_t p10 = (dest.samples * 10 + 99) / 100, p50 = (dest.samples * 50 + 99) / 100, p90 = (dest.samples * 90 + 99) / 100;
+  uint32_t cumulative = 0;
+  dest.rssi_p10 = dest.rssi_p50 = dest.rssi_p90 = 0;
+  for (int k = 0; k < CHAN_RSSI_BINS && dest.samples > 0; k++) {
+    uint32_t prev = cumulative;
+    cumulative += hist[k];
+    int16_t centre = CHAN_RSSI_BIN_MIN + k * CHAN_RSSI_BIN_WIDTH + CHAN_RSSI_BIN_WIDTH / 2;
+    if (prev < p10 && cumulative >= p10) dest.rssi_p10 = centre;
+    if (prev < p50 && cumulative >= p50) dest.rssi_p50 = centre;
+    if (prev < p90 && cumulative >= p90) dest.rssi_p90 = centre;
+  }
+}
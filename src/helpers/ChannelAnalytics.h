@@ -0,0 +1,83 @@
+#pragma once
+
+#include <Arduino.h>   // needed for PlatformIO
+
+#ifndef CHAN_HISTORY_MINUTES
+  #if defined(ESP32)
+    #define CHAN_HISTORY_MINUTES   60
+  #else
+    #define CHAN_HISTORY_MINUTES   15
+  #endif
+#endif
+#define CHAN_SAMPLE_INTERVAL_MILLIS  100
+#define CHAN_RSSI_BINS         16
+#define CHAN_RSSI_BIN_MIN    -128   // dBm, lower edge of first bin (anything below is counted in it)
+#define CHAN_RSSI_BIN_WIDTH     4   // dB
+
+struct ChannelBucket {
+  uint32_t minute;          // (millis / 60000) this bucket is for
+  uint16_t samples, busy_samples;
+  uint16_t lbt_checks, lbt_busy;
+  uint16_t rx_good, rx_errors, rx_detects;
+  uint32_t rx_airtime, tx_airtime;   // millis
+  uint16_t rssi_hist[CHAN_RSSI_BINS];
+};
+
+struct ChannelStats {
+  uint32_t span_millis;     // time actually covered by the window
+  uint32_t samples, busy_samples;
+  uint32_t lbt_checks, lbt_busy;
+  uint32_t rx_good, rx_errors, rx_detects;
+  uint32_t rx_airtime, tx_airtime;
+  int16_t rssi_p10, rssi_p50, rssi_p90;   // dBm (bin centres)
+
+  static uint8_t pct(uint32_t n, uint32_t d) { return d ? (n * 100UL + d/2) / d : 0; }
+
+  uint8_t busyPercent() const { return pct(busy_samples, samples); }
+  uint8_t lbtBusyPercent() const { return pct(lbt_busy, lbt_checks); }
+  uint8_t rxAirPercent() const { return pct(rx_airtime, span_millis); }
+  uint8_t txAirPercent() const { return pct(tx_airtime, span_millis); }
+  /**
+   * \returns  estimate of receptions lost to collisions: CRC errors, plus preambles detected that never became a packet
+   */
+  uint8_t collisionPercent() const {
+    uint32_t lost = rx_errors;
+    if (rx_detects > rx_good + rx_errors) lost += rx_detects - rx_good - rx_errors;
+    uint32_t total = rx_good + lost;
+    return pct(lost, total);
+  }
+};
+
+/**
+ * \brief  Rolling channel statistics (RSSI histogram, busy ratio, LBT busy ratio, airtime shares, collision estimate),
+ *      kept in per-minute buckets so they can be summed over any window up to CHAN_HISTORY_MINUTES.
+ */
+class ChannelAnalytics {
+  ChannelBucket _buckets[CHAN_HISTORY_MINUTES];
+  unsigned long _started;
+  uint16_t _busy_x256;        // smoothed busy ratio (x256 %), for quick backoff decisions
+
+  ChannelBucket* current(unsigned long now);
+
+public:
+  ChannelAnalytics();
+
+  void begin(unsigned long now);
+
+  void addRSSISample(int16_t rssi, bool busy, unsigned long now);
+  void addLBTCheck(bool busy, unsigned long now);
+  void addRxDetect(unsigned long now) { current(now)->rx_detects++; }
+  void addRxPacket(uint32_t airtime, unsigned long now);
+  void addRxError(unsigned long now) { current(now)->rx_errors++; }
+  void addTxAirtime(uint32_t airtime, unsigned long now) { current(now)->tx_airtime += airtime; }
+
+  /**
+   * \brief  sums the last 'minutes' (including the current, partial minute)
+   */
+  void getStats(int minutes, ChannelStats& dest, unsigned long now) const;
+
+  /**
+   * \returns  recent channel congestion 0..100, from the last ~64 RSSI samples (smoothed)
+   */
+  uint8_t getBusyPercent() const { return _busy_x256 >> 8; }
+};
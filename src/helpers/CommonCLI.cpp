@@ -344,6 +344,8 @@ void CommonCLI::handleCommand(uint32_t sender_timestamp, const char* command, ch
                 "rs232"
 #elif WITH_ESPNOW_BRIDGE
                 "espnow"
+#elif defined(WITH_IP_BRIDGE)
+                "ip"
 #else
                 "none"
 #endif
@@ -363,6 +365,8 @@ void CommonCLI::handleCommand(uint32_t sender_timestamp, const char* command, ch
 #ifdef WITH_ESPNOW_BRIDGE
       } else if (memcmp(config, "bridge.channel", 14) == 0) {
         sprintf(reply, "> %d", (uint32_t)_prefs->bridge_channel);
+#endif
+#if defined(WITH_ESPNOW_BRIDGE) || defined(WITH_IP_BRIDGE)
       } else if (memcmp(config, "bridge.secret", 13) == 0) {
         sprintf(reply, "> %s", _prefs->bridge_secret);
 #endif
@@ -601,6 +605,8 @@ void CommonCLI::handleCommand(uint32_t sender_timestamp, const char* command, ch
         } else {
           strcpy(reply, "Error: channel must be between 1-14");
         }
+#endif
+#if defined(WITH_ESPNOW_BRIDGE) || defined(WITH_IP_BRIDGE)
       } else if (memcmp(config, "bridge.secret ", 14) == 0) {
         StrHelper::strncpy(_prefs->bridge_secret, &config[14], sizeof(_prefs->bridge_secret));
         _callbacks->restartBridge();
@@ -12,6 +12,10 @@ struct ContactInfo {
   uint8_t flags;
   uint8_t out_path_len;   // encoded: bits[7:6]=mode, bits[5:0]=hops. OUT_PATH_UNKNOWN=no path
   mutable bool shared_secret_valid; // flag to indicate if shared_secret has been calculated
+  uint8_t peer_hash_size;   // runtime only (NOT persisted), PEER_HASH_SIZE_V2 once they've sent us PAYLOAD_VER_2
+  bool wide_hash_failed;    // runtime only, a PAYLOAD_VER_2 send got no reply, so stick to 1-byte hashes
+  unsigned long wide_hash_deadline;   // runtime only, reply due to our PAYLOAD_VER_2 send (0 = none outstanding)
+  uint16_t peer_feat1;      // runtime only, ADV_FEAT1_* bits from their last advert
   uint8_t out_path[MAX_PATH_SIZE];
   uint32_t last_advert_timestamp;   // by THEIR clock
   uint32_t lastmod;  // by OUR clock
@@ -0,0 +1,186 @@
+#include "ContactRouteCache.h"
+
+static bool isZeroKey(const uint8_t* key) {
+  for (int i = 0; i < 8; i++) {
+    if (key[i]) return false;
+  }
+  return true;
+}
+
+static void clearCandidates(ContactRoutes* c) {
+  memset(c, 0, sizeof(*c));
+  for (int i = 0; i < MAX_ROUTES_PER_CONTACT; i++) {
+    c->routes[i].path_len = OUT_PATH_UNKNOWN;
+  }
+}
+
+void ContactRouteCache::begin() {
+  if (_table != NULL) return;  // already initialized
+#if defined(ESP32) && defined(BOARD_HAS_PSRAM)
+  _table = (ContactRoutes *) ps_calloc(ROUTE_CACHE_SIZE, sizeof(ContactRoutes));
+#else
+  _table = new ContactRoutes[ROUTE_CACHE_SIZE];
+#endif
+  if (_table == NULL) return;
+
+  for (int i = 0; i < ROUTE_CACHE_SIZE; i++) {
+    clearCandidates(&_table[i]);
+  }
+}
+
+ContactRoutes* ContactRouteCache::find(const uint8_t* pub_key) const {
+  if (_table == NULL) return NULL;
+
+  for (int i = 0; i < ROUTE_CACHE_SIZE; i++) {
+    if (memcmp(_table[i].pub_key, pub_key, sizeof(_table[i].pub_key)) == 0) return &_table[i];
+  }
+  return NULL;  // not found
+}
+
+ContactRoutes* ContactRouteCache::findOrAlloc(const uint8_t* pub_key, unsigned long now) {
+  auto c = find(pub_key);
+  if (c || _table == NULL) return c;
+
+  c = &_table[0];   // find an unused slot, or evict the least recently used contact
+  for (int i = 0; i < ROUTE_CACHE_SIZE; i++) {
+    if (isZeroKey(_table[i].pub_key)) { c = &_table[i]; break; }
+    if ((long)(_table[i].last_used - c->last_used) < 0) c = &_table[i];
+  }
+  clearCandidates(c);
+  memcpy(c->pub_key, pub_key, sizeof(c->pub_key));
+  c->last_used = now;
+  return c;
+}
+
+RouteCandidate* ContactRouteCache::findCandidate(ContactRoutes* c, const uint8_t* path, uint8_t path_len) const {
+  for (int i = 0; i < MAX_ROUTES_PER_CONTACT; i++) {
+    auto r = &c->routes[i];
+    if (r->path_len == path_len && memcmp(r->path, path, mesh::Packet::getPathByteLenFor(path_len)) == 0) return r;
+  }
+  return NULL;  // not found
+}
+
+uint32_t ContactRouteCache::calcScore(const RouteCandidate& r) {
+  uint32_t hops = r.path_len & 63;
+  uint32_t score = r.avg_latency ? r.avg_latency : ROUTE_EST_HOP_MILLIS * (hops + 1);
+  score += r.fails * ROUTE_FAIL_PENALTY;
+  if (r.source == ROUTE_SRC_ADVERT && r.num_delivered == 0) score += ROUTE_ADVERT_PENALTY;
+  return score;   // lower is better
+}
+
+void ContactRouteCache::addPath(const uint8_t* pub_key, const uint8_t* path, uint8_t path_len, uint8_t source, unsigned long now) {
+  if (path_len == OUT_PATH_UNKNOWN || !mesh::Packet::isValidPathLen(path_len)) return;
+
+  auto c = findOrAlloc(pub_key, now);
+  if (c == NULL) return;
+
+  c->last_used = now;
+  auto r = findCandidate(c, path, path_len);
+  if (r) {   // already known, just refresh
+    if (source == ROUTE_SRC_PATH || source == ROUTE_SRC_TRACE) {
+      r->source = source;   // now verified
+      r->fails = 0;
+    }
+    r->learnt = now;
+    return;
+  }
+
+  r = &c->routes[0];   // find unused slot, or evict the worst scoring candidate
+  uint32_t worst = 0;
+  for (int i = 0; i < MAX_ROUTES_PER_CONTACT; i++) {
+    if (c->routes[i].path_len == OUT_PATH_UNKNOWN) { r = &c->routes[i]; break; }
+
+    uint32_t s = calcScore(c->routes[i]);
+    if (s >= worst) { worst = s; r = &c->routes[i]; }
+  }
+  memset(r, 0, sizeof(*r));
+  r->path_len = mesh::Packet::copyPath(r->path, path, path_len);
+  r->source = source;
+  r->learnt = now;
+}
+
+uint8_t ContactRouteCache::getBestPath(const uint8_t* pub_key, uint8_t* path, unsigned long now) const {
+  auto c = find(pub_key);
+  if (c == NULL) return OUT_PATH_UNKNOWN;
+
+  const RouteCandidate* best = NULL;
+  uint32_t best_score = 0;
+  for (int i = 0; i < MAX_ROUTES_PER_CONTACT; i++) {
+    auto r = &c->routes[i];
+    if (r->path_len == OUT_PATH_UNKNOWN || r->fails >= ROUTE_MAX_FAILS) continue;
+    if (now - r->learnt > ROUTE_EXPIRY_MILLIS) continue;   // stale
+
+    uint32_t s = calcScore(*r);
+    if (best == NULL || s < best_score || (s == best_score && (long)(r->learnt - best->learnt) > 0)) {  // ties go to newest
+      best = r;
+      best_score = s;
+    }
+  }
+  if (best == NULL) return OUT_PATH_UNKNOWN;
+
+  return mesh::Packet::copyPath(path, best->path, best->path_len);
+}
+
+void ContactRouteCache::onDelivered(const uint8_t* pub_key, const uint8_t* path, uint8_t path_len, uint32_t latency_millis, unsigned long now) {
+  auto c = find(pub_key);
+  if (c == NULL) return;
+
+  auto r = findCandidate(c, path, path_len);
+  if (r == NULL) return;
+
+  if (latency_millis > 0xFFFF) latency_millis = 0xFFFF;
+  if (r->avg_latency == 0) {
+    r->avg_latency = latency_millis;
+  } else {
+    r->avg_latency = (r->avg_latency * 3 + latency_millis) / 4;   // smoothed
+  }
+  if (r->num_delivered < 0xFFFF) r->num_delivered++;
+  r->fails = 0;
+  r->learnt = now;
+  c->last_used = now;
+}
+
+void ContactRouteCache::onFailed(const uint8_t* pub_key, const uint8_t* path, uint8_t path_len) {
+  auto c = find(pub_key);
+  if (c == NULL) return;
+
+  auto r = findCandidate(c, path, path_len);
+  if (r && r->fails < 0xFF) r->fails++;
+}
+
+void ContactRouteCache::remove(const uint8_t* pub_key) {
+  auto c = find(pub_key);
+  if (c) clearCandidates(c);
+}
+
+void ContactRouteCache::removePath(const uint8_t* pub_key, const uint8_t* path, uint8_t path_len) {
+  auto c = find(pub_key);
+  if (c == NULL) return;
+
+  auto r = findCandidate(c, path, path_len);
+  if (r) {
+    memset(r, 0, sizeof(*r));
+    r->path_len = OUT_PATH_UNKNOWN;
+  }
+}
+
+int ContactRouteCache::getNumContacts() const {
+  if (_table == NULL) return 0;
+
+  int n = 0;
+  for (int i = 0; i < ROUTE_CACHE_SIZE; i++) {
+    if (!isZeroKey(_table[i].pub_key)) n++;
+  }
+  return n;
+}
+
+int ContactRouteCache::getNumCandidates(const uint8_t* pub_key) const {
+  auto c = find(pub_key);
+  if (c == NULL) return 0;
+
+  int n = 0;
+  for (int i = 0; i < MAX_ROUTES_PER_CONTACT; i++) {
+    if (c->routes[i].path_len != OUT_PATH_UNKNOWN && c->routes[i].fails < ROUTE_MAX_FAILS) n++;
+  }
+  return n;
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <Arduino.h>   // needed for PlatformIO
+#include <Mesh.h>
+
+#ifndef OUT_PATH_UNKNOWN
+  #define OUT_PATH_UNKNOWN  0xFF
+#endif
+
+#ifndef ROUTE_CACHE_SIZE   // number of contacts with cached routes (~240 bytes each)
+  #if defined(ESP32) && defined(BOARD_HAS_PSRAM)
+    #define ROUTE_CACHE_SIZE       32
+  #elif defined(NRF52_PLATFORM) || defined(STM32_PLATFORM)
+    #define ROUTE_CACHE_SIZE        6
+  #else
+    #define ROUTE_CACHE_SIZE       12
+  #endif
+#endif
+
+#ifndef ROUTE_MAX_PROBES
+  #define ROUTE_MAX_PROBES          4   // DIRECT sends being timed at once
+#endif
+
+#ifndef MAX_ROUTES_PER_CONTACT
+  #define MAX_ROUTES_PER_CONTACT    3
+#endif
+
+#define ROUTE_SRC_PATH      1   // out_path from a PATH return (peer verified)
+#define ROUTE_SRC_ADVERT    2   // reversed flood path of an advert (assumes symmetric links)
+#define ROUTE_SRC_TRACE     3   // outbound half of a round-trip trace
+
+#define ROUTE_MAX_FAILS          2   // consecutive failures before a candidate is unusable
+#define ROUTE_EST_HOP_MILLIS  1000   // assumed ACK latency per hop, until measured
+#define ROUTE_FAIL_PENALTY    4000   // score penalty per consecutive failure
+#define ROUTE_ADVERT_PENALTY  2000   // score penalty for unverified (advert) routes
+#define ROUTE_EXPIRY_MILLIS   (12UL*60*60*1000)   // forget candidates not refreshed for this long
+
+struct RouteCandidate {
+  uint8_t path_len;        // encoded (mode + hops), OUT_PATH_UNKNOWN = unused slot
+  uint8_t source;          // one of ROUTE_SRC_*
+  uint8_t fails;           // consecutive failures
+  uint16_t avg_latency;    // smoothed ACK round-trip (millis), 0 = not yet measured
+  uint16_t num_delivered;
+  unsigned long learnt;    // millis() when learnt, or last delivered
+  uint8_t path[MAX_PATH_SIZE];
+};
+
+struct RouteProbe {
+  uint32_t ack;            // expected ACK, 0 = unused slot
+  unsigned long sent;
+  unsigned long timeout;   // millis() when considered failed
+  uint8_t pub_key[8];
+  uint8_t path_len;
+  uint8_t path[MAX_PATH_SIZE];
+};
+
+struct ContactRoutes {
+  uint8_t pub_key[8];   // prefix, zeroes = unused
+  unsigned long last_used;
+  RouteCandidate routes[MAX_ROUTES_PER_CONTACT];
+};
+
+/**
+ * \brief  Several candidate out_paths per contact, scored by hop count, measured ACK latency and failure history.
+ *     The best candidate becomes the contact's active out_path, and failed candidates are skipped in favour of the next best.
+ */
+class ContactRouteCache {
+  ContactRoutes* _table;
+  int _num_failovers;
+
+  ContactRoutes* find(const uint8_t* pub_key) const;
+  ContactRoutes* findOrAlloc(const uint8_t* pub_key, unsigned long now);
+  RouteCandidate* findCandidate(ContactRoutes* c, const uint8_t* path, uint8_t path_len) const;
+
+public:
+  ContactRouteCache() { _table = NULL; _num_failovers = 0; }
+
+  void begin();   // allocates table (PSRAM where available)
+  bool isReady() const { return _table != NULL; }
+
+  static uint32_t calcScore(const RouteCandidate& r);
+
+  /**
+   * \brief  add, or refresh, a candidate out_path. (evicts the worst candidate if full)
+   */
+  void addPath(const uint8_t* pub_key, const uint8_t* path, uint8_t path_len, uint8_t source, unsigned long now);
+
+  /**
+   * \brief  copy the best usable candidate into 'path'
+   * \returns  the encoded path_len, or OUT_PATH_UNKNOWN if none usable
+   */
+  uint8_t getBestPath(const uint8_t* pub_key, uint8_t* path, unsigned long now) const;
+
+  void onDelivered(const uint8_t* pub_key, const uint8_t* path, uint8_t path_len, uint32_t latency_millis, unsigned long now);
+  void onFailed(const uint8_t* pub_key, const uint8_t* path, uint8_t path_len);
+  void remove(const uint8_t* pub_key);
+
+  /**
+   * \brief  forget just the one candidate, eg. the active out_path after it was reset. Other candidates are kept.
+   */
+  void removePath(const uint8_t* pub_key, const uint8_t* path, uint8_t path_len);
+
+  int getNumCandidates(const uint8_t* pub_key) const;
+  int getNumContacts() const;
+  int getNumFailovers() const { return _num_failovers; }
+  void countFailover() { _num_failovers++; }
+};
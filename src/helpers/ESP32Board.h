@@ -57,7 +57,7 @@ public:
     return raw / 4;
   }
 
-  void enterLightSleep(uint32_t secs) {
+  uint8_t enterLightSleepMillis(uint32_t ms) {
 #if defined(CONFIG_IDF_TARGET_ESP32S3) && defined(P_LORA_DIO_1) // Supported ESP32 variants
     if (rtc_gpio_is_valid_gpio((gpio_num_t)P_LORA_DIO_1)) { // Only enter sleep mode if P_LORA_DIO_1 is RTC pin
       esp_sleep_pd_config(ESP_PD_DOMAIN_RTC_PERIPH, ESP_PD_OPTION_ON);
@@ -70,25 +70,44 @@ public:
       esp_sleep_enable_gpio_wakeup();
 #endif
 
-      if (secs > 0) {
-        esp_sleep_enable_timer_wakeup(secs * 1000000ULL); // Timer wake (microseconds)
+      if (ms > 0) {
+        esp_sleep_enable_timer_wakeup(ms * 1000ULL); // Timer wake (microseconds)
+      } else {
+        esp_sleep_disable_wakeup_source(ESP_SLEEP_WAKEUP_TIMER); // left over from a previous sleep
       }
 
       esp_light_sleep_start(); // CPU halts here, resumes on wake
+
+      switch (esp_sleep_get_wakeup_cause()) {
+        case ESP_SLEEP_WAKEUP_TIMER: return BD_WAKE_TIMER;
+        case ESP_SLEEP_WAKEUP_EXT1:  return BD_WAKE_RADIO;
+        default:                     return BD_WAKE_OTHER;
+      }
     }
 #endif
+    return BD_WAKE_NONE;
   }
 
-  void sleep(uint32_t secs) override {
-    // To check for WiFi status to see if there is active OTA
+  void enterLightSleep(uint32_t secs) {
+    enterLightSleepMillis(secs * 1000);
+  }
+
+  // To check for WiFi status to see if there is active OTA
+  bool canLightSleep() {
     wifi_mode_t mode;
-    esp_err_t err = esp_wifi_get_mode(&mode);
-    
-    if (err != ESP_OK) {          // WiFi is off ~ No active OTA, safe to go to sleep
+    return esp_wifi_get_mode(&mode) != ESP_OK;   // WiFi is off ~ No active OTA, safe to go to sleep
+  }
+
+  void sleep(uint32_t secs) override {
+    if (canLightSleep()) {
       enterLightSleep(secs);      // To wake up after "secs" seconds or when receiving a LoRa packet
     }
   }
 
+  uint8_t sleepMillis(uint32_t ms) override {
+    return canLightSleep() ? enterLightSleepMillis(ms) : BD_WAKE_NONE;
+  }
+
   uint8_t getStartupReason() const override { return startup_reason; }
 
 #if defined(P_LORA_TX_LED)
@@ -0,0 +1,130 @@
+#include "IdleScheduler.h"
+#include <Dispatcher.h>
+
+IdleScheduler idleScheduler;
+
+static const uint32_t hist_limits[IDLE_HIST_BUCKETS - 1] = { 10, 100, 1000, 10000, 60000 };
+
+static uint8_t pct(uint32_t n, uint32_t d) { return d ? (n * 100ULL + d/2) / d : 0; }
+
+IdleScheduler::IdleScheduler() {
+  _deadline = IDLE_NO_DEADLINE;
+  _cause = _last_wake = IDLE_WAKE_OTHER;
+#if defined(ESP32)
+  _task = NULL;
+#endif
+  resetStats();
+}
+
+void IdleScheduler::begin() {
+#if defined(ESP32)
+  _task = xTaskGetCurrentTaskHandle();
+#endif
+  resetStats();
+}
+
+void IdleScheduler::wake() {
+#if defined(ESP32)
+  if (_task) {
+    _cause = IDLE_WAKE_OTHER;
+    xTaskNotifyGive(_task);
+  }
+#endif
+}
+
+void IdleScheduler::radioWake(void* ctx) {
+#if defined(ESP32)
+  auto self = (IdleScheduler *) ctx;
+  if (self->_task) {
+    self->_cause = IDLE_WAKE_RADIO;
+    xTaskNotifyGive(self->_task);
+  }
+#endif
+}
+
+uint32_t IdleScheduler::takeDeadline(uint32_t max_ms) {
+  uint32_t t = _deadline < max_ms ? _deadline : max_ms;
+  _deadline = IDLE_NO_DEADLINE;   // next pass registers afresh
+  return t;
+}
+
+uint32_t IdleScheduler::block(uint32_t ms) {
+#if defined(ESP32)
+  TickType_t ticks = pdMS_TO_TICKS(ms);
+  if (ticks == 0) ticks = 1;
+
+  unsigned long start = millis();
+  uint32_t notified = ulTaskNotifyTake(pdTRUE, ticks);   // a wake() since the last wait returns at once
+  uint32_t waited = millis() - start;
+  record(waited, notified ? _cause : IDLE_WAKE_DEADLINE, false);
+  return waited;
+#else
+  return 0;
+#endif
+}
+
+uint32_t IdleScheduler::wait(uint32_t max_ms) {
+  return block(takeDeadline(max_ms));
+}
+
+uint32_t IdleScheduler::sleep(mesh::MainBoard& board, uint32_t max_ms, uint32_t wait_ms) {
+  uint32_t t = takeDeadline(max_ms);
+  if (t < IDLE_MIN_SLEEP_MS) return block(t);
+
+  unsigned long start = millis();
+  uint8_t woke = board.sleepMillis(t);
+  if (woke == BD_WAKE_NONE) return block(t < wait_ms ? t : wait_ms);   // board can't (or mustn't, eg. WiFi on) sleep: caller's usual wait
+  uint32_t slept = millis() - start;
+
+#if defined(ESP32)
+  ulTaskNotifyTake(pdTRUE, 0);   // Rx task ran on wake, the caller is about to poll anyway
+#endif
+  record(slept, woke == BD_WAKE_TIMER ? IDLE_WAKE_DEADLINE : (woke == BD_WAKE_RADIO ? IDLE_WAKE_RADIO : IDLE_WAKE_OTHER), true);
+  return slept;
+}
+
+void IdleScheduler::record(uint32_t ms, uint8_t cause, bool asleep) {
+  if (asleep) {
+    _stats.asleep_ms += ms;
+  } else {
+    _stats.waiting_ms += ms;
+  }
+  _last_wake = cause < IDLE_NUM_WAKES ? cause : IDLE_WAKE_OTHER;
+  _stats.naps++;
+  _stats.wakes[_last_wake]++;
+
+  int b = 0;
+  while (b < IDLE_HIST_BUCKETS - 1 && ms >= hist_limits[b]) b++;
+  _stats.hist[b]++;
+}
+
+void IdleScheduler::resetStats() {
+  memset(&_stats, 0, sizeof(_stats));
+  _stats.started = millis();
+}
+
+void IdleScheduler::formatStats(char* dest, size_t sz) const {
+  uint32_t up = millis() - _stats.started;
+  uint32_t idle = _stats.asleep_ms + _stats.waiting_ms;
+  uint32_t awake = up > idle ? up - idle : 0;
+  snprintf(dest, sz, "%lus awake:%u%% sleep:%u%% wait:%u%% wake t/r/o:%lu/%lu/%lu len:%lu/%lu/%lu/%lu/%lu/%lu",
+           (unsigned long) (up / 1000), (uint32_t) pct(awake, up), (uint32_t) pct(_stats.asleep_ms, up),
+           (uint32_t) pct(_stats.waiting_ms, up), (unsigned long) _stats.wakes[IDLE_WAKE_DEADLINE],
+           (unsigned long) _stats.wakes[IDLE_WAKE_RADIO], (unsigned long) _stats.wakes[IDLE_WAKE_OTHER],
+           (unsigned long) _stats.hist[0], (unsigned long) _stats.hist[1], (unsigned long) _stats.hist[2],
+           (unsigned long) _stats.hist[3], (unsigned long) _stats.hist[4], (unsigned long) _stats.hist[5]);
+}
+
+void IdleScheduler::print(Print& out) const {
+  uint32_t up = millis() - _stats.started;
+  uint32_t idle = _stats.asleep_ms + _stats.waiting_ms;
+  uint32_t awake = up > idle ? up - idle : 0;
+  out.printf("Idle: %lus, awake %u%%, light sleep %u%%, waiting %u%% (%lu naps)\n",
+             (unsigned long) (up / 1000), (uint32_t) pct(awake, up), (uint32_t) pct(_stats.asleep_ms, up),
+             (uint32_t) pct(_stats.waiting_ms, up), (unsigned long) _stats.naps);
+  out.printf("  wakes: deadline %lu, radio %lu, other %lu\n", (unsigned long) _stats.wakes[IDLE_WAKE_DEADLINE],
+             (unsigned long) _stats.wakes[IDLE_WAKE_RADIO], (unsigned long) _stats.wakes[IDLE_WAKE_OTHER]);
+  out.printf("  <10ms %lu | <100ms %lu | <1s %lu | <10s %lu | <60s %lu | 60s+ %lu\n",
+             (unsigned long) _stats.hist[0], (unsigned long) _stats.hist[1], (unsigned long) _stats.hist[2],
+             (unsigned long) _stats.hist[3], (unsigned long) _stats.hist[4], (unsigned long) _stats.hist[5]);
+}
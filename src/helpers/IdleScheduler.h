@@ -0,0 +1,97 @@
+#pragma once
+
+#include <Arduino.h>   // needed for PlatformIO
+#include <MeshCore.h>
+
+#if defined(ESP32)
+  #include <freertos/FreeRTOS.h>
+  #include <freertos/task.h>
+#endif
+
+#ifndef IDLE_MIN_SLEEP_MS
+  #define IDLE_MIN_SLEEP_MS    20   // shorter than this isn't worth a light sleep, just wait
+#endif
+#define IDLE_HIST_BUCKETS       6   // idle period lengths: <10ms, <100ms, <1s, <10s, <60s, longer
+
+enum IdleWake : uint8_t {
+  IDLE_WAKE_DEADLINE = 0,   // timed out: something registered is due
+  IDLE_WAKE_RADIO,          // radio interrupt (packet received, or Tx done)
+  IDLE_WAKE_OTHER,          // wake(), button, etc
+  IDLE_NUM_WAKES
+};
+
+struct IdleStats {
+  unsigned long started;     // millis() when stats were reset
+  uint32_t asleep_ms;        // in light sleep
+  uint32_t waiting_ms;       // blocked in wait() (CPU idle, clocks running)
+  uint32_t naps;
+  uint32_t hist[IDLE_HIST_BUCKETS];
+  uint32_t wakes[IDLE_NUM_WAKES];
+};
+
+/**
+ * \brief  Lets a loop idle until its earliest deadline instead of spinning. Each pass, subsystems
+ *      register how long until they next have work (deadline()), then the loop calls wait() (task
+ *      blocks, FreeRTOS idles the core) or sleep() (board light sleep). Interrupts end the idle
+ *      period early via wake() / radioWake(). Keeps a histogram of idle periods and wake causes.
+ *      Only one task may wait on a scheduler. Without FreeRTOS (non-ESP32), wait() doesn't block.
+ */
+class IdleScheduler {
+  uint32_t _deadline;
+  volatile uint8_t _cause;   // of the pending notify
+  uint8_t _last_wake;
+  IdleStats _stats;
+#if defined(ESP32)
+  TaskHandle_t _task;
+#endif
+
+  uint32_t takeDeadline(uint32_t max_ms);
+  uint32_t block(uint32_t ms);
+  void record(uint32_t ms, uint8_t cause, bool asleep);
+
+public:
+  IdleScheduler();
+
+  /**
+   * \brief  the calling task is the one that will wait()
+   */
+  void begin();
+
+  /**
+   * \brief  something is due in 'ms' (0 = now) -- the earliest registered this pass wins
+   */
+  void deadline(uint32_t ms) { if (ms < _deadline) _deadline = ms; }
+
+  void wake();
+  static void radioWake(void* ctx);   // for RadioLibWrapper::setWakeHook()
+
+  /**
+   * \brief  blocks until the earliest deadline, 'max_ms', or wake(). Always yields at least one tick.
+   * \returns  millis spent waiting
+   */
+  uint32_t wait(uint32_t max_ms);
+
+  /**
+   * \brief  light sleeps until the earliest deadline or 'max_ms' (radio packet wakes early), or
+   *        just wait()s if that's too short. If the board can't sleep, waits at most 'wait_ms', so
+   *        the caller keeps polling (serial CLI, UI) instead of blocking for the whole sleep.
+   * \returns  millis spent idle
+   */
+  uint32_t sleep(mesh::MainBoard& board, uint32_t max_ms, uint32_t wait_ms);
+
+  /**
+   * \returns  IdleWake that ended the last wait() / sleep()
+   */
+  uint8_t getLastWake() const { return _last_wake; }
+
+  void resetStats();
+  const IdleStats& getStats() const { return _stats; }
+
+  /**
+   * \brief  one-line summary (fits a CLI reply)
+   */
+  void formatStats(char* dest, size_t sz) const;
+  void print(Print& out) const;
+};
+
+extern IdleScheduler idleScheduler;
@@ -0,0 +1,135 @@
+#include "LinkAdapter.h"
+
+#define LINK_STALE_MILLIS   (15*60*1000UL)   // SNR samples older than this aren't trusted
+
+LinkAdapter::LinkAdapter() {
+  memset(_links, 0, sizeof(_links));
+  memset(_peer, 0, sizeof(_peer));
+  _xfer_id = 0;
+  _initiator = false;
+  _switch_at = _revert_at = _req_timeout = 0;
+  clear();
+}
+
+LinkStats* LinkAdapter::find(const uint8_t* pub_key) {
+  for (int i = 0; i < LINK_TABLE_SIZE; i++) {
+    if (memcmp(_links[i].pub_key, pub_key, sizeof(_links[i].pub_key)) == 0) return &_links[i];
+  }
+  return NULL;
+}
+
+const LinkStats* LinkAdapter::getStats(const uint8_t* pub_key) const {
+  for (int i = 0; i < LINK_TABLE_SIZE; i++) {
+    if (memcmp(_links[i].pub_key, pub_key, sizeof(_links[i].pub_key)) == 0) return &_links[i];
+  }
+  return NULL;
+}
+
+void LinkAdapter::recordSNR(const uint8_t* pub_key, float snr, unsigned long now) {
+  int16_t snr_x4 = (int16_t)(snr * 4);
+
+  LinkStats* l = find(pub_key);
+  if (l == NULL) {   // new neighbour, replace least recently heard
+    l = &_links[0];
+    for (int i = 1; i < LINK_TABLE_SIZE; i++) {
+      if ((long)(_links[i].last_heard - l->last_heard) < 0) l = &_links[i];
+    }
+    memset(l, 0, sizeof(*l));
+    memcpy(l->pub_key, pub_key, sizeof(l->pub_key));
+    l->snr_x4 = snr_x4;
+  } else if (l->samples == 0 || now - l->last_heard > LINK_STALE_MILLIS) {
+    l->snr_x4 = snr_x4;
+    l->samples = 0;
+  } else {
+    l->snr_x4 = (l->snr_x4 * 3 + snr_x4) / 4;   // EWMA, alpha = 1/4
+  }
+  if (l->samples < 255) l->samples++;
+  l->last_heard = now;
+}
+
+void LinkAdapter::recordBlobOK(const uint8_t* pub_key) {
+  LinkStats* l = find(pub_key);
+  if (l && l->blobs_ok < 0xFFFF) l->blobs_ok++;
+}
+
+uint8_t LinkAdapter::pickFastSF(const uint8_t* pub_key, uint8_t base_sf, unsigned long now) {
+  LinkStats* l = find(pub_key);
+  if (l == NULL || l->samples < LINK_MIN_SAMPLES || now - l->last_heard > LINK_STALE_MILLIS) return 0;
+  if ((long)(now - l->cooldown_until) < 0) return 0;   // fast link failed recently
+  if (l->blobs_ok == 0) return 0;   // no blob transfer has worked with this neighbour yet, on the base SF
+
+  for (uint8_t sf = minFastSF(base_sf); sf < base_sf; sf++) {
+    if (l->snr_x4 >= demodLimitX4(sf) + LINK_SNR_MARGIN*4) return sf;
+  }
+  return 0;
+}
+
+void LinkAdapter::startRequest(const uint8_t* pub_key, uint8_t sf, uint16_t xfer_id, unsigned long now) {
+  memcpy(_peer, pub_key, sizeof(_peer));
+  _sf = sf;
+  _xfer_id = xfer_id;
+  _initiator = true;
+  _accepted = _switched = _confirmed = false;
+  _req_timeout = now + LINK_REQ_TIMEOUT_MILLIS;
+}
+
+void LinkAdapter::accept(const uint8_t* pub_key, uint8_t sf, uint16_t xfer_id, unsigned long switch_at, uint32_t window_millis) {
+  memcpy(_peer, pub_key, sizeof(_peer));
+  _sf = sf;
+  _xfer_id = xfer_id;
+  _initiator = false;
+  _accepted = true;
+  _switched = _confirmed = false;
+  _switch_at = switch_at;
+  _revert_at = switch_at + window_millis;
+}
+
+void LinkAdapter::onAccepted(unsigned long now, uint32_t window_millis) {
+  _accepted = true;
+  _switch_at = now;
+  _revert_at = now + LINK_SWITCH_GUARD_MILLIS + window_millis;
+}
+
+void LinkAdapter::fallback(unsigned long now) {
+  if (_sf == 0) return;
+  if (!_confirmed) {   // never heard peer on the fast SF, so the link isn't as good as it looked
+    LinkStats* l = find(_peer);
+    if (l) {
+      l->num_fallbacks++;
+      l->cooldown_until = now + LINK_FALLBACK_COOLDOWN;
+    }
+  }
+  _revert_at = now;
+}
+
+uint8_t LinkAdapter::checkTimers(uint8_t base_sf, unsigned long now) {
+  if (_sf == 0) return 0;
+
+  if (!_accepted) {
+    if ((long)(now - _req_timeout) >= 0) clear();   // no reply from peer, stay on base SF
+    return 0;
+  }
+  if ((long)(now - _revert_at) >= 0) {
+    bool was_switched = _switched;
+    clear();
+    return was_switched ? base_sf : 0;
+  }
+  if (!_switched && (long)(now - _switch_at) >= 0) {
+    _switched = true;
+    LinkStats* l = find(_peer);
+    if (l) {
+      l->num_switches++;
+      l->last_sf = _sf;
+    }
+    return _sf;
+  }
+  return 0;
+}
+
+void LinkAdapter::addAirtimeSaved(uint32_t fast_airtime, uint8_t base_sf) {
+  if (!_switched || base_sf <= _sf) return;
+  LinkStats* l = find(_peer);
+  if (l) {
+    l->airtime_saved += fast_airtime * ((1UL << (base_sf - _sf)) - 1);   // airtime roughly doubles per SF step
+  }
+}
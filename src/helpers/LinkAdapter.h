@@ -0,0 +1,95 @@
+#pragma once
+
+#include <Arduino.h>   // needed for PlatformIO
+#include <Mesh.h>
+
+#ifndef LINK_TABLE_SIZE
+  #define LINK_TABLE_SIZE        16   // neighbours (zero-hop contacts) we track link quality for
+#endif
+#ifndef LINK_SNR_MARGIN
+  #define LINK_SNR_MARGIN         8   // dB above the demod limit of the faster SF, before switching to it
+#endif
+#ifndef LINK_MAX_SF_STEP
+  #define LINK_MAX_SF_STEP        2   // fast SF is at most this far below the channel's (base) SF
+#endif
+#define LINK_MIN_SAMPLES          3   // SNR samples needed, before link is trusted
+#define LINK_MIN_SF               7
+#define LINK_MAX_WINDOW_SECS     30   // longest time off the base SF
+#define LINK_REQ_TIMEOUT_MILLIS  4000
+#define LINK_SWITCH_GUARD_MILLIS  300  // after peer's reply, before sending at new SF
+#define LINK_FALLBACK_COOLDOWN  (10*60*1000UL)   // after a failed fast link, don't retry it for this long
+
+struct LinkStats {
+  uint8_t pub_key[8];     // prefix, zeroes = unused
+  int16_t snr_x4;         // smoothed SNR (x4)
+  uint8_t samples;
+  uint8_t last_sf;        // last fast SF used, 0 = never
+  uint16_t num_switches;
+  uint16_t num_fallbacks;
+  uint16_t blobs_ok;      // blobs delivered to/from neighbour (at any SF)
+  uint32_t airtime_saved; // millis (estimated)
+  unsigned long last_heard;
+  unsigned long cooldown_until;
+};
+
+/**
+ * \brief  Tracks SNR of zero-hop neighbours, and the state of a temporary 'fast link' (faster spreading factor),
+ *     negotiated with one neighbour for the duration of a bulk transfer, then reverting to the base SF.
+ *     Only the SF changes (freq, BW and CR stay the channel's), by at most LINK_MAX_SF_STEP, and only with
+ *     neighbours that have already completed a blob transfer with us on the base SF.
+ */
+class LinkAdapter {
+  LinkStats _links[LINK_TABLE_SIZE];
+
+  // current fast link session (only one at a time)
+  uint8_t _peer[8];
+  uint8_t _sf;              // 0 = no session
+  uint16_t _xfer_id;
+  bool _initiator;
+  bool _accepted;           // both sides agreed (initiator only, responder accepts immediately)
+  bool _switched;           // radio is currently on _sf
+  bool _confirmed;          // peer has been heard on _sf
+  unsigned long _switch_at, _revert_at, _req_timeout;
+
+  void clear() { _sf = 0; _switched = _accepted = _confirmed = false; }
+
+  LinkStats* find(const uint8_t* pub_key);
+
+public:
+  LinkAdapter();
+
+  void recordSNR(const uint8_t* pub_key, float snr, unsigned long now);
+  void recordBlobOK(const uint8_t* pub_key);
+  const LinkStats* getStats(const uint8_t* pub_key) const;
+  const LinkStats* getByIdx(int i) const { return &_links[i]; }
+
+  /**
+   * \returns  the fastest SF that the link to given neighbour can support, or zero if not faster than base_sf
+   */
+  uint8_t pickFastSF(const uint8_t* pub_key, uint8_t base_sf, unsigned long now);
+  static uint8_t minFastSF(uint8_t base_sf) { return base_sf > LINK_MIN_SF + LINK_MAX_SF_STEP ? base_sf - LINK_MAX_SF_STEP : LINK_MIN_SF; }
+  static int demodLimitX4(uint8_t sf) { return -(int)(sf - 4) * 10; }   // SF7: -7.5dB ... SF12: -20dB (x4)
+
+  // session
+  bool isActive() const { return _sf != 0; }
+  bool isPending(uint16_t xfer_id) const { return _sf != 0 && _initiator && !_accepted && _xfer_id == xfer_id; }
+  bool isSwitched() const { return _switched; }
+  bool isPeer(const uint8_t* pub_key) const { return _sf != 0 && memcmp(_peer, pub_key, sizeof(_peer)) == 0; }
+  uint8_t getSF() const { return _sf; }
+  uint16_t getXferId() const { return _xfer_id; }
+
+  void startRequest(const uint8_t* pub_key, uint8_t sf, uint16_t xfer_id, unsigned long now);   // initiator
+  void accept(const uint8_t* pub_key, uint8_t sf, uint16_t xfer_id, unsigned long switch_at, uint32_t window_millis);   // responder
+  void onAccepted(unsigned long now, uint32_t window_millis);   // initiator, peer agreed
+  void onPeerHeard() { if (_switched) _confirmed = true; }
+  void cancel() { if (!_switched) clear(); }   // peer rejected (initiator)
+  void finish(unsigned long revert_at) { if (_sf && (long)(revert_at - _revert_at) < 0) _revert_at = revert_at; }
+  void fallback(unsigned long now);   // fast link isn't working, revert now
+
+  /**
+   * \brief  check timers
+   * \returns  SF to change radio to now, or zero for no change. (returns base_sf when reverting)
+   */
+  uint8_t checkTimers(uint8_t base_sf, unsigned long now);
+  void addAirtimeSaved(uint32_t fast_airtime, uint8_t base_sf);
+};
@@ -47,6 +47,8 @@ RegionMap::RegionMap(TransportKeyStore& store) : _store(&store) {
   wildcard.id = wildcard.parent = 0;
   wildcard.flags = 0;  // default behaviour, allow flood and direct
   strcpy(wildcard.name, "*");
+  invalidateMatchCache();
+  n_match_calls = n_match_hot = n_match_cached = n_match_hmacs = 0;
 }
 
 bool RegionMap::is_name_char(uint8_t c) {
@@ -82,6 +84,7 @@ bool RegionMap::load(FILESYSTEM* _fs, const char* path) {
 
       num_regions = 0; next_id = 1;
       default_id = home_id = 0;
+      invalidateMatchCache();
 
       bool success = file.read(pad, 3) == 3;  // reserved header
       success = success && file.read((uint8_t *) &default_id, sizeof(default_id)) == sizeof(default_id);
@@ -185,20 +188,98 @@ int RegionMap::getTransportKeysFor(const RegionEntry& src, TransportKey dest[],
   return num;
 }
 
+uint32_t RegionMap::calcMatchStamp(uint8_t mask) const {
+  uint32_t h = 2166136261u ^ num_regions;   // FNV-1a over the (id, allowed) list
+  for (int i = 0; i < num_regions; i++) {
+    h = (h ^ regions[i].id) * 16777619u;
+    h = (h ^ (regions[i].flags & mask)) * 16777619u;
+  }
+  return h;
+}
+
+bool RegionMap::isHotKey(uint16_t region_id, uint8_t key_idx) const {
+  for (int i = 0; i < num_hot; i++) {
+    if (hot_keys[i].region_id == region_id && hot_keys[i].key_idx == key_idx) return true;
+  }
+  return false;
+}
+
+void RegionMap::promoteHotKey(int idx) {
+  if (idx == 0) return;
+  RegionHotKey tmp = hot_keys[idx];
+  while (idx > 0) {   // shuffle down, to make room at front
+    hot_keys[idx] = hot_keys[idx - 1];
+    idx--;
+  }
+  hot_keys[0] = tmp;
+}
+
+void RegionMap::putHotKey(uint16_t region_id, uint8_t key_idx, const TransportKey& key) {
+  if (num_hot < MAX_REGION_HOT_KEYS) num_hot++;   // otherwise, evict the least recently matched (last)
+  int i = num_hot - 1;
+  hot_keys[i].region_id = region_id;
+  hot_keys[i].key_idx = key_idx;
+  hot_keys[i].calc.setKey(key);
+  promoteHotKey(i);
+}
+
+void RegionMap::putRecentMatch(const uint8_t* pkt_hash, uint16_t code, uint16_t region_id, uint32_t stamp) {
+  auto m = &recent_matches[next_match_idx];
+  memcpy(m->pkt_hash, pkt_hash, MAX_HASH_SIZE);
+  m->code = code;
+  m->region_id = region_id;
+  m->stamp = stamp;
+  next_match_idx = (next_match_idx + 1) % MAX_REGION_MATCH_CACHE;   // cyclic table
+  if (num_matches < MAX_REGION_MATCH_CACHE) num_matches++;
+}
+
 RegionEntry* RegionMap::findMatch(mesh::Packet* packet, uint8_t mask) {
+  uint16_t code = packet->transport_codes[0];
+  n_match_calls++;
+
+  // first, try regions which recently matched traffic (cheap, HMAC midstates are pre-computed)
+  for (int i = 0; i < num_hot; i++) {
+    auto region = findById(hot_keys[i].region_id);
+    if (region == NULL || region->isWildcard() || (region->flags & mask) != 0) continue;
+
+    n_match_hmacs++;
+    if (hot_keys[i].calc.calcTransportCode(packet) == code) {
+      promoteHotKey(i);
+      n_match_hot++;
+      return region;
+    }
+  }
+
+  // same flood packet heard again (via other repeaters)?  Re-use result of the full scan below
+  uint8_t pkt_hash[MAX_HASH_SIZE];
+  packet->calculatePacketHash(pkt_hash);
+  uint32_t stamp = calcMatchStamp(mask);
+  for (int i = 0; i < num_matches; i++) {
+    auto m = &recent_matches[i];
+    if (m->stamp == stamp && m->code == code && memcmp(m->pkt_hash, pkt_hash, MAX_HASH_SIZE) == 0) {
+      n_match_cached++;
+      return m->region_id == 0 ? NULL : findById(m->region_id);
+    }
+  }
+
   for (int i = 0; i < num_regions; i++) {
     auto region = &regions[i];
     if ((region->flags & mask) == 0) {   // does region allow this? (per 'mask' param)
       TransportKey keys[4];
       int num = getTransportKeysFor(*region, keys, 4);
       for (int j = 0; j < num; j++) {
-        uint16_t code = keys[j].calcTransportCode(packet);
-        if (packet->transport_codes[0] == code) {   // a match!!
+        if (isHotKey(region->id, j)) continue;   // already checked above
+
+        n_match_hmacs++;
+        if (keys[j].calcTransportCode(packet) == code) {   // a match!!
+          putHotKey(region->id, j, keys[j]);
+          putRecentMatch(pkt_hash, code, region->id, stamp);
           return region;
         }
       }
     }
   }
+  putRecentMatch(pkt_hash, code, 0, stamp);
   return NULL;  // no matches
 }
 
@@ -274,11 +355,13 @@ bool RegionMap::removeRegion(const RegionEntry& region) {
     regions[i] = regions[i + 1];
     i++;
   }
+  invalidateMatchCache();
   return true;  // success
 }
 
 bool RegionMap::clear() {
   num_regions = 0;
+  invalidateMatchCache();
   return true;  // success
 }
 
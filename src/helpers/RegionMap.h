@@ -8,6 +8,14 @@
   #define MAX_REGION_ENTRIES  32
 #endif
 
+#ifndef MAX_REGION_HOT_KEYS
+  #define MAX_REGION_HOT_KEYS   4    // prepared keys of regions that recently matched traffic
+#endif
+
+#ifndef MAX_REGION_MATCH_CACHE
+  #define MAX_REGION_MATCH_CACHE  8    // recent findMatch() results (repeat receptions of same flood)
+#endif
+
 #define REGION_DENY_FLOOD   0x01
 #define REGION_DENY_DIRECT  0x02   // reserved for future
 
@@ -20,14 +28,38 @@ struct RegionEntry {
   bool isWildcard() const { return id == 0; }
 };
 
+struct RegionHotKey {
+  uint16_t region_id;
+  uint8_t key_idx;
+  TransportCodeCalc calc;
+};
+
+struct RegionMatchResult {
+  uint8_t pkt_hash[MAX_HASH_SIZE];
+  uint16_t code;
+  uint16_t region_id;   // 0 = no match
+  uint32_t stamp;       // regions/flags snapshot this result is valid for
+};
+
 class RegionMap {
   TransportKeyStore* _store;
   uint16_t next_id, home_id, default_id;
   uint16_t num_regions;
   RegionEntry regions[MAX_REGION_ENTRIES];
   RegionEntry wildcard;
+  RegionHotKey hot_keys[MAX_REGION_HOT_KEYS];   // most recently matched first
+  int num_hot;
+  RegionMatchResult recent_matches[MAX_REGION_MATCH_CACHE];
+  int num_matches, next_match_idx;
+  uint32_t n_match_calls, n_match_hot, n_match_cached, n_match_hmacs;
 
   void printChildRegions(int indent, const RegionEntry* parent, Stream& out) const;
+  uint32_t calcMatchStamp(uint8_t mask) const;
+  bool isHotKey(uint16_t region_id, uint8_t key_idx) const;
+  void putHotKey(uint16_t region_id, uint8_t key_idx, const TransportKey& key);
+  void promoteHotKey(int idx);
+  void putRecentMatch(const uint8_t* pkt_hash, uint16_t code, uint16_t region_id, uint32_t stamp);
+  void invalidateMatchCache() { num_hot = num_matches = next_match_idx = 0; }
 
 public:
   RegionMap(TransportKeyStore& store);
@@ -49,13 +81,19 @@ public:
   void setDefaultRegion(const RegionEntry* def);
   bool removeRegion(const RegionEntry& region);
   bool clear();
-  void resetFrom(const RegionMap& src) { num_regions = 0; next_id = src.next_id; }
+  void resetFrom(const RegionMap& src) { num_regions = 0; next_id = src.next_id; invalidateMatchCache(); }
   int getCount() const { return num_regions; }
   const RegionEntry* getByIdx(int i) const { return &regions[i]; }
   const RegionEntry* getRoot() const { return &wildcard; }
   int exportNamesTo(char *dest, int max_len, uint8_t mask, bool invert = false);
   int getTransportKeysFor(const RegionEntry& src, TransportKey dest[], int max_num);
 
+  // findMatch() stats
+  uint32_t getNumMatchCalls() const { return n_match_calls; }
+  uint32_t getNumHotMatches() const { return n_match_hot; }
+  uint32_t getNumCachedMatches() const { return n_match_cached; }
+  uint32_t getNumMatchHMACs() const { return n_match_hmacs; }
+
   void    exportTo(Stream& out) const;
   size_t  exportTo(char *dest, size_t max_len) const;
  
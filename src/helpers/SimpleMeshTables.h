@@ -6,8 +6,12 @@
   #include <FS.h>
 #endif
 
-#define MAX_PACKET_HASHES  128
-#define MAX_PACKET_ACKS     64
+#ifndef MAX_PACKET_HASHES
+  #define MAX_PACKET_HASHES  128
+#endif
+#ifndef MAX_PACKET_ACKS
+  #define MAX_PACKET_ACKS     64
+#endif
 
 class SimpleMeshTables : public mesh::MeshTables {
   uint8_t _hashes[MAX_PACKET_HASHES*MAX_HASH_SIZE];
@@ -17,6 +17,16 @@ int PacketQueue::countBefore(uint32_t now) const {
   return n;
 }
 
+uint32_t PacketQueue::millisToNext(uint32_t now) const {
+  uint32_t best = IDLE_NO_DEADLINE;
+  for (int j = 0; j < _num; j++) {
+    if (_schedule_table[j] <= now) return 0;   // already due (get() picks it on the next pass)
+    uint32_t t = _schedule_table[j] - now;
+    if (t < best) best = t;
+  }
+  return best;
+}
+
 mesh::Packet* PacketQueue::get(uint32_t now) {
   uint8_t min_pri = 0xFF;
   int best_idx = -1;
@@ -111,3 +121,10 @@ void StaticPoolPacketManager::queueInbound(mesh::Packet* packet, uint32_t schedu
 mesh::Packet* StaticPoolPacketManager::getNextInbound(uint32_t now) {
   return rx_queue.get(now);
 }
+
+uint32_t StaticPoolPacketManager::millisToNextOutbound(uint32_t now) const {
+  return send_queue.millisToNext(now);
+}
+uint32_t StaticPoolPacketManager::millisToNextInbound(uint32_t now) const {
+  return rx_queue.millisToNext(now);
+}
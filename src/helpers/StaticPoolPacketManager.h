@@ -14,6 +14,7 @@ public:
   void add(mesh::Packet* packet, uint8_t priority, uint32_t scheduled_for);
   int count() const { return _num; }
   int countBefore(uint32_t now) const;
+  uint32_t millisToNext(uint32_t now) const;
   mesh::Packet* itemAt(int i) const { return _table[i]; }
   mesh::Packet* removeByIdx(int i);
 };
@@ -34,4 +35,6 @@ public:
   mesh::Packet* removeOutboundByIdx(int i) override;
   void queueInbound(mesh::Packet* packet, uint32_t scheduled_for) override;
   mesh::Packet* getNextInbound(uint32_t now) override;
+  uint32_t millisToNextOutbound(uint32_t now) const override;
+  uint32_t millisToNextInbound(uint32_t now) const override;
 };
\ No newline at end of file
@@ -2,13 +2,39 @@
 #include <SHA256.h>
 
 uint16_t TransportKey::calcTransportCode(const mesh::Packet* packet) const {
-  uint16_t code;
-  SHA256 sha;
-  sha.resetHMAC(key, sizeof(key));
+  TransportCodeCalc calc;
+  calc.setKey(*this);
+  return calc.calcTransportCode(packet);
+}
+
+void TransportCodeCalc::setKey(const TransportKey& key) {
+  uint8_t block[64];   // SHA256 block size
+
+  memset(block, 0, sizeof(block));
+  memcpy(block, key.key, sizeof(key.key));
+  for (int i = 0; i < sizeof(block); i++) block[i] ^= 0x36;   // ipad
+  inner.reset();
+  inner.update(block, sizeof(block));
+
+  for (int i = 0; i < sizeof(block); i++) block[i] ^= (0x36 ^ 0x5C);   // opad
+  outer.reset();
+  outer.update(block, sizeof(block));
+
+  memset(block, 0, sizeof(block));
+}
+
+uint16_t TransportCodeCalc::calcTransportCode(const mesh::Packet* packet) const {
+  uint8_t digest[32];
+  SHA256 sha = inner;   // resume from the midstate, same result as resetHMAC() + finalizeHMAC()
   uint8_t type = packet->getPayloadType();
   sha.update(&type, 1);
   sha.update(packet->payload, packet->payload_len);
-  sha.finalizeHMAC(key, sizeof(key), &code, 2);
+  sha.finalize(digest, sizeof(digest));
+
+  uint16_t code;
+  sha = outer;
+  sha.update(digest, sizeof(digest));
+  sha.finalize(&code, 2);
   if (code == 0) {     // reserve codes 0000 and FFFF
     code++;
   } else if (code == 0xFFFF) {
@@ -25,18 +51,24 @@ bool TransportKey::isNull() const {
 }
 
 void TransportKeyStore::putCache(uint16_t id, const TransportKey& key) {
+  int i;
   if (num_cache < MAX_TKS_ENTRIES) {
-    cache_ids[num_cache] = id;
-    cache_keys[num_cache] = key;
-    num_cache++;
+    i = num_cache++;
   } else {
-    // TODO: evict oldest cache entry
+    i = 0;   // evict the least recently used entry
+    for (int j = 1; j < MAX_TKS_ENTRIES; j++) {
+      if ((int32_t)(cache_used[j] - cache_used[i]) < 0) i = j;
+    }
   }
+  cache_ids[i] = id;
+  cache_keys[i] = key;
+  cache_used[i] = ++use_counter;
 }
 
 void TransportKeyStore::getAutoKeyFor(uint16_t id, const char* name, TransportKey& dest) {
   for (int i = 0; i < num_cache; i++) {  // first, check cache
     if (cache_ids[i] == id) {   // cache hit!
+      cache_used[i] = ++use_counter;
       dest = cache_keys[i];
       return;
     }
@@ -53,6 +85,7 @@ int TransportKeyStore::loadKeysFor(uint16_t id, TransportKey keys[], int max_num
   int n = 0;
   for (int i = 0; i < num_cache && n < max_num; i++) {  // first, check cache
     if (cache_ids[i] == id) {
+      cache_used[i] = ++use_counter;
       keys[n++] = cache_keys[i];
     }
   }
@@ -3,6 +3,7 @@
 #include <Arduino.h>   // needed for PlatformIO
 #include <Packet.h>
 #include <helpers/IdentityStore.h>
+#include <SHA256.h>
 
 struct TransportKey {
   uint8_t key[16];
@@ -11,18 +12,32 @@ struct TransportKey {
   bool isNull() const;
 };
 
+/**
+ * \brief  A TransportKey with the HMAC inner/outer key blocks already absorbed (ie. the HMAC midstates),
+ *         so each calcTransportCode() only has to hash the packet payload and the outer digest.
+ */
+class TransportCodeCalc {
+  SHA256 inner, outer;
+
+public:
+  void setKey(const TransportKey& key);
+  uint16_t calcTransportCode(const mesh::Packet* packet) const;
+};
+
 #define MAX_TKS_ENTRIES   16
 
 class TransportKeyStore {
   uint16_t     cache_ids[MAX_TKS_ENTRIES];
   TransportKey cache_keys[MAX_TKS_ENTRIES];
+  uint32_t     cache_used[MAX_TKS_ENTRIES];   // LRU stamps
+  uint32_t     use_counter;
   int num_cache;
 
   void putCache(uint16_t id, const TransportKey& key);
   void invalidateCache() { num_cache = 0; }
 
 public:
-  TransportKeyStore() { num_cache = 0; }
+  TransportKeyStore() { num_cache = 0; use_counter = 0; }
   void getAutoKeyFor(uint16_t id, const char* name, TransportKey& dest);
   int loadKeysFor(uint16_t id, TransportKey keys[], int max_num);
   bool saveKeysFor(uint16_t id, const TransportKey keys[], int num);
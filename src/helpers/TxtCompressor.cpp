@@ -0,0 +1,89 @@
+#include "TxtCompressor.h"
+#include <string.h>
+
+// NOTE: index in this table + 1 is the code. Tuned for short (English) chat text, longer entries give the savings.
+//       Changing this table breaks compatibility with other nodes!
+static const char* const dict[] = {
+  " ", "e", "t", "a", "o", "i", "n", "s", "r", "h", "l", "d", "c", "u", "m", "w", "y", "f", "g", "p", "b",
+  "v", "k", "j", "x", "q", "z", ".", ",", "?", "!", "'", "0", "1", "2", "3", "4", "5", "6", "7", "8", "9",
+  "I", "T", "A", "S", "W", "H", "O", "M", "N", "B", "C", "D", "G", "L", "P", "R", "Y", "E", "F", "K", "J",
+  "U", "V", ":", "-", "/", "(", ")", "\"", "@", "#", "&", "*", "the ", " the ", "ing", "and", " and ", "you",
+  " you", "th", "he", "in", "er", "an", "re", "on", "at", "en", "nd", "ti", "es", "or", "te", "of", "ed",
+  "is", "it", "al", "ar", "st", "to", "nt", "ng", "se", "ha", "as", "ou", "io", "le", "ve", "co", "me", "de",
+  "hi", "ri", "ro", "ic", "ne", "ea", "ra", "ce", "li", "ch", "ll", "be", "ma", "si", "om", "ur", "ok",
+  "hey", "lol", "thanks", "thx", "please", "what", "where", "when", "how", "going", "here", "there", "good",
+  "morning", "night", "today", "tomorrow", "yes", "can", "will", "just", "have", "are", "for", "that",
+  "this", "with", "not", "but", "all", "was", "get", "got", "out", "now", "one", "about", "know", "see",
+  "back", "like", "time", "mesh", "node", "repeater", "signal", "radio", "test", "copy", "received", "hear",
+  "anyone", "home", "work", "I'm", "don't", "it's", "'s", "n't", "e ", "s ", "t ", "d ", "y ", ", ", ". ",
+  "? ", "! ", " a ", " to ", " of ", " in ", " is ", " it ", " on ", " be ", " we ", " me ", " my ", " so ",
+  " do ", " for ", " at ", " up", "er ", "ed ", "ing ", "es ", "ly", "ion", "ment", "tion", "ould", "ight",
+  "ere", "ver", "our", "ome", "ake", "ave", "ust", "ill", "ell", "ame", "ect", "ent", "ess", "est", "ter",
+  "per", "pro", "con", "com", "un", "ow", "wh", "sh", "ck", "ay"
+};
+
+#define DICT_SIZE   ((int)(sizeof(dict) / sizeof(dict[0])))
+
+int TxtCompressor::compress(const char* src, int src_len, uint8_t* dest, int dest_max) {
+  static uint8_t dict_len[DICT_SIZE];
+  if (dict_len[0] == 0) {   // first use
+    for (int d = 0; d < DICT_SIZE; d++) dict_len[d] = strlen(dict[d]);
+  }
+
+  int o = 0;
+  int lit_start = -1;  // start of current verbatim run (in dest), or -1
+  for (int i = 0; i < src_len; ) {
+    // greedy, longest dictionary match
+    int best = -1, best_len = 0;
+    for (int d = 0; d < DICT_SIZE; d++) {
+      int n = dict_len[d];
+      if (n > best_len && n <= src_len - i && dict[d][0] == src[i] && memcmp(dict[d], &src[i], n) == 0) {
+        best = d;
+        best_len = n;
+      }
+    }
+
+    if (best >= 0) {
+      if (o + 1 > dest_max) return -1;
+      dest[o++] = best + 1;
+      i += best_len;
+      lit_start = -1;
+    } else if (src[i] == 0) {
+      return -1;   // can't encode nulls
+    } else {
+      if (lit_start >= 0 && dest[lit_start + 1] < 255) {   // append to current run
+        if (o + 1 > dest_max) return -1;
+        dest[lit_start + 1]++;
+      } else {
+        if (o + 3 > dest_max) return -1;
+        lit_start = o;
+        dest[o++] = TXT_CODE_VERBATIM;
+        dest[o++] = 1;
+      }
+      dest[o++] = src[i++];
+    }
+  }
+  return o;
+}
+
+int TxtCompressor::decompress(const uint8_t* src, int src_len, char* dest, int dest_max) {
+  int o = 0;
+  for (int i = 0; i < src_len && src[i] != 0; ) {   // zero code = end (ie. padding)
+    uint8_t c = src[i++];
+    if (c == TXT_CODE_VERBATIM) {
+      if (i >= src_len) return -1;
+      int n = src[i++];
+      if (i + n > src_len || o + n > dest_max) return -1;
+      memcpy(&dest[o], &src[i], n);
+      i += n; o += n;
+    } else if (c <= DICT_SIZE) {
+      int n = strlen(dict[c - 1]);
+      if (o + n > dest_max) return -1;
+      memcpy(&dest[o], dict[c - 1], n);
+      o += n;
+    } else {
+      return -1;   // unknown code (FUTURE)
+    }
+  }
+  return o;
+}
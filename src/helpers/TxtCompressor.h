@@ -0,0 +1,23 @@
+#pragma once
+
+#include <stdint.h>
+
+#define TXT_CODE_VERBATIM   0xFF   // followed by: length (1 byte), raw bytes
+
+/**
+ * \brief  Static dictionary compressor for short chat text (SMAZ-like).
+ *     Codes: 0 = end of text, 1..N = dictionary entry, 0xFF = verbatim run. Output never contains zero bytes
+ *     (except in verbatim runs, which text doesn't have), so zero padding after cipher blocks is harmless.
+ */
+class TxtCompressor {
+public:
+  /**
+   * \returns  compressed length, or -1 if it doesn't fit in dest_max
+   */
+  static int compress(const char* src, int src_len, uint8_t* dest, int dest_max);
+
+  /**
+   * \returns  decompressed length (NOT null terminated), or -1 if src is invalid or too long
+   */
+  static int decompress(const uint8_t* src, int src_len, char* dest, int dest_max);
+};
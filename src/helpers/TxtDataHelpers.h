@@ -6,6 +6,7 @@
 #define TXT_TYPE_PLAIN          0    // a plain text message
 #define TXT_TYPE_CLI_DATA       1    // a CLI command
 #define TXT_TYPE_SIGNED_PLAIN   2    // plain text, signed by sender
+#define TXT_TYPE_COMPRESSED     3    // plain text, compressed with TxtCompressor
 
 class StrHelper {
 public:
@@ -2,7 +2,7 @@
 
 #include "helpers/AbstractBridge.h"
 #include "helpers/CommonCLI.h"
-#include "helpers/SimpleMeshTables.h"
+#include "helpers/bridges/BridgeTables.h"
 
 #include <RTClib.h>
 
@@ -14,7 +14,7 @@
  *
  * Features:
  * - Fletcher-16 checksum calculation for data integrity
- * - Packet duplicate detection using SimpleMeshTables
+ * - Packet duplicate detection and loop prevention using the node's shared BridgeTables
  * - Common timestamp formatting for debug logging
  * - Shared packet management and queuing logic
  */
@@ -62,8 +62,11 @@ protected:
   /** Node preferences for configuration settings */
   NodePrefs *_prefs;
 
-  /** Tracks seen packets to prevent loops in broadcast communications */
-  SimpleMeshTables _seen_packets;
+  /** Seen packets, shared with the node's other bridges to prevent loops between transports */
+  BridgeTables *_tables;
+
+  /** This bridge's interface id in _tables */
+  uint8_t _iface;
 
   /**
    * @brief Constructs a BridgeBase instance
@@ -71,9 +74,14 @@ protected:
    * @param prefs Node preferences for configuration settings
    * @param mgr PacketManager for allocating and queuing packets
    * @param rtc RTCClock for timestamping debug messages
+   * @param name Short transport name, for stats
+   * @param tables Seen-set to join, NULL for the node's shared one (separate tables simulate separate nodes)
    */
-  BridgeBase(NodePrefs *prefs, mesh::PacketManager *mgr, mesh::RTCClock *rtc)
-      : _prefs(prefs), _mgr(mgr), _rtc(rtc) {}
+  BridgeBase(NodePrefs *prefs, mesh::PacketManager *mgr, mesh::RTCClock *rtc, const char *name,
+             BridgeTables *tables = NULL)
+      : _prefs(prefs), _mgr(mgr), _rtc(rtc), _tables(tables ? tables : &BridgeTables::shared()) {
+    _iface = _tables->addInterface(name);
+  }
 
   /**
    * @brief Gets formatted date/time string for logging
@@ -110,7 +118,7 @@ protected:
    * @brief Common packet handling for received packets
    *
    * Implements the standard pattern used by all bridges:
-   * - Check if packet was seen before using _seen_packets.hasSeen()
+   * - Check if packet was seen before, on any bridge, using _tables->allowInject()
    * - Queue packet for mesh processing if not seen before
    * - Free packet if already seen to prevent duplicates
    *
@@ -0,0 +1,101 @@
+#include "BridgeTables.h"
+
+#include <Arduino.h>
+
+BridgeTables::BridgeTables() {
+  memset(_entries, 0, sizeof(_entries));
+  _next_idx = 0;
+  _num_ifaces = 0;
+  memset(_names, 0, sizeof(_names));
+  memset(_stats, 0, sizeof(_stats));
+}
+
+BridgeTables &BridgeTables::shared() {
+  static BridgeTables tables;   // only instantiated in builds with a bridge
+  return tables;
+}
+
+uint8_t BridgeTables::addInterface(const char *name) {
+  if (_num_ifaces >= BRIDGE_MAX_IFACES) return BRIDGE_IFACE_MESH;
+
+  _names[_num_ifaces] = name;
+  return _num_ifaces++;
+}
+
+BridgeTables::Entry *BridgeTables::lookup(const mesh::Packet *packet, bool &is_new) {
+  uint8_t hash[MAX_HASH_SIZE];
+  packet->calculatePacketHash(hash);
+  unsigned long now = millis();
+
+  Entry *e = NULL;
+  for (int i = 0; i < BRIDGE_SEEN_SIZE && e == NULL; i++) {
+    if (memcmp(hash, _entries[i].hash, MAX_HASH_SIZE) == 0) e = &_entries[i];
+  }
+  is_new = e == NULL || now - e->seen_at > BRIDGE_SEEN_TTL_MS;
+
+  if (e == NULL) {
+    e = &_entries[_next_idx];
+    _next_idx = (_next_idx + 1) % BRIDGE_SEEN_SIZE;   // cyclic table
+    memcpy(e->hash, hash, MAX_HASH_SIZE);
+  }
+  if (is_new) {   // new, or expired: start over
+    e->seen_at = now;
+    e->origin = BRIDGE_IFACE_MESH;
+    e->sent = 0;
+  }
+  return e;
+}
+
+bool BridgeTables::exceedsHops(const mesh::Packet *packet) {
+  // a Direct packet's path is the route still to go, only flood paths count hops travelled
+  return packet->isRouteFlood() && (packet->path_len & 63) >= BRIDGE_MAX_HOPS;
+}
+
+bool BridgeTables::allowForward(const mesh::Packet *packet, uint8_t iface) {
+  if (iface >= _num_ifaces) return false;
+
+  if (exceedsHops(packet)) {
+    _stats[iface].hop_limited++;
+    return false;
+  }
+
+  bool is_new;
+  Entry *e = lookup(packet, is_new);
+  if (e->origin == iface || (e->sent & (1 << iface))) {
+    _stats[iface].tx_suppressed++;
+    return false;
+  }
+  e->sent |= 1 << iface;
+  _stats[iface].forwarded++;
+  return true;
+}
+
+bool BridgeTables::allowInject(const mesh::Packet *packet, uint8_t iface) {
+  if (iface >= _num_ifaces) return false;
+
+  bool is_new;
+  Entry *e = lookup(packet, is_new);
+  if (!is_new) {   // came in on another bridge, or we sent it out (so the mesh has it)
+    _stats[iface].rx_suppressed++;
+    return false;
+  }
+  e->origin = iface;
+
+  if (exceedsHops(packet)) {
+    _stats[iface].hop_limited++;
+    return false;
+  }
+  _stats[iface].injected++;
+  return true;
+}
+
+void BridgeTables::formatStats(char *dest, size_t sz) const {
+  size_t len = 0;
+  dest[0] = 0;
+  for (int i = 0; i < _num_ifaces && len < sz; i++) {
+    const BridgeIfaceStats &s = _stats[i];
+    len += snprintf(&dest[len], sz - len, "%s%s fwd:%lu sup:%lu inj:%lu dup:%lu hop:%lu", i > 0 ? "\n" : "",
+                    _names[i], (unsigned long)s.forwarded, (unsigned long)s.tx_suppressed,
+                    (unsigned long)s.injected, (unsigned long)s.rx_suppressed, (unsigned long)s.hop_limited);
+  }
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <Mesh.h>
+
+#ifndef BRIDGE_SEEN_SIZE
+  #define BRIDGE_SEEN_SIZE       128
+#endif
+#ifndef BRIDGE_SEEN_TTL_MS
+  #define BRIDGE_SEEN_TTL_MS  120000   // after this a packet may cross the bridges again
+#endif
+#ifndef BRIDGE_MAX_HOPS
+  #define BRIDGE_MAX_HOPS         16   // flood packets that have travelled further aren't bridged
+#endif
+#define BRIDGE_MAX_IFACES          4
+#define BRIDGE_IFACE_MESH       0xFF   // origin: heard on the mesh (LoRa), or sent by this node
+
+struct BridgeIfaceStats {
+  uint32_t forwarded;       // mesh -> bridge
+  uint32_t tx_suppressed;   // not sent: came from this bridge, or already sent on it
+  uint32_t injected;        // bridge -> mesh
+  uint32_t rx_suppressed;   // not injected: already seen on some transport
+  uint32_t hop_limited;
+};
+
+/**
+ * @brief Seen-set shared by all the bridges on a node
+ *
+ * Every packet crossing a bridge, either way, is recorded with the interface it arrived on
+ * (its origin) and the interfaces it has been sent out on. A packet is never sent back on its
+ * origin, or twice on the same interface, and a packet already seen on any transport isn't
+ * injected into the mesh again. So floods can't ping-pong between transports (eg. ESP-NOW and
+ * RS232 on one node, or between repeaters that bridge the same area), however the bridges are
+ * wired. Entries expire after BRIDGE_SEEN_TTL_MS, and flood packets past BRIDGE_MAX_HOPS are
+ * not bridged, which bounds any loop these don't catch.
+ */
+class BridgeTables {
+  struct Entry {
+    uint8_t hash[MAX_HASH_SIZE];
+    unsigned long seen_at;
+    uint8_t origin;   // interface id, or BRIDGE_IFACE_MESH
+    uint8_t sent;     // bit per interface id
+  };
+
+  Entry _entries[BRIDGE_SEEN_SIZE];
+  int _next_idx;
+  uint8_t _num_ifaces;
+  const char *_names[BRIDGE_MAX_IFACES];
+  BridgeIfaceStats _stats[BRIDGE_MAX_IFACES];
+
+  Entry *lookup(const mesh::Packet *packet, bool &is_new);
+  static bool exceedsHops(const mesh::Packet *packet);
+
+public:
+  BridgeTables();
+
+  /**
+   * @brief The node's shared instance, used by BridgeBase
+   */
+  static BridgeTables &shared();
+
+  /**
+   * @brief Registers a bridge
+   *
+   * @param name Short name for stats, eg. "rs232"
+   * @return Interface id, or BRIDGE_IFACE_MESH if there are already BRIDGE_MAX_IFACES
+   */
+  uint8_t addInterface(const char *name);
+
+  /**
+   * @brief Mesh -> bridge: records the packet as sent on 'iface'
+   *
+   * @return false if it came from 'iface', was already sent on it, or has travelled too far
+   */
+  bool allowForward(const mesh::Packet *packet, uint8_t iface);
+
+  /**
+   * @brief Bridge -> mesh: records 'iface' as the packet's origin
+   *
+   * @return false if the packet was already seen on any transport, or has travelled too far
+   */
+  bool allowInject(const mesh::Packet *packet, uint8_t iface);
+
+  int getNumInterfaces() const { return _num_ifaces; }
+  const char *getName(uint8_t iface) const { return _names[iface]; }
+  const BridgeIfaceStats &getStats(uint8_t iface) const { return _stats[iface]; }
+  void resetStats() { memset(_stats, 0, sizeof(_stats)); }
+
+  /**
+   * @brief One line per interface, eg. "ip fwd:12 sup:3 inj:40 dup:5 hop:0"
+   */
+  void formatStats(char *dest, size_t sz) const;
+};
@@ -0,0 +1,592 @@
+#include "IPBridge.h"
+
+#ifdef WITH_IP_BRIDGE
+
+#include <SHA256.h>
+
+#if defined(ESP32)
+  #include <WiFi.h>
+  #include <lwip/sockets.h>
+  #include <lwip/netdb.h>
+#else
+  #include <arpa/inet.h>
+  #include <errno.h>
+  #include <fcntl.h>
+  #include <netdb.h>
+  #include <netinet/in.h>
+  #include <netinet/tcp.h>
+  #include <sys/select.h>
+  #include <sys/socket.h>
+  #include <time.h>
+  #include <unistd.h>
+#endif
+
+#ifndef MSG_NOSIGNAL
+  #define MSG_NOSIGNAL 0
+#endif
+
+#define IP_BRIDGE_CONNECT_TIMEOUT  10000
+#define IP_BRIDGE_MIN_BACKOFF       1000
+#define IP_BRIDGE_RX_PER_LOOP          8   // UDP datagrams handled per loop() call
+
+static_assert(IP_BRIDGE_MAX_FRAME >= 18 + 2 + MAX_TRANS_UNIT + 1 + 8, "IP_BRIDGE_MAX_FRAME too small for one packet");
+static_assert(IP_BRIDGE_TCP_TXBUF >= IP_BRIDGE_MAX_FRAME, "IP_BRIDGE_TCP_TXBUF must hold a frame");
+
+static bool setNonBlocking(int fd) {
+  int flags = fcntl(fd, F_GETFL, 0);
+  return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+static bool resolveHost(const char *host, struct in_addr *addr) {
+  if (inet_pton(AF_INET, host, addr) == 1) return true;
+
+  // NOTE: blocks while the name is looked up, only done when (re)connecting
+  struct addrinfo hints, *res = NULL;
+  memset(&hints, 0, sizeof(hints));
+  hints.ai_family = AF_INET;
+  if (getaddrinfo(host, NULL, &hints, &res) != 0 || res == NULL) return false;
+  *addr = ((struct sockaddr_in *)res->ai_addr)->sin_addr;
+  freeaddrinfo(res);
+  return true;
+}
+
+static void putU32(uint8_t *dest, uint32_t v) {
+  dest[0] = v >> 24; dest[1] = v >> 16; dest[2] = v >> 8; dest[3] = v;
+}
+
+static uint32_t getU32(const uint8_t *src) {
+  return ((uint32_t)src[0] << 24) | ((uint32_t)src[1] << 16) | ((uint32_t)src[2] << 8) | src[3];
+}
+
+// constant time, so a forger can't find the MAC a byte at a time
+static bool macEquals(const uint8_t *a, const uint8_t *b, size_t len) {
+  uint8_t diff = 0;
+  for (size_t i = 0; i < len; i++) diff |= a[i] ^ b[i];
+  return diff == 0;
+}
+
+IPBridge::IPBridge(NodePrefs *prefs, uint8_t mode, const char *host, uint16_t port, mesh::PacketManager *mgr,
+                   mesh::RTCClock *rtc, BridgeTables *tables)
+    : BridgeBase(prefs, mgr, rtc, "ip", tables), _mode(mode), _host(host), _port(port), _id(0), _seq(0), _fd(-1),
+      _next_connect(0), _backoff(IP_BRIDGE_MIN_BACKOFF), _group_addr(0), _batch_len(0), _batch_count(0),
+      _batch_started(0), _next_inject(0) {
+  for (int i = 0; i < IP_BRIDGE_MAX_PEERS; i++) {
+    _conns[i].fd = -1;
+    _conns[i].connecting = false;
+    _conns[i].rx_len = _conns[i].tx_len = 0;
+  }
+  memset(_senders, 0, sizeof(_senders));
+  memset(&_stats, 0, sizeof(_stats));
+}
+
+void IPBridge::begin() {
+  BRIDGE_DEBUG_PRINTLN("Initializing, mode=%d host=%s port=%d\n", _mode, _host, _port);
+
+  if (_prefs->bridge_secret[0] == 0) {
+    // frames are only as trustworthy as the key, refuse to bridge an open network
+    BRIDGE_DEBUG_PRINTLN("bridge.secret not set, not starting\n");
+    return;
+  }
+
+#if defined(ESP32)
+  _id = esp_random();
+  #ifdef WIFI_SSID
+  if (WiFi.status() != WL_CONNECTED) {
+    WiFi.mode(WIFI_STA);
+    WiFi.begin(WIFI_SSID, WIFI_PWD);
+  }
+  #endif
+#else
+  // several instances may share a host, or even a process (simulated meshes)
+  srand((unsigned)time(NULL) ^ ((unsigned)getpid() << 8) ^ (unsigned)micros() ^ (unsigned)(uintptr_t)this);
+  _id = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+#endif
+
+  _seq = 0;
+  _batch_count = 0;
+  _backoff = IP_BRIDGE_MIN_BACKOFF;
+  _next_connect = _next_inject = millis();
+  memset(_senders, 0, sizeof(_senders));
+
+  // Update bridge state
+  _initialized = true;
+}
+
+void IPBridge::end() {
+  BRIDGE_DEBUG_PRINTLN("Stopping...\n");
+  closeSockets();
+
+  // Update bridge state
+  _initialized = false;
+}
+
+bool IPBridge::networkUp() const {
+#if defined(ESP32)
+  return WiFi.status() == WL_CONNECTED;
+#else
+  return true;
+#endif
+}
+
+int IPBridge::getNumConnected() const {
+  if (_mode == IP_BRIDGE_UDP) return _fd >= 0 ? 1 : 0;
+
+  int n = 0;
+  for (int i = 0; i < IP_BRIDGE_MAX_PEERS; i++) {
+    if (_conns[i].fd >= 0 && !_conns[i].connecting) n++;
+  }
+  return n;
+}
+
+void IPBridge::openSockets() {
+  bool udp = _mode == IP_BRIDGE_UDP;
+  int fd = socket(AF_INET, udp ? SOCK_DGRAM : SOCK_STREAM, 0);
+  if (fd < 0) {
+    BRIDGE_DEBUG_PRINTLN("socket() failed, errno=%d\n", errno);
+    _next_connect = millis() + _backoff;
+    return;
+  }
+
+  int one = 1;
+  setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+#ifdef SO_REUSEPORT
+  if (udp) setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one));   // lets two instances share a host
+#endif
+
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(_port);
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+
+  bool ok = setNonBlocking(fd) && bind(fd, (struct sockaddr *)&addr, sizeof(addr)) == 0;
+  if (ok && udp) {
+    struct in_addr group;
+    ok = resolveHost(_host, &group);
+    if (ok && IN_MULTICAST(ntohl(group.s_addr))) {
+      struct ip_mreq mreq;
+      mreq.imr_multiaddr = group;
+      mreq.imr_interface.s_addr = htonl(INADDR_ANY);
+      uint8_t ttl = IP_BRIDGE_MCAST_TTL;
+      ok = setsockopt(fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) == 0;
+      setsockopt(fd, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl));
+    }
+    if (ok) _group_addr = group.s_addr;   // not multicast: a unicast/broadcast peer
+  } else if (ok) {
+    ok = listen(fd, IP_BRIDGE_MAX_PEERS) == 0;
+  }
+
+  if (!ok) {
+    BRIDGE_DEBUG_PRINTLN("%s setup on port %d failed, errno=%d\n", udp ? "UDP" : "TCP", _port, errno);
+    close(fd);
+    retryLater();
+    return;
+  }
+
+  _fd = fd;
+  _backoff = IP_BRIDGE_MIN_BACKOFF;
+  if (udp) _stats.connects++;
+  BRIDGE_DEBUG_PRINTLN("%s ready on port %d\n", udp ? "UDP" : "TCP", _port);
+}
+
+void IPBridge::retryLater() {
+  _next_connect = millis() + _backoff;
+  _backoff *= 2;
+  if (_backoff > IP_BRIDGE_MAX_BACKOFF) _backoff = IP_BRIDGE_MAX_BACKOFF;
+}
+
+void IPBridge::closeConn(Conn &c) {
+  if (c.fd >= 0) close(c.fd);
+  c.fd = -1;
+  c.connecting = false;
+  c.rx_len = c.tx_len = 0;
+
+  if (_mode == IP_BRIDGE_TCP_CLIENT) retryLater();   // reconnect, backing off while the server stays away
+}
+
+void IPBridge::closeSockets() {
+  for (int i = 0; i < IP_BRIDGE_MAX_PEERS; i++) {
+    if (_conns[i].fd >= 0) closeConn(_conns[i]);
+  }
+  if (_fd >= 0) {
+    close(_fd);
+    _fd = -1;
+  }
+  _batch_count = 0;
+}
+
+void IPBridge::startConnect() {
+  Conn &c = _conns[0];
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(_port);
+
+  if (!resolveHost(_host, &addr.sin_addr)) {
+    BRIDGE_DEBUG_PRINTLN("Can't resolve %s\n", _host);
+    closeConn(c);
+    return;
+  }
+  c.fd = socket(AF_INET, SOCK_STREAM, 0);
+  if (c.fd < 0 || !setNonBlocking(c.fd)) {
+    closeConn(c);
+    return;
+  }
+  int one = 1;
+  setsockopt(c.fd, SOL_SOCKET, SO_KEEPALIVE, &one, sizeof(one));
+  setsockopt(c.fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));   // frames are already batched
+
+  if (connect(c.fd, (struct sockaddr *)&addr, sizeof(addr)) == 0) {
+    c.connecting = false;
+    _backoff = IP_BRIDGE_MIN_BACKOFF;
+    _stats.connects++;
+  } else if (errno == EINPROGRESS) {
+    c.connecting = true;
+    _next_connect = millis() + IP_BRIDGE_CONNECT_TIMEOUT;
+  } else {
+    BRIDGE_DEBUG_PRINTLN("connect to %s:%d failed, errno=%d\n", _host, _port, errno);
+    closeConn(c);
+  }
+}
+
+void IPBridge::acceptPeers() {
+  for (;;) {
+    int fd = accept(_fd, NULL, NULL);
+    if (fd < 0) break;
+
+    Conn *slot = NULL;
+    for (int i = 0; i < IP_BRIDGE_MAX_PEERS && slot == NULL; i++) {
+      if (_conns[i].fd < 0) slot = &_conns[i];
+    }
+    if (slot == NULL || !setNonBlocking(fd)) {
+      BRIDGE_DEBUG_PRINTLN("Peer refused, max %d\n", IP_BRIDGE_MAX_PEERS);
+      close(fd);
+      continue;
+    }
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    slot->fd = fd;
+    slot->connecting = false;
+    slot->rx_len = slot->tx_len = 0;
+    _stats.connects++;
+    BRIDGE_DEBUG_PRINTLN("Peer connected\n");
+  }
+}
+
+void IPBridge::flushConn(Conn &c) {
+  if (c.fd < 0 || c.connecting || c.tx_len == 0) return;
+
+  int n = send(c.fd, c.tx, c.tx_len, MSG_NOSIGNAL);
+  if (n > 0) {
+    c.tx_len -= n;
+    memmove(c.tx, &c.tx[n], c.tx_len);
+  } else if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+    BRIDGE_DEBUG_PRINTLN("TCP send failed, errno=%d\n", errno);
+    closeConn(c);
+  }
+}
+
+void IPBridge::pollConn(Conn &c) {
+  if (c.connecting) {
+    fd_set wfds;
+    FD_ZERO(&wfds);
+    FD_SET(c.fd, &wfds);
+    struct timeval tv = { 0, 0 };
+    if (select(c.fd + 1, NULL, &wfds, NULL, &tv) <= 0) {
+      if ((long)(millis() - _next_connect) >= 0) {
+        BRIDGE_DEBUG_PRINTLN("connect to %s:%d timed out\n", _host, _port);
+        closeConn(c);
+      }
+      return;
+    }
+    int err = 0;
+    socklen_t err_len = sizeof(err);
+    getsockopt(c.fd, SOL_SOCKET, SO_ERROR, &err, &err_len);
+    if (err != 0) {
+      BRIDGE_DEBUG_PRINTLN("connect to %s:%d failed, err=%d\n", _host, _port, err);
+      closeConn(c);
+      return;
+    }
+    c.connecting = false;
+    _backoff = IP_BRIDGE_MIN_BACKOFF;
+    _stats.connects++;
+    BRIDGE_DEBUG_PRINTLN("Connected to %s:%d\n", _host, _port);
+  }
+
+  flushConn(c);
+
+  while (c.fd >= 0) {
+    int n = recv(c.fd, &c.rx[c.rx_len], sizeof(c.rx) - c.rx_len, 0);
+    if (n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) {
+      BRIDGE_DEBUG_PRINTLN("Peer disconnected\n");
+      closeConn(c);
+      return;
+    }
+    if (n < 0) break;   // nothing more for now
+    c.rx_len += n;
+
+    // split the stream into frames, resyncing on the magic word after garbage
+    uint16_t pos = 0;
+    while (c.rx_len - pos >= BRIDGE_MAGIC_SIZE + BRIDGE_LENGTH_SIZE) {
+      const uint8_t *p = &c.rx[pos];
+      uint16_t len = BRIDGE_MAGIC_SIZE + BRIDGE_LENGTH_SIZE + ((p[2] << 8) | p[3]);
+      if (((p[0] << 8) | p[1]) != BRIDGE_PACKET_MAGIC || len > IP_BRIDGE_MAX_FRAME || len < HEADER_SIZE + MAC_SIZE) {
+        pos++;
+        continue;
+      }
+      if (c.rx_len - pos < len) break;   // rest hasn't arrived yet
+
+      processFrame(p, len);
+      pos += len;
+    }
+    c.rx_len -= pos;
+    memmove(c.rx, &c.rx[pos], c.rx_len);
+  }
+}
+
+void IPBridge::loop() {
+  // Guard against uninitialized state
+  if (_initialized == false) {
+    return;
+  }
+
+  if (!networkUp()) {
+    if (_fd >= 0 || _conns[0].fd >= 0) {
+      BRIDGE_DEBUG_PRINTLN("Network down\n");
+      closeSockets();
+    }
+    return;
+  }
+
+  unsigned long now = millis();
+  if (_mode == IP_BRIDGE_TCP_CLIENT) {
+    if (_conns[0].fd < 0 && (long)(now - _next_connect) >= 0) startConnect();
+  } else if (_fd < 0 && (long)(now - _next_connect) >= 0) {
+    openSockets();
+  }
+
+  if (_batch_count > 0 && now - _batch_started >= IP_BRIDGE_BATCH_MS) {
+    flushBatch();
+  }
+
+  if (_mode == IP_BRIDGE_UDP) {
+    if (_fd < 0) return;
+
+    uint8_t frame[IP_BRIDGE_MAX_FRAME];
+    for (int i = 0; i < IP_BRIDGE_RX_PER_LOOP; i++) {
+      int n = recv(_fd, frame, sizeof(frame), 0);
+      if (n <= 0) break;
+      processFrame(frame, n);
+    }
+  } else {
+    if (_mode == IP_BRIDGE_TCP_SERVER && _fd >= 0) acceptPeers();
+
+    for (int i = 0; i < IP_BRIDGE_MAX_PEERS; i++) {
+      if (_conns[i].fd >= 0) pollConn(_conns[i]);
+    }
+  }
+}
+
+void IPBridge::computeMAC(const uint8_t *data, size_t len, uint8_t *mac) const {
+  size_t key_len = strnlen(_prefs->bridge_secret, sizeof(_prefs->bridge_secret));
+  SHA256 sha;
+  sha.resetHMAC(_prefs->bridge_secret, key_len);
+  sha.update(data, len);
+  sha.finalizeHMAC(_prefs->bridge_secret, key_len, mac, MAC_SIZE);
+}
+
+void IPBridge::sendPacket(mesh::Packet *packet) {
+  // Guard against uninitialized state
+  if (_initialized == false) {
+    return;
+  }
+
+  // First validate the packet pointer
+  if (!packet) {
+    BRIDGE_DEBUG_PRINTLN("TX invalid packet pointer\n");
+    return;
+  }
+
+  if (_tables->allowForward(packet, _iface)) {
+    uint8_t raw[MAX_TRANS_UNIT + 1];
+    uint16_t len = packet->writeTo(raw);
+
+    if (_batch_count > 0 && (_batch_len + 2 + len + MAC_SIZE > IP_BRIDGE_MAX_FRAME || _batch_count == 255)) {
+      flushBatch();   // no room, send what we have and start a new frame
+    }
+    if (_batch_count == 0) {
+      _batch_len = HEADER_SIZE;
+      _batch_started = millis();
+    }
+    _batch[_batch_len++] = (len >> 8) & 0xFF;
+    _batch[_batch_len++] = len & 0xFF;
+    memcpy(&_batch[_batch_len], raw, len);
+    _batch_len += len;
+    _batch_count++;
+  }
+}
+
+void IPBridge::flushBatch() {
+  if (_batch_count == 0) return;
+
+  uint16_t body_len = _batch_len + MAC_SIZE - (BRIDGE_MAGIC_SIZE + BRIDGE_LENGTH_SIZE);
+  _batch[0] = (BRIDGE_PACKET_MAGIC >> 8) & 0xFF;
+  _batch[1] = BRIDGE_PACKET_MAGIC & 0xFF;
+  _batch[2] = (body_len >> 8) & 0xFF;
+  _batch[3] = body_len & 0xFF;
+  _batch[4] = FRAME_VERSION;
+  putU32(&_batch[5], _id);
+  putU32(&_batch[9], ++_seq);
+  putU32(&_batch[13], _rtc->getCurrentTime());
+  _batch[17] = _batch_count;
+  computeMAC(_batch, _batch_len, &_batch[_batch_len]);
+
+  BRIDGE_DEBUG_PRINTLN("TX, frame len=%d packets=%d\n", _batch_len + MAC_SIZE, _batch_count);
+  _stats.tx_frames++;
+  _stats.tx_packets += _batch_count;
+  sendFrame(_batch, _batch_len + MAC_SIZE);
+  _batch_count = 0;
+}
+
+void IPBridge::sendFrame(const uint8_t *frame, uint16_t len) {
+  if (_mode == IP_BRIDGE_UDP) {
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(_port);
+    addr.sin_addr.s_addr = _group_addr;
+    if (_fd < 0 || sendto(_fd, frame, len, 0, (struct sockaddr *)&addr, sizeof(addr)) != len) {
+      _stats.tx_dropped++;
+    }
+    return;
+  }
+
+  bool queued = false;
+  for (int i = 0; i < IP_BRIDGE_MAX_PEERS; i++) {
+    Conn &c = _conns[i];
+    if (c.fd < 0 || c.connecting) continue;
+
+    if (c.tx_len + len > sizeof(c.tx)) {
+      BRIDGE_DEBUG_PRINTLN("TCP backlog full, frame dropped\n");   // peer slower than the mesh
+      continue;
+    }
+    memcpy(&c.tx[c.tx_len], frame, len);
+    c.tx_len += len;
+    flushConn(c);
+    queued = true;
+  }
+  if (!queued) _stats.tx_dropped++;
+}
+
+bool IPBridge::acceptSequence(uint32_t id, uint32_t seq) {
+  Sender *s = NULL;
+  Sender *oldest = &_senders[0];
+  for (int i = 0; i < IP_BRIDGE_MAX_SENDERS && s == NULL; i++) {
+    if (_senders[i].window != 0 && _senders[i].id == id) {
+      s = &_senders[i];
+    } else if (_senders[i].window == 0 || (oldest->window != 0 && _senders[i].heard < oldest->heard)) {
+      oldest = &_senders[i];   // empty slot, or least recently heard
+    }
+  }
+
+  if (s == NULL) {   // new bridge (or one that rebooted, which picks a new id)
+    s = oldest;
+    s->id = id;
+    s->last_seq = seq;
+    s->window = 1;
+  } else {
+    int32_t ahead = (int32_t)(seq - s->last_seq);
+    if (ahead > 0) {
+      s->window = ahead >= 32 ? 1 : (s->window << ahead) | 1;
+      s->last_seq = seq;
+    } else {
+      uint32_t behind = (uint32_t)(-ahead);
+      if (behind >= 32 || (s->window & (1UL << behind))) return false;   // replayed, or too old to tell
+      s->window |= 1UL << behind;
+    }
+  }
+  s->heard = millis();
+  return true;
+}
+
+void IPBridge::processFrame(const uint8_t *frame, uint16_t len) {
+  if (len < HEADER_SIZE + MAC_SIZE || ((frame[0] << 8) | frame[1]) != BRIDGE_PACKET_MAGIC ||
+      BRIDGE_MAGIC_SIZE + BRIDGE_LENGTH_SIZE + ((frame[2] << 8) | frame[3]) != len) {
+    BRIDGE_DEBUG_PRINTLN("RX malformed frame, len=%d\n", len);
+    return;
+  }
+  if (frame[4] != FRAME_VERSION) return;
+
+  uint32_t sender = getU32(&frame[5]);
+  if (sender == _id) return;   // our own multicast, looped back
+
+  uint8_t mac[MAC_SIZE];
+  computeMAC(frame, len - MAC_SIZE, mac);
+  if (!macEquals(mac, &frame[len - MAC_SIZE], MAC_SIZE)) {
+    // wrong key - likely from a different network
+    BRIDGE_DEBUG_PRINTLN("RX MAC mismatch, sender=%08X\n", sender);
+    _stats.auth_failed++;
+    return;
+  }
+  if (IP_BRIDGE_MAX_SKEW > 0) {
+    int32_t skew = (int32_t)(getU32(&frame[13]) - _rtc->getCurrentTime());
+    if (skew > IP_BRIDGE_MAX_SKEW || skew < -IP_BRIDGE_MAX_SKEW) {
+      BRIDGE_DEBUG_PRINTLN("RX stale frame, sender=%08X skew=%d\n", sender, skew);   // or clocks not in sync
+      _stats.stale++;
+      return;
+    }
+  }
+  if (!acceptSequence(sender, getU32(&frame[9]))) {
+    BRIDGE_DEBUG_PRINTLN("RX replayed frame, sender=%08X\n", sender);
+    _stats.replayed++;
+    return;
+  }
+  _stats.rx_frames++;
+
+  uint8_t count = frame[17];
+  uint16_t pos = HEADER_SIZE;
+  const uint16_t end = len - MAC_SIZE;
+  while (count-- > 0 && pos + 2 <= end) {
+    uint16_t pkt_len = (frame[pos] << 8) | frame[pos + 1];
+    pos += 2;
+    if (pkt_len > end - pos || pkt_len > MAX_TRANS_UNIT + 1) break;
+
+    mesh::Packet *pkt = _mgr->allocNew();
+    if (!pkt) break;
+
+    if (pkt->readFrom(&frame[pos], pkt_len)) {
+      _stats.rx_packets++;
+      onPacketReceived(pkt);
+    } else {
+      _mgr->free(pkt);
+    }
+    pos += pkt_len;
+  }
+}
+
+void IPBridge::onPacketReceived(mesh::Packet *packet) {
+  // Guard against uninitialized state
+  if (_initialized == false) {
+    _mgr->free(packet);
+    return;
+  }
+
+  // pace re-injection: one slot per 1/IP_BRIDGE_RX_RATE sec, at most IP_BRIDGE_RX_BURST slots booked ahead
+  const unsigned long interval = 1000 / IP_BRIDGE_RX_RATE;
+  unsigned long now = millis();
+  if ((long)(_next_inject - now) < 0) _next_inject = now;
+  if (_next_inject - now >= interval * IP_BRIDGE_RX_BURST) {
+    BRIDGE_DEBUG_PRINTLN("RX rate limited, packet dropped\n");
+    _stats.rate_dropped++;
+    _mgr->free(packet);
+    return;
+  }
+  if (!_tables->allowInject(packet, _iface)) {
+    _mgr->free(packet);
+    return;
+  }
+  _mgr->queueInbound(packet, _next_inject + _prefs->bridge_delay);
+  _next_inject += interval;
+}
+
+#endif
@@ -0,0 +1,187 @@
+#pragma once
+
+#include "helpers/bridges/BridgeBase.h"
+
+/** IPBridge transport modes (value of WITH_IP_BRIDGE) */
+#define IP_BRIDGE_UDP          1   // UDP multicast, for a LAN
+#define IP_BRIDGE_TCP_CLIENT   2   // connects out to a TCP server (reconnects), for WAN links
+#define IP_BRIDGE_TCP_SERVER   3   // accepts up to IP_BRIDGE_MAX_PEERS TCP clients
+
+#ifdef WITH_IP_BRIDGE
+
+#ifndef IP_BRIDGE_HOST
+  #define IP_BRIDGE_HOST        "239.67.62.1"   // UDP: multicast group, TCP client: server address
+#endif
+#ifndef IP_BRIDGE_PORT
+  #define IP_BRIDGE_PORT        4862
+#endif
+#ifndef IP_BRIDGE_MAX_FRAME
+  #define IP_BRIDGE_MAX_FRAME   1200   // bytes per datagram / TCP record, below typical path MTU
+#endif
+#ifndef IP_BRIDGE_BATCH_MS
+  #define IP_BRIDGE_BATCH_MS      20   // longest a packet waits for others to share its frame
+#endif
+#ifndef IP_BRIDGE_RX_RATE
+  #define IP_BRIDGE_RX_RATE        4   // packets/sec re-injected into the mesh
+#endif
+#ifndef IP_BRIDGE_RX_BURST
+  #define IP_BRIDGE_RX_BURST       8   // packets that may be waiting for their re-injection slot (held in the pool)
+#endif
+#ifndef IP_BRIDGE_MAX_PEERS
+  #define IP_BRIDGE_MAX_PEERS      3
+#endif
+#ifndef IP_BRIDGE_TCP_TXBUF
+  #define IP_BRIDGE_TCP_TXBUF   2048
+#endif
+#ifndef IP_BRIDGE_MCAST_TTL
+  #define IP_BRIDGE_MCAST_TTL      1
+#endif
+#ifndef IP_BRIDGE_MAX_SKEW
+  #define IP_BRIDGE_MAX_SKEW     300   // secs a frame's timestamp may differ from our RTC, 0 = don't check
+#endif
+#define IP_BRIDGE_MAX_SENDERS      8   // remote bridges tracked for replay protection
+#define IP_BRIDGE_MAX_BACKOFF  30000
+
+struct IPBridgeStats {
+  uint32_t tx_frames, tx_packets, tx_dropped;
+  uint32_t rx_frames, rx_packets;
+  uint32_t auth_failed, replayed, stale, rate_dropped;
+  uint32_t connects;
+};
+
+/**
+ * @brief Bridge implementation over IP (UDP multicast or TCP) for linking distant mesh segments
+ *
+ * Packets forwarded to the bridge are batched, several to a frame, and sent once the frame is
+ * full or IP_BRIDGE_BATCH_MS has passed. Each frame is authenticated with an HMAC keyed by
+ * _prefs->bridge_secret and carries a sender id, sequence number and RTC timestamp, so frames from
+ * another network, altered in transit or replayed are dropped. The sequence window only covers the
+ * last IP_BRIDGE_MAX_SENDERS bridges heard since boot, so older frames are caught by the timestamp
+ * (IP_BRIDGE_MAX_SKEW, which needs the bridges' clocks roughly in sync), and a replay inside that
+ * window by the seen-set. Received packets are re-injected into the mesh no faster than
+ * IP_BRIDGE_RX_RATE, so a busy IP side can't flood the LoRa channel.
+ *
+ * Frame Structure (one UDP datagram, or one record in the TCP stream):
+ * [2 bytes] Magic Header (0xC03E)
+ * [2 bytes] Body Length - bytes that follow, including the MAC
+ * [1 byte]  Version
+ * [4 bytes] Sender Id - random per boot, also drops our own multicast echoes
+ * [4 bytes] Sequence Number
+ * [4 bytes] Timestamp - sender's RTC time (secs)
+ * [1 byte]  Packet Count
+ * Per packet: [2 bytes] Length, [n bytes] Mesh Packet
+ * [8 bytes] HMAC-SHA256 over everything above, truncated
+ *
+ * Uses BSD sockets only (lwIP on ESP32), so it also runs in a host build, eg. two
+ * simulated meshes bridged over localhost.
+ *
+ * Configuration:
+ * - Define WITH_IP_BRIDGE as IP_BRIDGE_UDP, IP_BRIDGE_TCP_CLIENT or IP_BRIDGE_TCP_SERVER
+ * - IP_BRIDGE_HOST and IP_BRIDGE_PORT for the group / server
+ * - On ESP32 define WIFI_SSID and WIFI_PWD, or bring WiFi up elsewhere
+ * - _prefs->bridge_secret is the shared key (same on every bridge)
+ */
+class IPBridge : public BridgeBase {
+public:
+  /**
+   * @brief Constructs an IPBridge instance
+   *
+   * @param prefs Node preferences for configuration settings
+   * @param mode IP_BRIDGE_UDP, IP_BRIDGE_TCP_CLIENT or IP_BRIDGE_TCP_SERVER
+   * @param host Multicast group (UDP) or server address (TCP client), unused for TCP server
+   * @param port UDP/TCP port
+   * @param mgr PacketManager for allocating and queuing packets
+   * @param rtc RTCClock for timestamping debug messages
+   * @param tables Seen-set, NULL for the node's shared one (give each simulated node its own)
+   */
+  IPBridge(NodePrefs *prefs, uint8_t mode, const char *host, uint16_t port, mesh::PacketManager *mgr,
+           mesh::RTCClock *rtc, BridgeTables *tables = NULL);
+
+  /**
+   * Starts the bridge. Sockets are opened from loop() once the network is up.
+   */
+  void begin() override;
+
+  /**
+   * Closes all sockets and stops the bridge
+   */
+  void end() override;
+
+  /**
+   * Main loop handler: (re)connects, flushes the batch, and receives frames
+   */
+  void loop() override;
+
+  /**
+   * Adds the packet to the outgoing batch, if not seen before
+   *
+   * @param packet The mesh packet to transmit
+   */
+  void sendPacket(mesh::Packet *packet) override;
+
+  /**
+   * Queues the packet for the mesh at the next re-injection slot, if not seen before
+   *
+   * @param packet The received mesh packet
+   */
+  void onPacketReceived(mesh::Packet *packet) override;
+
+  const IPBridgeStats &getStats() const { return _stats; }
+  int getNumConnected() const;
+
+private:
+  static constexpr uint8_t FRAME_VERSION = 2;
+  static constexpr uint16_t HEADER_SIZE = BRIDGE_MAGIC_SIZE + BRIDGE_LENGTH_SIZE + 1 + 4 + 4 + 4 + 1;
+  static constexpr uint16_t MAC_SIZE = 8;
+
+  struct Conn {
+    int fd;
+    bool connecting;
+    uint16_t rx_len, tx_len;
+    uint8_t rx[IP_BRIDGE_MAX_FRAME];
+    uint8_t tx[IP_BRIDGE_TCP_TXBUF];
+  };
+
+  struct Sender {
+    uint32_t id, last_seq, window;   // window: bit n set if (last_seq - n) was seen
+    unsigned long heard;
+  };
+
+  uint8_t _mode;
+  const char *_host;
+  uint16_t _port;
+  uint32_t _id, _seq;
+
+  int _fd;                 // UDP socket, or TCP listen socket
+  Conn _conns[IP_BRIDGE_MAX_PEERS];
+  unsigned long _next_connect;
+  uint32_t _backoff;
+  uint32_t _group_addr;    // UDP: network order
+
+  uint8_t _batch[IP_BRIDGE_MAX_FRAME];
+  uint16_t _batch_len;
+  uint8_t _batch_count;
+  unsigned long _batch_started;
+
+  unsigned long _next_inject;
+  Sender _senders[IP_BRIDGE_MAX_SENDERS];
+  IPBridgeStats _stats;
+
+  bool networkUp() const;
+  void retryLater();
+  void openSockets();
+  void closeSockets();
+  void closeConn(Conn &c);
+  void startConnect();
+  void acceptPeers();
+  void pollConn(Conn &c);
+  void flushConn(Conn &c);
+
+  void flushBatch();
+  void sendFrame(const uint8_t *frame, uint16_t len);
+  void computeMAC(const uint8_t *data, size_t len, uint8_t *mac) const;
+  bool acceptSequence(uint32_t id, uint32_t seq);
+  void processFrame(const uint8_t *frame, uint16_t len);
+};
+
+#endif
@@ -5,7 +5,7 @@
 #ifdef WITH_RS232_BRIDGE
 
 RS232Bridge::RS232Bridge(NodePrefs *prefs, Stream &serial, mesh::PacketManager *mgr, mesh::RTCClock *rtc)
-    : BridgeBase(prefs, mgr, rtc), _serial(&serial) {}
+    : BridgeBase(prefs, mgr, rtc, "rs232"), _serial(&serial) {}
 
 void RS232Bridge::begin() {
   BRIDGE_DEBUG_PRINTLN("Initializing at %d baud...\n", _prefs->bridge_baud);
@@ -115,7 +115,7 @@ void RS232Bridge::sendPacket(mesh::Packet *packet) {
     return;
   }
 
-  if (!_seen_packets.hasSeen(packet)) {
+  if (_tables->allowForward(packet, _iface)) {
 
     uint8_t buffer[MAX_SERIAL_PACKET_SIZE];
     uint16_t len = packet->writeTo(buffer + 4);
@@ -0,0 +1,368 @@
+#include "ATChannel.h"
+
+static const char* resultName(ATResult r) {
+  switch (r) {
+    case AT_OK:        return "OK";
+    case AT_ERROR:     return "FAIL";
+    case AT_TIMEOUT:   return "TIMEOUT";
+    default:           return "CANCELLED";
+  }
+}
+
+static bool isErrorCode(const char* line) {
+  return strcmp(line, "ERROR") == 0 ||
+         strncmp(line, "+CME ERROR", 10) == 0 ||
+         strncmp(line, "+CMS ERROR", 10) == 0;
+}
+
+// Result codes that end an ATD as well as being URCs for the call handler
+static bool isCallFailure(const char* line) {
+  return strcmp(line, "NO CARRIER") == 0 || strcmp(line, "BUSY") == 0 ||
+         strcmp(line, "NO ANSWER") == 0 || strcmp(line, "NO DIALTONE") == 0;
+}
+
+ATChannel::ATChannel() {
+  _stream = NULL;
+  _tag = "[AT]";
+  _trace = true;
+  _head = _count = 0;
+  _active = _payload_sent = _last_failed = false;
+  _sent_at = _settle_until = 0;
+  _name[0] = 0;
+  _is_dial = _take_text = false;
+  _line_len = _resp_len = 0;
+  _resp[0] = 0;
+  _raw_dest = NULL;
+  _raw_len = _raw_got = _raw_cap = 0;
+  _raw_done = NULL;
+  _raw_ctx = NULL;
+  _num_subs = 0;
+  resetStats();
+}
+
+void ATChannel::begin(Stream& stream, const char* tag) {
+  _stream = &stream;
+  _tag = tag;
+  reset();
+}
+
+bool ATChannel::subscribe(const char* prefix, ATLineFn fn, void* ctx) {
+  if (_num_subs >= AT_MAX_URC_SUBS) return false;
+  UrcSub& s = _subs[_num_subs++];
+  s.prefix = prefix;
+  s.len = strlen(prefix);
+  s.fn = fn;
+  s.ctx = ctx;
+  return true;
+}
+
+bool ATChannel::submit(const ATRequest& req) {
+  if (_count >= AT_QUEUE_SIZE || req.cmd == NULL) return false;
+
+  Slot& s = _queue[(_head + _count) % AT_QUEUE_SIZE];
+  strncpy(s.cmd, req.cmd, AT_CMD_MAX - 1);
+  s.cmd[AT_CMD_MAX - 1] = 0;
+  s.payload = req.payload;
+  s.payload_len = req.payload_len;
+  s.final_prefix = req.final_prefix;
+  s.timeout = req.timeout;
+  s.chain = req.chain;
+  s.text_lines = req.text_lines;
+  s.on_line = req.on_line;
+  s.done = req.done;
+  s.ctx = req.ctx;
+  s.queued_at = millis();
+  _count++;
+  if (_count > _stats.max_depth) _stats.max_depth = _count;
+
+  if (!_active && !isCapturing()) startNext(millis());
+  return true;
+}
+
+struct ATExecWait {
+  bool done;
+  ATResult result;
+  char* resp;
+  size_t resp_len;
+  ATDoneFn user_done;
+  void* user_ctx;
+};
+
+static void execDone(void* ctx, ATResult result, const char* resp) {
+  ATExecWait* w = (ATExecWait*)ctx;
+  if (w->resp && w->resp_len > 0) {
+    strncpy(w->resp, resp, w->resp_len - 1);
+    w->resp[w->resp_len - 1] = 0;
+  }
+  if (w->user_done) w->user_done(w->user_ctx, result, resp);
+  w->result = result;
+  w->done = true;
+}
+
+ATResult ATChannel::exec(const ATRequest& req, char* resp, size_t resp_len) {
+  if (_stream == NULL || req.cmd == NULL) return AT_CANCELLED;
+
+  ATExecWait w = { false, AT_CANCELLED, resp, resp_len, req.done, req.ctx };
+  if (resp && resp_len > 0) resp[0] = 0;
+
+  ATRequest r = req;
+  r.done = execDone;
+  r.ctx = &w;
+  while (!submit(r)) {   // queue full of async work: let some of it finish
+    poll();
+    delay(1);
+  }
+  while (!w.done) {
+    poll();
+    if (!w.done) delay(1);
+  }
+  return w.result;
+}
+
+ATResult ATChannel::exec(const char* cmd, uint32_t timeout, char* resp, size_t resp_len) {
+  ATRequest req;
+  req.cmd = cmd;
+  req.timeout = timeout;
+  return exec(req, resp, resp_len);
+}
+
+void ATChannel::poll() {
+  if (_stream == NULL) return;
+
+  while (_stream->available()) {
+    feed((char)_stream->read());
+    if (!_active && _count > 0 && !isCapturing()) startNext(millis());   // next command goes straight out
+  }
+
+  unsigned long now = millis();
+  if (_active && now - _sent_at >= _queue[_head].timeout) {
+    if (_queue[_head].payload && !_payload_sent) _stream->write((uint8_t)0x1B);   // ESC, abandon the prompt
+    _settle_until = now + AT_SETTLE_MS;
+    finish(AT_TIMEOUT);
+  }
+  if (!_active && !isCapturing()) startNext(now);
+}
+
+void ATChannel::captureRaw(uint8_t* dest, int len, int cap, ATRawFn done, void* ctx) {
+  if (len <= 0) {
+    if (done) done(ctx, dest, 0);
+    return;
+  }
+  _raw_dest = dest;
+  _raw_len = len;
+  _raw_got = 0;
+  _raw_cap = cap;
+  _raw_done = done;
+  _raw_ctx = ctx;
+}
+
+void ATChannel::reset() {
+  while (_count > 0) finish(AT_CANCELLED);
+  _active = false;
+  _last_failed = false;
+  _line_len = 0;
+  _resp_len = 0;
+  _resp[0] = 0;
+  _raw_len = 0;
+  _settle_until = millis();
+  if (_stream) {
+    while (_stream->available()) _stream->read();
+  }
+}
+
+void ATChannel::feed(char c) {
+  if (_raw_len > 0) {
+    if (_raw_got < _raw_cap) _raw_dest[_raw_got] = c;
+    if (++_raw_got >= _raw_len) {
+      int kept = _raw_len < _raw_cap ? _raw_len : _raw_cap;
+      _raw_len = 0;
+      if (_raw_done) _raw_done(_raw_ctx, _raw_dest, kept);
+    }
+    return;
+  }
+
+  if (c == '\r') return;
+  if (c == '\n') {
+    _line[_line_len] = 0;
+    int len = _line_len;
+    _line_len = 0;
+    if (len > 0 || _take_text) handleLine(_line);
+    return;
+  }
+  if (_line_len == 0) {
+    if (c == ' ') return;
+    if (c == '>' && _active && _queue[_head].payload && !_payload_sent) {   // "> " prompt has no line end
+      sendPayload();
+      return;
+    }
+  }
+  if (_line_len < AT_LINE_MAX - 1) _line[_line_len++] = c;
+}
+
+void ATChannel::handleLine(const char* line) {
+  if (!_active) {
+    if (dispatchURC(line)) return;
+    if (strcmp(line, "OK") == 0 || isErrorCode(line)) {
+      _stats.late_finals++;   // reply to a command that already timed out
+    } else {
+      _stats.unmatched++;
+    }
+    return;
+  }
+
+  Slot& s = _queue[_head];
+  if (_take_text) {   // even "OK" or "RING" here is somebody's message text
+    _take_text = false;
+    appendResp(line);
+    if (s.on_line) s.on_line(s.ctx, line);
+    return;
+  }
+  if (strcmp(line, s.cmd) == 0) return;   // echo, before ATE0
+
+  if (s.payload && !_payload_sent && strncmp(line, "CONNECT", 7) == 0) {
+    sendPayload();
+    return;
+  }
+  if (s.final_prefix && strncmp(line, s.final_prefix, strlen(s.final_prefix)) == 0) {
+    appendResp(line);
+    if (s.on_line) s.on_line(s.ctx, line);
+    finish(AT_OK);
+    return;
+  }
+  if (strcmp(line, "OK") == 0) {
+    appendResp(line);
+    if (!s.final_prefix) finish(AT_OK);   // else the result follows as its own line
+    return;
+  }
+  if (isErrorCode(line)) {
+    appendResp(line);
+    finish(AT_ERROR);
+    return;
+  }
+  if (_is_dial && isCallFailure(line)) {
+    dispatchURC(line);   // the call handler tracks these too
+    appendResp(line);
+    finish(AT_ERROR);
+    return;
+  }
+  if (_name[0] && strncmp(line, _name, strlen(_name)) == 0) {   // this command's own info line
+    appendResp(line);
+    _take_text = s.text_lines;
+    if (s.on_line) s.on_line(s.ctx, line);
+    return;
+  }
+  if (dispatchURC(line)) return;
+
+  appendResp(line);
+  if (s.on_line) s.on_line(s.ctx, line);
+}
+
+bool ATChannel::dispatchURC(const char* line) {
+  for (int i = 0; i < _num_subs; i++) {
+    if (strncmp(line, _subs[i].prefix, _subs[i].len) == 0) {
+      _stats.urcs++;
+      _subs[i].fn(_subs[i].ctx, line);
+      return true;
+    }
+  }
+  return false;
+}
+
+// Lines kept in the modem's own "\r\n" layout, so callers can parse them as before
+void ATChannel::appendResp(const char* line) {
+  int len = strlen(line);
+  if (_resp_len + len + 2 >= AT_RESP_MAX) return;
+  memcpy(&_resp[_resp_len], line, len);
+  _resp_len += len;
+  _resp[_resp_len++] = '\r';
+  _resp[_resp_len++] = '\n';
+  _resp[_resp_len] = 0;
+}
+
+void ATChannel::sendPayload() {
+  Slot& s = _queue[_head];
+  _stream->write(s.payload, s.payload_len);
+  _payload_sent = true;
+  if (_trace) Serial.printf("%s TX: <%d bytes>\n", _tag, s.payload_len);
+}
+
+void ATChannel::setCommandName(const char* cmd) {
+  _name[0] = 0;
+  _is_dial = strncmp(cmd, "ATD", 3) == 0;
+  if (strncmp(cmd, "AT+", 3) != 0) return;
+
+  int n = 0;
+  _name[n++] = '+';
+  for (const char* p = cmd + 3; *p && *p != '=' && *p != '?' && n < (int)sizeof(_name) - 2; p++) {
+    _name[n++] = *p;
+  }
+  _name[n++] = ':';
+  _name[n] = 0;
+}
+
+void ATChannel::startNext(unsigned long now) {
+  while (_count > 0 && !_active) {
+    if ((long)(now - _settle_until) < 0) return;
+
+    // Whatever has already arrived predates this command, so it's URCs
+    while (_stream->available() && !isCapturing()) feed((char)_stream->read());
+    if (_active || _count == 0 || isCapturing()) return;
+
+    Slot& s = _queue[_head];
+    if (s.chain && _last_failed) {
+      finish(AT_CANCELLED);
+      continue;
+    }
+
+    uint32_t waited = now - s.queued_at;
+    if (waited > _stats.max_queue_ms) _stats.max_queue_ms = waited;
+
+    setCommandName(s.cmd);
+    _resp_len = 0;
+    _resp[0] = 0;
+    _payload_sent = false;
+    _take_text = false;
+    _active = true;
+    _sent_at = now;
+    _stats.sent++;
+
+    if (_trace) Serial.printf("%s TX: %s\n", _tag, s.cmd);
+    _stream->print(s.cmd);
+    _stream->print("\r\n");
+  }
+}
+
+void ATChannel::finish(ATResult result) {
+  Slot& s = _queue[_head];
+  bool was_active = _active;
+
+  switch (result) {
+    case AT_OK:      _stats.ok++; break;
+    case AT_ERROR:   _stats.failed++; break;
+    case AT_TIMEOUT: _stats.timeouts++; break;
+    default:         _stats.cancelled++; break;
+  }
+  if (was_active && (result == AT_OK || result == AT_ERROR)) {
+    uint32_t ms = millis() - _sent_at;
+    _stats.last_ms = ms;
+    _stats.total_ms += ms;
+    if (ms > _stats.max_ms) _stats.max_ms = ms;
+  }
+  if (_trace && was_active) {
+    if (_resp_len > 0) {
+      Serial.printf("%s RX: %.120s [%s, %lums]\n", _tag, _resp, resultName(result), millis() - _sent_at);
+    } else {
+      Serial.printf("%s RX: (no response) [%s]\n", _tag, resultName(result));
+    }
+  }
+
+  ATDoneFn done = s.done;
+  void* ctx = s.ctx;
+  _head = (_head + 1) % AT_QUEUE_SIZE;
+  _count--;
+  _active = false;
+  _take_text = false;
+  _last_failed = (result != AT_OK);
+
+  if (done) done(ctx, result, was_active ? _resp : "");
+}
@@ -0,0 +1,184 @@
+#pragma once
+
+#include <Arduino.h>
+
+// =============================================================================
+// ATChannel - shared AT command transport for the A76xx modem drivers
+//
+// One owner task feeds the UART through poll(). Bytes are split into lines as
+// they arrive, and each line is either part of the response to the command in
+// flight, or an unsolicited result code (URC) routed to whoever subscribed to
+// its prefix. A line "+XYZ: ..." belongs to the command AT+XYZ while that is
+// in flight, so queries like AT+CREG? still see their answer when +CREG: is
+// also subscribed as a URC.
+//
+// Commands are queued and written back to back: the next one goes out as soon
+// as the previous final result code arrives, each with its own timeout
+// counted from when it was written. submit() returns immediately and reports
+// through a callback, so a slow command (SMS send, MQTT publish) no longer
+// stalls the task loop. exec() is the blocking form, for init sequences.
+//
+// Commands with a payload (SMS body, MQTT topic, file data) write it when the
+// modem prompts with '>' or CONNECT. A command marked 'chain' is cancelled if
+// the command before it failed, for multi-step operations like publish.
+//
+// Depends only on Stream and millis(), so it can be driven from a host test
+// against a pty or a scripted modem.
+// =============================================================================
+
+#ifndef AT_QUEUE_SIZE
+  #define AT_QUEUE_SIZE        8     // commands waiting or in flight
+#endif
+#ifndef AT_MAX_URC_SUBS
+  #define AT_MAX_URC_SUBS     16
+#endif
+#define AT_CMD_MAX           256     // longest command line (CMQTTCONNECT with credentials)
+#define AT_LINE_MAX          256
+#define AT_RESP_MAX          512     // response lines of the command in flight
+#define AT_DEFAULT_TIMEOUT  2000
+#define AT_SETTLE_MS         200     // quiet time after a timeout, so a late reply isn't taken as the next one's
+
+enum ATResult : uint8_t {
+  AT_OK = 0,       // OK (or the command's final prefix)
+  AT_ERROR,        // ERROR / +CME ERROR / +CMS ERROR / call failure code
+  AT_TIMEOUT,
+  AT_CANCELLED,    // chained after a failed command, or channel reset
+};
+
+typedef void (*ATLineFn)(void* ctx, const char* line);
+typedef void (*ATDoneFn)(void* ctx, ATResult result, const char* resp);
+typedef void (*ATRawFn)(void* ctx, const uint8_t* data, int len);
+
+struct ATRequest {
+  const char* cmd = nullptr;
+  uint32_t timeout = AT_DEFAULT_TIMEOUT;
+  const uint8_t* payload = nullptr;   // not copied, must stay valid until done
+  int payload_len = 0;
+  const char* final_prefix = nullptr; // complete on this line instead of OK (eg. "+CMQTTCONNECT:")
+  bool chain = false;                 // cancel if the previous command failed
+  bool text_lines = false;            // each +XYZ: info line is followed by one line of free text (SMS body)
+  ATLineFn on_line = nullptr;         // each response line as it arrives
+  ATDoneFn done = nullptr;
+  void* ctx = nullptr;
+};
+
+struct ATStats {
+  uint32_t sent, ok, failed, timeouts, cancelled;
+  uint32_t urcs, unmatched, late_finals;
+  uint32_t last_ms, max_ms, total_ms;   // write -> final result
+  uint32_t max_queue_ms;                // submit -> write
+  uint16_t max_depth;
+
+  uint32_t avgMillis() const { uint32_t n = ok + failed; return n ? total_ms / n : 0; }
+};
+
+class ATChannel {
+  struct Slot {
+    char cmd[AT_CMD_MAX];
+    const uint8_t* payload;
+    int payload_len;
+    const char* final_prefix;
+    uint32_t timeout;
+    bool chain;
+    bool text_lines;
+    ATLineFn on_line;
+    ATDoneFn done;
+    void* ctx;
+    unsigned long queued_at;
+  };
+  struct UrcSub {
+    const char* prefix;
+    uint8_t len;
+    ATLineFn fn;
+    void* ctx;
+  };
+
+  Stream* _stream;
+  const char* _tag;
+  bool _trace;
+
+  Slot _queue[AT_QUEUE_SIZE];
+  int _head, _count;
+  bool _active;            // _queue[_head] has been written
+  bool _payload_sent;
+  bool _last_failed;
+  unsigned long _sent_at;
+  unsigned long _settle_until;
+  char _name[24];          // "+XYZ:" of the command in flight
+  bool _is_dial;
+  bool _take_text;         // next line is text, whatever it looks like
+
+  char _line[AT_LINE_MAX];
+  int _line_len;
+  char _resp[AT_RESP_MAX];
+  int _resp_len;
+
+  uint8_t* _raw_dest;
+  int _raw_len, _raw_got, _raw_cap;
+  ATRawFn _raw_done;
+  void* _raw_ctx;
+
+  UrcSub _subs[AT_MAX_URC_SUBS];
+  int _num_subs;
+
+  ATStats _stats;
+
+  void feed(char c);
+  void handleLine(const char* line);
+  bool dispatchURC(const char* line);
+  void appendResp(const char* line);
+  void sendPayload();
+  void startNext(unsigned long now);
+  void finish(ATResult result);
+  void setCommandName(const char* cmd);
+
+public:
+  ATChannel();
+
+  /**
+   * \brief  attach to the modem UART, dropping anything queued. Subscriptions are kept.
+   */
+  void begin(Stream& stream, const char* tag);
+  void setTrace(bool on) { _trace = on; }
+
+  /**
+   * \brief  route lines starting with 'prefix' to fn (prefix must be a string literal / static)
+   */
+  bool subscribe(const char* prefix, ATLineFn fn, void* ctx);
+
+  /**
+   * \brief  queue a command; its done() runs from poll()
+   * \returns  false if the queue is full
+   */
+  bool submit(const ATRequest& req);
+
+  /**
+   * \brief  queue a command and run poll() until it completes (not from inside a callback)
+   * \param  resp  optional copy of the response lines, final result included
+   */
+  ATResult exec(const ATRequest& req, char* resp = nullptr, size_t resp_len = 0);
+  ATResult exec(const char* cmd, uint32_t timeout, char* resp = nullptr, size_t resp_len = 0);
+
+  /**
+   * \brief  read input, route lines, complete/time out the command in flight and start the next
+   */
+  void poll();
+
+  /**
+   * \brief  take the next 'len' bytes raw (after a length-prefixed URC such as +CMQTTRXTOPIC).
+   *         Bytes beyond 'cap' are discarded. done() gets what was kept.
+   */
+  void captureRaw(uint8_t* dest, int len, int cap, ATRawFn done, void* ctx);
+  bool isCapturing() const { return _raw_len > 0; }
+
+  /**
+   * \brief  cancel everything queued and discard pending input
+   */
+  void reset();
+
+  bool isIdle() const { return _count == 0; }
+  int  getDepth() const { return _count; }
+  int  getFree() const { return AT_QUEUE_SIZE - _count; }
+  const ATStats& getStats() const { return _stats; }
+  void resetStats() { memset(&_stats, 0, sizeof(_stats)); }
+};
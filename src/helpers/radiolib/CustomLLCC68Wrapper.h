@@ -12,8 +12,8 @@ public:
   float getCurrentRSSI() override {
     return ((CustomLLCC68 *)_radio)->getRSSI(false);
   }
-  float getLastRSSI() const override { return ((CustomLLCC68 *)_radio)->getRSSI(); }
-  float getLastSNR() const override { return ((CustomLLCC68 *)_radio)->getSNR(); }
+  float readLastRSSI() const override { return ((CustomLLCC68 *)_radio)->getRSSI(); }
+  float readLastSNR() const override { return ((CustomLLCC68 *)_radio)->getSNR(); }
 
   float packetScore(float snr, int packet_len) override {
     int sf = ((CustomLLCC68 *)_radio)->spreadingFactor;
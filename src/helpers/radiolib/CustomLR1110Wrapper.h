@@ -20,7 +20,7 @@ public:
     _radio->setPreambleLength(16); // overcomes weird issues with small and big pkts
   }
 
-  float getLastRSSI() const override { return ((CustomLR1110 *)_radio)->getRSSI(); }
-  float getLastSNR() const override { return ((CustomLR1110 *)_radio)->getSNR(); }
+  float readLastRSSI() const override { return ((CustomLR1110 *)_radio)->getRSSI(); }
+  float readLastSNR() const override { return ((CustomLR1110 *)_radio)->getSNR(); }
   int16_t setRxBoostedGainMode(bool en) { return ((CustomLR1110 *)_radio)->setRxBoostedGainMode(en); };
 };
@@ -12,8 +12,8 @@ public:
   float getCurrentRSSI() override {
     return ((CustomSX1268 *)_radio)->getRSSI(false);
   }
-  float getLastRSSI() const override { return ((CustomSX1268 *)_radio)->getRSSI(); }
-  float getLastSNR() const override { return ((CustomSX1268 *)_radio)->getSNR(); }
+  float readLastRSSI() const override { return ((CustomSX1268 *)_radio)->getRSSI(); }
+  float readLastSNR() const override { return ((CustomSX1268 *)_radio)->getSNR(); }
 
   float packetScore(float snr, int packet_len) override {
     int sf = ((CustomSX1268 *)_radio)->spreadingFactor;
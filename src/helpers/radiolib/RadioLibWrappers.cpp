@@ -10,9 +10,19 @@
 
 #define NUM_NOISE_FLOOR_SAMPLES  64
 #define SAMPLING_THRESHOLD  14
+#define CHAN_BUSY_MARGIN    10   // dB above noise floor counted as 'busy', when interference threshold is disabled
 
 static volatile uint8_t state = STATE_IDLE;
 
+#if RADIO_RX_TASK
+  #include <freertos/task.h>
+
+  #define RX_TASK_STACK_SIZE   3072
+  #define RX_TASK_PRIORITY     (configMAX_PRIORITIES - 2)   // above loop() and UI, below system tasks
+
+static TaskHandle_t rx_task_handle = NULL;
+#endif
+
 // this function is called when a complete packet
 // is transmitted by the module
 static 
@@ -22,9 +32,22 @@ static
 void setFlag(void) {
   // we sent a packet, set the flag
   state |= STATE_INT_READY;
+#if RADIO_RX_TASK
+  if (rx_task_handle) {   // defer to Rx task, to read packet out of radio
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(rx_task_handle, &woken);
+    if (woken) portYIELD_FROM_ISR();
+  }
+#endif
 }
 
 void RadioLibWrapper::begin() {
+#if RADIO_RX_TASK
+  if (_lock == NULL) _lock = xSemaphoreCreateRecursiveMutex();
+  if (rx_task_handle == NULL) {
+    xTaskCreatePinnedToCore(rxTaskLoop, "radio_rx", RX_TASK_STACK_SIZE, this, RX_TASK_PRIORITY, &rx_task_handle, xPortGetCoreID());
+  }
+#endif
   _radio->setPacketReceivedAction(setFlag);  // this is also SentComplete interrupt
   state = STATE_IDLE;
 
@@ -38,11 +61,49 @@ void RadioLibWrapper::begin() {
   // start average out some samples
   _num_floor_samples = 0;
   _floor_sample_sum = 0;
+
+  _analytics.begin(millis());
+  _next_chan_sample = 0;
+  _tx_start = 0;
+  _was_detecting = false;
+}
+
+#if RADIO_RX_TASK
+void RadioLibWrapper::rxTaskLoop(void* arg) {
+  auto self = (RadioLibWrapper *) arg;
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);   // wait for DIO interrupt
+    self->drainRadio();
+    if (self->_wake_fn) self->_wake_fn(self->_wake_ctx);
+  }
 }
 
+void RadioLibWrapper::drainRadio() {
+  lockRadio();
+  if ((state & STATE_INT_READY) && (state & ~STATE_INT_READY) == STATE_RX) {   // Rx done (Tx done is handled by loop())
+    if ((uint8_t)(_rx_head - _rx_tail) >= RX_RING_SIZE) {
+      _rx_dropped++;   // loop() is way behind
+      state = STATE_IDLE;
+    } else {
+      RxFrame* f = &_rx_ring[_rx_head & (RX_RING_SIZE - 1)];
+      int len = readPacket(f->data, MAX_TRANS_UNIT, f->rssi, f->snr);
+      if (len > 0) {
+        f->len = len;
+        __sync_synchronize();   // frame contents must be visible before head moves
+        _rx_head++;
+      }
+    }
+    startRecv();   // back to Rx straight away
+  }
+  unlockRadio();
+}
+#endif
+
 void RadioLibWrapper::idle() {
+  lockRadio();
   _radio->standby();
   state = STATE_IDLE;   // need another startReceive()
+  unlockRadio();
 }
 
 void RadioLibWrapper::triggerNoiseFloorCalibrate(int threshold) {
@@ -54,15 +115,33 @@ void RadioLibWrapper::triggerNoiseFloorCalibrate(int threshold) {
 }
 
 void RadioLibWrapper::resetAGC() {
+  lockRadio();
   // make sure we're not mid-receive of packet!
-  if ((state & STATE_INT_READY) != 0 || isReceivingPacket()) return;
+  if ((state & STATE_INT_READY) == 0 && !isReceivingPacket()) {
+    // NOTE: according to higher powers, just issuing RadioLib's startReceive() will reset the AGC.
+    //      revisit this if a better impl is discovered.
+    state = STATE_IDLE;   // trigger a startReceive()
+  }
+  unlockRadio();
+}
 
-  // NOTE: according to higher powers, just issuing RadioLib's startReceive() will reset the AGC.
-  //      revisit this if a better impl is discovered.
-  state = STATE_IDLE;   // trigger a startReceive()
+void RadioLibWrapper::sampleChannel() {
+  bool detecting = isReceivingPacket();
+  if (detecting && !_was_detecting) _analytics.addRxDetect(millis());   // preamble/header seen
+  _was_detecting = detecting;
+
+  int rssi = getCurrentRSSI();
+  int margin = _threshold ? _threshold : CHAN_BUSY_MARGIN;
+  _analytics.addRSSISample(rssi, detecting || (_noise_floor != 0 && rssi > _noise_floor + margin), millis());
 }
 
 void RadioLibWrapper::loop() {
+  lockRadio();
+  if (state == STATE_RX && (long)(millis() - _next_chan_sample) >= 0) {
+    sampleChannel();
+    _next_chan_sample = millis() + CHAN_SAMPLE_INTERVAL_MILLIS;
+  }
+
   if (state == STATE_RX && _num_floor_samples < NUM_NOISE_FLOOR_SAMPLES) {
     if (!isReceivingPacket()) {
       int rssi = getCurrentRSSI();
@@ -80,6 +159,16 @@ void RadioLibWrapper::loop() {
 
     MESH_DEBUG_PRINTLN("RadioLibWrapper: noise_floor = %d", (int)_noise_floor);
   }
+  unlockRadio();
+}
+
+uint32_t RadioLibWrapper::getIdleMillis() {
+#if RADIO_RX_TASK
+  if (_rx_tail != _rx_head) return 0;   // frames waiting for recvRaw()
+#endif
+  if (state != STATE_RX && state != STATE_TX_WAIT) return 0;   // done flag set, or needs startReceive()
+  // NOTE: channel sampling and noise floor are best effort, they run on whatever loop() passes there are
+  return IDLE_NO_DEADLINE;
 }
 
 void RadioLibWrapper::startRecv() {
@@ -95,32 +184,51 @@ bool RadioLibWrapper::isInRecvMode() const {
   return (state & ~STATE_INT_READY) == STATE_RX;
 }
 
+int RadioLibWrapper::readPacket(uint8_t* bytes, int sz, float& rssi, float& snr) {
+  int len = _radio->getPacketLength();
+  if (len > 0) {
+    if (len > sz) { len = sz; }
+    int err = _radio->readData(bytes, len);
+    if (err != RADIOLIB_ERR_NONE) {
+      MESH_DEBUG_PRINTLN("RadioLibWrapper: error: readData(%d)", err);
+      len = 0;
+      _analytics.addRxError(millis());   // mostly CRC errors, ie. collisions
+    } else {
+    //  Serial.print("  readData() -> "); Serial.println(len);
+      n_recv++;
+      rssi = readLastRSSI();
+      snr = readLastSNR();
+      _analytics.addRxPacket(getEstAirtimeFor(len), millis());
+    }
+  }
+  state = STATE_IDLE;   // need another startReceive()
+  return len;
+}
+
 int RadioLibWrapper::recvRaw(uint8_t* bytes, int sz) {
+#if RADIO_RX_TASK
+  if (_rx_tail != _rx_head) {   // packet already drained by Rx task
+    RxFrame* f = &_rx_ring[_rx_tail & (RX_RING_SIZE - 1)];
+    int len = f->len > sz ? sz : f->len;
+    memcpy(bytes, f->data, len);
+    _last_rssi = f->rssi;
+    _last_snr = f->snr;
+    __sync_synchronize();   // done with frame, before producer can re-use it
+    _rx_tail++;
+    return len;
+  }
+#endif
+
   int len = 0;
-  if (state & STATE_INT_READY) {
-    len = _radio->getPacketLength();
-    if (len > 0) {
-      if (len > sz) { len = sz; }
-      int err = _radio->readData(bytes, len);
-      if (err != RADIOLIB_ERR_NONE) {
-        MESH_DEBUG_PRINTLN("RadioLibWrapper: error: readData(%d)", err);
-        len = 0;
-      } else {
-      //  Serial.print("  readData() -> "); Serial.println(len);
-        n_recv++;
-      }
-    }
-    state = STATE_IDLE;   // need another startReceive()
+  lockRadio();
+  if (state & STATE_INT_READY) {   // NOTE: with Rx task, only for packet that woke us from deep sleep
+    len = readPacket(bytes, sz, _last_rssi, _last_snr);
   }
 
   if (state != STATE_RX) {
-    int err = _radio->startReceive();
-    if (err == RADIOLIB_ERR_NONE) {
-      state = STATE_RX;
-    } else {
-      MESH_DEBUG_PRINTLN("RadioLibWrapper: error: startReceive(%d)", err);
-    }
+    startRecv();
   }
+  unlockRadio();
   return len;
 }
 
@@ -130,30 +238,39 @@ uint32_t RadioLibWrapper::getEstAirtimeFor(int len_bytes) {
 
 bool RadioLibWrapper::startSendRaw(const uint8_t* bytes, int len) {
   _board->onBeforeTransmit();
+  lockRadio();
   int err = _radio->startTransmit((uint8_t *) bytes, len);
   if (err == RADIOLIB_ERR_NONE) {
     state = STATE_TX_WAIT;
+    _tx_start = millis();
+    unlockRadio();
     return true;
   }
   MESH_DEBUG_PRINTLN("RadioLibWrapper: error: startTransmit(%d)", err);
   idle();   // trigger another startRecv()
+  unlockRadio();
   _board->onAfterTransmit();
   return false;
 }
 
 bool RadioLibWrapper::isSendComplete() {
   if (state & STATE_INT_READY) {
+    lockRadio();
     state = STATE_IDLE;
     n_sent++;
+    _analytics.addTxAirtime(millis() - _tx_start, millis());
+    unlockRadio();
     return true;
   }
   return false;
 }
 
 void RadioLibWrapper::onSendFinished() {
+  lockRadio();
   _radio->finishTransmit();
-  _board->onAfterTransmit();
   state = STATE_IDLE;
+  unlockRadio();
+  _board->onAfterTransmit();
 }
 
 bool RadioLibWrapper::isChannelActive() {
@@ -162,13 +279,6 @@ bool RadioLibWrapper::isChannelActive() {
           : getCurrentRSSI() > _noise_floor + _threshold;
 }
 
-float RadioLibWrapper::getLastRSSI() const {
-  return _radio->getRSSI();
-}
-float RadioLibWrapper::getLastSNR() const {
-  return _radio->getSNR();
-}
-
 // Approximate SNR threshold per SF for successful reception (based on Semtech datasheets)
 static float snr_threshold[] = {
     -7.5,  // SF7 needs at least -7.5 dB SNR
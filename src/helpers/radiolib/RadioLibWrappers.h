@@ -2,6 +2,28 @@
 
 #include <Mesh.h>
 #include <RadioLib.h>
+#include <helpers/ChannelAnalytics.h>
+
+#ifndef RADIO_RX_TASK
+  #if defined(ESP32)
+    #define RADIO_RX_TASK   1   // drain received packets from a high priority task, so they aren't lost while loop() is blocked
+  #else
+    #define RADIO_RX_TASK   0
+  #endif
+#endif
+
+#if RADIO_RX_TASK
+  #include <freertos/FreeRTOS.h>
+  #include <freertos/semphr.h>
+
+  #define RX_RING_SIZE   8   // must be power of 2
+
+struct RxFrame {
+  float rssi, snr;
+  uint16_t len;
+  uint8_t data[MAX_TRANS_UNIT+1];
+};
+#endif
 
 class RadioLibWrapper : public mesh::Radio {
 protected:
@@ -11,16 +33,46 @@ protected:
   int16_t _noise_floor, _threshold;
   uint16_t _num_floor_samples;
   int32_t _floor_sample_sum;
+  ChannelAnalytics _analytics;
+  unsigned long _next_chan_sample, _tx_start;
+  bool _was_detecting;
+  float _last_rssi, _last_snr;
+#if RADIO_RX_TASK
+  RxFrame _rx_ring[RX_RING_SIZE];
+  volatile uint8_t _rx_head, _rx_tail;   // single producer (Rx task), single consumer (loop)
+  uint32_t _rx_dropped;
+  SemaphoreHandle_t _lock;
+  void (*_wake_fn)(void* ctx);
+  void* _wake_ctx;
+
+  static void rxTaskLoop(void* arg);
+  void drainRadio();
+#endif
+
+  void sampleChannel();
+  int readPacket(uint8_t* bytes, int sz, float& rssi, float& snr);
+  virtual float readLastRSSI() const { return _radio->getRSSI(); }   // of packet just received
+  virtual float readLastSNR() const { return _radio->getSNR(); }
 
-  void idle();
   void startRecv();
   float packetScoreInt(float snr, int sf, int packet_len);
   virtual bool isReceivingPacket() =0;
 
 public:
-  RadioLibWrapper(PhysicalLayer& radio, mesh::MainBoard& board) : _radio(&radio), _board(&board) { n_recv = n_sent = 0; }
+  RadioLibWrapper(PhysicalLayer& radio, mesh::MainBoard& board) : _radio(&radio), _board(&board) {
+    n_recv = n_sent = 0;
+    _last_rssi = _last_snr = 0;
+  #if RADIO_RX_TASK
+    _rx_head = _rx_tail = 0;
+    _rx_dropped = 0;
+    _lock = NULL;
+    _wake_fn = NULL;
+    _wake_ctx = NULL;
+  #endif
+  }
 
   void begin() override;
+  void idle();   // standby, and Rx task leaves radio alone until next recvRaw()
   virtual void powerOff() { _radio->sleep(); }
   int recvRaw(uint8_t* bytes, int sz) override;
   uint32_t getEstAirtimeFor(int len_bytes) override;
@@ -31,25 +83,51 @@ public:
   bool isChannelActive();
 
   bool isReceiving() override { 
-    if (isReceivingPacket()) return true;
-
-    return isChannelActive();
+    lockRadio();
+    bool busy = isReceivingPacket() || isChannelActive();
+    _analytics.addLBTCheck(busy, millis());
+    unlockRadio();
+    return busy;
   }
 
+  // for code outside this class that accesses the radio (eg. changing radio params)
+  // NOTE: this guards radio state only. A shared SPI bus (e-ink, SD) is arbitrated per transaction by the HAL
+#if RADIO_RX_TASK
+  void lockRadio() { if (_lock) xSemaphoreTakeRecursive(_lock, portMAX_DELAY); }
+  void unlockRadio() { if (_lock) xSemaphoreGiveRecursive(_lock); }
+  uint32_t getRxDropped() const { return _rx_dropped; }
+  // called from the Rx task after each radio interrupt (Rx or Tx done), eg. to wake an idle loop
+  void setWakeHook(void (*fn)(void* ctx), void* ctx) { _wake_ctx = ctx; _wake_fn = fn; }
+#else
+  void lockRadio() { }
+  void unlockRadio() { }
+  uint32_t getRxDropped() const { return 0; }
+  void setWakeHook(void (*fn)(void* ctx), void* ctx) { }
+#endif
+
   virtual float getCurrentRSSI() =0;
 
   int getNoiseFloor() const override { return _noise_floor; }
+  uint8_t getChannelBusyPercent() const override { return _analytics.getBusyPercent(); }
+  const ChannelAnalytics& getChannelAnalytics() const { return _analytics; }
+  // consistent copy for other tasks (eg. UI), the Rx task and loop() update the analytics under the radio lock
+  void getChannelStats(int minutes, ChannelStats& dest) {
+    lockRadio();
+    _analytics.getStats(minutes, dest, millis());
+    unlockRadio();
+  }
   void triggerNoiseFloorCalibrate(int threshold) override;
   void resetAGC() override;
 
   void loop() override;
+  uint32_t getIdleMillis() override;
 
   uint32_t getPacketsRecv() const { return n_recv; }
   uint32_t getPacketsSent() const { return n_sent; }
   void resetStats() { n_recv = n_sent = 0; }
 
-  virtual float getLastRSSI() const override;
-  virtual float getLastSNR() const override;
+  float getLastRSSI() const override { return _last_rssi; }
+  float getLastSNR() const override { return _last_snr; }
 
   float packetScore(float snr, int packet_len) override { return packetScoreInt(snr, 10, packet_len); }  // assume sf=10
 };
@@ -149,6 +149,171 @@ public:
 static RAK12500LocationProvider RAK12500_provider;
 #endif
 
+// Sampler drivers, one per sensor. Reads happen on the sampler (task or loop()), never inside
+// querySensors(), so they can take their time.
+
+#if ENV_INCLUDE_AHTX0
+static bool readAHTX0(EnvSample& s) {
+  sensors_event_t humidity, temp;
+  AHTX0.getEvent(&humidity, &temp);
+  s.add(TELEM_CHANNEL_SELF, ENV_TEMPERATURE, temp.temperature);
+  s.add(TELEM_CHANNEL_SELF, ENV_HUMIDITY, humidity.relative_humidity);
+  return true;
+}
+static const EnvSensorDriver AHTX0_driver = { "AHTX0", 80, ENV_SAMPLE_PERIOD_MS, NULL, readAHTX0 };
+#endif
+
+#if ENV_INCLUDE_BME680
+static bool startBME680() {
+  return BME680.beginReading() != 0;   // heater + TPH conversion runs while we're away
+}
+static bool readBME680(EnvSample& s) {
+  if (!BME680.endReading()) return false;
+  s.add(TELEM_CHANNEL_SELF, ENV_TEMPERATURE, BME680.temperature);
+  s.add(TELEM_CHANNEL_SELF, ENV_HUMIDITY, BME680.humidity);
+  s.add(TELEM_CHANNEL_SELF, ENV_PRESSURE, BME680.pressure / 100);
+  s.add(TELEM_CHANNEL_SELF, ENV_ALTITUDE, 44330.0 * (1.0 - pow((BME680.pressure / 100) / TELEM_BME680_SEALEVELPRESSURE_HPA, 0.1903)));
+  s.add(ENV_CHANNEL_NEXT, ENV_ANALOG, BME680.gas_resistance);
+  return true;
+}
+static const EnvSensorDriver BME680_driver = { "BME680", 200, ENV_SAMPLE_PERIOD_MS, startBME680, readBME680 };
+#endif
+
+#if ENV_INCLUDE_BME280
+static bool readBME280(EnvSample& s) {
+  if (!BME280.takeForcedMeasurement()) return false;  // trigger a fresh reading in forced mode
+  s.add(TELEM_CHANNEL_SELF, ENV_TEMPERATURE, BME280.readTemperature());
+  s.add(TELEM_CHANNEL_SELF, ENV_HUMIDITY, BME280.readHumidity());
+  s.add(TELEM_CHANNEL_SELF, ENV_PRESSURE, BME280.readPressure()/100);
+  s.add(TELEM_CHANNEL_SELF, ENV_ALTITUDE, BME280.readAltitude(TELEM_BME280_SEALEVELPRESSURE_HPA));
+  return true;
+}
+static const EnvSensorDriver BME280_driver = { "BME280", 10, ENV_SAMPLE_PERIOD_MS, NULL, readBME280 };
+#endif
+
+#if ENV_INCLUDE_BMP280
+static bool readBMP280(EnvSample& s) {
+  s.add(TELEM_CHANNEL_SELF, ENV_TEMPERATURE, BMP280.readTemperature());
+  s.add(TELEM_CHANNEL_SELF, ENV_PRESSURE, BMP280.readPressure()/100);
+  s.add(TELEM_CHANNEL_SELF, ENV_ALTITUDE, BMP280.readAltitude(TELEM_BMP280_SEALEVELPRESSURE_HPA));
+  return true;
+}
+static const EnvSensorDriver BMP280_driver = { "BMP280", 5, ENV_SAMPLE_PERIOD_MS, NULL, readBMP280 };
+#endif
+
+#if ENV_INCLUDE_SHTC3
+static bool readSHTC3(EnvSample& s) {
+  sensors_event_t humidity, temp;
+  SHTC3.getEvent(&humidity, &temp);
+  s.add(TELEM_CHANNEL_SELF, ENV_TEMPERATURE, temp.temperature);
+  s.add(TELEM_CHANNEL_SELF, ENV_HUMIDITY, humidity.relative_humidity);
+  return true;
+}
+static const EnvSensorDriver SHTC3_driver = { "SHTC3", 15, ENV_SAMPLE_PERIOD_MS, NULL, readSHTC3 };
+#endif
+
+#if ENV_INCLUDE_SHT4X
+static bool readSHT4X(EnvSample& s) {
+  float sht4x_humidity, sht4x_temperature;
+  if (SHT4X.measureLowestPrecision(sht4x_temperature, sht4x_humidity) != 0) return false;
+  s.add(TELEM_CHANNEL_SELF, ENV_TEMPERATURE, sht4x_temperature);
+  s.add(TELEM_CHANNEL_SELF, ENV_HUMIDITY, sht4x_humidity);
+  return true;
+}
+static const EnvSensorDriver SHT4X_driver = { "SHT4X", 2, ENV_SAMPLE_PERIOD_MS, NULL, readSHT4X };
+#endif
+
+#if ENV_INCLUDE_LPS22HB
+static bool readLPS22HB(EnvSample& s) {
+  s.add(TELEM_CHANNEL_SELF, ENV_TEMPERATURE, LPS22HB.readTemperature());
+  s.add(TELEM_CHANNEL_SELF, ENV_PRESSURE, LPS22HB.readPressure() * 10); // convert kPa to hPa
+  return true;
+}
+static const EnvSensorDriver LPS22HB_driver = { "LPS22HB", 40, ENV_SAMPLE_PERIOD_MS, NULL, readLPS22HB };
+#endif
+
+#if ENV_INCLUDE_INA3221
+static bool readINA3221(EnvSample& s) {
+  uint8_t ch = ENV_CHANNEL_NEXT;
+  for(int i = 0; i < TELEM_INA3221_NUM_CHANNELS; i++) {
+    // add only enabled INA3221 channels to telemetry
+    if (INA3221.isChannelEnabled(i)) {
+      float voltage = INA3221.getBusVoltage(i);
+      float current = INA3221.getCurrentAmps(i);
+      s.add(ch, ENV_VOLTAGE, voltage);
+      s.add(ch, ENV_CURRENT, current);
+      s.add(ch, ENV_POWER, voltage * current);
+      ch++;
+    }
+  }
+  return true;
+}
+static const EnvSensorDriver INA3221_driver = { "INA3221", 2, ENV_POWER_SAMPLE_PERIOD_MS, NULL, readINA3221 };
+#endif
+
+#if ENV_INCLUDE_INA219
+static bool readINA219(EnvSample& s) {
+  s.add(ENV_CHANNEL_NEXT, ENV_VOLTAGE, INA219.getBusVoltage_V());
+  s.add(ENV_CHANNEL_NEXT, ENV_CURRENT, INA219.getCurrent_mA() / 1000);
+  s.add(ENV_CHANNEL_NEXT, ENV_POWER, INA219.getPower_mW() / 1000);
+  return true;
+}
+static const EnvSensorDriver INA219_driver = { "INA219", 2, ENV_POWER_SAMPLE_PERIOD_MS, NULL, readINA219 };
+#endif
+
+#if ENV_INCLUDE_INA260
+static bool readINA260(EnvSample& s) {
+  s.add(ENV_CHANNEL_NEXT, ENV_VOLTAGE, INA260.readBusVoltage() / 1000);
+  s.add(ENV_CHANNEL_NEXT, ENV_CURRENT, INA260.readCurrent() / 1000);
+  s.add(ENV_CHANNEL_NEXT, ENV_POWER, INA260.readPower() / 1000);
+  return true;
+}
+static const EnvSensorDriver INA260_driver = { "INA260", 2, ENV_POWER_SAMPLE_PERIOD_MS, NULL, readINA260 };
+#endif
+
+#if ENV_INCLUDE_INA226
+static bool readINA226(EnvSample& s) {
+  s.add(ENV_CHANNEL_NEXT, ENV_VOLTAGE, INA226.getBusVoltage());
+  s.add(ENV_CHANNEL_NEXT, ENV_CURRENT, INA226.getCurrent_mA() / 1000.0);
+  s.add(ENV_CHANNEL_NEXT, ENV_POWER, INA226.getPower_mW() / 1000.0);
+  return true;
+}
+static const EnvSensorDriver INA226_driver = { "INA226", 2, ENV_POWER_SAMPLE_PERIOD_MS, NULL, readINA226 };
+#endif
+
+#if ENV_INCLUDE_MLX90614
+static bool readMLX90614(EnvSample& s) {
+  s.add(TELEM_CHANNEL_SELF, ENV_TEMPERATURE, MLX90614.readObjectTempC());
+  s.add(TELEM_CHANNEL_SELF + 1, ENV_TEMPERATURE, MLX90614.readAmbientTempC());
+  return true;
+}
+static const EnvSensorDriver MLX90614_driver = { "MLX90614", 2, ENV_SAMPLE_PERIOD_MS, NULL, readMLX90614 };
+#endif
+
+#if ENV_INCLUDE_VL53L0X
+static bool readVL53L0X(EnvSample& s) {
+  VL53L0X_RangingMeasurementData_t measure;
+  VL53L0X.rangingTest(&measure, false); // pass in 'true' to get debug data
+  if (measure.RangeStatus != 4) { // phase failures
+    s.add(TELEM_CHANNEL_SELF, ENV_DISTANCE, measure.RangeMilliMeter / 1000.0f); // convert mm to m
+  } else {
+    s.add(TELEM_CHANNEL_SELF, ENV_DISTANCE, 0.0f); // no valid measurement
+  }
+  return true;
+}
+static const EnvSensorDriver VL53L0X_driver = { "VL53L0X", 35, ENV_POWER_SAMPLE_PERIOD_MS, NULL, readVL53L0X };
+#endif
+
+#if ENV_INCLUDE_BMP085
+static bool readBMP085(EnvSample& s) {
+  s.add(TELEM_CHANNEL_SELF, ENV_TEMPERATURE, BMP085.readTemperature());
+  s.add(TELEM_CHANNEL_SELF, ENV_PRESSURE, BMP085.readPressure() / 100);
+  s.add(TELEM_CHANNEL_SELF, ENV_ALTITUDE, BMP085.readAltitude(TELEM_BMP085_SEALEVELPRESSURE_HPA * 100));
+  return true;
+}
+static const EnvSensorDriver BMP085_driver = { "BMP085", 30, ENV_SAMPLE_PERIOD_MS, NULL, readBMP085 };
+#endif
+
 bool EnvironmentSensorManager::begin() {
   #if ENV_INCLUDE_GPS
   #ifdef RAK_WISBLOCK_GPS
@@ -173,6 +338,7 @@ bool EnvironmentSensorManager::begin() {
   if (AHTX0.begin(TELEM_WIRE, 0, TELEM_AHTX_ADDRESS)) {
     MESH_DEBUG_PRINTLN("Found AHT10/AHT20 at address: %02X", TELEM_AHTX_ADDRESS);
     AHTX0_initialized = true;
+    addSensor(AHTX0_driver);
   } else {
     AHTX0_initialized = false;
     MESH_DEBUG_PRINTLN("AHT10/AHT20 was not found at I2C address %02X", TELEM_AHTX_ADDRESS);
@@ -183,6 +349,7 @@ bool EnvironmentSensorManager::begin() {
   if (BME680.begin(TELEM_BME680_ADDRESS, TELEM_WIRE)) {
     MESH_DEBUG_PRINTLN("Found BME680 at address: %02X", TELEM_BME680_ADDRESS);
     BME680_initialized = true;
+    addSensor(BME680_driver);
   } else {
     BME680_initialized = false;
     MESH_DEBUG_PRINTLN("BME680 was not found at I2C address %02X", TELEM_BME680_ADDRESS);
@@ -201,6 +368,7 @@ bool EnvironmentSensorManager::begin() {
                        Adafruit_BME280::FILTER_OFF,
                        Adafruit_BME280::STANDBY_MS_1000);
     BME280_initialized = true;
+    addSensor(BME280_driver);
   } else {
     BME280_initialized = false;
     MESH_DEBUG_PRINTLN("BME280 was not found at I2C address %02X", TELEM_BME280_ADDRESS);
@@ -212,6 +380,7 @@ bool EnvironmentSensorManager::begin() {
     MESH_DEBUG_PRINTLN("Found BMP280 at address: %02X", TELEM_BMP280_ADDRESS);
     MESH_DEBUG_PRINTLN("BMP sensor ID: %02X", BMP280.sensorID());
     BMP280_initialized = true;
+    addSensor(BMP280_driver);
   } else {
     BMP280_initialized = false;
     MESH_DEBUG_PRINTLN("BMP280 was not found at I2C address %02X", TELEM_BMP280_ADDRESS);
@@ -222,6 +391,7 @@ bool EnvironmentSensorManager::begin() {
   if (SHTC3.begin(TELEM_WIRE)) {
     MESH_DEBUG_PRINTLN("Found sensor: SHTC3");
     SHTC3_initialized = true;
+    addSensor(SHTC3_driver);
   } else {
     SHTC3_initialized = false;
     MESH_DEBUG_PRINTLN("SHTC3 was not found at I2C address %02X", 0x70);
@@ -237,6 +407,7 @@ bool EnvironmentSensorManager::begin() {
   if (sht4x_error == 0) {
     MESH_DEBUG_PRINTLN("Found SHT4X at address: %02X", TELEM_SHT4X_ADDRESS);
     SHT4X_initialized = true;
+    addSensor(SHT4X_driver);
   } else {
     SHT4X_initialized = false;
     MESH_DEBUG_PRINTLN("SHT4X was not found at I2C address %02X", TELEM_SHT4X_ADDRESS);
@@ -247,6 +418,7 @@ bool EnvironmentSensorManager::begin() {
   if (LPS22HB.begin()) {
     MESH_DEBUG_PRINTLN("Found sensor: LPS22HB");
     LPS22HB_initialized = true;
+    addSensor(LPS22HB_driver);
   } else {
     LPS22HB_initialized = false;
     MESH_DEBUG_PRINTLN("LPS22HB was not found at I2C address %02X", 0x5C);
@@ -262,6 +434,7 @@ bool EnvironmentSensorManager::begin() {
       INA3221.setShuntResistance(i, TELEM_INA3221_SHUNT_VALUE);
     }
     INA3221_initialized = true;
+    addSensor(INA3221_driver);
   } else {
     INA3221_initialized = false;
     MESH_DEBUG_PRINTLN("INA3221 was not found at I2C address %02X", TELEM_INA3221_ADDRESS);
@@ -272,6 +445,7 @@ bool EnvironmentSensorManager::begin() {
   if (INA219.begin(TELEM_WIRE)) {
     MESH_DEBUG_PRINTLN("Found INA219 at address: %02X", TELEM_INA219_ADDRESS);
     INA219_initialized = true;
+    addSensor(INA219_driver);
   } else {
     INA219_initialized = false;
     MESH_DEBUG_PRINTLN("INA219 was not found at I2C address %02X", TELEM_INA219_ADDRESS);
@@ -282,6 +456,7 @@ bool EnvironmentSensorManager::begin() {
   if (INA260.begin(TELEM_INA260_ADDRESS, TELEM_WIRE)) {
     MESH_DEBUG_PRINTLN("Found INA260 at address: %02X", TELEM_INA260_ADDRESS);
     INA260_initialized = true;
+    addSensor(INA260_driver);
   } else {
     INA260_initialized = false;
     MESH_DEBUG_PRINTLN("INA260 was not found at I2C address %02X", TELEM_INA219_ADDRESS);
@@ -293,6 +468,7 @@ bool EnvironmentSensorManager::begin() {
     MESH_DEBUG_PRINTLN("Found INA226 at address: %02X", TELEM_INA226_ADDRESS);
     INA226.setMaxCurrentShunt(TELEM_INA226_MAX_AMP, TELEM_INA226_SHUNT_VALUE);
     INA226_initialized = true;
+    addSensor(INA226_driver);
   } else {
     INA226_initialized = false;
     MESH_DEBUG_PRINTLN("INA226 was not found at I2C address %02X", TELEM_INA226_ADDRESS);
@@ -303,6 +479,7 @@ bool EnvironmentSensorManager::begin() {
   if (MLX90614.begin(TELEM_MLX90614_ADDRESS, TELEM_WIRE)) {
     MESH_DEBUG_PRINTLN("Found MLX90614 at address: %02X", TELEM_MLX90614_ADDRESS);
     MLX90614_initialized = true;
+    addSensor(MLX90614_driver);
   } else {
     MLX90614_initialized = false;
     MESH_DEBUG_PRINTLN("MLX90614 was not found at I2C address %02X", TELEM_MLX90614_ADDRESS);
@@ -313,6 +490,7 @@ bool EnvironmentSensorManager::begin() {
   if (VL53L0X.begin(TELEM_VL53L0X_ADDRESS, false, TELEM_WIRE)) {
     MESH_DEBUG_PRINTLN("Found VL53L0X at address: %02X", TELEM_VL53L0X_ADDRESS);
     VL53L0X_initialized = true;
+    addSensor(VL53L0X_driver);
   } else {
     VL53L0X_initialized = false;
     MESH_DEBUG_PRINTLN("VL53L0X was not found at I2C address %02X", TELEM_VL53L0X_ADDRESS);
@@ -325,12 +503,14 @@ bool EnvironmentSensorManager::begin() {
   if (BMP085.begin(0, TELEM_WIRE)) {
     MESH_DEBUG_PRINTLN("Found sensor BMP085");
     BMP085_initialized = true;
+    addSensor(BMP085_driver);
   } else {
     BMP085_initialized = false;
     MESH_DEBUG_PRINTLN("BMP085 was not found at I2C address %02X", 0x77);
   }
   #endif
 
+  startSampler();
   return true;
 }
 
@@ -342,152 +522,166 @@ bool EnvironmentSensorManager::querySensors(uint8_t requester_permissions, Cayen
   }
 
   if (requester_permissions & TELEM_PERM_ENVIRONMENT) {
-
-    #if ENV_INCLUDE_AHTX0
-    if (AHTX0_initialized) {
-      sensors_event_t humidity, temp;
-      AHTX0.getEvent(&humidity, &temp);
-      telemetry.addTemperature(TELEM_CHANNEL_SELF, temp.temperature);
-      telemetry.addRelativeHumidity(TELEM_CHANNEL_SELF, humidity.relative_humidity);
-    }
-    #endif
-
-    #if ENV_INCLUDE_BME680
-    if (BME680_initialized) {
-      if (BME680.performReading()) {
-        telemetry.addTemperature(TELEM_CHANNEL_SELF, BME680.temperature);
-        telemetry.addRelativeHumidity(TELEM_CHANNEL_SELF, BME680.humidity);
-        telemetry.addBarometricPressure(TELEM_CHANNEL_SELF, BME680.pressure / 100);
-        telemetry.addAltitude(TELEM_CHANNEL_SELF, 44330.0 * (1.0 - pow((BME680.pressure / 100) / TELEM_BME680_SEALEVELPRESSURE_HPA, 0.1903)));
-        telemetry.addAnalogInput(next_available_channel, BME680.gas_resistance);
-        next_available_channel++;
+    // serialise the sampler's latest values, no sensor I/O here
+    unsigned long now = millis();
+#if ENV_SAMPLE_LAZY
+    if ((long)(now - _demand_until) >= 0) {   // sampler was idle: take fresh samples for the next request
+      for (int i = 0; i < _num_slots; i++) {
+        if (!_slots[i].converting) _slots[i].next_due = now;
       }
     }
-    #endif
-
-    #if ENV_INCLUDE_BME280
-    if (BME280_initialized) {
-      if (BME280.takeForcedMeasurement()) {  // trigger a fresh reading in forced mode
-        telemetry.addTemperature(TELEM_CHANNEL_SELF, BME280.readTemperature());
-        telemetry.addRelativeHumidity(TELEM_CHANNEL_SELF, BME280.readHumidity());
-        telemetry.addBarometricPressure(TELEM_CHANNEL_SELF, BME280.readPressure()/100);
-        telemetry.addAltitude(TELEM_CHANNEL_SELF, BME280.readAltitude(TELEM_BME280_SEALEVELPRESSURE_HPA));
+    _demand_until = now + ENV_LAZY_WINDOW_MS;
+#endif
+    EnvSample sample;
+    for (int i = 0; i < _num_slots; i++) {
+      getSample(_slots[i], sample);
+      if (sample.count == 0) continue;  // failed, or not sampled yet
+#if !ENV_SAMPLE_LAZY
+      const EnvSensorDriver* d = _slots[i].driver;
+      if (now - sample.at_ms > 3 * d->period_ms + d->conversion_ms + 5000) continue;  // sampler stuck
+#endif   // lazy: the last value however old, rather than nothing after a quiet spell
+
+      int own_channels = 0;
+      for (int j = 0; j < sample.count; j++) {
+        const EnvReading& r = sample.readings[j];
+        uint8_t ch = r.channel;
+        if (ch >= ENV_CHANNEL_NEXT) {
+          ch = next_available_channel + (ch - ENV_CHANNEL_NEXT);
+          if (r.channel - ENV_CHANNEL_NEXT + 1 > own_channels) own_channels = r.channel - ENV_CHANNEL_NEXT + 1;
+        }
+        switch (r.type) {
+          case ENV_TEMPERATURE: telemetry.addTemperature(ch, r.value); break;
+          case ENV_HUMIDITY:    telemetry.addRelativeHumidity(ch, r.value); break;
+          case ENV_PRESSURE:    telemetry.addBarometricPressure(ch, r.value); break;
+          case ENV_ALTITUDE:    telemetry.addAltitude(ch, r.value); break;
+          case ENV_ANALOG:      telemetry.addAnalogInput(ch, r.value); break;
+          case ENV_VOLTAGE:     telemetry.addVoltage(ch, r.value); break;
+          case ENV_CURRENT:     telemetry.addCurrent(ch, r.value); break;
+          case ENV_POWER:       telemetry.addPower(ch, r.value); break;
+          case ENV_DISTANCE:    telemetry.addDistance(ch, r.value); break;
+        }
       }
+      next_available_channel += own_channels;
     }
-    #endif
-
-    #if ENV_INCLUDE_BMP280
-    if (BMP280_initialized) {
-      telemetry.addTemperature(TELEM_CHANNEL_SELF, BMP280.readTemperature());
-      telemetry.addBarometricPressure(TELEM_CHANNEL_SELF, BMP280.readPressure()/100);
-      telemetry.addAltitude(TELEM_CHANNEL_SELF, BMP280.readAltitude(TELEM_BMP280_SEALEVELPRESSURE_HPA));
-    }
-    #endif
-
-    #if ENV_INCLUDE_SHTC3
-    if (SHTC3_initialized) {
-      sensors_event_t humidity, temp;
-      SHTC3.getEvent(&humidity, &temp);
+  }
 
-      telemetry.addTemperature(TELEM_CHANNEL_SELF, temp.temperature);
-      telemetry.addRelativeHumidity(TELEM_CHANNEL_SELF, humidity.relative_humidity);
-    }
-    #endif
+  return true;
+}
 
-    #if ENV_INCLUDE_SHT4X
-    if (SHT4X_initialized) {
-      float sht4x_humidity, sht4x_temperature;
-      int16_t sht4x_error;
-      sht4x_error = SHT4X.measureLowestPrecision(sht4x_temperature, sht4x_humidity);
-      if (sht4x_error == 0) {
-        telemetry.addTemperature(TELEM_CHANNEL_SELF, sht4x_temperature);
-        telemetry.addRelativeHumidity(TELEM_CHANNEL_SELF, sht4x_humidity);
-      }
-    }
-    #endif
+void EnvironmentSensorManager::addSensor(const EnvSensorDriver& driver) {
+  if (_num_slots >= ENV_MAX_SENSORS) {
+    MESH_DEBUG_PRINTLN("Too many sensors, %s not sampled", driver.name);
+    return;
+  }
+  Slot& slot = _slots[_num_slots++];
+  memset(&slot, 0, sizeof(slot));
+  slot.driver = &driver;
+}
 
-    #if ENV_INCLUDE_LPS22HB
-    if (LPS22HB_initialized) {
-      telemetry.addTemperature(TELEM_CHANNEL_SELF, LPS22HB.readTemperature());
-      telemetry.addBarometricPressure(TELEM_CHANNEL_SELF, LPS22HB.readPressure() * 10); // convert kPa to hPa
-    }
-    #endif
+// Retries only if a whole publish completed during the copy, never on one that's in progress,
+// so a higher priority reader can't spin on a preempted sampler (same scheme as GNSSLocationProvider)
+void EnvironmentSensorManager::getSample(const Slot& slot, EnvSample& dest) const {
+  uint32_t seq;
+  do {
+    seq = slot.seq;
+    __sync_synchronize();
+    dest = slot.sample[seq & 1];
+    __sync_synchronize();
+  } while (seq != slot.seq);
+}
 
-    #if ENV_INCLUDE_INA3221
-    if (INA3221_initialized) {
-      for(int i = 0; i < TELEM_INA3221_NUM_CHANNELS; i++) {
-        // add only enabled INA3221 channels to telemetry
-        if (INA3221.isChannelEnabled(i)) {
-          float voltage = INA3221.getBusVoltage(i);
-          float current = INA3221.getCurrentAmps(i);
-          telemetry.addVoltage(next_available_channel, voltage);
-          telemetry.addCurrent(next_available_channel, current);
-          telemetry.addPower(next_available_channel, voltage * current);
-          next_available_channel++;
-        }
-      }
-    }
-    #endif
+void EnvironmentSensorManager::publish(Slot& slot, const EnvSample& sample) {
+  uint32_t seq = slot.seq + 1;
+  slot.sample[seq & 1] = sample;
+  __sync_synchronize();
+  slot.seq = seq;
+}
 
-    #if ENV_INCLUDE_INA219
-    if (INA219_initialized) {
-      telemetry.addVoltage(next_available_channel, INA219.getBusVoltage_V());
-      telemetry.addCurrent(next_available_channel, INA219.getCurrent_mA() / 1000);
-      telemetry.addPower(next_available_channel, INA219.getPower_mW() / 1000);
-      next_available_channel++;
-    }
-    #endif
+void EnvironmentSensorManager::finishSample(Slot& slot) {
+  EnvSample sample;
+  sample.count = 0;
+  if (!slot.driver->read(sample)) sample.count = 0;   // omitted from telemetry, like a failed read was
+  sample.at_ms = millis();
+  slot.converting = false;
+  publish(slot, sample);
+}
 
-    #if ENV_INCLUDE_INA260
-    if (INA260_initialized) {
-      telemetry.addVoltage(next_available_channel, INA260.readBusVoltage() / 1000);
-      telemetry.addCurrent(next_available_channel, INA260.readCurrent() / 1000);
-      telemetry.addPower(next_available_channel, INA260.readPower() / 1000);
-      next_available_channel++;
+bool EnvironmentSensorManager::stepSampler(unsigned long now) {
+  Slot* due = NULL;
+  for (int i = 0; i < _num_slots; i++) {
+    Slot& slot = _slots[i];
+    if (slot.converting) {   // one conversion in flight at a time, finish it first
+      if ((long)(now - slot.ready_at) < 0) return false;
+      finishSample(slot);
+      return true;
     }
-    #endif
-
-    #if ENV_INCLUDE_INA226
-    if (INA226_initialized) {
-      telemetry.addVoltage(next_available_channel, INA226.getBusVoltage());
-      telemetry.addCurrent(next_available_channel, INA226.getCurrent_mA() / 1000.0);
-      telemetry.addPower(next_available_channel, INA226.getPower_mW() / 1000.0);
-      next_available_channel++;
+    if ((long)(now - slot.next_due) >= 0 && (due == NULL || (long)(slot.next_due - due->next_due) < 0)) {
+      due = &slot;   // most overdue
     }
-    #endif
+  }
+  if (due == NULL) return false;
+
+  due->next_due = now + due->driver->period_ms;
+  if (due->driver->start == NULL) {
+    finishSample(*due);
+  } else if (due->driver->start()) {
+    due->converting = true;
+    due->ready_at = now + due->driver->conversion_ms;
+  } else {
+    EnvSample failed;
+    failed.count = 0;
+    failed.at_ms = now;
+    publish(*due, failed);
+  }
+  return true;
+}
 
-    #if ENV_INCLUDE_MLX90614
-    if (MLX90614_initialized) {
-      telemetry.addTemperature(TELEM_CHANNEL_SELF, MLX90614.readObjectTempC());
-      telemetry.addTemperature(TELEM_CHANNEL_SELF + 1, MLX90614.readAmbientTempC());
-    }
-    #endif
+uint32_t EnvironmentSensorManager::millisToNextSample(unsigned long now) const {
+  uint32_t ms = 0xFFFFFFFF;
+  for (int i = 0; i < _num_slots; i++) {
+    unsigned long at = _slots[i].converting ? _slots[i].ready_at : _slots[i].next_due;
+    long d = (long)(at - now);
+    if (_slots[i].converting && d > 0) return d;   // nothing else starts until it's collected
+    if (d <= 0) return 0;
+    if ((uint32_t)d < ms) ms = d;
+  }
+  return ms;
+}
 
-    #if ENV_INCLUDE_VL53L0X
-    if (VL53L0X_initialized) {
-      VL53L0X_RangingMeasurementData_t measure;
-      VL53L0X.rangingTest(&measure, false); // pass in 'true' to get debug data
-      if (measure.RangeStatus != 4) { // phase failures
-        telemetry.addDistance(TELEM_CHANNEL_SELF, measure.RangeMilliMeter / 1000.0f); // convert mm to m
-      } else {
-        telemetry.addDistance(TELEM_CHANNEL_SELF, 0.0f); // no valid measurement
-      }
-    }
-    #endif
+void EnvironmentSensorManager::startSampler() {
+  if (_num_slots == 0) return;
 
-    #if ENV_INCLUDE_BMP085
-    if (BMP085_initialized) {
-        telemetry.addTemperature(TELEM_CHANNEL_SELF, BMP085.readTemperature());
-        telemetry.addBarometricPressure(TELEM_CHANNEL_SELF, BMP085.readPressure() / 100);
-        telemetry.addAltitude(TELEM_CHANNEL_SELF, BMP085.readAltitude(TELEM_BMP085_SEALEVELPRESSURE_HPA * 100));
-    }
-    #endif
+  // first round now, so the first telemetry request has values
+  unsigned long now = millis();
+  for (int i = 0; i < _num_slots; i++) {
+    const EnvSensorDriver* d = _slots[i].driver;
+    if (d->start && d->start()) delay(d->conversion_ms);
+    finishSample(_slots[i]);
+    _slots[i].next_due = now + d->period_ms;
+  }
 
+#if ENV_SENSOR_TASK
+  if (_task == NULL) {
+    xTaskCreatePinnedToCore(taskEntry, "sensors", ENV_TASK_STACK_SIZE, this, ENV_TASK_PRIORITY, &_task, ENV_TASK_CORE);
   }
+#endif
+}
 
-  return true;
+#if ENV_SENSOR_TASK
+void EnvironmentSensorManager::taskEntry(void* param) {
+  static_cast<EnvironmentSensorManager*>(param)->taskLoop();
 }
 
+void EnvironmentSensorManager::taskLoop() {
+  for (;;) {
+    while (stepSampler(millis())) { }
+
+    uint32_t ms = millisToNextSample(millis());
+    if (ms > ENV_SAMPLE_PERIOD_MS) ms = ENV_SAMPLE_PERIOD_MS;
+    vTaskDelay(pdMS_TO_TICKS(ms) + 1);
+  }
+}
+#endif
 
 int EnvironmentSensorManager::getNumSettings() const {
   int settings = 0;
@@ -703,10 +897,19 @@ void EnvironmentSensorManager::stop_gps() {
   #endif
 }
 
+#endif
+
 void EnvironmentSensorManager::loop() {
-  static long next_gps_update = 0;
+#if !ENV_SENSOR_TASK
+  #if ENV_SAMPLE_LAZY
+  if ((long)(millis() - _demand_until) < 0)
+  #endif
+  stepSampler(millis());   // at most one sensor read per pass
+#endif
 
   #if ENV_INCLUDE_GPS
+  static long next_gps_update = 0;
+
   _location->loop();
   if (millis() > next_gps_update) {
 
@@ -733,4 +936,3 @@ void EnvironmentSensorManager::loop() {
   }
   #endif
 }
-#endif
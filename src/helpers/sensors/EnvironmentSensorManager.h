@@ -4,10 +4,117 @@
 #include <helpers/SensorManager.h>
 #include <helpers/sensors/LocationProvider.h>
 
+#ifndef ENV_SENSOR_TASK
+  #if defined(ESP32)
+    #define ENV_SENSOR_TASK     1   // sample on a background task, else one step per loop()
+  #else
+    #define ENV_SENSOR_TASK     0
+  #endif
+#endif
+#if ENV_SENSOR_TASK
+  #include <freertos/FreeRTOS.h>
+  #include <freertos/task.h>
+#endif
+
+#ifndef ENV_SAMPLE_PERIOD_MS
+  #define ENV_SAMPLE_PERIOD_MS        60000   // climate sensors
+#endif
+#ifndef ENV_POWER_SAMPLE_PERIOD_MS
+  #define ENV_POWER_SAMPLE_PERIOD_MS  10000   // voltage/current monitors, distance
+#endif
+#ifndef ENV_SAMPLE_LAZY
+  #define ENV_SAMPLE_LAZY    (!ENV_SENSOR_TASK)   // sample only around telemetry requests (saves I2C wake-ups on nRF52)
+#endif
+#ifndef ENV_LAZY_WINDOW_MS
+  #define ENV_LAZY_WINDOW_MS    (15*60*1000UL)   // lazy: keep sampling this long after a request
+#endif
+#ifndef ENV_MAX_SENSORS
+  #define ENV_MAX_SENSORS    8
+#endif
+#define ENV_MAX_READINGS    10
+#define ENV_CHANNEL_NEXT  0x80   // EnvReading::channel, ENV_CHANNEL_NEXT + n = the sensor's n-th own channel
+#define ENV_TASK_STACK_SIZE  4096
+#define ENV_TASK_PRIORITY       1
+#define ENV_TASK_CORE           0
+
+enum EnvReadingType : uint8_t {
+  ENV_TEMPERATURE, ENV_HUMIDITY, ENV_PRESSURE, ENV_ALTITUDE, ENV_ANALOG,
+  ENV_VOLTAGE, ENV_CURRENT, ENV_POWER, ENV_DISTANCE
+};
+
+struct EnvReading {
+  uint8_t channel;
+  uint8_t type;     // EnvReadingType
+  float value;
+};
+
+struct EnvSample {
+  unsigned long at_ms;   // millis() when taken
+  uint8_t count;         // 0 = sensor didn't answer
+  EnvReading readings[ENV_MAX_READINGS];
+
+  void add(uint8_t channel, uint8_t type, float value) {
+    if (count < ENV_MAX_READINGS) readings[count++] = { channel, type, value };
+  }
+};
+
+/**
+ * \brief  how the sampler polls a sensor: start() (optional) kicks off a conversion and read() collects
+ *      it conversion_ms later, or read() alone does a blocking measurement taking about conversion_ms.
+ *      read() returns false if the sensor didn't answer.
+ */
+struct EnvSensorDriver {
+  const char* name;
+  uint16_t conversion_ms;
+  uint32_t period_ms;
+  bool (*start)();
+  bool (*read)(EnvSample& sample);
+};
+
+/**
+ * \brief  Each detected sensor is sampled on its own period, on a background task (ESP32) or one step per
+ *      loop(), into a latest-value cache. querySensors() only serialises the cache, so a telemetry
+ *      request costs the same whichever sensors are fitted, and never waits on the I2C bus.
+ *      With ENV_SAMPLE_LAZY (default without the task), sampling only runs for ENV_LAZY_WINDOW_MS after
+ *      a telemetry request. The first request after a quiet spell gets the last cached values, however
+ *      old (they can be hours stale), while fresh ones are taken for the next request.
+ */
 class EnvironmentSensorManager : public SensorManager {
+  struct Slot {
+    const EnvSensorDriver* driver;
+    unsigned long next_due, ready_at;
+    bool converting;
+    volatile uint32_t seq;   // sample[seq & 1] is the published one, the sampler writes the other
+    EnvSample sample[2];
+  };
+  Slot _slots[ENV_MAX_SENSORS];
+  int _num_slots = 0;
+#if ENV_SAMPLE_LAZY
+  unsigned long _demand_until = 0;   // sampler runs until then
+#endif
+#if ENV_SENSOR_TASK
+  TaskHandle_t _task = NULL;
+  static void taskEntry(void* param);
+  void taskLoop();
+#endif
+
+  void publish(Slot& slot, const EnvSample& sample);
+  void finishSample(Slot& slot);
+  void getSample(const Slot& slot, EnvSample& dest) const;
+
 protected:
   int next_available_channel = TELEM_CHANNEL_SELF + 1;
 
+  void addSensor(const EnvSensorDriver& driver);
+  void startSampler();
+
+  /**
+   * \brief  starts or completes one due sample
+   * \returns  false if nothing was due
+   */
+  bool stepSampler(unsigned long now);
+  uint32_t millisToNextSample(unsigned long now) const;
+
   bool AHTX0_initialized = false;
   bool BME280_initialized = false;
   bool BMP280_initialized = false;
@@ -48,9 +155,7 @@ public:
   #endif
   bool begin() override;
   bool querySensors(uint8_t requester_permissions, CayenneLPP& telemetry) override;
-  #if ENV_INCLUDE_GPS
   void loop() override;
-  #endif
   int getNumSettings() const override;
   const char* getSettingName(int i) const override;
   const char* getSettingValue(int i) const override;
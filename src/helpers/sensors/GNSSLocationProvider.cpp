@@ -0,0 +1,162 @@
+#ifdef ESP32
+
+#include "GNSSLocationProvider.h"
+
+GNSSLocationProvider::GNSSLocationProvider(Stream& ser, mesh::RTCClock* clock, int pin_reset, int pin_en, RefCountedDigitalPin* peripher_power) :
+  nmea(_nmeaBuffer, sizeof(_nmeaBuffer)), _clock(clock), _gps_serial(&ser), _peripher_power(peripher_power), _pin_reset(pin_reset), _pin_en(pin_en) {
+  if (_pin_reset != -1) {
+    pinMode(_pin_reset, OUTPUT);
+    digitalWrite(_pin_reset, GPS_RESET_FORCE);
+  }
+  if (_pin_en != -1) {
+    pinMode(_pin_en, OUTPUT);
+    digitalWrite(_pin_en, LOW);
+  }
+}
+
+void GNSSLocationProvider::begin() {
+  if (_peripher_power) _peripher_power->claim();
+  if (_pin_en != -1) {
+    digitalWrite(_pin_en, PIN_GPS_EN_ACTIVE);
+  }
+  if (_pin_reset != -1) {
+    digitalWrite(_pin_reset, !GPS_RESET_FORCE);
+  }
+}
+
+void GNSSLocationProvider::reset() {
+  if (_pin_reset != -1) {
+    digitalWrite(_pin_reset, GPS_RESET_FORCE);
+    delay(10);
+    digitalWrite(_pin_reset, !GPS_RESET_FORCE);
+  }
+}
+
+void GNSSLocationProvider::stop() {
+  if (_pin_en != -1) {
+    digitalWrite(_pin_en, !PIN_GPS_EN_ACTIVE);
+  }
+  if (_peripher_power) _peripher_power->release();
+}
+
+bool GNSSLocationProvider::isEnabled() {
+  // read the enable pin, gps can be switched outside of here
+  if (_pin_en != -1) {
+    return digitalRead(_pin_en) == PIN_GPS_EN_ACTIVE;
+  }
+  return true;
+}
+
+// Copy the published buffer; retry only if a whole publish completed meanwhile.
+// The task writes the other buffer, so a reader that preempts it mid-write
+// (eg. the mesh task, on the same core at a higher priority) never waits on it.
+GNSSFix GNSSLocationProvider::getFix() const {
+  GNSSFix f;
+  uint32_t seq;
+  do {
+    seq = _seq;
+    __sync_synchronize();
+    f = _fix[seq & 1];
+    __sync_synchronize();
+  } while (seq != _seq);
+  return f;
+}
+
+void GNSSLocationProvider::publish() {
+  GNSSFix f;
+  f.lat = nmea.getLatitude();
+  f.lon = nmea.getLongitude();
+  f.alt = 0;
+  nmea.getAltitude(f.alt);
+  f.sats = nmea.getNumSatellites();
+  f.valid = nmea.isValid();
+  if (nmea.getYear() >= 2020) {
+    DateTime dt(nmea.getYear(), nmea.getMonth(), nmea.getDay(), nmea.getHour(), nmea.getMinute(), nmea.getSecond());
+    f.time = dt.unixtime();
+  } else {
+    f.time = 0;
+  }
+  f.at_ms = millis();
+
+  uint32_t seq = _seq + 1;
+  _fix[seq & 1] = f;       // the buffer readers aren't using
+  __sync_synchronize();
+  _seq = seq;              // publish it
+  _stats.fixes++;
+}
+
+void GNSSLocationProvider::taskEntry(void* param) {
+  static_cast<GNSSLocationProvider*>(param)->taskLoop();
+}
+
+void GNSSLocationProvider::taskLoop() {
+  for (;;) {
+    if (_clear_req) {
+      _clear_req = false;
+      nmea.clear();
+    }
+
+    uint32_t batch = 0;
+    while (_gps_serial->available()) {
+      char c = _gps_serial->read();
+      #ifdef GPS_NMEA_DEBUG
+      Serial.print(c);
+      #endif
+      batch++;
+      if (!nmea.process(c)) continue;
+
+      _stats.sentences++;
+      const char* id = nmea.getMessageID();
+      if (strcmp(id, "RMC") == 0 || strcmp(id, "GGA") == 0) publish();
+    }
+    _stats.bytes += batch;
+    if (batch > _stats.max_batch) _stats.max_batch = batch;
+
+    vTaskDelay(pdMS_TO_TICKS(isEnabled() ? GNSS_TASK_POLL_MS : GNSS_TASK_IDLE_MS));
+  }
+}
+
+void GNSSLocationProvider::sendSentence(const char* sentence) {
+  nmea.sendSentence(*_gps_serial, sentence);   // adds the checksum; touches no parser state
+}
+
+void GNSSLocationProvider::setFixRate(uint8_t hz) {
+  if (hz < 1) hz = 1;
+  if (hz > 10) hz = 10;
+  char cmd[24];
+  snprintf(cmd, sizeof(cmd), "$PCAS02,%d", 1000 / hz);
+  sendSentence(cmd);
+  snprintf(cmd, sizeof(cmd), "$PMTK220,%d", 1000 / hz);
+  sendSentence(cmd);
+}
+
+void GNSSLocationProvider::setConstellations(uint8_t mask) {
+  char cmd[16];
+  snprintf(cmd, sizeof(cmd), "$PCAS04,%d", mask & 0x07);
+  sendSentence(cmd);
+}
+
+void GNSSLocationProvider::loop() {
+  // Started from the first loop(), after setup() has finished re-opening the UART
+  if (_task == NULL) {
+    xTaskCreatePinnedToCore(taskEntry, "gnss", GNSS_TASK_STACK_SIZE,
+                            this, GNSS_TASK_PRIORITY, &_task, GNSS_TASK_CORE);
+  }
+
+  if (millis() < next_check) return;
+  next_check = millis() + 1000;
+
+  GNSSFix f = getFix();
+  if (!f.valid) {
+    time_valid = 0;
+    return;
+  }
+  time_valid++;
+  if (_time_sync_needed && time_valid > 2 && f.time != 0 && _clock != NULL) {
+    // Fix time is when the sentence arrived; carry it forward to now
+    _clock->setCurrentTime(f.time + (millis() - f.at_ms + 500) / 1000);
+    _time_sync_needed = false;
+  }
+}
+
+#endif
@@ -0,0 +1,112 @@
+#pragma once
+
+// =============================================================================
+// GNSSLocationProvider - NMEA parsing off the main loop (ESP32)
+//
+// The UART driver already fills its RX ring from the UART ISR; this provider
+// drains that ring on a small background task and feeds MicroNMEA, which
+// parses incrementally a byte at a time. Every completed RMC/GGA publishes a
+// GNSSFix snapshot into one of two buffers and flips a sequence counter, so
+// the main loop reads a consistent fix with no lock and no per-byte work,
+// even at 10 Hz output, and never waits on a preempted publish.
+//
+// Give the UART a bigger RX ring before Serial2.begin() (GNSS_UART_RX_BUF)
+// so a burst of sentences survives the task's poll interval.
+//
+// Rate and constellation setters speak CASIC ($PCASxx, the T-Deck Pro MAX
+// module) with the MTK equivalent alongside; a module ignores the sentences
+// it doesn't know. Binary UBX/CASIC output isn't parsed.
+// =============================================================================
+
+#include "MicroNMEALocationProvider.h"
+
+#ifndef GNSS_UART_RX_BUF
+  #define GNSS_UART_RX_BUF      1024    // ~250ms of 38400 baud
+#endif
+#ifndef GNSS_TASK_POLL_MS
+  #define GNSS_TASK_POLL_MS       20
+#endif
+#ifndef GNSS_TASK_IDLE_MS
+  #define GNSS_TASK_IDLE_MS      250    // GPS powered off
+#endif
+#define GNSS_TASK_PRIORITY         1
+#define GNSS_TASK_STACK_SIZE    3072
+#define GNSS_TASK_CORE             0
+
+// CASIC $PCAS04 bits
+#define GNSS_GPS        0x01
+#define GNSS_BEIDOU     0x02
+#define GNSS_GLONASS    0x04
+
+struct GNSSFix {
+  long lat, lon;           // micro-degrees
+  long alt;                // mm
+  uint8_t sats;
+  bool valid;
+  uint32_t time;           // UNIX epoch seconds of the fix, 0 if no date yet
+  unsigned long at_ms;     // millis() when the fix's sentence was parsed
+};
+
+struct GNSSStats {
+  uint32_t bytes, sentences, fixes;
+  uint32_t max_batch;      // most bytes drained in one pass
+};
+
+class GNSSLocationProvider : public LocationProvider {
+  char _nmeaBuffer[100];
+  MicroNMEA nmea;          // task-owned
+  mesh::RTCClock* _clock;
+  Stream* _gps_serial;
+  RefCountedDigitalPin* _peripher_power;
+  int _pin_reset;
+  int _pin_en;
+  unsigned long next_check = 0;
+  long time_valid = 0;
+
+  TaskHandle_t _task = NULL;
+  volatile uint32_t _seq = 0;      // _fix[_seq & 1] is the published fix
+  GNSSFix _fix[2] = {};
+  volatile bool _clear_req = false;
+  GNSSStats _stats = {};
+
+  static void taskEntry(void* param);
+  void taskLoop();
+  void publish();
+
+public:
+  GNSSLocationProvider(Stream& ser, mesh::RTCClock* clock = NULL, int pin_reset = GPS_RESET, int pin_en = GPS_EN, RefCountedDigitalPin* peripher_power = NULL);
+
+  void begin() override;
+  void reset() override;
+  void stop() override;
+  bool isEnabled() override;
+
+  /**
+   * \brief  consistent copy of the latest fix; safe from any task
+   */
+  GNSSFix getFix() const;
+
+  void syncTime() override { _clear_req = true; LocationProvider::syncTime(); }
+  long getLatitude() override { return getFix().lat; }
+  long getLongitude() override { return getFix().lon; }
+  long getAltitude() override { return getFix().alt; }
+  long satellitesCount() override { return getFix().sats; }
+  bool isValid() override { return getFix().valid; }
+  long getTimestamp() override { return getFix().time; }
+
+  void sendSentence(const char* sentence) override;
+
+  /**
+   * \brief  position output rate, 1..10 Hz
+   */
+  void setFixRate(uint8_t hz);
+  /**
+   * \brief  constellations to track, GNSS_GPS | GNSS_BEIDOU | GNSS_GLONASS
+   */
+  void setConstellations(uint8_t mask);
+
+  const GNSSStats& getStats() const { return _stats; }
+
+  // Time sync only; parsing runs on the task
+  void loop() override;
+};
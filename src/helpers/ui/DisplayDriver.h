@@ -3,6 +3,9 @@
 #include <stdint.h>
 #include <string.h>
 
+// sprite (eg. emoji) for a code point: MSB first, (w+7)/8 bytes per row, or NULL
+typedef const uint8_t* (*GlyphSpriteLookup)(uint32_t cp, uint8_t& w, uint8_t& h);
+
 class DisplayDriver {
   int _w, _h;
 protected:
@@ -73,6 +76,11 @@ public:
     dest[j] = 0;
   }
   
+  // Unicode fallback for code points the fonts don't have: glyph packs on SD,
+  // then sprites, then a replacement box (see GlyphPack.h). Returns packs loaded.
+  virtual int loadGlyphPacks(const char* dir) { return 0; }
+  virtual void setGlyphSpriteLookup(GlyphSpriteLookup fn) { }
+
   // draw text with ellipsis if it exceeds max_width
   virtual void drawTextEllipsized(int x, int y, int max_width, const char* str) {
     char temp_str[256];  // reasonable buffer size
@@ -24,6 +24,10 @@
 // Periodic slow (deep) refresh to clear ghosting
 #define FULL_SLOW_PERIOD 1  // every frame -- eliminates ghosting (increase to 2+ for less flashing)
 
+#define REFRESH_TASK_STACK_SIZE  4096
+#define REFRESH_TASK_PRIORITY    1   // same as loop(), panel update is mostly waiting on waveform timing
+#define REFRESH_TASK_CORE        1   // keep off the radio/mesh core
+
 // ---------------------------------------------------------------------------
 // UTF-8 helpers for diacritic / extended Latin rendering
 // ---------------------------------------------------------------------------
@@ -108,6 +112,8 @@ static bool hasNonAscii(const char* str) {
 }
 
 FastEPDDisplay::~FastEPDDisplay() {
+  if (_refreshTask) vTaskDelete(_refreshTask);
+  free(_backBuf);
   delete _canvas;
   delete _epd;
 }
@@ -168,7 +174,24 @@ bool FastEPDDisplay::begin() {
 #endif
   _canvas->setTextWrap(false);
 
+  if (!_atlas.begin()) {
+    Serial.println("[FastEPD] Glyph atlas allocation failed, using per-pixel text");
+  }
+
   _curr_color = GxEPD_BLACK;
+
+#if EPD_ASYNC_REFRESH
+  // Back buffer + refresh task. If either fails, endFrame() just updates inline.
+  _backBuf = (uint8_t*) ps_malloc(((uint32_t)EPD_WIDTH * EPD_HEIGHT) / 8);
+  if (_backBuf) memset(_backBuf, 0xFF, ((uint32_t)EPD_WIDTH * EPD_HEIGHT) / 8);   // matches initial clear (white)
+  _backLock = xSemaphoreCreateMutex();
+  if (_backBuf && _backLock) {
+    xTaskCreatePinnedToCore(refreshTaskLoop, "epd_refresh", REFRESH_TASK_STACK_SIZE, this,
+                            REFRESH_TASK_PRIORITY, &_refreshTask, REFRESH_TASK_CORE);
+  }
+  Serial.printf("[FastEPD] Async refresh: %s\n", _refreshTask ? "ON" : "OFF (inline)");
+#endif
+
   _init = true;
   _isOn = true;
 
@@ -182,6 +205,7 @@ void FastEPDDisplay::turnOn() {
 }
 
 void FastEPDDisplay::turnOff() {
+  waitForRefresh();   // last frame must be on the panel, before caller powers things down
   _isOn = false;
 }
 
@@ -301,7 +325,11 @@ void FastEPDDisplay::print(const char* str) {
 
   if (!hasNonAscii(str)) {
     // Pure ASCII fast path
-    _canvas->print(str);
+    for (const char* p = str; *p; p++) {
+      if (*p == '\n' || *p == '\r' || !atlasGlyphAtCursor((uint8_t)*p)) {
+        _canvas->write((uint8_t)*p);
+      }
+    }
     return;
   }
 
@@ -313,22 +341,58 @@ void FastEPDDisplay::print(const char* str) {
   while (pos < len) {
     uint8_t b = s[pos];
     if (b < 0x80) {
-      _canvas->write(b);
+      if (b == '\n' || b == '\r' || !atlasGlyphAtCursor(b)) _canvas->write(b);
       pos++;
     } else {
       int consumed;
       uint32_t cp = utf8Decode(s + pos, len - pos, &consumed);
       if (has8bFont && cp >= _currentFont->first && cp <= _currentFont->last) {
-        drawGlyphAtCursor((uint16_t)cp);
-      } else if (!has8bFont) {
-        char folded = foldToAscii(cp);
-        if (folded) _canvas->write((uint8_t)folded);
+        if (!atlasGlyphAtCursor((uint16_t)cp)) drawGlyphAtCursor((uint16_t)cp);
+      } else {
+        char folded = has8bFont ? 0 : foldToAscii(cp);
+        if (folded) {
+          _canvas->write((uint8_t)folded);
+#if GLYPH_PACKS
+        } else if (_glyphPacks.isActive() && cp != 0xFFFD) {   // not invalid UTF-8
+          drawFallbackGlyph(cp);
+#endif
+        }
       }
       pos += consumed;
     }
   }
 }
 
+bool FastEPDDisplay::atlasGlyphAtCursor(uint16_t cp) {
+  // Atlas blits unrotated, unscaled glyphs only
+  if (!_atlas.isReady() || !_currentFont || _currentTextScale != 1 || _canvas->getRotation() != 0) return false;
+  if (cp < _currentFont->first || cp > _currentFont->last) return false;   // canvas skips these too
+
+  const AtlasGlyph* g = _atlas.get(_currentFont, cp);
+  if (!g) return false;
+
+  int16_t cx = _canvas->getCursorX();
+  int16_t cy = _canvas->getCursorY();
+  if (g->w > 0 && g->h > 0) {
+    // Canvas color: 0 = black, 1 = white
+    _atlas.blit(_canvas->getBuffer(), (EPD_WIDTH + 7) / 8, EPD_HEIGHT, cx, cy, g, _curr_color != GxEPD_BLACK);
+  }
+  _canvas->setCursor(cx + g->xa, cy);
+  return true;
+}
+
+#if GLYPH_PACKS
+void FastEPDDisplay::drawFallbackGlyph(uint32_t cp) {
+  int16_t cx = _canvas->getCursorX();
+  int16_t cy = _canvas->getCursorY();
+  int lineH = _currentFont ? _currentFont->yAdvance : 8;
+  int baseline = _currentFont ? cy : cy + 7 * _currentTextScale;   // built-in font: cursor is top-left
+  uint16_t canvasColor = (_curr_color == GxEPD_BLACK) ? 0 : 1;
+  int adv = _glyphPacks.draw(*_canvas, cx, baseline, cp, lineH, _currentTextScale, canvasColor);
+  _canvas->setCursor(cx + adv, cy);
+}
+#endif
+
 void FastEPDDisplay::drawGlyphAtCursor(uint16_t cp) {
   if (!_canvas || !_currentFont || cp < _currentFont->first || cp > _currentFont->last) return;
 
@@ -464,17 +528,22 @@ uint16_t FastEPDDisplay::getTextWidth(const char* str) {
       uint32_t cp = utf8Decode(s + pos, len - pos, &consumed);
       if (cp >= _currentFont->first && cp <= _currentFont->last) {
         totalAdv += _currentFont->glyph[cp - _currentFont->first].xAdvance * _currentTextScale;
+#if GLYPH_PACKS
+      } else if (_glyphPacks.isActive() && cp != 0xFFFD) {
+        totalAdv += _glyphPacks.advance(cp, _currentFont->yAdvance, _currentTextScale);
+#endif
       }
       pos += consumed;
     }
     return (uint16_t)ceil((totalAdv + 1) / scale_x);
   }
 
-  // Classic/7b: fold to ASCII, then measure
+  // Classic/7b: fold to ASCII, then measure (plus fallback glyphs for what won't fold)
   char folded[256];
   const uint8_t* s = (const uint8_t*)str;
   int len = strlen(str);
   int pos = 0, fi = 0;
+  int fallbackAdv = 0;
   while (pos < len && fi < 254) {
     uint8_t b = s[pos];
     if (b < 0x80) {
@@ -485,6 +554,11 @@ uint16_t FastEPDDisplay::getTextWidth(const char* str) {
       uint32_t cp = utf8Decode(s + pos, len - pos, &consumed);
       char fc = foldToAscii(cp);
       if (fc) folded[fi++] = fc;
+#if GLYPH_PACKS
+      else if (_glyphPacks.isActive() && cp != 0xFFFD) {
+        fallbackAdv += _glyphPacks.advance(cp, _currentFont ? _currentFont->yAdvance : 8, _currentTextScale);
+      }
+#endif
       pos += consumed;
     }
   }
@@ -492,7 +566,32 @@ uint16_t FastEPDDisplay::getTextWidth(const char* str) {
   int16_t x1, y1;
   uint16_t w, h;
   _canvas->getTextBounds(folded, 0, 0, &x1, &y1, &w, &h);
-  return (uint16_t)ceil((w + 1) / scale_x);
+  return (uint16_t)ceil((w + fallbackAdv + 1) / scale_x);
+}
+
+// Copy a frame into dst (inverting for dark mode), row by row, and report
+// which rows actually changed: [row0, row1], or row0 > row1 for none.
+// This is the damaged region passed to partialUpdate().
+static void copyFrameDiff(uint8_t* dst, const uint8_t* src, bool invert, int& row0, int& row1) {
+  const int rowBytes = EPD_WIDTH / 8;
+  row0 = EPD_HEIGHT;
+  row1 = -1;
+  for (int r = 0; r < EPD_HEIGHT; r++, src += rowBytes, dst += rowBytes) {
+    bool changed = false;
+    if (invert) {
+      for (int i = 0; i < rowBytes; i++) {
+        uint8_t v = ~src[i];
+        if (dst[i] != v) { dst[i] = v; changed = true; }
+      }
+    } else if (memcmp(dst, src, rowBytes) != 0) {
+      memcpy(dst, src, rowBytes);
+      changed = true;
+    }
+    if (changed) {
+      if (r < row0) row0 = r;
+      row1 = r;
+    }
+  }
 }
 
 void FastEPDDisplay::endFrame() {
@@ -504,21 +603,43 @@ void FastEPDDisplay::endFrame() {
   }
   _lastCRC = crc;
 
-  // Copy GFXcanvas1 buffer to FastEPD's current buffer — direct copy.
+  // Copy GFXcanvas1 buffer to FastEPD's current buffer (or the back buffer,
+  // when the refresh task owns the panel) — direct copy.
   // Both use same polarity: bit 1 = white, bit 0 = black.
+  // Dark mode: invert every byte (white↔black).
   uint8_t* src = _canvas->getBuffer();
-  uint8_t* dst = _epd->currentBuffer();
-  size_t bufSize = ((uint32_t)EPD_WIDTH * EPD_HEIGHT) / 8;
+  int row0, row1;
+
+  if (_refreshTask) {
+    xSemaphoreTake(_backLock, portMAX_DELAY);
+    copyFrameDiff(_backBuf, src, _darkMode, row0, row1);
+    if (row0 <= row1) {
+      if (_framePending) {   // previous frame never made it to the panel, its damage still needs updating
+        _framesCoalesced++;
+        if (_pendingRow0 < row0) row0 = _pendingRow0;
+        if (_pendingRow1 > row1) row1 = _pendingRow1;
+      }
+      _pendingRow0 = row0;
+      _pendingRow1 = row1;
+      _framePending = true;
+      _pendingPartial = _forcePartial;
+    }
+    xSemaphoreGive(_backLock);
 
-  if (!src || !dst) return;
+    if (row0 <= row1) xTaskNotifyGive(_refreshTask);
+    return;
+  }
 
-  memcpy(dst, src, bufSize);
+  uint8_t* dst = _epd->currentBuffer();
+  if (!src || !dst) return;
 
-  // Dark mode: invert every byte in the buffer (white↔black)
-  if (_darkMode) {
-    for (size_t i = 0; i < bufSize; i++) dst[i] = ~dst[i];
+  copyFrameDiff(dst, src, _darkMode, row0, row1);
+  if (row0 <= row1) {   // else, drawing changed but pixels didn't
+    updatePanel(_forcePartial, row0, row1);
   }
+}
 
+void FastEPDDisplay::updatePanel(bool forcePartial, int row0, int row1) {
   // Refresh strategy:
   //   partialUpdate(true) — no flash, differential, keeps previous buffer
   //   fullUpdate(false)   — brief flash, clears ghosting (CLEAR_FAST)
@@ -526,20 +647,49 @@ void FastEPDDisplay::endFrame() {
   //
   // Use partial for most frames. Periodic full refresh every N frames
   // to clear accumulated ghosting artifacts.
+  // Partial updates only drive the damaged rows (row0..row1).
   _fullRefreshCount++;
-  if (_forcePartial) {
+  if (forcePartial) {
     // VKB typing mode — no flash, fast differential update
-    _epd->partialUpdate(true);
+    _epd->partialUpdate(true, row0, row1);
     _fullRefreshCount = 0;  // Reset so next non-partial frame does full refresh
   } else if (_fullRefreshCount >= FULL_SLOW_PERIOD) {
     _fullRefreshCount = 0;
     _epd->fullUpdate(true);   // Full clean refresh — clears all ghosting
   } else {
-    _epd->partialUpdate(true);  // No flash — differential
+    _epd->partialUpdate(true, row0, row1);  // No flash — differential
   }
   _epd->backupPlane();
 }
 
+void FastEPDDisplay::refreshTaskLoop(void* arg) {
+  auto self = (FastEPDDisplay*) arg;
+  size_t bufSize = ((uint32_t)EPD_WIDTH * EPD_HEIGHT) / 8;
+
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);   // wait for endFrame()
+
+    while (self->_framePending) {   // newest frame only, any in between were overwritten
+      xSemaphoreTake(self->_backLock, portMAX_DELAY);
+      memcpy(self->_epd->currentBuffer(), self->_backBuf, bufSize);
+      bool partial = self->_pendingPartial;
+      int row0 = self->_pendingRow0, row1 = self->_pendingRow1;
+      self->_refreshing = true;
+      self->_framePending = false;
+      xSemaphoreGive(self->_backLock);
+
+      self->updatePanel(partial, row0, row1);
+      self->_refreshing = false;
+    }
+  }
+}
+
+void FastEPDDisplay::waitForRefresh() {
+  while (_refreshTask && isRefreshing()) {
+    delay(5);
+  }
+}
+
 void FastEPDDisplay::translateUTF8ToBlocks(char* dest, const char* src, size_t dest_size) {
   if (_currentFont && _currentFont->last > 0xFF) {
     strncpy(dest, src, dest_size - 1);
@@ -560,7 +710,14 @@ void FastEPDDisplay::translateUTF8ToBlocks(char* dest, const char* src, size_t d
       int consumed;
       uint32_t cp = utf8Decode(s + pos, len - pos, &consumed);
       char folded = foldToAscii(cp);
-      if (folded) dest[j++] = folded;
+      if (folded) {
+        dest[j++] = folded;
+#if GLYPH_PACKS
+      } else if (_glyphPacks.isActive() && cp != 0xFFFD && j + consumed < dest_size) {
+        memcpy(&dest[j], &s[pos], consumed);   // keep, print() draws it via fallback
+        j += consumed;
+#endif
+      }
       pos += consumed;
     } else {
       pos++;
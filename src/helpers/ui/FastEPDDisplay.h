@@ -7,6 +7,10 @@
 //   - FastEPD handles hardware init, power management, and display refresh
 //   - Adafruit_GFX GFXcanvas1 handles all drawing/text rendering
 //   - On endFrame(), canvas buffer is copied to FastEPD and display is updated
+//   - With EPD_ASYNC_REFRESH, endFrame() only copies the canvas to a back
+//     buffer and wakes the "epd_refresh" task, which does the (blocking) panel
+//     update. Frames that arrive while a refresh is in progress are coalesced:
+//     only the newest one is drawn when the panel is free again.
 //
 // This avoids depending on FastEPD's drawing API — only uses its well-tested
 // hardware interface (initPanel, fullUpdate, partialUpdate, currentBuffer).
@@ -28,6 +32,16 @@
 #include "MeckFonts.h"
 
 #include "DisplayDriver.h"
+#include "GlyphAtlas.h"
+#include "GlyphPack.h"
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+
+#ifndef EPD_ASYNC_REFRESH
+  #define EPD_ASYNC_REFRESH  1
+#endif
 
 // GxEPD2 color constant compatibility — MapScreen uses these directly
 #ifndef GxEPD_BLACK
@@ -82,8 +96,32 @@ class FastEPDDisplay : public DisplayDriver {
   const GFXfont* _currentFont = nullptr;  // Track for UTF-8 rendering
   uint8_t _currentTextScale = 1;          // Track glyph scale factor
 
+  // Async refresh (EPD_ASYNC_REFRESH)
+  uint8_t* _backBuf = nullptr;            // latest frame, waiting for refresh task (PSRAM)
+  SemaphoreHandle_t _backLock = NULL;     // guards _backBuf + _framePending
+  TaskHandle_t _refreshTask = NULL;
+  volatile bool _framePending = false;
+  volatile bool _refreshing = false;
+  bool _pendingPartial = false;           // _forcePartial, as at endFrame()
+  int _pendingRow0, _pendingRow1;         // damaged rows of pending frame (vs panel)
+  uint32_t _framesCoalesced = 0;
+
+  static void refreshTaskLoop(void* arg);
+  void updatePanel(bool forcePartial, int row0, int row1);    // blocking, from epd->currentBuffer()
+
+  // Pre-rasterised glyphs, blitted straight into the canvas buffer
+  GlyphAtlas _atlas;
+
   // Render one glyph from the current 8b font at the canvas cursor position
   void drawGlyphAtCursor(uint16_t cp);
+  // Same via atlas, returns false if it can't be used (scaled text, portrait rotation, no PSRAM)
+  bool atlasGlyphAtCursor(uint16_t cp);
+
+#if GLYPH_PACKS
+  GlyphPackSet _glyphPacks;
+  // Code point not in current font: glyph pack / sprite / box, at cursor
+  void drawFallbackGlyph(uint32_t cp);
+#endif
 
   // Virtual 128×128 → physical canvas mapping (runtime, changes with portrait)
   float scale_x  = 7.5f;       // 960 / 128 (landscape default)
@@ -112,6 +150,10 @@ public:
   uint16_t getTextWidth(const char* str) override;
   void endFrame() override;
   void translateUTF8ToBlocks(char* dest, const char* src, size_t dest_size) override;
+#if GLYPH_PACKS
+  int loadGlyphPacks(const char* dir) override { return _glyphPacks.load(dir); }
+  void setGlyphSpriteLookup(GlyphSpriteLookup fn) override { _glyphPacks.setSpriteLookup(fn); }
+#endif
 
   // --- Raw pixel access for MapScreen (bypasses scaling) ---
   void drawPixelRaw(int16_t x, int16_t y, uint16_t color) {
@@ -123,6 +165,7 @@ public:
   void drawTextRaw(int16_t x, int16_t y, const char* text, uint16_t color) {
     if (!_canvas) return;
     _canvas->setFont(NULL);
+    _currentFont = nullptr;
     _canvas->setTextSize(3);  // 3× built-in 5×7 = 15×21, readable on 960×540
     _canvas->setTextColor(color ? 1 : 0);
     _canvas->setCursor(x, y);
@@ -131,6 +174,12 @@ public:
 
   void invalidateFrameCRC() { _lastCRC = 0; }
 
+  // Async refresh state -- isRefreshing() also covers a frame still queued
+  bool isRefreshing() const { return _framePending || _refreshing; }
+  void waitForRefresh();
+  uint32_t getFramesCoalesced() const { return _framesCoalesced; }
+  const GlyphAtlas& getGlyphAtlas() const { return _atlas; }
+
   // Temporarily force partial (no-flash) updates — use during VKB typing
   void setForcePartial(bool partial) { _forcePartial = partial; }
   bool isForcePartial() const { return _forcePartial; }
@@ -0,0 +1,131 @@
+#include "GlyphAtlas.h"
+#include <string.h>
+#include <stdlib.h>
+
+#define MAX_PROBES  8
+
+static inline uint32_t slotHash(const GFXfont* font, uint16_t cp) {
+  return (((uint32_t)(uintptr_t)font >> 2) ^ (cp * 2654435761UL)) & (GLYPH_ATLAS_SLOTS - 1);
+}
+
+GlyphAtlas::GlyphAtlas() {
+  _slots = NULL;
+  _arena = NULL;
+  _arena_used = 0;
+  _num_used = 0;
+  _hits = _misses = _flushes = 0;
+}
+
+bool GlyphAtlas::begin() {
+  if (_arena) return true;
+#if defined(ESP32) && defined(BOARD_HAS_PSRAM)
+  _slots = (AtlasGlyph *) ps_calloc(GLYPH_ATLAS_SLOTS, sizeof(AtlasGlyph));
+  _arena = (uint8_t *) ps_malloc(GLYPH_ATLAS_ARENA_SIZE);
+#else
+  _slots = (AtlasGlyph *) calloc(GLYPH_ATLAS_SLOTS, sizeof(AtlasGlyph));
+  _arena = (uint8_t *) malloc(GLYPH_ATLAS_ARENA_SIZE);
+#endif
+  if (_slots == NULL || _arena == NULL) {
+    free(_slots);
+    free(_arena);
+    _slots = NULL;
+    _arena = NULL;
+    return false;
+  }
+  return true;
+}
+
+void GlyphAtlas::flush() {
+  memset(_slots, 0, GLYPH_ATLAS_SLOTS * sizeof(AtlasGlyph));
+  _arena_used = 0;
+  _num_used = 0;
+  _flushes++;
+}
+
+AtlasGlyph* GlyphAtlas::rasterise(AtlasGlyph* slot, const GFXfont* font, uint16_t cp) {
+  const GFXglyph* glyph = &font->glyph[cp - font->first];
+  uint8_t stride = (glyph->width + 7) / 8;
+  uint32_t sz = (uint32_t)stride * glyph->height;
+  if (_arena_used + sz > GLYPH_ATLAS_ARENA_SIZE) return NULL;   // caller flushes
+
+  slot->font = font;
+  slot->cp = cp;
+  slot->w = glyph->width;
+  slot->h = glyph->height;
+  slot->xo = glyph->xOffset;
+  slot->yo = glyph->yOffset;
+  slot->xa = glyph->xAdvance;
+  slot->stride = stride;
+  slot->offset = _arena_used;
+
+  // unpack bit stream (rows not byte aligned) to byte-aligned rows, padding bits zero
+  uint8_t* dest = &_arena[_arena_used];
+  memset(dest, 0, sz);
+  const uint8_t* src = &font->bitmap[glyph->bitmapOffset];
+  uint32_t bit = 0;
+  for (int y = 0; y < glyph->height; y++) {
+    uint8_t* row = &dest[y * stride];
+    for (int x = 0; x < glyph->width; x++, bit++) {
+      if (src[bit >> 3] & (0x80 >> (bit & 7))) {
+        row[x >> 3] |= 0x80 >> (x & 7);
+      }
+    }
+  }
+  _arena_used += sz;
+  _num_used++;
+  return slot;
+}
+
+const AtlasGlyph* GlyphAtlas::get(const GFXfont* font, uint16_t cp) {
+  if (_arena == NULL || font == NULL || cp < font->first || cp > font->last) return NULL;
+
+  uint32_t h = slotHash(font, cp);
+  for (int i = 0; i < MAX_PROBES; i++) {
+    AtlasGlyph* s = &_slots[(h + i) & (GLYPH_ATLAS_SLOTS - 1)];
+    if (s->font == font && s->cp == cp) {
+      _hits++;
+      return s;
+    }
+    if (s->font == NULL) {
+      _misses++;
+      if (_num_used < GLYPH_ATLAS_SLOTS * 3 / 4) {
+        AtlasGlyph* g = rasterise(s, font, cp);
+        if (g) return g;
+      }
+      break;   // out of slots or arena
+    }
+  }
+  // probe sequence full, or out of space: start over
+  flush();
+  AtlasGlyph* s = &_slots[h];
+  return rasterise(s, font, cp);   // NULL only if a single glyph is bigger than the arena
+}
+
+void GlyphAtlas::blit(uint8_t* fb, int fb_row_bytes, int fb_h, int x, int y, const AtlasGlyph* g, bool set_bits) const {
+  int x0 = x + g->xo;
+  int y0 = y + g->yo;
+  int shift = x0 & 7;               // (two's complement, so also right for negative x0)
+  int col0 = (x0 - shift) / 8;      // framebuffer byte of first glyph byte
+  const uint8_t* src = &_arena[g->offset];
+
+  for (int r = 0; r < g->h; r++, src += g->stride) {
+    int fy = y0 + r;
+    if (fy < 0) continue;
+    if (fy >= fb_h) break;
+    uint8_t* row = &fb[fy * fb_row_bytes];
+
+    for (int k = 0; k < g->stride; k++) {
+      uint8_t b = src[k];
+      if (b == 0) continue;
+      int c = col0 + k;
+      uint8_t hi = b >> shift;
+      uint8_t lo = shift ? (uint8_t)(b << (8 - shift)) : 0;
+      if (c >= 0 && c < fb_row_bytes) {
+        if (set_bits) row[c] |= hi; else row[c] &= ~hi;
+      }
+      if (lo && c + 1 >= 0 && c + 1 < fb_row_bytes) {
+        if (set_bits) row[c + 1] |= lo; else row[c + 1] &= ~lo;
+      }
+    }
+  }
+}
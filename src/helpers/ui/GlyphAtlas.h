@@ -0,0 +1,62 @@
+#pragma once
+
+#include <Arduino.h>   // needed for PlatformIO
+#include <gfxfont.h>
+
+#ifndef GLYPH_ATLAS_SLOTS
+  #define GLYPH_ATLAS_SLOTS       512     // power of 2
+#endif
+#ifndef GLYPH_ATLAS_ARENA_SIZE
+  #define GLYPH_ATLAS_ARENA_SIZE  (48*1024)
+#endif
+
+struct AtlasGlyph {
+  const GFXfont* font;   // NULL = free slot
+  uint16_t cp;
+  uint8_t w, h;
+  int8_t xo, yo;
+  uint8_t xa;            // xAdvance
+  uint8_t stride;        // bytes per row in arena
+  uint32_t offset;       // of rows in arena
+};
+
+/**
+ * \brief  Cache of pre-rasterised glyphs for Adafruit GFXfont tables. GFXfont bitmaps are bit-packed across
+ *     rows, so drawing one means a drawPixel() per set bit. Here each glyph is unpacked once (on first use)
+ *     into byte-aligned rows, which blit() then shifts and ORs/ANDs into a 1-bpp (MSB first) framebuffer,
+ *     a byte at a time. Lookup is by (font, codepoint), so UTF-8 decoded code points hit directly.
+ *     When slots or arena run out, the whole atlas is flushed.
+ */
+class GlyphAtlas {
+  AtlasGlyph* _slots;
+  uint8_t* _arena;
+  uint32_t _arena_used;
+  uint16_t _num_used;
+  uint32_t _hits, _misses, _flushes;
+
+  void flush();
+  AtlasGlyph* rasterise(AtlasGlyph* slot, const GFXfont* font, uint16_t cp);
+
+public:
+  GlyphAtlas();
+
+  bool begin();
+  bool isReady() const { return _arena != NULL; }
+
+  /**
+   * \returns  the glyph (rasterised now, if not cached), or NULL if cp isn't in font
+   */
+  const AtlasGlyph* get(const GFXfont* font, uint16_t cp);
+
+  /**
+   * \brief  draw glyph with its origin (cursor, on baseline) at x,y. Clipped to framebuffer.
+   * \param  fb_row_bytes  bytes per framebuffer row
+   * \param  set_bits  true to set glyph pixels to 1, false to clear them to 0
+   */
+  void blit(uint8_t* fb, int fb_row_bytes, int fb_h, int x, int y, const AtlasGlyph* g, bool set_bits) const;
+
+  uint32_t getHits() const { return _hits; }
+  uint32_t getMisses() const { return _misses; }
+  uint32_t getFlushes() const { return _flushes; }
+  uint32_t getArenaUsed() const { return _arena_used; }
+};
@@ -0,0 +1,335 @@
+#include "GlyphPack.h"
+
+#if GLYPH_PACKS
+#include <SD.h>
+#include <string.h>
+#include <stdlib.h>
+
+#define HEADER_SIZE       20
+#define INDEX_ENTRY_SIZE  12
+#define MAX_BLOCK         128   // index entries per block we're prepared to read
+#define COMPRESSED_BIT    0x80000000UL
+
+static inline uint32_t rd32(const uint8_t* p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline uint32_t keyHash(uint32_t key) {
+  return ((uint32_t)(key * 2654435761u) >> 16) & (GLYPH_PACK_HASH_BUCKETS - 1);
+}
+
+GlyphPackSet::GlyphPackSet() {
+  _num_packs = 0;
+  _slots = NULL;
+  _bitmaps = NULL;
+  _lru_head = _lru_tail = -1;
+  _num_used = 0;
+  _sprites = NULL;
+  _hits = _misses = 0;
+  for (int i = 0; i < GLYPH_PACK_HASH_BUCKETS; i++) _buckets[i] = -1;
+}
+
+bool GlyphPackSet::addPack(const char* path) {
+  File f = SD.open(path, FILE_READ);
+  if (!f) return false;
+
+  uint8_t hdr[HEADER_SIZE];
+  if (f.read(hdr, HEADER_SIZE) != HEADER_SIZE || memcmp(hdr, "MGP1", 4) != 0) {
+    f.close();
+    return false;
+  }
+  Pack& p = _packs[_num_packs];
+  p.height = hdr[4];
+  p.ascent = hdr[5];
+  p.block = hdr[6] | (hdr[7] << 8);
+  p.count = rd32(&hdr[8]);
+  uint32_t fence_off = rd32(&hdr[12]);
+  p.index_off = rd32(&hdr[16]);
+  if (p.height == 0 || p.block == 0 || p.block > MAX_BLOCK || p.count == 0) {
+    f.close();
+    return false;
+  }
+
+  p.num_fences = (p.count + p.block - 1) / p.block;
+#if defined(ESP32) && defined(BOARD_HAS_PSRAM)
+  p.fences = (uint32_t *) ps_malloc(p.num_fences * sizeof(uint32_t));
+#else
+  p.fences = (uint32_t *) malloc(p.num_fences * sizeof(uint32_t));
+#endif
+  if (p.fences == NULL) {
+    f.close();
+    return false;
+  }
+  bool ok = f.seek(fence_off) && f.read((uint8_t *) p.fences, p.num_fences * sizeof(uint32_t)) == p.num_fences * sizeof(uint32_t);
+  f.close();
+  if (!ok) {
+    free(p.fences);
+    return false;
+  }
+  // NOTE: file is little-endian, same as ESP32, so fences are usable as read
+
+  strncpy(p.path, path, sizeof(p.path) - 1);
+  p.path[sizeof(p.path) - 1] = 0;
+  _num_packs++;
+  Serial.printf("GlyphPack: %s, %dpx, %u glyphs\n", p.path, p.height, (unsigned) p.count);
+  return true;
+}
+
+int GlyphPackSet::load(const char* dir) {
+  if (_slots == NULL) {
+#if defined(ESP32) && defined(BOARD_HAS_PSRAM)
+    _slots = (PackGlyph *) ps_calloc(GLYPH_PACK_CACHE_SLOTS, sizeof(PackGlyph));
+    _bitmaps = (uint8_t *) ps_malloc(GLYPH_PACK_CACHE_SLOTS * GLYPH_PACK_MAX_BITMAP);
+#else
+    _slots = (PackGlyph *) calloc(GLYPH_PACK_CACHE_SLOTS, sizeof(PackGlyph));
+    _bitmaps = (uint8_t *) malloc(GLYPH_PACK_CACHE_SLOTS * GLYPH_PACK_MAX_BITMAP);
+#endif
+    if (_slots == NULL || _bitmaps == NULL) {
+      free(_slots);
+      free(_bitmaps);
+      _slots = NULL;
+      _bitmaps = NULL;
+      return 0;
+    }
+  }
+
+  File root = SD.open(dir);
+  if (!root || !root.isDirectory()) return 0;
+
+  char path[48];
+  File f;
+  while (_num_packs < GLYPH_PACK_MAX && (f = root.openNextFile())) {
+    const char* name = f.name();
+    bool is_pack = !f.isDirectory() && strlen(name) > 4 && strcasecmp(&name[strlen(name) - 4], ".mgp") == 0;
+    if (is_pack) {
+      if (name[0] == '/') {
+        snprintf(path, sizeof(path), "%s", name);
+      } else {
+        snprintf(path, sizeof(path), "%s/%s", dir, name);
+      }
+    }
+    f.close();
+    if (is_pack) addPack(path);
+  }
+  root.close();
+  return _num_packs;
+}
+
+bool GlyphPackSet::isZeroWidth(uint32_t cp) {
+  return (cp >= 0xFE00 && cp <= 0xFE0F)      // variation selectors
+      || (cp >= 0x200B && cp <= 0x200F)      // zero width space/joiners, direction marks
+      || cp == 0xFEFF;                       // BOM
+}
+
+// ------------------------------------------------------------------------------------------------
+// LRU cache
+
+PackGlyph* GlyphPackSet::lookup(uint32_t key) {
+  for (int16_t i = _buckets[keyHash(key)]; i >= 0; i = _slots[i].chain) {
+    if (_slots[i].key == key) return &_slots[i];
+  }
+  return NULL;
+}
+
+void GlyphPackSet::touch(PackGlyph* g) {
+  int16_t i = g - _slots;
+  if (_lru_head == i) return;
+  // unlink
+  if (g->prev >= 0) _slots[g->prev].next = g->next;
+  if (g->next >= 0) _slots[g->next].prev = g->prev;
+  if (_lru_tail == i) _lru_tail = g->prev;
+  // insert at head
+  g->prev = -1;
+  g->next = _lru_head;
+  if (_lru_head >= 0) _slots[_lru_head].prev = i;
+  _lru_head = i;
+  if (_lru_tail < 0) _lru_tail = i;
+}
+
+PackGlyph* GlyphPackSet::allocSlot(uint32_t key) {
+  int16_t i;
+  if (_num_used < GLYPH_PACK_CACHE_SLOTS) {
+    i = _num_used++;
+    _slots[i].prev = _slots[i].next = -1;
+  } else {
+    i = _lru_tail;   // evict least recently used, remove from its hash chain
+    int16_t* pp = &_buckets[keyHash(_slots[i].key)];
+    while (*pp != i) pp = &_slots[*pp].chain;
+    *pp = _slots[i].chain;
+  }
+  PackGlyph* g = &_slots[i];
+  g->key = key;
+  uint32_t b = keyHash(key);
+  g->chain = _buckets[b];
+  _buckets[b] = i;
+  touch(g);
+  return g;
+}
+
+bool GlyphPackSet::readGlyph(const Pack& p, uint32_t cp, PackGlyph* g, uint8_t* bits) {
+  // fence search: last block whose first cp <= cp
+  int lo = 0, hi = p.num_fences - 1, blk = -1;
+  while (lo <= hi) {
+    int mid = (lo + hi) / 2;
+    if (p.fences[mid] <= cp) { blk = mid; lo = mid + 1; } else { hi = mid - 1; }
+  }
+  if (blk < 0) return false;
+
+  File f = SD.open(p.path, FILE_READ);
+  if (!f) return false;
+
+  uint32_t first = (uint32_t)blk * p.block;
+  int n = p.count - first < p.block ? p.count - first : p.block;
+  uint8_t entries[MAX_BLOCK * INDEX_ENTRY_SIZE];
+  if (!f.seek(p.index_off + first * INDEX_ENTRY_SIZE) || f.read(entries, n * INDEX_ENTRY_SIZE) != n * INDEX_ENTRY_SIZE) {
+    f.close();
+    return false;
+  }
+
+  const uint8_t* e = NULL;
+  lo = 0; hi = n - 1;
+  while (lo <= hi) {
+    int mid = (lo + hi) / 2;
+    uint32_t mcp = rd32(&entries[mid * INDEX_ENTRY_SIZE]) & 0xFFFFFF;
+    if (mcp == cp) { e = &entries[mid * INDEX_ENTRY_SIZE]; break; }
+    if (mcp < cp) lo = mid + 1; else hi = mid - 1;
+  }
+  if (e == NULL || e[8] > GLYPH_PACK_MAX_DIM || e[9] > GLYPH_PACK_MAX_DIM) {
+    f.close();
+    return false;
+  }
+
+  g->xa = e[3];
+  g->w = e[8];
+  g->h = e[9];
+  g->xo = (int8_t) e[10];
+  g->yo = (int8_t) e[11];
+  uint32_t off = rd32(&e[4]);
+  int raw = (g->w * g->h + 7) / 8;
+  bool ok = raw == 0;
+  if (raw > 0 && f.seek(off & ~COMPRESSED_BIT)) {
+    if (off & COMPRESSED_BIT) {
+      uint8_t src[GLYPH_PACK_MAX_BITMAP + GLYPH_PACK_MAX_BITMAP / 128 + 2];   // PackBits worst case
+      int len = f.read(src, raw + raw / 128 + 2);
+      int si = 0, di = 0;
+      while (si < len && di < raw) {
+        uint8_t c = src[si++];
+        if (c < 128) {
+          for (int k = 0; k <= c && si < len && di < raw; k++) bits[di++] = src[si++];
+        } else if (si < len) {
+          uint8_t v = src[si++];
+          for (int k = 0; k < c - 126 && di < raw; k++) bits[di++] = v;
+        }
+      }
+      ok = di == raw;
+    } else {
+      ok = f.read(bits, raw) == raw;
+    }
+  }
+  f.close();
+  return ok;
+}
+
+const PackGlyph* GlyphPackSet::get(int pack, uint32_t cp, const uint8_t** bits) {
+  if (_slots == NULL) return NULL;
+
+  uint32_t key = ((uint32_t)pack << 24) | (cp & 0xFFFFFF);
+  PackGlyph* g = lookup(key);
+  if (g) {
+    _hits++;
+    touch(g);
+  } else {
+    _misses++;
+    g = allocSlot(key);
+    g->found = readGlyph(_packs[pack], cp, g, &_bitmaps[(g - _slots) * GLYPH_PACK_MAX_BITMAP]);
+  }
+  *bits = &_bitmaps[(g - _slots) * GLYPH_PACK_MAX_BITMAP];
+  return g->found ? g : NULL;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Fallback chain
+
+int GlyphPackSet::nearestPack(int px_height) const {
+  int best = -1;
+  for (int i = 0; i < _num_packs; i++) {
+    if (best < 0 || abs(_packs[i].height - px_height) < abs(_packs[best].height - px_height)) best = i;
+  }
+  return best;
+}
+
+static inline int spriteScale(int px_height) {
+  return px_height >= 24 ? px_height / 12 : 1;   // emoji sprites are ~10-12px
+}
+
+int GlyphPackSet::draw(Adafruit_GFX& gfx, int x, int y, uint32_t cp, int px_height, uint8_t scale, uint16_t color) {
+  if (isZeroWidth(cp)) return 0;
+
+  // 1. glyph pack, nearest size
+  int best = nearestPack(px_height);
+  if (best >= 0) {
+    const uint8_t* bits;
+    const PackGlyph* g = get(best, cp, &bits);
+    if (g) {
+      int bit = 0;
+      for (int yy = 0; yy < g->h; yy++) {
+        for (int xx = 0; xx < g->w; xx++, bit++) {
+          if (bits[bit >> 3] & (0x80 >> (bit & 7))) {
+            if (scale == 1) {
+              gfx.drawPixel(x + g->xo + xx, y + g->yo + yy, color);
+            } else {
+              gfx.fillRect(x + (g->xo + xx) * scale, y + (g->yo + yy) * scale, scale, scale, color);
+            }
+          }
+        }
+      }
+      return g->xa * scale;
+    }
+  }
+
+  // 2. sprite (emoji), scaled up towards the line height, sitting on the baseline
+  if (_sprites) {
+    uint8_t w, h;
+    const uint8_t* sprite = _sprites(cp, w, h);
+    if (sprite) {
+      int s = scale * spriteScale(px_height);
+      int stride = (w + 7) / 8;
+      int top = y - h * s + s;
+      for (int yy = 0; yy < h; yy++) {
+        for (int xx = 0; xx < w; xx++) {
+          if (pgm_read_byte(&sprite[yy * stride + (xx >> 3)]) & (0x80 >> (xx & 7))) {
+            gfx.fillRect(x + xx * s, top + yy * s, s, s, color);
+          }
+        }
+      }
+      return (w + 1) * s;
+    }
+  }
+
+  // 3. replacement box
+  int bw = (px_height * scale) / 2;
+  int bh = (px_height * scale * 2) / 3;
+  if (bw < 4) bw = 4;
+  if (bh < 6) bh = 6;
+  gfx.drawRect(x + scale, y - bh + 1, bw - 2 * scale, bh, color);
+  return bw;
+}
+
+int GlyphPackSet::advance(uint32_t cp, int px_height, uint8_t scale) {
+  if (isZeroWidth(cp)) return 0;
+
+  int best = nearestPack(px_height);
+  if (best >= 0) {
+    const uint8_t* bits;
+    const PackGlyph* g = get(best, cp, &bits);
+    if (g) return g->xa * scale;
+  }
+  if (_sprites) {
+    uint8_t w, h;
+    if (_sprites(cp, w, h)) return (w + 1) * scale * spriteScale(px_height);
+  }
+  int bw = (px_height * scale) / 2;
+  return bw < 4 ? 4 : bw;
+}
+
+#endif
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <Arduino.h>   // needed for PlatformIO
+#include <Adafruit_GFX.h>
+#include "DisplayDriver.h"
+
+#ifndef GLYPH_PACKS
+  #ifdef ESP32
+    #define GLYPH_PACKS  1
+  #else
+    #define GLYPH_PACKS  0
+  #endif
+#endif
+#ifndef GLYPH_PACK_DIR
+  #define GLYPH_PACK_DIR          "/fonts"
+#endif
+#ifndef GLYPH_PACK_MAX
+  #define GLYPH_PACK_MAX           4     // sizes loaded at once
+#endif
+#ifndef GLYPH_PACK_CACHE_SLOTS
+  #define GLYPH_PACK_CACHE_SLOTS  192
+#endif
+#define GLYPH_PACK_MAX_DIM        48     // larger glyphs in a pack are treated as missing
+#define GLYPH_PACK_MAX_BITMAP     ((GLYPH_PACK_MAX_DIM * GLYPH_PACK_MAX_DIM + 7) / 8)
+#define GLYPH_PACK_HASH_BUCKETS   64     // power of 2
+
+/*
+ * Glyph pack file, one per pixel size, eg. /fonts/unicode_24.mgp  (all little-endian)
+ *
+ *   header (20 bytes):
+ *     char[4]   "MGP1"
+ *     uint8     height      line height (px), used to pick pack for current font
+ *     uint8     ascent      baseline to top of line (px)
+ *     uint16    block       index entries per block (fence stride)
+ *     uint32    count       number of glyphs
+ *     uint32    fence_off   uint32[ceil(count/block)]: first codepoint of each index block
+ *     uint32    index_off   count x 12 byte entries, sorted by codepoint:
+ *                             uint32 cp (bits 0-23), xAdvance (bits 24-31)
+ *                             uint32 bitmap offset (bit 31 set = PackBits compressed)
+ *                             uint8 width, height; int8 xOffset, yOffset   (as GFXglyph)
+ *   bitmaps: GFXfont style bit stream (MSB first, rows not byte aligned), optionally
+ *     PackBits compressed: n < 128 -> n+1 literal bytes follow, n >= 128 -> next byte repeated n-126 times
+ *
+ * Only the fence table is kept in RAM, so a lookup is a binary search of fences, then one block
+ * read + binary search, then one bitmap read. Results (including 'not in pack') go in an LRU cache.
+ */
+
+struct PackGlyph {
+  uint32_t key;          // pack << 24 | cp
+  int16_t prev, next;    // LRU list, head = most recent
+  int16_t chain;         // next in hash bucket
+  uint8_t w, h;
+  int8_t xo, yo;
+  uint8_t xa;
+  bool found;            // false = not in pack (cached negative)
+};
+
+/**
+ * \brief  Fallback for code points the current font doesn't have: SD glyph pack (nearest size)
+ *     -> sprite lookup (emoji) -> replacement box. Drawing is on any Adafruit_GFX surface.
+ */
+class GlyphPackSet {
+  struct Pack {
+    char path[48];
+    uint8_t height, ascent;
+    uint16_t block;
+    uint32_t count;
+    uint32_t index_off;
+    uint32_t* fences;
+    uint16_t num_fences;
+  };
+  Pack _packs[GLYPH_PACK_MAX];
+  uint8_t _num_packs;
+
+  PackGlyph* _slots;
+  uint8_t* _bitmaps;     // GLYPH_PACK_MAX_BITMAP per slot
+  int16_t _buckets[GLYPH_PACK_HASH_BUCKETS];
+  int16_t _lru_head, _lru_tail;
+  uint16_t _num_used;
+  GlyphSpriteLookup _sprites;
+  uint32_t _hits, _misses;
+
+  bool addPack(const char* path);
+  PackGlyph* lookup(uint32_t key);
+  PackGlyph* allocSlot(uint32_t key);
+  void touch(PackGlyph* g);
+  bool readGlyph(const Pack& p, uint32_t cp, PackGlyph* g, uint8_t* bits);
+  const PackGlyph* get(int pack, uint32_t cp, const uint8_t** bits);
+  int nearestPack(int px_height) const;
+
+public:
+  GlyphPackSet();
+
+  /**
+   * \brief  load headers + fence tables of the *.mgp files in dir (SD must be mounted)
+   * \returns  number of packs loaded
+   */
+  int load(const char* dir);
+  void setSpriteLookup(GlyphSpriteLookup fn) { _sprites = fn; }
+
+  bool isActive() const { return _num_packs > 0 || _sprites != NULL; }
+  static bool isZeroWidth(uint32_t cp);
+
+  /**
+   * \brief  draw cp with its origin on the baseline at x,y (fallback chain), scaled by 'scale'
+   * \param  px_height  line height of current font, selects the pack
+   * \returns  advance in px (already scaled)
+   */
+  int draw(Adafruit_GFX& gfx, int x, int y, uint32_t cp, int px_height, uint8_t scale, uint16_t color);
+  int advance(uint32_t cp, int px_height, uint8_t scale);
+
+  uint32_t getHits() const { return _hits; }
+  uint32_t getMisses() const { return _misses; }
+};
@@ -108,6 +108,10 @@ static bool hasNonAscii(const char* str) {
   // E-ink and LoRa SHARE the same SPI bus (SCK=36, MOSI=33)
   // They MUST use the same SPI peripheral (HSPI) to avoid GPIO conflicts
   // Different chip selects allow both to coexist: E-ink CS=34, LoRa CS=3
+  // Transfers from different tasks (radio Rx task, mesh task, UI) are safe: the
+  // ESP32 HAL holds a per-peripheral mutex from beginTransaction() to
+  // endTransaction(), shared by every SPIClass on HSPI (this one, the LoRa one, SD).
+  // GxEPD2, RadioLib and the SD driver all drive their CS inside a transaction.
   SPIClass displaySpi(HSPI);
 #endif
 
@@ -311,17 +315,34 @@ void GxEPDDisplay::print(const char* str) {
       if (has8bFont && cp >= _currentFont->first && cp <= _currentFont->last) {
         // Render directly from 8b font glyph table
         drawGlyphAtCursor((uint16_t)cp);
-      } else if (!has8bFont) {
+      } else {
         // Classic/7b font -- fold to ASCII
-        char folded = foldToAscii(cp);
-        if (folded) display.write((uint8_t)folded);
+        char folded = has8bFont ? 0 : foldToAscii(cp);
+        if (folded) {
+          display.write((uint8_t)folded);
+#if GLYPH_PACKS
+        } else if (_glyphPacks.isActive() && cp != 0xFFFD) {   // not invalid UTF-8
+          drawFallbackGlyph(cp);
+#endif
+        }
+        // else: codepoint outside font range, skip
       }
-      // else: codepoint outside font range, skip
       pos += consumed;
     }
   }
 }
 
+#if GLYPH_PACKS
+void GxEPDDisplay::drawFallbackGlyph(uint32_t cp) {
+  int16_t cx = display.getCursorX();
+  int16_t cy = display.getCursorY();
+  int lineH = _currentFont ? _currentFont->yAdvance : 8;
+  int baseline = _currentFont ? cy : cy + 7 * _currentTextScale;   // built-in font: cursor is top-left
+  int adv = _glyphPacks.draw(display, cx, baseline, cp, lineH, _currentTextScale, _curr_color);
+  display.setCursor(cx + adv, cy);
+}
+#endif
+
 // Render one glyph from the current 8b font at the display cursor position.
 // Mimics Adafruit_GFX::drawChar() but supports 16-bit codepoints.
 void GxEPDDisplay::drawGlyphAtCursor(uint16_t cp) {
@@ -446,6 +467,10 @@ uint16_t GxEPDDisplay::getTextWidth(const char* str) {
       uint32_t cp = utf8Decode(s + pos, len - pos, &consumed);
       if (cp >= _currentFont->first && cp <= _currentFont->last) {
         totalAdv += _currentFont->glyph[cp - _currentFont->first].xAdvance * _currentTextScale;
+#if GLYPH_PACKS
+      } else if (_glyphPacks.isActive() && cp != 0xFFFD) {
+        totalAdv += _glyphPacks.advance(cp, _currentFont->yAdvance, _currentTextScale);
+#endif
       }
       pos += consumed;
     }
@@ -457,6 +482,7 @@ uint16_t GxEPDDisplay::getTextWidth(const char* str) {
   const uint8_t* s = (const uint8_t*)str;
   int len = strlen(str);
   int pos = 0, fi = 0;
+  int fallbackAdv = 0;   // code points that won't fold, drawn by the glyph fallback
   while (pos < len && fi < 254) {
     uint8_t b = s[pos];
     if (b < 0x80) {
@@ -467,6 +493,11 @@ uint16_t GxEPDDisplay::getTextWidth(const char* str) {
       uint32_t cp = utf8Decode(s + pos, len - pos, &consumed);
       char fc = foldToAscii(cp);
       if (fc) folded[fi++] = fc;
+#if GLYPH_PACKS
+      else if (_glyphPacks.isActive() && cp != 0xFFFD) {
+        fallbackAdv += _glyphPacks.advance(cp, _currentFont ? _currentFont->yAdvance : 8, _currentTextScale);
+      }
+#endif
       pos += consumed;
     }
   }
@@ -474,7 +505,7 @@ uint16_t GxEPDDisplay::getTextWidth(const char* str) {
   int16_t x1, y1;
   uint16_t w, h;
   display.getTextBounds(folded, 0, 0, &x1, &y1, &w, &h);
-  return ceil((w + 1) / scale_x);
+  return ceil((w + fallbackAdv + 1) / scale_x);
 }
 
 void GxEPDDisplay::endFrame() {
@@ -511,7 +542,14 @@ void GxEPDDisplay::translateUTF8ToBlocks(char* dest, const char* src, size_t des
       int consumed;
       uint32_t cp = utf8Decode(s + pos, len - pos, &consumed);
       char folded = foldToAscii(cp);
-      if (folded) dest[j++] = folded;
+      if (folded) {
+        dest[j++] = folded;
+#if GLYPH_PACKS
+      } else if (_glyphPacks.isActive() && cp != 0xFFFD && j + consumed < dest_size) {
+        memcpy(&dest[j], &s[pos], consumed);   // keep, print() draws it via fallback
+        j += consumed;
+#endif
+      }
       pos += consumed;
     } else {
       pos++;  // skip control chars
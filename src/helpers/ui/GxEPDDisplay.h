@@ -52,6 +52,7 @@ public:
 };
 
 #include "DisplayDriver.h"
+#include "GlyphPack.h"
 
 class GxEPDDisplay : public DisplayDriver {
 
@@ -80,6 +81,12 @@ class GxEPDDisplay : public DisplayDriver {
   // Render one glyph from the current 8b font at the display's cursor position
   void drawGlyphAtCursor(uint16_t cp);
 
+#if GLYPH_PACKS
+  GlyphPackSet _glyphPacks;
+  // Code point not in current font: glyph pack / sprite / box, at cursor
+  void drawFallbackGlyph(uint32_t cp);
+#endif
+
 public:
 // Virtual canvas dimensions — default 128×128 (MeshCore standard).
 // Override for displays where physical resolution / scale < 128.
@@ -117,6 +124,10 @@ public:
   uint16_t getTextWidth(const char* str) override;
   void endFrame() override;
   void translateUTF8ToBlocks(char* dest, const char* src, size_t dest_size) override;
+#if GLYPH_PACKS
+  int loadGlyphPacks(const char* dir) override { return _glyphPacks.load(dir); }
+  void setGlyphSpriteLookup(GlyphSpriteLookup fn) override { _glyphPacks.setSpriteLookup(fn); }
+#endif
 
   // --- Raw pixel access for MapScreen (bypasses scaling) ---
   void drawPixelRaw(int16_t x, int16_t y, uint16_t color) {
@@ -0,0 +1,153 @@
+#pragma once
+
+#include "DisplayDriver.h"
+
+// ---------------------------------------------------------------------------
+// Retained-mode widgets for UIScreen.
+//
+// A screen keeps its widgets between frames and only pushes new content into
+// them (eg. label.set(buf)). Widgets whose content changed are marked dirty,
+// and only those are re-laid-out (text measured, aligned) on the next render.
+// Every widget is still drawn each frame, as startFrame() clears the canvas.
+// Pixel-level damage for the panel update is worked out by the display driver.
+// ---------------------------------------------------------------------------
+
+#ifndef UI_LABEL_MAX_LEN
+  #define UI_LABEL_MAX_LEN       40
+#endif
+#ifndef UI_GROUP_MAX_WIDGETS
+  #define UI_GROUP_MAX_WIDGETS    8
+#endif
+
+struct UIRect {
+  int x, y, w, h;
+
+  UIRect() : x(0), y(0), w(0), h(0) { }
+};
+
+class UIWidget {
+protected:
+  UIRect _bounds;
+  bool _dirty;
+  bool _visible;
+
+public:
+  UIWidget() : _dirty(true), _visible(true) { }
+
+  const UIRect& bounds() const { return _bounds; }
+  bool isDirty() const { return _dirty; }
+  void invalidate() { _dirty = true; }
+  void clearDirty() { _dirty = false; }
+
+  bool isVisible() const { return _visible; }
+  void setVisible(bool v) { if (v != _visible) { _visible = v; _dirty = true; } }
+
+  virtual void layout(DisplayDriver& display) { }   // only called when dirty
+  virtual void draw(DisplayDriver& display) = 0;
+};
+
+class UILabel : public UIWidget {
+public:
+  enum Align { LEFT, CENTER, RIGHT };
+
+private:
+  char _text[UI_LABEL_MAX_LEN];
+  int _anchor_x, _y, _line_h;
+  int _size;
+  DisplayDriver::Color _color;
+  Align _align;
+
+public:
+  UILabel(int anchor_x, int y, int line_h, int size = 1, DisplayDriver::Color color = DisplayDriver::LIGHT, Align align = LEFT)
+    : _anchor_x(anchor_x), _y(y), _line_h(line_h), _size(size), _color(color), _align(align) {
+    _text[0] = 0;
+  }
+
+  const char* get() const { return _text; }
+
+  void set(const char* text) {
+    if (strncmp(_text, text, sizeof(_text) - 1) == 0) return;   // unchanged
+    strncpy(_text, text, sizeof(_text) - 1);
+    _text[sizeof(_text) - 1] = 0;
+    _dirty = true;
+  }
+  void moveTo(int anchor_x, int y) {
+    if (anchor_x != _anchor_x || y != _y) { _anchor_x = anchor_x; _y = y; _dirty = true; }
+  }
+  void setTextSize(int sz) { if (sz != _size) { _size = sz; _dirty = true; } }
+  void setColor(DisplayDriver::Color c) { _color = c; }   // doesn't change layout
+
+  void layout(DisplayDriver& display) override {
+    display.setTextSize(_size);
+    int w = _text[0] ? display.getTextWidth(_text) : 0;
+    int x = _anchor_x;
+    if (_align == CENTER) x -= w / 2;
+    else if (_align == RIGHT) x -= w;
+    _bounds.x = x;
+    _bounds.y = _y;
+    _bounds.w = w;
+    _bounds.h = _line_h;
+  }
+
+  void draw(DisplayDriver& display) override {
+    if (_text[0] == 0) return;
+    display.setTextSize(_size);
+    display.setColor(_color);
+    display.setCursor(_bounds.x, _bounds.y);
+    display.print(_text);
+  }
+};
+
+class UIIcon : public UIWidget {
+  const uint8_t* _bits;
+  DisplayDriver::Color _color;
+
+public:
+  UIIcon(int x, int y, const uint8_t* bits, int w, int h, DisplayDriver::Color color = DisplayDriver::LIGHT)
+    : _bits(bits), _color(color) {
+    _bounds.x = x; _bounds.y = y; _bounds.w = w; _bounds.h = h;
+  }
+
+  void setBits(const uint8_t* bits) { if (bits != _bits) { _bits = bits; _dirty = true; } }
+
+  void draw(DisplayDriver& display) override {
+    if (_bits == NULL) return;
+    display.setColor(_color);
+    display.drawXbm(_bounds.x, _bounds.y, _bits, _bounds.w, _bounds.h);
+  }
+};
+
+class UIWidgetGroup {
+  UIWidget* _items[UI_GROUP_MAX_WIDGETS];
+  uint8_t _count;
+  int _font_style;     // measurements are only valid for this font style
+
+public:
+  UIWidgetGroup() : _count(0), _font_style(-1) { }
+
+  bool add(UIWidget* w) {
+    if (_count >= UI_GROUP_MAX_WIDGETS) return false;
+    _items[_count++] = w;
+    return true;
+  }
+
+  void invalidateAll() {
+    for (int i = 0; i < _count; i++) _items[i]->invalidate();
+  }
+
+  // lay out dirty widgets, then draw all (visible) widgets
+  void render(DisplayDriver& display) {
+    if (display.getFontStyle() != _font_style) {   // text metrics all changed
+      _font_style = display.getFontStyle();
+      invalidateAll();
+    }
+    for (int i = 0; i < _count; i++) {
+      UIWidget* w = _items[i];
+      if (w->isDirty()) {
+        if (w->isVisible()) w->layout(display);
+        w->clearDirty();
+      }
+      if (w->isVisible()) w->draw(display);
+    }
+  }
+};
@@ -71,14 +71,18 @@ uint32_t radio_get_rng_seed() {
 }
 
 void radio_set_params(float freq, float bw, uint8_t sf, uint8_t cr) {
+  radio_driver.lockRadio();   // Rx task may be reading from radio
   radio.setFrequency(freq);
   radio.setSpreadingFactor(sf);
   radio.setBandwidth(bw);
   radio.setCodingRate(cr);
+  radio_driver.unlockRadio();
 }
 
 void radio_set_tx_power(uint8_t dbm) {
+  radio_driver.lockRadio();   // Rx task may be reading from radio
   radio.setOutputPower(dbm);
+  radio_driver.unlockRadio();
 }
 
 mesh::LocalIdentity radio_new_identity() {
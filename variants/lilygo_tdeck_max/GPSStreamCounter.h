@@ -3,11 +3,11 @@
 #include <Arduino.h>
 
 // Transparent Stream wrapper that counts NMEA sentences (newline-delimited)
-// flowing from the GPS serial port to the MicroNMEA parser.
+// flowing from the GPS serial port to the MicroNMEA parser (on the GNSS task).
 //
-// Usage:  Instead of  MicroNMEALocationProvider gps(Serial2, &rtc_clock);
+// Usage:  Instead of  GNSSLocationProvider gps(Serial2, &rtc_clock);
 //         Use:        GPSStreamCounter gpsStream(Serial2);
-//                     MicroNMEALocationProvider gps(gpsStream, &rtc_clock);
+//                     GNSSLocationProvider gps(gpsStream, &rtc_clock);
 //
 // Every read() call passes through to the underlying stream; when a '\n'
 // is seen the sentence counter increments.  This lets the UI display a
@@ -26,9 +26,9 @@ AutoDiscoverRTCClock rtc_clock(fallback_clock);
 
 #if HAS_GPS
   // Wrap Serial2 with a sentence counter so the UI can show NMEA throughput.
-  // MicroNMEALocationProvider reads through this wrapper transparently.
+  // GNSSLocationProvider reads through this wrapper on its own task.
   GPSStreamCounter gpsStream(Serial2);
-  MicroNMEALocationProvider gps(gpsStream, &rtc_clock);
+  GNSSLocationProvider gps(gpsStream, &rtc_clock);
   EnvironmentSensorManager sensors(gps);
 #else
   SensorManager sensors;
@@ -71,6 +71,7 @@ uint32_t radio_get_rng_seed() {
 }
 
 void radio_set_params(float freq, float bw, uint8_t sf, uint8_t cr) {
+  radio_driver.lockRadio();   // Rx task may be reading from radio
   radio.setFrequency(freq);
   radio.setSpreadingFactor(sf);
   radio.setBandwidth(bw);
@@ -83,10 +84,13 @@ void radio_set_params(float freq, float bw, uint8_t sf, uint8_t cr) {
   uint16_t preamble = (sf <= 8) ? 32 : 16;
   radio.setPreambleLength(preamble);
   MESH_DEBUG_PRINTLN("radio_set_params() - bw=%.1f sf=%u preamble=%u", bw, sf, preamble);
+  radio_driver.unlockRadio();
 }
 
 void radio_set_tx_power(uint8_t dbm) {
+  radio_driver.lockRadio();   // Rx task may be reading from radio
   radio.setOutputPower(dbm);
+  radio_driver.unlockRadio();
 }
 
 mesh::LocalIdentity radio_new_identity() {
@@ -17,7 +17,7 @@
 
 #if HAS_GPS
   #include "helpers/sensors/EnvironmentSensorManager.h"
-  #include "helpers/sensors/MicroNMEALocationProvider.h"
+  #include "helpers/sensors/GNSSLocationProvider.h"
   #include "GPSStreamCounter.h"
 #else
   #include <helpers/SensorManager.h>
@@ -29,6 +29,7 @@ extern AutoDiscoverRTCClock rtc_clock;
 
 #if HAS_GPS
   extern GPSStreamCounter gpsStream;
+  extern GNSSLocationProvider gps;
   extern EnvironmentSensorManager sensors;
 #else
   extern SensorManager sensors;